@@ -7,6 +7,26 @@ inter_salt = "changeme";
 -- Use encryption to communicate with clients?
 use_client_encryption = true;
 
+-- How many threads should perform network I/O and packet encryption? Packet handling itself is still serialized
+io_threads = 1;
+
+-- How many threads (each with its own database connection) should run queries that were taken off the packet handling path?
+database_threads = 2;
+
+-- How many threads should channel servers spread maps across? Movement and map upkeep for different maps then run in parallel
+-- 0 keeps every map on the single packet handling thread
+map_worker_threads = 0;
+
+-- How many bytes may be waiting to be sent to a client before it's considered too slow and disconnected? 0 disables the limit
+client_send_queue_limit = 1048576;
+
+-- How often (in seconds) should each server write its packet handler, session, timer and database statistics to the log? 0 disables it
+stats_log_interval = 300;
+
+-- Should each server serve the same statistics as plain text to local connections (e.g. for a monitoring scraper)? 0 disables it
+-- Servers on the same machine take the first free port at or after this one, the port in use is logged on startup
+stats_port = 0;
+
 -- Ping inter-server connections? This should generally remain enabled, but it's useful for using a debugger
 inter_ping = {
 	["enabled"] = true,
@@ -48,6 +48,14 @@ function generateWorld(props)
 		-- Map unload time (in seconds)
 		-- 0 means map unloading is disabled
 		["map_unload_time"] = 60 * 60,
+		-- Number of players a map needs before movement, attacks, and expressions are only sent to players nearby
+		-- 0 means every player on the map always sees them
+		["interest_player_threshold"] = 0,
+		-- How far away (in pixels) a player can be and still see those packets once a map is past the threshold
+		["interest_view_range"] = 1000,
+		-- How long (in milliseconds) player and mob movement is held so it can be merged and sent once per interval
+		-- 0 means movement is sent as soon as it arrives
+		["movement_coalesce_interval"] = 0,
 		
 		-- NPC script allocation, overrides regular scripts set in client
 		-- Note: wrong npc ids give exception!!!
@@ -0,0 +1,102 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bench/bench_case.hpp"
+#include "bench/reference_transformer.hpp"
+#include "common/encrypted_packet_transformer.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <random>
+
+namespace vana {
+namespace bench {
+
+namespace {
+	const crypto_iv client_iv = 0x52A1F3C7;
+	const crypto_iv server_iv = 0x0B64E91D;
+	const uint16_t header_size = 4;
+	const int32_t max_fuzz_size = 5000;
+	const int32_t fuzz_packets = 2000;
+
+	struct timed_size {
+		int32_t size;
+		size_t iterations;
+	};
+
+	const timed_size timed_sizes[] = {
+		{2, 100000},
+		{64, 50000},
+		{4096, 5000},
+	};
+
+	auto fill(vector<unsigned char> &buffer, std::mt19937 &engine) -> void {
+		std::uniform_int_distribution<int32_t> bytes{0, 255};
+		for (auto &value : buffer) {
+			value = static_cast<unsigned char>(bytes(engine));
+		}
+	}
+}
+
+auto aes_transformer(std::ostream &out) -> result {
+	std::mt19937 engine{0x5EED};
+	std::uniform_int_distribution<int32_t> sizes{1, max_fuzz_size};
+
+	// Every side starts from the same IVs and shuffles them once per packet, so they stay in step as long as every packet matches
+	encrypted_packet_transformer server{client_iv, server_iv};
+	encrypted_packet_transformer client{server_iv, client_iv};
+	reference_transformer reference{client_iv, server_iv};
+
+	for (int32_t i = 0; i < fuzz_packets; ++i) {
+		// Sizes past 1460 bytes span several chunks, each of which restarts from the IV
+		vector<unsigned char> plain(sizes(engine));
+		fill(plain, engine);
+		int32_t size = static_cast<int32_t>(plain.size());
+
+		vector<unsigned char> current = plain;
+		vector<unsigned char> expected = plain;
+		server.encrypt_packet(current.data(), size, header_size);
+		reference.encrypt_packet(expected.data(), size, header_size);
+		if (current != expected) {
+			out << "encrypt_packet differs from the old path on a " << size << " byte packet" << std::endl;
+			return result::failure;
+		}
+
+		client.decrypt_packet(current.data(), size, header_size);
+		if (current != plain) {
+			out << "decrypt_packet doesn't round trip a " << size << " byte packet" << std::endl;
+			return result::failure;
+		}
+	}
+	out << fuzz_packets << " packets of 1-" << max_fuzz_size << " bytes match the old path" << std::endl;
+
+	out << std::fixed << std::setprecision(1);
+	for (const auto &timed : timed_sizes) {
+		vector<unsigned char> buffer(timed.size);
+		fill(buffer, engine);
+
+		double old_ns = nanoseconds_per_call(timed.iterations, [&] { reference.encrypt_packet(buffer.data(), timed.size, header_size); });
+		double new_ns = nanoseconds_per_call(timed.iterations, [&] { server.encrypt_packet(buffer.data(), timed.size, header_size); });
+		out << std::setw(5) << timed.size << " bytes: "
+			<< old_ns << " ns -> " << new_ns << " ns per packet"
+			<< " (" << old_ns / std::max(new_ns, 1.0) << "x)" << std::endl;
+	}
+
+	return result::success;
+}
+
+}
+}
@@ -0,0 +1,68 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<uint64_t> s_heap_allocations{0};
+
+	auto counted_allocate(std::size_t size) -> void * {
+		s_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+		void *memory = std::malloc(size == 0 ? 1 : size);
+		if (memory == nullptr) {
+			throw std::bad_alloc{};
+		}
+		return memory;
+	}
+}
+
+auto operator new(std::size_t size) -> void * {
+	return counted_allocate(size);
+}
+
+auto operator new[](std::size_t size) -> void * {
+	return counted_allocate(size);
+}
+
+auto operator delete(void *memory) noexcept -> void {
+	std::free(memory);
+}
+
+auto operator delete[](void *memory) noexcept -> void {
+	std::free(memory);
+}
+
+auto operator delete(void *memory, std::size_t) noexcept -> void {
+	std::free(memory);
+}
+
+auto operator delete[](void *memory, std::size_t) noexcept -> void {
+	std::free(memory);
+}
+
+namespace vana {
+namespace bench {
+
+auto get_heap_allocation_count() -> uint64_t {
+	return s_heap_allocations.load(std::memory_order_relaxed);
+}
+
+}
+}
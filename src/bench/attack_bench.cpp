@@ -0,0 +1,186 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bench/allocation_counter.hpp"
+#include "bench/bench_case.hpp"
+#include "common/attack_data.hpp"
+#include "common/packet_builder.hpp"
+#include "common/packet_reader.hpp"
+#include <iomanip>
+#include <random>
+
+namespace vana {
+namespace bench {
+
+namespace {
+	const size_t recorded_attacks = 4096;
+	const size_t replay_passes = 50;
+
+	// The damage section of an attack packet, everything in front of it is fixed size and doesn't touch attack_data's storage
+	struct recorded_attack {
+		int8_t targets;
+		int8_t hits;
+		bool meso_explosion;
+		bool summon;
+		vector<unsigned char> packet;
+	};
+
+	// No captures ship with the repository, so these follow what the client sends: mostly single target skills with a few hits, some mob-clearing ones, summons and Meso Explosion
+	auto record_attacks(std::mt19937 &engine) -> vector<recorded_attack> {
+		std::discrete_distribution<int32_t> target_counts{0, 40, 10, 12, 6, 8, 10, 3, 2, 1, 1, 1, 1, 1, 1, 1};
+		std::discrete_distribution<int32_t> hit_counts{0, 35, 15, 12, 15, 5, 8, 4, 2, 1, 1, 1, 1, 1, 1, 1};
+		std::uniform_int_distribution<int32_t> percentage{0, 99};
+		std::uniform_int_distribution<game_map_object> mob_ids{100, 140};
+		std::uniform_int_distribution<game_damage> damages{1, 99999};
+
+		vector<recorded_attack> attacks;
+		for (size_t i = 0; i < recorded_attacks; ++i) {
+			recorded_attack attack;
+			int32_t kind = percentage(engine);
+			attack.summon = kind < 10;
+			attack.meso_explosion = !attack.summon && kind < 15;
+			attack.targets = static_cast<int8_t>(target_counts(engine));
+			attack.hits = attack.summon ? 1 : static_cast<int8_t>(hit_counts(engine));
+
+			// Each mob once, a repeated mob would have its hits merged and could go past the limit
+			game_map_object first_mob = mob_ids(engine);
+			packet_builder builder;
+			for (int8_t t = 0; t < attack.targets; ++t) {
+				builder
+					.add<game_map_object>(first_mob + t)
+					.add<int8_t>(-1)
+					.add<uint8_t>(0x85)
+					.add<int8_t>(2)
+					.add<uint8_t>(0)
+					.add<point>(point{120, -45})
+					.add<point>(point{118, -60});
+
+				int8_t hits = attack.hits;
+				if (attack.meso_explosion) {
+					hits = static_cast<int8_t>(hit_counts(engine));
+					builder.add<int8_t>(hits);
+				}
+				else {
+					builder.add<uint16_t>(90);
+				}
+				for (int8_t k = 0; k < hits; ++k) {
+					builder.add<game_damage>(damages(engine));
+				}
+				if (!attack.summon) {
+					builder.add<game_checksum>(0xF9B16E60);
+				}
+			}
+			attack.packet.assign(builder.get_buffer(), builder.get_buffer() + builder.get_size());
+			attacks.push_back(std::move(attack));
+		}
+		return attacks;
+	}
+
+	auto replay(recorded_attack &recorded) -> int64_t {
+		attack_data attack;
+		attack.targets = recorded.targets;
+		attack.hits = recorded.hits;
+		attack.is_meso_explosion = recorded.meso_explosion;
+		packet_reader reader{recorded.packet.data(), recorded.packet.size()};
+		attack.read_targets(reader, recorded.summon);
+		return attack.total_damage;
+	}
+
+	// How compile_attack used to collect damage, one hash table per attack and one vector per target
+	auto replay_hash_map(recorded_attack &recorded) -> int64_t {
+		hash_map<game_map_object, vector<game_damage>> damages;
+		int64_t total_damage = 0;
+		int8_t hits = recorded.hits;
+		packet_reader reader{recorded.packet.data(), recorded.packet.size()};
+		for (int8_t i = 0; i < recorded.targets; ++i) {
+			game_map_object map_mob_id = reader.get<game_map_object>();
+			reader.skip<int8_t>();
+			reader.skip<uint8_t>();
+			reader.skip<int8_t>();
+			reader.skip<uint8_t>();
+			reader.skip<point>();
+			reader.skip<point>();
+			if (!recorded.meso_explosion) {
+				reader.skip<uint16_t>();
+			}
+			else {
+				hits = reader.get<int8_t>();
+			}
+			vector<game_damage> &target = damages[map_mob_id];
+			for (int8_t k = 0; k < hits; ++k) {
+				game_damage damage = reader.get<game_damage>();
+				target.push_back(damage);
+				total_damage += damage;
+			}
+			if (!recorded.summon) {
+				reader.skip<game_checksum>();
+			}
+		}
+		return total_damage;
+	}
+}
+
+auto attack_replay(std::ostream &out) -> result {
+	std::mt19937 engine{0x5EED};
+	vector<recorded_attack> attacks = record_attacks(engine);
+	size_t replayed = attacks.size() * replay_passes;
+
+	int64_t inline_damage = 0;
+	uint64_t inline_allocations = get_heap_allocation_count();
+	auto start = std::chrono::steady_clock::now();
+	for (size_t pass = 0; pass < replay_passes; ++pass) {
+		for (auto &attack : attacks) {
+			inline_damage += replay(attack);
+		}
+	}
+	auto inline_elapsed = std::chrono::steady_clock::now() - start;
+	inline_allocations = get_heap_allocation_count() - inline_allocations;
+
+	int64_t map_damage = 0;
+	uint64_t map_allocations = get_heap_allocation_count();
+	start = std::chrono::steady_clock::now();
+	for (size_t pass = 0; pass < replay_passes; ++pass) {
+		for (auto &attack : attacks) {
+			map_damage += replay_hash_map(attack);
+		}
+	}
+	auto map_elapsed = std::chrono::steady_clock::now() - start;
+	map_allocations = get_heap_allocation_count() - map_allocations;
+
+	out << std::fixed << std::setprecision(2)
+		<< replayed << " attacks, inline targets: "
+		<< static_cast<double>(inline_allocations) / replayed << " allocations and "
+		<< static_cast<double>(duration_cast<nanoseconds>(inline_elapsed).count()) / replayed << " ns per attack" << std::endl
+		<< replayed << " attacks, hash_map of vectors: "
+		<< static_cast<double>(map_allocations) / replayed << " allocations and "
+		<< static_cast<double>(duration_cast<nanoseconds>(map_elapsed).count()) / replayed << " ns per attack" << std::endl;
+
+	// None of the generated attacks go past the protocol limits, so both have to see every damage line
+	if (inline_damage != map_damage) {
+		out << "inline targets counted " << inline_damage << " damage, expected " << map_damage << std::endl;
+		return result::failure;
+	}
+	if (inline_allocations != 0) {
+		out << "compiling an attack still allocates" << std::endl;
+		return result::failure;
+	}
+
+	return result::success;
+}
+
+}
+}
@@ -0,0 +1,51 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace vana {
+	namespace bench {
+		// A case returns failure when one of its checks doesn't hold, the timings it prints are informational
+		struct bench_case {
+			const char *name;
+			// Cases that read the MCDB only run when named on the command line
+			bool needs_database;
+			auto (*run)(std::ostream &out) -> result;
+		};
+
+		auto aes_transformer(std::ostream &out) -> result;
+		auto shuffle(std::ostream &out) -> result;
+		auto packet_buffers(std::ostream &out) -> result;
+		auto provider_lookups(std::ostream &out) -> result;
+		auto attack_replay(std::ostream &out) -> result;
+
+		template <typename TFunc>
+		auto nanoseconds_per_call(size_t iterations, TFunc func) -> double {
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; ++i) {
+				func();
+			}
+			auto elapsed = std::chrono::steady_clock::now() - start;
+			return static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / iterations;
+		}
+	}
+}
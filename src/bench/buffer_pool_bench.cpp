@@ -0,0 +1,183 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bench/bench_case.hpp"
+#include "common/packet_builder.hpp"
+#include "common/util/buffer_pool.hpp"
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+
+namespace vana {
+namespace bench {
+
+namespace {
+	// Mostly small game packets with the occasional map or inventory dump
+	const size_t packet_sizes[] = {2, 6, 14, 24, 40, 64, 90, 150, 300, 600, 1200, 4000};
+	const size_t warmup_packets = 100000;
+	const size_t measured_packets = 1000000;
+	const size_t max_in_flight = 64;
+
+	auto make_sizes(std::mt19937 &engine) -> vector<size_t> {
+		std::uniform_int_distribution<size_t> index{0, std::extent<decltype(packet_sizes)>::value - 1};
+		vector<size_t> sizes(4096);
+		for (auto &size : sizes) {
+			size = packet_sizes[index(engine)];
+		}
+		return sizes;
+	}
+
+	// Build a packet, copy it the way a broadcast does and frame it for sending
+	auto send_packet(const unsigned char *payload, size_t size) -> void {
+		packet_builder builder;
+		builder.add<uint16_t>(0x0001);
+		builder.add_buffer(payload, size);
+		packet_builder copy = builder;
+		vana::util::pooled_buffer frame{copy.get_size() + 4};
+		memcpy(frame.get() + 4, copy.get_buffer(), copy.get_size());
+	}
+
+	// The compiler is allowed to drop a new[]/delete[] pair outright unless the pointer escapes
+	unsigned char * volatile escaped = nullptr;
+
+	auto send_packet_heap(const unsigned char *payload, size_t size) -> void {
+		unsigned char *builder = new unsigned char[size + 2];
+		memcpy(builder + 2, payload, size);
+		unsigned char *copy = new unsigned char[size + 2];
+		memcpy(copy, builder, size + 2);
+		unsigned char *frame = new unsigned char[size + 6];
+		memcpy(frame + 4, copy, size + 2);
+		escaped = builder;
+		escaped = copy;
+		escaped = frame;
+		delete[] frame;
+		delete[] copy;
+		delete[] builder;
+	}
+
+	// Frames are handed to another thread that releases them, like a write completion does
+	class frame_queue {
+	public:
+		auto push(unsigned char *buffer, size_t capacity) -> void {
+			owned_lock<mutex> l{m_mutex};
+			m_not_full.wait(l, [this] { return m_count < max_in_flight; });
+			m_frames[(m_first + m_count) % max_in_flight] = {buffer, capacity};
+			m_count++;
+			m_not_empty.notify_one();
+		}
+
+		auto pop(pair<unsigned char *, size_t> &frame) -> bool {
+			owned_lock<mutex> l{m_mutex};
+			m_not_empty.wait(l, [this] { return m_count > 0 || m_done; });
+			if (m_count == 0) {
+				return false;
+			}
+			frame = m_frames[m_first];
+			m_first = (m_first + 1) % max_in_flight;
+			m_count--;
+			m_not_full.notify_one();
+			return true;
+		}
+
+		auto finish() -> void {
+			owned_lock<mutex> l{m_mutex};
+			m_done = true;
+			m_not_empty.notify_one();
+		}
+	private:
+		mutex m_mutex;
+		std::condition_variable m_not_full;
+		std::condition_variable m_not_empty;
+		array<pair<unsigned char *, size_t>, max_in_flight> m_frames;
+		size_t m_first = 0;
+		size_t m_count = 0;
+		bool m_done = false;
+	};
+
+	auto send_across_threads(const vector<size_t> &sizes, size_t packets) -> void {
+		frame_queue queue;
+		std::thread writer{[&queue] {
+			pair<unsigned char *, size_t> frame;
+			while (queue.pop(frame)) {
+				vana::util::buffer_pool::release(frame.first, frame.second);
+			}
+			vana::util::buffer_pool::release_thread_cache();
+		}};
+
+		for (size_t i = 0; i < packets; ++i) {
+			vana::util::pooled_buffer frame{sizes[i % sizes.size()] + 6};
+			size_t capacity = frame.capacity();
+			queue.push(frame.release(), capacity);
+		}
+		queue.finish();
+		writer.join();
+	}
+}
+
+auto packet_buffers(std::ostream &out) -> result {
+	using vana::util::buffer_pool;
+
+	std::mt19937 engine{0x5EED};
+	vector<size_t> sizes = make_sizes(engine);
+	vector<unsigned char> payload(packet_sizes[std::extent<decltype(packet_sizes)>::value - 1], 0x5A);
+	const unsigned char *data = payload.data();
+
+	for (size_t i = 0; i < warmup_packets; ++i) {
+		send_packet(data, sizes[i % sizes.size()]);
+	}
+
+	size_t i = 0;
+	uint64_t allocations = buffer_pool::get_allocation_count();
+	double pooled_ns = nanoseconds_per_call(measured_packets, [&] { send_packet(data, sizes[i++ % sizes.size()]); });
+	allocations = buffer_pool::get_allocation_count() - allocations;
+
+	i = 0;
+	double heap_ns = nanoseconds_per_call(measured_packets, [&] { send_packet_heap(data, sizes[i++ % sizes.size()]); });
+
+	out << std::fixed << std::setprecision(1)
+		<< measured_packets << " packets: " << allocations << " pool allocations, "
+		<< pooled_ns << " ns per packet pooled, " << heap_ns << " ns with new[]/delete[]" << std::endl;
+	if (allocations != 0) {
+		out << "the pool still allocates once warm" << std::endl;
+		return result::failure;
+	}
+
+	send_across_threads(sizes, warmup_packets);
+	allocations = buffer_pool::get_allocation_count();
+	auto start = std::chrono::steady_clock::now();
+	send_across_threads(sizes, measured_packets);
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	allocations = buffer_pool::get_allocation_count() - allocations;
+
+	out << measured_packets << " frames released on another thread: " << allocations << " pool allocations, "
+		<< static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / measured_packets << " ns per frame" << std::endl;
+	// Whether a size class runs dry depends on how the two threads get scheduled, so a new high-water mark can still allocate a few
+	// Without reuse this would be one allocation per frame
+	if (allocations > measured_packets / 1000) {
+		out << "buffers released on another thread aren't being reused" << std::endl;
+		return result::failure;
+	}
+
+	return result::success;
+}
+
+}
+}
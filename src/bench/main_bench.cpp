@@ -0,0 +1,86 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "common/exit_code.hpp"
+#include "bench/bench_case.hpp"
+#include <botan/botan.h>
+#include <cstring>
+#include <iostream>
+
+namespace {
+	const vana::bench::bench_case cases[] = {
+		{"aes_transformer", false, &vana::bench::aes_transformer},
+		{"shuffle", false, &vana::bench::shuffle},
+		{"packet_buffers", false, &vana::bench::packet_buffers},
+		{"provider_lookups", true, &vana::bench::provider_lookups},
+		{"attack_replay", false, &vana::bench::attack_replay},
+	};
+
+	auto print_usage() -> void {
+		std::cerr << "Usage: bench [case ...]" << std::endl
+			<< "Runs every case that doesn't need the MCDB when no case is named" << std::endl
+			<< "Cases:" << std::endl;
+		for (const auto &value : cases) {
+			std::cerr << "  " << value.name << (value.needs_database ? " (needs the MCDB)" : "") << std::endl;
+		}
+	}
+
+	auto is_selected(const vana::bench::bench_case &value, int argc, char *argv[]) -> bool {
+		if (argc == 1) {
+			return !value.needs_database;
+		}
+		for (int i = 1; i < argc; i++) {
+			if (std::strcmp(argv[i], value.name) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+auto main(int argc, char *argv[]) -> vana::exit_code_underlying {
+	using namespace vana;
+
+	for (int i = 1; i < argc; i++) {
+		bool known = false;
+		for (const auto &value : cases) {
+			known = known || std::strcmp(argv[i], value.name) == 0;
+		}
+		if (!known) {
+			print_usage();
+			return static_cast<exit_code_underlying>(exit_code::config_error);
+		}
+	}
+
+	Botan::LibraryInitializer init{"thread_safe=true"};
+	bool failed = false;
+
+	for (const auto &value : cases) {
+		if (!is_selected(value, argc, argv)) {
+			continue;
+		}
+
+		std::cout << "[" << value.name << "]" << std::endl;
+		if (value.run(std::cout) == result::failure) {
+			std::cout << "FAILED" << std::endl;
+			failed = true;
+		}
+		std::cout << std::endl;
+	}
+
+	return static_cast<exit_code_underlying>(failed ? exit_code::program_exception : exit_code::ok);
+}
@@ -0,0 +1,156 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bench/bench_case.hpp"
+#include "common/data/provider/buff.hpp"
+#include "common/data/provider/drop.hpp"
+#include "common/data/provider/item.hpp"
+#include "common/data/provider/mob.hpp"
+#include "common/data/provider/skill.hpp"
+#include "common/io/database.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <random>
+
+namespace vana {
+namespace bench {
+
+namespace {
+	const size_t replayed_events = 200000;
+	// Roughly what a busy channel sees, most lookups come from killing mobs and using skills
+	const int32_t kill_percentage = 60;
+
+	struct skill_key {
+		game_skill_id id;
+		game_skill_level level;
+	};
+
+	auto load_mob_ids() -> vector<game_mob_id> {
+		auto &db = vana::io::database::get_data_db();
+		auto &sql = db.get_session();
+		soci::rowset<> rs = (sql.prepare << "SELECT mobid FROM " << db.make_table(vana::data::table::mob_data));
+
+		vector<game_mob_id> ids;
+		for (const auto &row : rs) {
+			ids.push_back(row.get<game_mob_id>("mobid"));
+		}
+		return ids;
+	}
+
+	auto load_skill_keys() -> vector<skill_key> {
+		auto &db = vana::io::database::get_data_db();
+		auto &sql = db.get_session();
+		soci::rowset<> rs = (sql.prepare << "SELECT skillid, skill_level FROM " << db.make_table(vana::data::table::skill_player_level_data));
+
+		vector<skill_key> keys;
+		for (const auto &row : rs) {
+			keys.push_back({row.get<game_skill_id>("skillid"), row.get<game_skill_level>("skill_level")});
+		}
+		return keys;
+	}
+}
+
+auto provider_lookups(std::ostream &out) -> result {
+	data::provider::buff buffs;
+	data::provider::item items;
+	data::provider::mob mobs;
+	data::provider::drop drops;
+	data::provider::skill skills;
+	buffs.load_data();
+	items.load_data(buffs);
+	mobs.load_data();
+	drops.load_data();
+	skills.load_data();
+
+	vector<game_mob_id> mob_ids = load_mob_ids();
+	vector<skill_key> skill_keys = load_skill_keys();
+	if (mob_ids.empty() || skill_keys.empty()) {
+		out << "the MCDB has no mobs or skills to look up" << std::endl;
+		return result::failure;
+	}
+
+	std::mt19937 engine{0x5EED};
+	std::uniform_int_distribution<int32_t> percentage{0, 99};
+	std::uniform_int_distribution<size_t> mob_index{0, mob_ids.size() - 1};
+	std::uniform_int_distribution<size_t> skill_index{0, skill_keys.size() - 1};
+	vector<pair<bool, size_t>> events(replayed_events);
+	for (auto &event : events) {
+		event.first = percentage(engine) < kill_percentage;
+		event.second = event.first ? mob_index(engine) : skill_index(engine);
+	}
+
+	// A kill looks up the mob, its drops and every item it can drop
+	size_t lookups = 0;
+	size_t missing = 0;
+	size_t drop_items = 0;
+	auto replay = [&] {
+		for (const auto &event : events) {
+			if (event.first) {
+				game_mob_id mob_id = mob_ids[event.second];
+				lookups += 2;
+				if (mobs.get_mob_info(mob_id) == nullptr) missing++;
+				for (const auto &drop : drops.get_drops(mob_id)) {
+					if (drop.is_mesos) continue;
+					lookups++;
+					if (items.get_item_info(drop.item_id) != nullptr) drop_items++;
+				}
+			}
+			else {
+				const auto &key = skill_keys[event.second];
+				lookups++;
+				if (skills.get_skill(key.id, key.level) == nullptr) missing++;
+			}
+		}
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	replay();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	double provider_ns = static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / lookups;
+
+	// The providers used to keep these in vectors and scan them, this is the same mob lookups against that layout
+	vector<pair<game_mob_id, size_t>> scanned;
+	for (size_t i = 0; i < mob_ids.size(); ++i) {
+		scanned.emplace_back(mob_ids[i], i);
+	}
+	size_t found = 0;
+	start = std::chrono::steady_clock::now();
+	for (const auto &event : events) {
+		if (!event.first) continue;
+		game_mob_id mob_id = mob_ids[event.second];
+		auto kvp = std::find_if(std::begin(scanned), std::end(scanned), [mob_id](const pair<game_mob_id, size_t> &value) { return value.first == mob_id; });
+		if (kvp != std::end(scanned)) found++;
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	size_t kills = std::count_if(std::begin(events), std::end(events), [](const pair<bool, size_t> &event) { return event.first; });
+	double scan_ns = static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / std::max<size_t>(kills, 1);
+
+	out << std::fixed << std::setprecision(1)
+		<< replayed_events << " events, " << lookups << " lookups (" << drop_items << " drop items): " << provider_ns << " ns per lookup" << std::endl
+		<< "scanning a vector of " << mob_ids.size() << " mobs instead: " << scan_ns << " ns per lookup" << std::endl;
+
+	// Every mob and skill key came out of the MCDB, so all of them have to resolve
+	if (missing != 0 || found != kills) {
+		out << missing + kills - found << " lookups for loaded IDs came back empty" << std::endl;
+		return result::failure;
+	}
+
+	return result::success;
+}
+
+}
+}
@@ -0,0 +1,45 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/block_cipher_iv.hpp"
+#include "common/types.hpp"
+#include <botan/lookup.h>
+
+namespace vana {
+	namespace bench {
+		// The packet encryption as it was before the transformer kept its key schedule, every check compares against it byte for byte
+		class reference_transformer {
+		public:
+			reference_transformer(crypto_iv recv_iv, crypto_iv send_iv);
+			auto encrypt_packet(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size) -> void;
+			auto decrypt_packet(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size) -> void;
+
+			// The byte-at-a-time shuffle layer
+			static auto shuffle_encrypt(unsigned char *packet_data, int32_t real_packet_size) -> void;
+			static auto shuffle_decrypt(unsigned char *packet_data, int32_t real_packet_size) -> void;
+		private:
+			// A new Botan::Pipe per 1460-byte chunk
+			auto apply_aes(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size, const unsigned char *iv, Botan::Cipher_Dir direction) -> void;
+
+			block_cipher_iv m_recv;
+			block_cipher_iv m_send;
+			Botan::SymmetricKey m_botan_key;
+		};
+	}
+}
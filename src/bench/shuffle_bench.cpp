@@ -0,0 +1,102 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bench/bench_case.hpp"
+#include "bench/reference_transformer.hpp"
+#include "common/shuffle_cipher.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <random>
+
+namespace vana {
+namespace bench {
+
+namespace {
+	const int32_t max_fuzz_size = 5000;
+	const int32_t fuzz_packets = 5000;
+	// Every size up to here is covered, so each vector remainder and direction shows up at least once
+	const int32_t exhaustive_size = 64;
+	const int32_t timed_size = 4096;
+	const size_t timed_iterations = 20000;
+
+	auto check(const vector<unsigned char> &plain, std::ostream &out) -> result {
+		int32_t size = static_cast<int32_t>(plain.size());
+
+		vector<unsigned char> expected = plain;
+		vector<unsigned char> scalar = plain;
+		vector<unsigned char> current = plain;
+		reference_transformer::shuffle_encrypt(expected.data(), size);
+		shuffle_cipher::encrypt_scalar(scalar.data(), size);
+		shuffle_cipher::encrypt(current.data(), size);
+		if (scalar != expected || current != expected) {
+			out << "encrypt differs from the old loops on a " << size << " byte packet" << std::endl;
+			return result::failure;
+		}
+
+		vector<unsigned char> decrypted = expected;
+		reference_transformer::shuffle_decrypt(decrypted.data(), size);
+		shuffle_cipher::decrypt_scalar(scalar.data(), size);
+		shuffle_cipher::decrypt(current.data(), size);
+		if (decrypted != plain || scalar != plain || current != plain) {
+			out << "decrypt differs from the old loops on a " << size << " byte packet" << std::endl;
+			return result::failure;
+		}
+
+		return result::success;
+	}
+}
+
+auto shuffle(std::ostream &out) -> result {
+	std::mt19937 engine{0x5EED};
+	std::uniform_int_distribution<int32_t> bytes{0, 255};
+	std::uniform_int_distribution<int32_t> sizes{0, max_fuzz_size};
+
+	for (int32_t i = 0; i < fuzz_packets + exhaustive_size; ++i) {
+		vector<unsigned char> plain(i < exhaustive_size ? i : sizes(engine));
+		for (auto &value : plain) {
+			value = static_cast<unsigned char>(bytes(engine));
+		}
+		if (check(plain, out) == result::failure) {
+			return result::failure;
+		}
+	}
+	out << fuzz_packets + exhaustive_size << " packets of 0-" << max_fuzz_size << " bytes match the old loops" << std::endl;
+
+	vector<unsigned char> buffer(timed_size);
+	for (auto &value : buffer) {
+		value = static_cast<unsigned char>(bytes(engine));
+	}
+	unsigned char *data = buffer.data();
+
+	double old_ns = nanoseconds_per_call(timed_iterations, [data] { reference_transformer::shuffle_encrypt(data, timed_size); });
+	double scalar_ns = nanoseconds_per_call(timed_iterations, [data] { shuffle_cipher::encrypt_scalar(data, timed_size); });
+	double current_ns = nanoseconds_per_call(timed_iterations, [data] { shuffle_cipher::encrypt(data, timed_size); });
+	out << std::fixed << std::setprecision(1)
+		<< "encrypt " << timed_size << " bytes: old " << old_ns << " ns, scalar " << scalar_ns << " ns, current " << current_ns << " ns"
+		<< " (" << old_ns / std::max(current_ns, 1.0) << "x)" << std::endl;
+
+	old_ns = nanoseconds_per_call(timed_iterations, [data] { reference_transformer::shuffle_decrypt(data, timed_size); });
+	scalar_ns = nanoseconds_per_call(timed_iterations, [data] { shuffle_cipher::decrypt_scalar(data, timed_size); });
+	current_ns = nanoseconds_per_call(timed_iterations, [data] { shuffle_cipher::decrypt(data, timed_size); });
+	out << "decrypt " << timed_size << " bytes: old " << old_ns << " ns, scalar " << scalar_ns << " ns, current " << current_ns << " ns"
+		<< " (" << old_ns / std::max(current_ns, 1.0) << "x)" << std::endl;
+
+	return result::success;
+}
+
+}
+}
@@ -0,0 +1,402 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bot.hpp"
+#include "common/constant/skill.hpp"
+#include "common/ip.hpp"
+#include "channel_server/cmsg_header.hpp"
+#include "channel_server/smsg_header.hpp"
+#include "login_server/cmsg_header.hpp"
+#include "login_server/smsg_header.hpp"
+#include <asio.hpp>
+
+namespace vana {
+namespace bot_client {
+
+namespace {
+	// Weights for the script, one action is picked every action interval
+	const int32_t walk_weight = 40;
+	const int32_t attack_weight = 25;
+	const int32_t loot_weight = 15;
+	const int32_t chat_weight = 15;
+	const int32_t change_channel_weight = 5;
+
+	const game_coord walk_distance = 150;
+	const game_foothold_id fake_foothold = 1;
+
+	auto read_address(packet_reader &reader) -> pair<ip, connection_port> {
+		// client_ip is written in network byte order
+		ip destination{ntohl(reader.get<uint32_t>())};
+		connection_port port = reader.get<connection_port>();
+		return std::make_pair(destination, port);
+	}
+}
+
+bot::bot(uint16_t index, const bot_config &config, bot_stats &stats) :
+	m_index{index},
+	m_config{config},
+	m_stats{stats},
+	m_connection{config.response_timeout},
+	m_random{index}
+{
+	m_channel_id = static_cast<game_channel_id>(index % config.channel_count);
+}
+
+auto bot::run(const time_point &end) -> void {
+	auto login_result = log_in();
+	m_stats.record_login(login_result);
+	if (login_result == result::failure) {
+		m_connection.disconnect();
+		return;
+	}
+
+	while (effective_clock::now() < end && m_connection.is_connected()) {
+		act();
+		pump(m_config.action_interval);
+	}
+
+	m_connection.disconnect();
+}
+
+auto bot::log_in() -> result {
+	if (m_connection.connect(ip{ip::string_to_ipv4(m_config.login_host)}, m_config.login_port) == result::failure) {
+		return result::failure;
+	}
+
+	packet_reader reply;
+	out_stream account;
+	account << m_config.account_prefix << m_index;
+
+	packet_builder auth;
+	auth
+		.add<packet_header>(CMSG_AUTHENTICATION)
+		.add<string>(account.str())
+		.add<string>(m_config.password);
+	if (request(bot_request::authentication, auth, {SMSG_AUTHENTICATION}, reply) == result::failure) {
+		return result::failure;
+	}
+	if (reply.get<int16_t>() != 0) {
+		// The account has to exist, have a gender and not be waiting on a PIN
+		return result::failure;
+	}
+
+	packet_builder world_list;
+	world_list.add<packet_header>(CMSG_WORLD_LIST);
+	if (request(bot_request::world_list, world_list, {SMSG_WORLD_LIST}, reply) == result::failure) {
+		return result::failure;
+	}
+
+	packet_builder world_status;
+	world_status
+		.add<packet_header>(CMSG_WORLD_STATUS)
+		.add<game_world_id>(m_config.world_id);
+	if (request(bot_request::world_status, world_status, {SMSG_WORLD_STATUS}, reply) == result::failure) {
+		return result::failure;
+	}
+
+	packet_builder player_list;
+	player_list
+		.add<packet_header>(CMSG_PLAYER_LIST)
+		.add<game_world_id>(m_config.world_id)
+		.add<game_channel_id>(m_channel_id);
+	if (request(bot_request::player_list, player_list, {SMSG_PLAYER_LIST}, reply) == result::failure) {
+		return result::failure;
+	}
+	if (reply.get<int8_t>() != 0 || reply.get<uint8_t>() == 0) {
+		// Channel offline or no characters on the account
+		return result::failure;
+	}
+	m_player_id = reply.get<game_player_id>();
+
+	packet_builder channel_connect;
+	channel_connect
+		.add<packet_header>(CMSG_CHANNEL_CONNECT)
+		.add<game_player_id>(m_player_id);
+	if (request(bot_request::channel_connect, channel_connect, {SMSG_CHANNEL_CONNECT}, reply) == result::failure) {
+		return result::failure;
+	}
+
+	reply.skip<int16_t>();
+	auto address = read_address(reply);
+	return enter_channel(address.first, address.second);
+}
+
+auto bot::enter_channel(const ip &destination, connection_port port) -> result {
+	m_mobs.clear();
+	m_drops.clear();
+
+	if (m_connection.connect(destination, port) == result::failure) {
+		return result::failure;
+	}
+
+	packet_reader reply;
+	packet_builder load;
+	load
+		.add<packet_header>(CMSG_PLAYER_LOAD)
+		.add<game_player_id>(m_player_id);
+	if (request(bot_request::player_load, load, {SMSG_CHANGE_MAP}, reply) == result::failure) {
+		return result::failure;
+	}
+
+	reply.skip<int32_t>();
+	m_portal_count = reply.get<game_portal_count>();
+	return result::success;
+}
+
+auto bot::act() -> result {
+	int32_t total = walk_weight + attack_weight + loot_weight + chat_weight;
+	if (m_config.channel_count > 1) {
+		total += change_channel_weight;
+	}
+
+	int32_t roll = std::uniform_int_distribution<int32_t>{0, total - 1}(m_random);
+	if ((roll -= walk_weight) < 0) return walk();
+	if ((roll -= attack_weight) < 0) return attack();
+	if ((roll -= loot_weight) < 0) return loot();
+	if ((roll -= chat_weight) < 0) return chat();
+	return change_channel();
+}
+
+auto bot::walk() -> result {
+	game_coord distance = std::uniform_int_distribution<game_coord>{-walk_distance, walk_distance}(m_random);
+	return move_to(m_position.move_x(distance));
+}
+
+auto bot::attack() -> result {
+	if (m_mobs.empty()) {
+		return walk();
+	}
+
+	game_map_object target = m_mobs[std::uniform_int_distribution<size_t>{0, m_mobs.size() - 1}(m_random)];
+	const int8_t hits = 1;
+
+	packet_builder builder;
+	builder
+		.add<packet_header>(CMSG_ATTACK_MELEE)
+		.add<game_portal_count>(m_portal_count)
+		.add<uint8_t>(0x10 | hits)
+		.add<game_skill_id>(constant::skill::all::regular_attack)
+		.add<game_checksum>(0)
+		.add<game_checksum>(0)
+		.add<uint8_t>(0) // Display
+		.add<uint8_t>(0) // Animation
+		.add<uint8_t>(0) // Weapon class
+		.add<uint8_t>(4) // Weapon speed
+		.add<game_tick_count>(static_cast<game_tick_count>(duration_cast<milliseconds>(effective_clock::now().time_since_epoch()).count()))
+		.add<game_map_object>(target)
+		.add<int8_t>(-1) // Hit action
+		.add<uint8_t>(0) // Action node and facing
+		.add<int8_t>(0) // Frame
+		.add<uint8_t>(0) // Damage calculator index
+		.add<point>(m_position)
+		.add<point>(m_position)
+		.add<uint16_t>(0); // Delay
+
+	for (int8_t i = 0; i < hits; ++i) {
+		builder.add<game_damage>(std::uniform_int_distribution<game_damage>{1, 20}(m_random));
+	}
+
+	builder
+		.add<game_checksum>(0)
+		.add<point>(m_position);
+
+	// Regular mobs answer the attacker with their HP bar, bosses and already dead mobs don't
+	packet_reader reply;
+	return request(bot_request::attack, builder, {SMSG_MOB_HP_DISPLAY, SMSG_MOB_DEATH}, reply);
+}
+
+auto bot::loot() -> result {
+	if (m_drops.empty()) {
+		return walk();
+	}
+
+	auto iter = std::begin(m_drops);
+	std::advance(iter, std::uniform_int_distribution<size_t>{0, m_drops.size() - 1}(m_random));
+	game_map_object drop_id = iter->first;
+	point drop_position = iter->second;
+
+	// The server checks the distance against where it last saw us move
+	if (move_to(drop_position) == result::failure) {
+		return result::failure;
+	}
+
+	packet_builder builder;
+	builder
+		.add<packet_header>(CMSG_ITEM_LOOT)
+		.unk<uint8_t>()
+		.add<game_tick_count>(0)
+		.add<point>(m_position)
+		.add<game_map_object>(drop_id);
+
+	packet_reader reply;
+	return request(bot_request::loot, builder, {SMSG_DROP_PICKUP, SMSG_INVENTORY_OPERATION}, reply);
+}
+
+auto bot::chat() -> result {
+	out_stream message;
+	message << "Bot " << m_index << " says " << m_random() % 1000;
+
+	packet_builder builder;
+	builder
+		.add<packet_header>(CMSG_PLAYER_CHAT)
+		.add<game_chat>(message.str())
+		.add<bool>(false);
+
+	packet_reader reply;
+	return request(bot_request::chat, builder, {SMSG_PLAYER_CHAT}, reply);
+}
+
+auto bot::change_channel() -> result {
+	game_channel_id channel = static_cast<game_channel_id>(std::uniform_int_distribution<int32_t>{1, m_config.channel_count - 1}(m_random));
+	channel = static_cast<game_channel_id>((m_channel_id + channel) % m_config.channel_count);
+
+	packet_builder builder;
+	builder
+		.add<packet_header>(CMSG_CHANNEL_CHANGE)
+		.add<game_channel_id>(channel);
+
+	packet_reader reply;
+	if (request(bot_request::channel_change, builder, {SMSG_CHANNEL_CHANGE}, reply) == result::failure) {
+		return result::failure;
+	}
+	if (!reply.get<bool>()) {
+		// Channel is offline, stay where we are
+		return result::success;
+	}
+
+	m_channel_id = channel;
+	auto address = read_address(reply);
+	return enter_channel(address.first, address.second);
+}
+
+auto bot::move_to(const point &destination) -> result {
+	// Only the final position matters to the server, so every move is a single normal movement
+	packet_builder builder;
+	builder
+		.add<packet_header>(CMSG_PLAYER_MOVE)
+		.add<game_portal_count>(m_portal_count)
+		.unk<int32_t>()
+		.add<point>(m_position)
+		.add<uint8_t>(1)
+		.add<int8_t>(0) // Normal movement
+		.add<point>(destination)
+		.add<int16_t>(0) // X velocity
+		.add<int16_t>(0) // Y velocity
+		.add<game_foothold_id>(fake_foothold)
+		.add<int8_t>(destination.x < m_position.x ? 5 : 4) // Stance, walking left or right
+		.add<int16_t>(300) // Time elapsed
+		.add<uint8_t>(0) // Keypad states
+		.add<point>(m_position)
+		.add<point>(destination);
+
+	m_stats.record_sent(bot_request::move);
+	if (m_connection.send(builder) == result::failure) {
+		return result::failure;
+	}
+	m_position = destination;
+	return result::success;
+}
+
+auto bot::request(bot_request type, const packet_builder &builder, std::initializer_list<packet_header> replies, packet_reader &reply) -> result {
+	m_stats.record_sent(type);
+	time_point start = effective_clock::now();
+	time_point deadline = start + m_config.response_timeout;
+	if (m_connection.send(builder) == result::failure) {
+		return result::failure;
+	}
+
+	time_point now = start;
+	while (now < deadline) {
+		if (m_connection.receive(reply, duration_cast<milliseconds>(deadline - now)) == result::failure) {
+			break;
+		}
+
+		now = effective_clock::now();
+		packet_header header = reply.peek<packet_header>();
+		if (std::find(std::begin(replies), std::end(replies), header) != std::end(replies)) {
+			m_stats.record(type, now - start);
+			handle(reply);
+			reply.reset(sizeof(packet_header));
+			return result::success;
+		}
+
+		handle(reply);
+	}
+
+	m_stats.record_unanswered(type);
+	return result::failure;
+}
+
+auto bot::pump(milliseconds wait) -> void {
+	time_point deadline = effective_clock::now() + wait;
+	packet_reader reader;
+	for (time_point now = effective_clock::now(); now < deadline; now = effective_clock::now()) {
+		if (m_connection.receive(reader, duration_cast<milliseconds>(deadline - now)) == result::failure) {
+			break;
+		}
+		handle(reader);
+	}
+}
+
+auto bot::handle(packet_reader &reader) -> void {
+	// Only the parts of the map the script acts on are tracked
+	try {
+		switch (reader.get<packet_header>()) {
+			case SMSG_CHANGE_MAP:
+				reader.skip<int32_t>();
+				m_portal_count = reader.get<game_portal_count>();
+				m_mobs.clear();
+				m_drops.clear();
+				break;
+			case SMSG_MOB_SHOW: {
+				game_map_object map_mob_id = reader.get<game_map_object>();
+				if (std::find(std::begin(m_mobs), std::end(m_mobs), map_mob_id) == std::end(m_mobs)) {
+					m_mobs.push_back(map_mob_id);
+				}
+				break;
+			}
+			case SMSG_MOB_DEATH: {
+				game_map_object map_mob_id = reader.get<game_map_object>();
+				m_mobs.erase(std::remove(std::begin(m_mobs), std::end(m_mobs), map_mob_id), std::end(m_mobs));
+				break;
+			}
+			case SMSG_DROP_ITEM: {
+				reader.skip<int8_t>();
+				game_map_object drop_id = reader.get<game_map_object>();
+				reader
+					.skip<bool>()
+					.skip<int32_t>()
+					.skip<int32_t>()
+					.skip<int8_t>();
+				m_drops[drop_id] = reader.get<point>();
+				break;
+			}
+			case SMSG_DROP_PICKUP: {
+				reader.skip<int8_t>();
+				m_drops.erase(reader.get<game_map_object>());
+				break;
+			}
+		}
+	}
+	catch (const packet_content_exception &) {
+		// A packet layout we don't understand isn't worth dropping the bot over
+	}
+	reader.reset();
+}
+
+}
+}
@@ -0,0 +1,65 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "bot_client/bot_config.hpp"
+#include "bot_client/bot_connection.hpp"
+#include "bot_client/bot_stats.hpp"
+#include "common/point.hpp"
+#include "common/types.hpp"
+#include <initializer_list>
+#include <random>
+
+namespace vana {
+	namespace bot_client {
+		// One synthetic player, logs in through the login server and then plays a weighted random script on its channel
+		class bot {
+			NONCOPYABLE(bot);
+			NO_DEFAULT_CONSTRUCTOR(bot);
+		public:
+			bot(uint16_t index, const bot_config &config, bot_stats &stats);
+
+			auto run(const time_point &end) -> void;
+		private:
+			auto log_in() -> result;
+			auto enter_channel(const ip &destination, connection_port port) -> result;
+			auto act() -> result;
+			auto walk() -> result;
+			auto attack() -> result;
+			auto loot() -> result;
+			auto chat() -> result;
+			auto change_channel() -> result;
+			auto move_to(const point &destination) -> result;
+			auto request(bot_request type, const packet_builder &builder, std::initializer_list<packet_header> replies, packet_reader &reply) -> result;
+			auto pump(milliseconds wait) -> void;
+			auto handle(packet_reader &reader) -> void;
+
+			uint16_t m_index = 0;
+			const bot_config &m_config;
+			bot_stats &m_stats;
+			bot_connection m_connection;
+			std::mt19937 m_random;
+			game_player_id m_player_id = 0;
+			game_channel_id m_channel_id = 0;
+			game_portal_count m_portal_count = 0;
+			point m_position;
+			vector<game_map_object> m_mobs;
+			hash_map<game_map_object, point> m_drops;
+		};
+	}
+}
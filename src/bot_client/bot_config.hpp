@@ -0,0 +1,43 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <string>
+
+namespace vana {
+	namespace bot_client {
+		struct bot_config {
+			string login_host = "127.0.0.1";
+			connection_port login_port = 8484;
+			uint16_t bot_count = 10;
+			// Bot N logs in as <account_prefix><N> and plays the first character on that account
+			string account_prefix = "bot";
+			string password = "password";
+			game_world_id world_id = 0;
+			// Bots are spread over this many channels and hop between them
+			game_channel_id channel_count = 1;
+			seconds duration{60};
+			milliseconds action_interval{250};
+			milliseconds ramp_interval{50};
+			milliseconds response_timeout{5000};
+			// Server processes to sample for CPU usage, only available where /proc exists
+			vector<int32_t> server_pids;
+		};
+	}
+}
@@ -0,0 +1,196 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bot_connection.hpp"
+#include "common/common_header.hpp"
+#include "common/maple_version.hpp"
+#include <cstring>
+
+namespace vana {
+namespace bot_client {
+
+bot_connection::bot_connection(milliseconds timeout) :
+	m_timeout{timeout},
+	m_socket{m_io_service},
+	m_timer{m_io_service}
+{
+}
+
+auto bot_connection::connect(const ip &destination, connection_port port) -> result {
+	disconnect();
+
+	asio::ip::tcp::endpoint endpoint{asio::ip::address_v4{destination.as_ipv4()}, port};
+	asio::error_code error = asio::error::would_block;
+	m_socket.async_connect(endpoint, [&](const asio::error_code &ec) {
+		error = ec;
+		m_timer.cancel();
+	});
+	run_with_timeout(m_timeout);
+
+	if (error || read_handshake() == result::failure) {
+		disconnect();
+		return result::failure;
+	}
+	return result::success;
+}
+
+auto bot_connection::disconnect() -> void {
+	asio::error_code ignored;
+	m_socket.close(ignored);
+	m_codec.reset();
+}
+
+auto bot_connection::is_connected() const -> bool {
+	return m_codec != nullptr;
+}
+
+auto bot_connection::send(const packet_builder &builder) -> result {
+	if (!is_connected()) return result::failure;
+
+	size_t length = builder.get_size();
+	m_send_buffer.resize(length + header_len);
+	memcpy(m_send_buffer.data() + header_len, builder.get_buffer(), length);
+
+	m_codec->set_packet_header(m_send_buffer.data(), static_cast<uint16_t>(length));
+	m_codec->encrypt_packet(m_send_buffer.data() + header_len, static_cast<int32_t>(length), header_len);
+
+	asio::error_code error;
+	asio::write(m_socket, asio::buffer(m_send_buffer), error);
+	if (error) {
+		disconnect();
+		return result::failure;
+	}
+	return result::success;
+}
+
+auto bot_connection::receive(packet_reader &reader, milliseconds wait) -> result {
+	while (is_connected()) {
+		if (wait_readable(wait) == result::failure) {
+			return result::failure;
+		}
+
+		unsigned char header[header_len];
+		if (read(header, header_len) == result::failure) {
+			return result::failure;
+		}
+		if (m_codec->test_packet(header) == validity_result::invalid) {
+			disconnect();
+			return result::failure;
+		}
+
+		uint16_t length = m_codec->get_packet_length(header);
+		m_buffer.resize(length);
+		if (read(m_buffer.data(), length) == result::failure) {
+			return result::failure;
+		}
+		m_codec->decrypt_packet(m_buffer.data(), length, header_len);
+
+		reader = packet_reader{m_buffer.data(), length};
+		if (reader.peek<packet_header>() != SMSG_PING) {
+			return result::success;
+		}
+
+		packet_builder pong;
+		pong.add<packet_header>(CMSG_PONG);
+		send(pong);
+	}
+	return result::failure;
+}
+
+auto bot_connection::read(unsigned char *buffer, size_t length) -> result {
+	asio::error_code error = asio::error::would_block;
+	asio::async_read(m_socket, asio::buffer(buffer, length), [&](const asio::error_code &ec, size_t bytes_transferred) {
+		error = ec;
+		m_timer.cancel();
+	});
+	run_with_timeout(m_timeout);
+
+	if (error) {
+		// A frame that stops halfway leaves the stream unusable
+		disconnect();
+		return result::failure;
+	}
+	return result::success;
+}
+
+auto bot_connection::wait_readable(milliseconds timeout) -> result {
+	asio::error_code error = asio::error::would_block;
+	m_socket.async_read_some(asio::null_buffers(), [&](const asio::error_code &ec, size_t bytes_transferred) {
+		error = ec;
+		m_timer.cancel();
+	});
+	run_with_timeout(timeout);
+
+	if (error == asio::error::operation_aborted) {
+		// Nothing arrived in time, the connection is still good
+		return result::failure;
+	}
+	if (error) {
+		disconnect();
+		return result::failure;
+	}
+	return result::success;
+}
+
+auto bot_connection::run_with_timeout(milliseconds timeout) -> void {
+	m_timer.expires_from_now(timeout);
+	m_timer.async_wait([this](const asio::error_code &ec) {
+		if (ec != asio::error::operation_aborted) {
+			asio::error_code ignored;
+			m_socket.cancel(ignored);
+		}
+	});
+
+	m_io_service.reset();
+	m_io_service.run();
+}
+
+auto bot_connection::read_handshake() -> result {
+	unsigned char length_buffer[sizeof(packet_header)];
+	if (read(length_buffer, sizeof(length_buffer)) == result::failure) {
+		return result::failure;
+	}
+
+	packet_header length = *reinterpret_cast<packet_header *>(length_buffer);
+	m_buffer.resize(length);
+	if (read(m_buffer.data(), length) == result::failure) {
+		return result::failure;
+	}
+
+	try {
+		packet_reader reader{m_buffer.data(), length};
+		game_version version = reader.get<game_version>();
+		reader.skip<string>(); // Subversion differs between the login and channel servers
+		crypto_iv send_iv = reader.get<crypto_iv>();
+		crypto_iv recv_iv = reader.get<crypto_iv>();
+		game_locale locale = reader.get<game_locale>();
+
+		if (version != maple_version::version || locale != maple_version::locale) {
+			return result::failure;
+		}
+
+		// Same orientation as an outbound server connection in connection_manager
+		m_codec = make_owned_ptr<encrypted_packet_transformer>(recv_iv, send_iv);
+	}
+	catch (packet_content_exception) {
+		return result::failure;
+	}
+	return result::success;
+}
+
+}
+}
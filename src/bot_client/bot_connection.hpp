@@ -0,0 +1,59 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/encrypted_packet_transformer.hpp"
+#include "common/ip.hpp"
+#include "common/packet_builder.hpp"
+#include "common/packet_reader.hpp"
+#include "common/types.hpp"
+#include <asio.hpp>
+
+namespace vana {
+	namespace bot_client {
+		// Blocking client side of a session, every call runs the connection's own io_service until it finishes or times out
+		class bot_connection {
+			NONCOPYABLE(bot_connection);
+			NO_DEFAULT_CONSTRUCTOR(bot_connection);
+		public:
+			bot_connection(milliseconds timeout);
+
+			auto connect(const ip &destination, connection_port port) -> result;
+			auto disconnect() -> void;
+			auto is_connected() const -> bool;
+			auto send(const packet_builder &builder) -> result;
+			// Waits up to wait for a packet to start arriving, pings are answered here and never returned
+			auto receive(packet_reader &reader, milliseconds wait) -> result;
+		private:
+			auto read(unsigned char *buffer, size_t length) -> result;
+			auto wait_readable(milliseconds timeout) -> result;
+			auto run_with_timeout(milliseconds timeout) -> void;
+			auto read_handshake() -> result;
+
+			static const size_t header_len = 4;
+
+			milliseconds m_timeout;
+			asio::io_service m_io_service;
+			asio::ip::tcp::socket m_socket;
+			asio::steady_timer m_timer;
+			owned_ptr<encrypted_packet_transformer> m_codec;
+			vector<unsigned char> m_buffer;
+			vector<unsigned char> m_send_buffer;
+		};
+	}
+}
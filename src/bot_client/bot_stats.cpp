@@ -0,0 +1,117 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "bot_stats.hpp"
+#include "common/common_header.hpp"
+#include "channel_server/cmsg_header.hpp"
+#include "login_server/cmsg_header.hpp"
+#include <iomanip>
+
+namespace vana {
+namespace bot_client {
+
+namespace {
+	struct request_info {
+		const char *name;
+		packet_header opcode;
+	};
+
+	const request_info g_requests[] = {
+		{"CMSG_AUTHENTICATION", CMSG_AUTHENTICATION},
+		{"CMSG_WORLD_LIST", CMSG_WORLD_LIST},
+		{"CMSG_WORLD_STATUS", CMSG_WORLD_STATUS},
+		{"CMSG_PLAYER_LIST", CMSG_PLAYER_LIST},
+		{"CMSG_CHANNEL_CONNECT", CMSG_CHANNEL_CONNECT},
+		{"CMSG_PLAYER_LOAD", CMSG_PLAYER_LOAD},
+		{"CMSG_PLAYER_MOVE", CMSG_PLAYER_MOVE},
+		{"CMSG_ATTACK_MELEE", CMSG_ATTACK_MELEE},
+		{"CMSG_ITEM_LOOT", CMSG_ITEM_LOOT},
+		{"CMSG_PLAYER_CHAT", CMSG_PLAYER_CHAT},
+		{"CMSG_CHANNEL_CHANGE", CMSG_CHANNEL_CHANGE},
+	};
+
+	auto format_opcode(packet_header opcode) -> string {
+		out_stream str;
+		str << "0x" << std::hex << std::setw(2) << std::setfill('0') << opcode;
+		return str.str();
+	}
+
+	static_assert(sizeof(g_requests) / sizeof(g_requests[0]) == static_cast<size_t>(bot_request::count), "Every bot_request needs a name");
+}
+
+auto bot_stats::record_sent(bot_request request) -> void {
+	m_sent[static_cast<size_t>(request)].fetch_add(1, std::memory_order_relaxed);
+}
+
+auto bot_stats::record(bot_request request, const duration &elapsed) -> void {
+	m_latency[static_cast<size_t>(request)].record(elapsed);
+}
+
+auto bot_stats::record_unanswered(bot_request request) -> void {
+	m_unanswered[static_cast<size_t>(request)].fetch_add(1, std::memory_order_relaxed);
+}
+
+auto bot_stats::record_login(result value) -> void {
+	if (value == result::success) {
+		m_logged_in.fetch_add(1, std::memory_order_relaxed);
+	}
+	else {
+		m_login_failures.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+auto bot_stats::get_logged_in() const -> uint32_t {
+	return m_logged_in.load(std::memory_order_relaxed);
+}
+
+auto bot_stats::print(std::ostream &out, const duration &elapsed) const -> void {
+	double elapsed_seconds = duration_cast<milliseconds>(elapsed).count() / 1000.;
+	out << "Bots logged in: " << m_logged_in.load(std::memory_order_relaxed)
+		<< ", failed: " << m_login_failures.load(std::memory_order_relaxed)
+		<< ", run time: " << std::fixed << std::setprecision(1) << elapsed_seconds << "s" << std::endl;
+
+	out << std::left << std::setw(24) << "Request"
+		<< std::right << std::setw(8) << "Opcode"
+		<< std::setw(10) << "Sent"
+		<< std::setw(10) << "Answered"
+		<< std::setw(10) << "Timeouts"
+		<< std::setw(10) << "Per sec"
+		<< std::setw(10) << "p50 us"
+		<< std::setw(10) << "p90 us"
+		<< std::setw(10) << "p99 us"
+		<< std::setw(10) << "Max us" << std::endl;
+
+	for (size_t i = 0; i < request_count; i++) {
+		uint64_t sent = m_sent[i].load(std::memory_order_relaxed);
+		if (sent == 0) continue;
+
+		const auto &latency = m_latency[i];
+		out << std::left << std::setw(24) << g_requests[i].name
+			<< std::right << std::setw(8) << format_opcode(g_requests[i].opcode)
+			<< std::setw(10) << sent
+			<< std::setw(10) << latency.get_count()
+			<< std::setw(10) << m_unanswered[i].load(std::memory_order_relaxed)
+			<< std::setw(10) << std::setprecision(1) << (elapsed_seconds > 0 ? sent / elapsed_seconds : 0.)
+			<< std::setw(10) << latency.get_percentile(50).count()
+			<< std::setw(10) << latency.get_percentile(90).count()
+			<< std::setw(10) << latency.get_percentile(99).count()
+			<< std::setw(10) << latency.get_max().count() << std::endl;
+	}
+}
+
+}
+}
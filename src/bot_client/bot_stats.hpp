@@ -0,0 +1,64 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include "common/util/latency_histogram.hpp"
+#include <atomic>
+#include <ostream>
+
+namespace vana {
+	namespace bot_client {
+		// Each request is timed from the send until the packet the server answers it with arrives
+		enum class bot_request : uint8_t {
+			authentication,
+			world_list,
+			world_status,
+			player_list,
+			channel_connect,
+			player_load,
+			move,
+			attack,
+			loot,
+			chat,
+			channel_change,
+			count,
+		};
+
+		class bot_stats {
+			NONCOPYABLE(bot_stats);
+		public:
+			bot_stats() = default;
+
+			auto record_sent(bot_request request) -> void;
+			auto record(bot_request request, const duration &elapsed) -> void;
+			auto record_unanswered(bot_request request) -> void;
+			auto record_login(result value) -> void;
+			auto get_logged_in() const -> uint32_t;
+			auto print(std::ostream &out, const duration &elapsed) const -> void;
+		private:
+			static const size_t request_count = static_cast<size_t>(bot_request::count);
+
+			vana::util::latency_histogram m_latency[request_count];
+			std::atomic<uint64_t> m_sent[request_count] = {};
+			std::atomic<uint64_t> m_unanswered[request_count] = {};
+			std::atomic<uint32_t> m_logged_in{0};
+			std::atomic<uint32_t> m_login_failures{0};
+		};
+	}
+}
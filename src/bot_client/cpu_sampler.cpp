@@ -0,0 +1,102 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cpu_sampler.hpp"
+#include <fstream>
+#include <iomanip>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace vana {
+namespace bot_client {
+
+cpu_sampler::cpu_sampler(const vector<int32_t> &pids) :
+	m_pids{pids}
+{
+}
+
+auto cpu_sampler::begin() -> void {
+	m_start = effective_clock::now();
+	m_start_cpu.clear();
+	for (auto pid : m_pids) {
+		duration cpu_time = duration::zero();
+		read_cpu_time(pid, cpu_time);
+		m_start_cpu.push_back(cpu_time);
+	}
+}
+
+auto cpu_sampler::print(std::ostream &out) const -> void {
+	if (m_pids.empty()) {
+		out << "Server CPU: no --pid given" << std::endl;
+		return;
+	}
+
+	auto wall = duration_cast<microseconds>(effective_clock::now() - m_start).count();
+	for (size_t i = 0; i < m_pids.size(); i++) {
+		duration cpu_time = duration::zero();
+		out << "Server CPU (pid " << m_pids[i] << "): ";
+		if (read_cpu_time(m_pids[i], cpu_time) == result::failure || wall <= 0) {
+			out << "unavailable" << std::endl;
+			continue;
+		}
+
+		auto used = duration_cast<microseconds>(cpu_time - m_start_cpu[i]).count();
+		// Can go over 100% when the server uses more than one core
+		out << std::fixed << std::setprecision(1) << (used * 100. / wall) << "% of one core, "
+			<< used / 1000 << "ms total" << std::endl;
+	}
+}
+
+auto cpu_sampler::read_cpu_time(int32_t pid, duration &cpu_time) -> result {
+#ifdef WIN32
+	return result::failure;
+#else
+	out_stream path;
+	path << "/proc/" << pid << "/stat";
+	std::ifstream file{path.str()};
+	string line;
+	if (!std::getline(file, line)) {
+		return result::failure;
+	}
+
+	// The process name is parenthesized and may contain spaces, fields are counted from after it
+	size_t name_end = line.rfind(')');
+	if (name_end == string::npos) {
+		return result::failure;
+	}
+
+	std::istringstream fields{line.substr(name_end + 1)};
+	string skipped;
+	for (int32_t i = 0; i < 11; i++) {
+		fields >> skipped;
+	}
+
+	uint64_t user_ticks = 0;
+	uint64_t system_ticks = 0;
+	if (!(fields >> user_ticks >> system_ticks)) {
+		return result::failure;
+	}
+
+	long ticks_per_second = sysconf(_SC_CLK_TCK);
+	cpu_time = duration_cast<duration>(microseconds{static_cast<microseconds::rep>((user_ticks + system_ticks) * 1000000 / ticks_per_second)});
+	return result::success;
+#endif
+}
+
+}
+}
@@ -0,0 +1,42 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <ostream>
+
+namespace vana {
+	namespace bot_client {
+		// Reports how much CPU the server processes used between begin() and print()
+		class cpu_sampler {
+			NONCOPYABLE(cpu_sampler);
+			NO_DEFAULT_CONSTRUCTOR(cpu_sampler);
+		public:
+			cpu_sampler(const vector<int32_t> &pids);
+
+			auto begin() -> void;
+			auto print(std::ostream &out) const -> void;
+		private:
+			static auto read_cpu_time(int32_t pid, duration &cpu_time) -> result;
+
+			vector<int32_t> m_pids;
+			vector<duration> m_start_cpu;
+			time_point m_start;
+		};
+	}
+}
@@ -0,0 +1,108 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "common/exit_code.hpp"
+#include "bot_client/bot.hpp"
+#include "bot_client/bot_config.hpp"
+#include "bot_client/bot_stats.hpp"
+#include "bot_client/cpu_sampler.hpp"
+#include <botan/botan.h>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace {
+	auto print_usage() -> void {
+		std::cerr << "Usage: bot_client [options]" << std::endl
+			<< "  --host <address>      Login server address (127.0.0.1)" << std::endl
+			<< "  --port <port>         Login server port (8484)" << std::endl
+			<< "  --bots <count>        Number of bots (10)" << std::endl
+			<< "  --prefix <name>       Bot N logs in as <prefix>N (bot)" << std::endl
+			<< "  --password <password> Password shared by every bot account (password)" << std::endl
+			<< "  --world <id>          World to play on (0)" << std::endl
+			<< "  --channels <count>    Channels to spread bots over and hop between (1)" << std::endl
+			<< "  --duration <seconds>  How long to run after the first bot starts (60)" << std::endl
+			<< "  --interval <ms>       Time between scripted actions per bot (250)" << std::endl
+			<< "  --pid <pid>           Server process to report CPU for, may be repeated" << std::endl
+			<< "Every account needs a gender, no PIN and at least one character on the world" << std::endl;
+	}
+
+	auto parse_arguments(int argc, char *argv[], vana::bot_client::bot_config &config) -> vana::result {
+		for (int i = 1; i < argc; i++) {
+			vana::string option = argv[i];
+			if (i + 1 >= argc) {
+				return vana::result::failure;
+			}
+			vana::string value = argv[++i];
+
+			if (option == "--host") config.login_host = value;
+			else if (option == "--port") config.login_port = static_cast<vana::connection_port>(std::atoi(value.c_str()));
+			else if (option == "--bots") config.bot_count = static_cast<vana::uint16_t>(std::atoi(value.c_str()));
+			else if (option == "--prefix") config.account_prefix = value;
+			else if (option == "--password") config.password = value;
+			else if (option == "--world") config.world_id = static_cast<vana::game_world_id>(std::atoi(value.c_str()));
+			else if (option == "--channels") config.channel_count = static_cast<vana::game_channel_id>(std::atoi(value.c_str()));
+			else if (option == "--duration") config.duration = vana::seconds{std::atoi(value.c_str())};
+			else if (option == "--interval") config.action_interval = vana::milliseconds{std::atoi(value.c_str())};
+			else if (option == "--pid") config.server_pids.push_back(std::atoi(value.c_str()));
+			else return vana::result::failure;
+		}
+
+		return config.bot_count > 0 && config.channel_count > 0 ?
+			vana::result::success :
+			vana::result::failure;
+	}
+}
+
+auto main(int argc, char *argv[]) -> vana::exit_code_underlying {
+	using namespace vana;
+	using namespace vana::bot_client;
+
+	bot_config config;
+	if (parse_arguments(argc, argv, config) == result::failure) {
+		print_usage();
+		return static_cast<exit_code_underlying>(exit_code::config_error);
+	}
+
+	Botan::LibraryInitializer init{"thread_safe=true"};
+	bot_stats stats;
+	cpu_sampler sampler{config.server_pids};
+
+	vector<owned_ptr<bot>> bots;
+	vector<std::thread> threads;
+	time_point start = effective_clock::now();
+	time_point end = start + config.duration;
+	sampler.begin();
+
+	for (uint16_t i = 0; i < config.bot_count; i++) {
+		bots.push_back(make_owned_ptr<bot>(i, config, stats));
+		bot *value = bots.back().get();
+		threads.emplace_back([value, end] { value->run(end); });
+
+		// Spread logins out so the login server sees a ramp instead of a spike
+		std::this_thread::sleep_for(config.ramp_interval);
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	stats.print(std::cout, effective_clock::now() - start);
+	sampler.print(std::cout);
+
+	return static_cast<exit_code_underlying>(stats.get_logged_in() > 0 ? exit_code::ok : exit_code::server_connection_error);
+}
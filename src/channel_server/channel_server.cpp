@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/connection_listener_config.hpp"
 #include "common/connection_manager.hpp"
 #include "common/data/initialize.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/exit_code.hpp"
 #include "common/lua/config_file.hpp"
 #include "common/packet_builder.hpp"
@@ -37,7 +38,9 @@ namespace channel_server {
 
 channel_server::channel_server() :
 	abstract_server{server_type::channel},
-	m_world_ip{0}
+	m_world_ip{0},
+	m_map_workers{get_connection_manager()},
+	m_write_behind{this}
 {
 }
 
@@ -48,6 +51,7 @@ auto channel_server::listen() -> void {
 	get_connection_manager().listen(
 		connection_listener_config{
 			config.client_ping,
+			config.client_send_queue_limit,
 			config.client_encryption,
 			connection_type::end_user,
 			maple_version::channel_subversion,
@@ -67,6 +71,9 @@ auto channel_server::finalize_player(ref_ptr<player> session) -> void {
 auto channel_server::shutdown() -> void {
 	// If we don't do this and the connection disconnects, it will try to call shutdown() again
 	m_channel_id = -1;
+	// Disconnecting players queues their final saves, which have to be written before the thread pool is joined
+	get_connection_manager().stop();
+	m_write_behind.flush();
 	abstract_server::shutdown();
 }
 
@@ -94,12 +101,15 @@ auto channel_server::load_data() -> result {
 	m_item_data_provider.load_data(m_buff_data_provider);
 	m_map_data_provider.load_data();
 	m_event_data_provider.load_data();
+	vana::data::snapshot::get_instance().close();
 
 	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing Commands... ";
 	chat_handler::initialize_commands();
 	std::cout << "DONE" << std::endl;
 
 	auto &config = get_inter_server_config();
+	m_map_workers.start(config.map_worker_count);
+
 	auto result = get_connection_manager().connect(
 		config.login_ip,
 		config.login_port,
@@ -118,6 +128,9 @@ auto channel_server::load_data() -> result {
 }
 
 auto channel_server::reload_data(const string &args) -> void {
+	// Reloading means the MCDB was edited without a version change, so the snapshot can't be trusted anymore
+	vana::data::snapshot::get_instance().invalidate();
+
 	if (args == "all") {
 		m_item_data_provider.load_data(m_buff_data_provider);
 		m_drop_data_provider.load_data();
@@ -140,6 +153,8 @@ auto channel_server::reload_data(const string &args) -> void {
 	else if (args == "reactors") m_reactor_data_provider.load_data();
 	else if (args == "quests") m_quest_data_provider.load_data();
 	else if (args == "maps") m_map_data_provider.load_data();
+
+	m_drop_tables.clear();
 }
 
 auto channel_server::make_log_identifier() const -> opt_string {
@@ -152,6 +167,13 @@ auto channel_server::get_log_prefix() const -> string {
 	return "channel";
 }
 
+auto channel_server::write_server_stats(out_stream &stream) -> void {
+	stream << "vana_players " << m_player_data_provider.get_player_count() << std::endl;
+	stream << "vana_maps_loaded " << m_map_factory.get_loaded_count() << std::endl;
+	stream << "vana_maps_active " << m_map_factory.get_active_count() << std::endl;
+	stream << "vana_write_behind_queue_depth " << m_write_behind.get_pending_count() << std::endl;
+}
+
 auto channel_server::connect_to_world(game_world_id world_id, connection_port port, const ip &ip) -> result {
 	m_world_id = world_id;
 	m_world_port = port;
@@ -242,6 +264,10 @@ auto channel_server::get_drop_data_provider() const -> const data::provider::dro
 	return m_drop_data_provider;
 }
 
+auto channel_server::get_drop_tables() -> drop_tables & {
+	return m_drop_tables;
+}
+
 auto channel_server::get_skill_data_provider() const -> const data::provider::skill & {
 	return m_skill_data_provider;
 }
@@ -282,6 +308,10 @@ auto channel_server::get_player_data_provider() -> player_data_provider & {
 	return m_player_data_provider;
 }
 
+auto channel_server::get_map_factory() -> map_factory & {
+	return m_map_factory;
+}
+
 auto channel_server::get_trades() -> trades & {
 	return m_trades;
 }
@@ -294,6 +324,14 @@ auto channel_server::get_instances() -> instances & {
 	return m_instances;
 }
 
+auto channel_server::get_map_workers() -> map_workers & {
+	return m_map_workers;
+}
+
+auto channel_server::get_write_behind() -> vana::io::write_behind & {
+	return m_write_behind;
+}
+
 auto channel_server::get_map(int32_t map_id) -> map * {
 	return m_map_factory.get_map(map_id);
 }
@@ -344,6 +382,7 @@ auto channel_server::modify_rate(int32_t rate_type, int32_t new_value) -> void {
 
 auto channel_server::set_rates(const config::rates &rates) -> void {
 	m_config.rates = rates;
+	m_drop_tables.clear();
 }
 
 auto channel_server::set_config(const config::world &config) -> void {
@@ -351,11 +390,14 @@ auto channel_server::set_config(const config::world &config) -> void {
 	if (config.map_unload_time != m_config.map_unload_time) {
 		map::set_map_unload_time(config.map_unload_time);
 	}
+	map::set_area_of_interest(config.interest_player_threshold, config.interest_view_range);
+	map::set_movement_coalesce_interval(config.movement_coalesce_interval);
 
 	for (auto &kvp : config.npc_forced_script) {
 		m_script_data_provider.register_npc_script(kvp.first, kvp.second);
 	}
 	m_config = config;
+	m_drop_tables.clear();
 }
 
 }
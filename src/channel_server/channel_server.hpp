@@ -34,13 +34,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/data/provider/skill.hpp"
 #include "common/data/provider/shop.hpp"
 #include "common/data/provider/valid_char.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/ip.hpp"
 #include "common/types.hpp"
 #include "common/util/finalization_pool.hpp"
+#include "channel_server/drop_tables.hpp"
 #include "channel_server/event_data_provider.hpp"
 #include "channel_server/instances.hpp"
 #include "channel_server/login_server_session.hpp"
 #include "channel_server/map_factory.hpp"
+#include "channel_server/map_workers.hpp"
 #include "channel_server/maple_tvs.hpp"
 #include "channel_server/player_data_provider.hpp"
 #include "channel_server/trades.hpp"
@@ -80,6 +83,7 @@ namespace vana {
 			auto get_mob_data_provider() const -> const data::provider::mob &;
 			auto get_beauty_data_provider() const -> const data::provider::beauty &;
 			auto get_drop_data_provider() const -> const data::provider::drop &;
+			auto get_drop_tables() -> drop_tables &;
 			auto get_skill_data_provider() const -> const data::provider::skill &;
 			auto get_shop_data_provider() const -> const data::provider::shop &;
 			auto get_script_data_provider() const -> const data::provider::script &;
@@ -90,10 +94,12 @@ namespace vana {
 			auto get_event_data_provider() const -> const event_data_provider &;
 			auto get_map_data_provider() -> data::provider::map &;
 			auto get_player_data_provider() -> player_data_provider &;
-			auto get_map_factory() const -> map_factory &;
+			auto get_map_factory() -> map_factory &;
+			auto get_map_workers() -> map_workers &;
 			auto get_trades() -> trades &;
 			auto get_maple_tvs() -> maple_tvs &;
 			auto get_instances() -> instances &;
+			auto get_write_behind() -> vana::io::write_behind &;
 
 			auto get_map(int32_t map_id) -> map *;
 			auto unload_map(int32_t map_id) -> void;
@@ -114,6 +120,7 @@ namespace vana {
 			auto listen() -> void;
 			auto make_log_identifier() const -> opt_string override;
 			auto get_log_prefix() const -> string override;
+			auto write_server_stats(out_stream &stream) -> void override;
 		private:
 			game_world_id m_world_id = -1;
 			game_channel_id m_channel_id = -1;
@@ -141,11 +148,14 @@ namespace vana {
 			data::provider::buff m_buff_data_provider;
 			data::provider::map m_map_data_provider;
 			event_data_provider m_event_data_provider;
+			drop_tables m_drop_tables;
 			player_data_provider m_player_data_provider;
+			map_workers m_map_workers;
 			map_factory m_map_factory;
 			trades m_trades;
 			maple_tvs m_maple_tvs;
 			instances m_instances;
+			vana::io::write_behind m_write_behind;
 		};
 	}
 }
\ No newline at end of file
@@ -628,6 +628,12 @@ auto chat_handler_functions::initialize() -> void {
 	command.notes.push_back("Allows you to view the lag of any player");
 	g_command_list["lag"] = command.add_to_map();
 
+	command.command = &management_functions::stats;
+	command.syntax = "[${reset}]";
+	command.notes.push_back("Shows server load, timer lag, database queues and the most expensive packet handlers");
+	command.notes.push_back("Reset clears the handler and timer lag statistics");
+	g_command_list["stats"] = command.add_to_map();
+
 	command.command = &management_functions::rehash;
 	command.notes.push_back("Rehashes world configurations after modification");
 	g_command_list["rehash"] = command.add_to_map();
@@ -25,9 +25,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/packet_reader.hpp"
 #include "common/point.hpp"
 #include "common/util/game_logic/item.hpp"
-#include "common/util/randomizer.hpp"
+#include "common/util/tausworthe_generator.hpp"
 #include "channel_server/channel_server.hpp"
 #include "channel_server/drop.hpp"
+#include "channel_server/drop_tables.hpp"
 #include "channel_server/drops_packet.hpp"
 #include "channel_server/inventory.hpp"
 #include "channel_server/maps.hpp"
@@ -37,16 +38,47 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/reactor_handler.hpp"
 #include "channel_server/skills.hpp"
 #include <algorithm>
+#include <random>
+#include <utility>
 
 namespace vana {
 namespace channel_server {
 
+namespace {
+
+// Scratch space for shuffling a drop table, reused so a kill doesn't allocate
+// thread_local is __thread outside of MSVC, so these have to be trivial namespace-scope pointers
+thread_local vector<const drop_tables::entry *> *s_roll_order = nullptr;
+thread_local vana::util::tausworthe_generator *s_roll_generator = nullptr;
+
+auto get_roll_order() -> vector<const drop_tables::entry *> & {
+	if (s_roll_order == nullptr) {
+		s_roll_order = new vector<const drop_tables::entry *>;
+	}
+	return *s_roll_order;
+}
+
+auto get_roll_generator() -> vana::util::tausworthe_generator & {
+	if (s_roll_generator == nullptr) {
+		std::random_device seeding_engine;
+		s_roll_generator = new vana::util::tausworthe_generator{seeding_engine(), seeding_engine(), seeding_engine()};
+	}
+	return *s_roll_generator;
+}
+
+// Uniform in [0, bound) without a division
+auto roll(vana::util::tausworthe_generator &generator, uint32_t bound) -> uint32_t {
+	return static_cast<uint32_t>((static_cast<uint64_t>(generator.next()) * bound) >> 32);
+}
+
+}
+
 auto drop_handler::do_drops(game_player_id player_id, game_map_id map_id, int32_t dropping_level, int32_t dropping_id, const point &origin, bool explosive, bool ffa, int32_t taunt, bool is_steal) -> void {
 	auto &channel = channel_server::get_instance();
-	auto &global_drops = channel.get_drop_data_provider().get_global_drops();
-
-	// Make a copy of the data so we can modify the object with global drops
-	auto drops = channel.get_drop_data_provider().get_drops(dropping_id);
+	auto drops = channel.get_drop_tables().get_table(dropping_id, dropping_level, map_id);
+	if (drops->empty()) {
+		return;
+	}
 
 	auto player = channel.get_player_data_provider().get_player(player_id);
 	game_coord drop_pos_counter = 0;
@@ -59,70 +91,31 @@ auto drop_handler::do_drops(game_player_id player_id, game_map_id map_id, int32_
 		}
 	}
 
-	auto &config = channel.get_config();
-	int32_t drop_rate = config.rates.drop_rate;
-	int32_t global_drop_rate = config.rates.global_drop_rate;
-	int32_t meso_rate = config.rates.drop_meso;
-	int32_t global_meso_rate = config.rates.global_drop_meso;
-	if (config.rates.is_global_drop_consistent_with_regular_drop_rate()) {
-		global_drop_rate = drop_rate;
-	}
-	if (config.rates.is_global_drop_meso_consistent_with_regular_drop_meso_rate()) {
-		global_meso_rate = meso_rate;
-	}
-
-	if (dropping_level != 0 && global_drops.size() != 0) {
-		data::type::drop_info d;
-		int8_t continent = channel.get_map_data_provider().get_continent(map_id).get(0);
-
-		if (global_drop_rate > 0) {
-			for (const auto &global_drop : global_drops) {
-				if (dropping_level >= global_drop.min_level && dropping_level <= global_drop.max_level) {
-					if (global_drop.continent == 0 || (continent == global_drop.continent)) {
-						d = data::type::drop_info{};
-						d.is_global = true;
-						d.chance = global_drop.chance;
-						d.is_mesos = global_drop.is_mesos;
-						d.item_id = global_drop.item_id;
-						d.min_amount = global_drop.min_amount;
-						d.max_amount = global_drop.max_amount;
-						d.quest_id = global_drop.quest_id;
-						drops.push_back(d);
-					}
-				}
-			}
-		}
+	auto &order = get_roll_order();
+	order.clear();
+	for (const auto &drop_info : *drops) {
+		order.push_back(&drop_info);
 	}
 
-	if (config.rates.drop_rate == 0) {
-		return;
+	auto &generator = get_roll_generator();
+	for (size_t i = order.size() - 1; i > 0; --i) {
+		std::swap(order[i], order[roll(generator, static_cast<uint32_t>(i + 1))]);
 	}
 
-	vana::util::randomizer::shuffle(drops);
 	game_coord mod = explosive ? 35 : 25;
-	for (const auto &drop_info : drops) {
-		if (drop_info.is_mesos && meso_rate == 0) {
-			continue;
-		}
-		if (drop_info.is_global && drop_info.is_mesos && global_meso_rate == 0) {
-			continue;
+	for (const auto *drop_info : order) {
+		game_slot_qty amount = static_cast<game_slot_qty>(drop_info->min_amount);
+		if (drop_info->max_amount > drop_info->min_amount) {
+			amount += static_cast<game_slot_qty>(roll(generator, static_cast<uint32_t>(drop_info->max_amount - drop_info->min_amount + 1)));
 		}
 
-		game_slot_qty amount = static_cast<game_slot_qty>(vana::util::randomizer::rand<int32_t>(drop_info.max_amount, drop_info.min_amount));
 		drop *value = nullptr;
-		uint32_t chance = drop_info.chance;
-
-		if (is_steal) {
-			chance = chance * 3 / 10;
-		}
-		else {
-			chance = chance * taunt / 100;
-			chance *= drop_info.is_global ?
-				global_drop_rate :
-				drop_rate;
-		}
+		uint32_t chance = is_steal ?
+			drop_info->steal_chance :
+			// Rate applied after the taunt division, a large rate times the taunt would overflow
+			drop_info->chance * taunt / 100 * drop_info->drop_rate;
 
-		if (vana::util::randomizer::rand<uint32_t>(999999) < chance) {
+		if (roll(generator, 1000000) < chance) {
 			pos.x = origin.x + ((drop_pos_counter % 2) ?
 				(mod * (drop_pos_counter + 1) / 2) :
 				-(mod * (drop_pos_counter / 2)));
@@ -135,9 +128,9 @@ auto drop_handler::do_drops(game_player_id player_id, game_map_id map_id, int32_
 			}
 			*/
 
-			if (!drop_info.is_mesos) {
-				game_item_id item_id = drop_info.item_id;
-				game_quest_id quest_id = drop_info.quest_id;
+			if (!drop_info->is_mesos) {
+				game_item_id item_id = drop_info->item_id;
+				game_quest_id quest_id = drop_info->quest_id;
 
 				if (quest_id > 0) {
 					if (player == nullptr || player->get_quests()->item_drop_allowed(item_id, quest_id) == allow_quest_item_result::disallow) {
@@ -161,9 +154,7 @@ auto drop_handler::do_drops(game_player_id player_id, game_map_id map_id, int32_
 			else {
 				game_mesos mesos = amount;
 				if (!is_steal) {
-					mesos *= drop_info.is_global ?
-						global_meso_rate :
-						meso_rate;
+					mesos *= drop_info->meso_rate;
 
 					if (player != nullptr) {
 						auto meso_up = player->get_active_buffs()->get_meso_up_source();
@@ -0,0 +1,108 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "drop_tables.hpp"
+#include "common/config/rates.hpp"
+#include "common/data/provider/drop.hpp"
+#include "common/data/provider/map.hpp"
+#include "common/util/game_logic/map.hpp"
+#include "channel_server/channel_server.hpp"
+
+namespace vana {
+namespace channel_server {
+
+auto drop_tables::get_table(int32_t dropping_id, int32_t dropping_level, game_map_id map_id) -> ref_ptr<const table> {
+	// Global drops only depend on the continent, which is fixed for a map cluster
+	uint8_t cluster = static_cast<uint8_t>(vana::util::game_logic::map::get_map_cluster(map_id));
+	uint64_t key =
+		(static_cast<uint64_t>(static_cast<uint32_t>(dropping_id)) << 32) |
+		(static_cast<uint64_t>(static_cast<uint32_t>(dropping_level) & 0xFFFFFF) << 8) |
+		cluster;
+
+	owned_lock<mutex> l{m_mutex};
+	auto kvp = m_tables.find(key);
+	if (kvp != std::end(m_tables)) {
+		return kvp->second;
+	}
+
+	auto compiled = compile(dropping_id, dropping_level, map_id, channel_server::get_instance().get_config().rates);
+	m_tables.emplace(key, compiled);
+	return compiled;
+}
+
+auto drop_tables::clear() -> void {
+	owned_lock<mutex> l{m_mutex};
+	m_tables.clear();
+}
+
+auto drop_tables::compile(int32_t dropping_id, int32_t dropping_level, game_map_id map_id, const config::rates &rates) -> ref_ptr<const table> {
+	auto compiled = make_ref_ptr<table>();
+	if (rates.drop_rate == 0) {
+		return compiled;
+	}
+
+	int32_t drop_rate = rates.drop_rate;
+	int32_t global_drop_rate = rates.is_global_drop_consistent_with_regular_drop_rate() ? drop_rate : rates.global_drop_rate;
+	int32_t meso_rate = rates.drop_meso;
+	int32_t global_meso_rate = rates.is_global_drop_meso_consistent_with_regular_drop_meso_rate() ? meso_rate : rates.global_drop_meso;
+
+	auto add = [&compiled](bool is_mesos, game_item_id item_id, int32_t min_amount, int32_t max_amount, game_quest_id quest_id, uint32_t chance, int32_t rate, int32_t mesos_rate) {
+		if (is_mesos && mesos_rate == 0) {
+			return;
+		}
+
+		entry value;
+		value.is_mesos = is_mesos;
+		value.item_id = item_id;
+		value.min_amount = min_amount;
+		value.max_amount = max_amount;
+		value.quest_id = quest_id;
+		value.chance = chance;
+		value.drop_rate = static_cast<uint32_t>(rate);
+		value.steal_chance = chance * 3 / 10;
+		value.meso_rate = mesos_rate;
+		compiled->push_back(value);
+	};
+
+	auto &channel = channel_server::get_instance();
+	for (const auto &drop : channel.get_drop_data_provider().get_drops(dropping_id)) {
+		add(drop.is_mesos, drop.item_id, drop.min_amount, drop.max_amount, drop.quest_id, drop.chance, drop_rate, meso_rate);
+	}
+
+	auto &global_drops = channel.get_drop_data_provider().get_global_drops();
+	if (dropping_level != 0 && global_drop_rate > 0 && global_drops.size() != 0) {
+		int8_t continent = channel.get_map_data_provider().get_continent(map_id).get(0);
+		for (const auto &global_drop : global_drops) {
+			if (dropping_level < global_drop.min_level || dropping_level > global_drop.max_level) {
+				continue;
+			}
+			if (global_drop.continent != 0 && continent != global_drop.continent) {
+				continue;
+			}
+			if (global_drop.is_mesos && meso_rate == 0) {
+				continue;
+			}
+			add(global_drop.is_mesos, global_drop.item_id, global_drop.min_amount, global_drop.max_amount, global_drop.quest_id, global_drop.chance, global_drop_rate, global_meso_rate);
+		}
+	}
+
+	compiled->shrink_to_fit();
+	return compiled;
+}
+
+}
+}
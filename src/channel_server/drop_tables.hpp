@@ -0,0 +1,56 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <mutex>
+#include <vector>
+
+namespace vana {
+	namespace config {
+		struct rates;
+	}
+
+	namespace channel_server {
+		// Drop lists with the matching global drops merged in and the world rates resolved per entry
+		// Built on first use for each dropper, dropper level, and map cluster, then reused until rates or data change
+		class drop_tables {
+		public:
+			struct entry {
+				bool is_mesos = false;
+				game_item_id item_id = 0;
+				int32_t min_amount = 0;
+				int32_t max_amount = 0;
+				game_quest_id quest_id = 0;
+				uint32_t chance = 0;
+				uint32_t steal_chance = 0;
+				uint32_t drop_rate = 0;
+				int32_t meso_rate = 0;
+			};
+			using table = vector<entry>;
+
+			auto get_table(int32_t dropping_id, int32_t dropping_level, game_map_id map_id) -> ref_ptr<const table>;
+			auto clear() -> void;
+		private:
+			static auto compile(int32_t dropping_id, int32_t dropping_level, game_map_id map_id, const config::rates &rates) -> ref_ptr<const table>;
+
+			mutex m_mutex;
+			hash_map<uint64_t, ref_ptr<const table>> m_tables;
+		};
+	}
+}
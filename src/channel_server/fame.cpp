@@ -34,40 +34,87 @@ auto fame::handle_fame(ref_ptr<player> player, packet_reader &reader) -> void {
 			// Hacking
 			return;
 		}
-		int32_t check_result = can_fame(player, target_id);
-		if (check_result != 0) {
-			player->send(packets::fame::send_error(check_result));
+		if (player->get_stats()->get_level() < 15) {
+			player->send(packets::fame::send_error(packets::fame::errors::level_under15));
+			return;
 		}
-		else {
-			auto famee = channel_server::get_instance().get_player_data_provider().get_player(target_id);
-			game_fame new_fame = famee->get_stats()->get_fame() + (type == 1 ? 1 : -1);
-			famee->get_stats()->set_fame(new_fame);
-			add_fame_log(player->get_id(), target_id);
-			player->send(packets::fame::send_fame(famee->get_name(), type, new_fame));
-			famee->send(packets::fame::receive_fame(player->get_name(), type));
+		if (player->is_fame_pending()) {
+			// The previous fame hasn't been logged yet, checking now would let both through
+			return;
 		}
+
+		auto &server = channel_server::get_instance();
+		if (server.get_player_data_provider().get_player(target_id) == nullptr) {
+			player->send(packets::fame::send_error(packets::fame::errors::incorrect_user));
+			return;
+		}
+
+		game_player_id from = player->get_id();
+		int32_t fame_time = static_cast<int32_t>(server.get_config().fame_time.count());
+		int32_t fame_reset_time = static_cast<int32_t>(server.get_config().fame_reset_time.count());
+		view_ptr<vana::channel_server::player> source = player;
+		auto clear_pending = [source] {
+			if (auto player = source.lock()) {
+				player->set_fame_pending(false);
+			}
+		};
+
+		// Held from the check until the log row is written
+		player->set_fame_pending(true);
+		server.get_database_executor().post<int32_t>(
+			"fame_check",
+			[from, target_id, fame_time, fame_reset_time](vana::io::database &db) -> int32_t {
+				return can_fame(db, from, target_id, fame_time, fame_reset_time);
+			},
+			[source, clear_pending, from, target_id, type](int32_t check_result) {
+				auto player = source.lock();
+				if (player == nullptr) {
+					return;
+				}
+				if (check_result != 0) {
+					clear_pending();
+					player->send(packets::fame::send_error(check_result));
+					return;
+				}
+
+				auto famee = channel_server::get_instance().get_player_data_provider().get_player(target_id);
+				if (famee == nullptr) {
+					clear_pending();
+					player->send(packets::fame::send_error(packets::fame::errors::incorrect_user));
+					return;
+				}
+
+				game_fame new_fame = famee->get_stats()->get_fame() + (type == 1 ? 1 : -1);
+				famee->get_stats()->set_fame(new_fame);
+				channel_server::get_instance().get_database_executor().execute(
+					"fame_log",
+					[from, target_id](vana::io::database &db) {
+						add_fame_log(db, from, target_id);
+					},
+					[clear_pending](bool) {
+						clear_pending();
+					});
+				player->send(packets::fame::send_fame(famee->get_name(), type, new_fame));
+				famee->send(packets::fame::receive_fame(player->get_name(), type));
+			},
+			clear_pending);
 	}
 	else {
 		player->send(packets::fame::send_error(packets::fame::errors::incorrect_user));
 	}
 }
 
-auto fame::can_fame(ref_ptr<player> player, game_player_id to) -> int32_t {
-	game_player_id from = player->get_id();
-	if (player->get_stats()->get_level() < 15) {
-		return packets::fame::errors::level_under15;
-	}
-	if (get_last_fame_log(from) == search_result::found) {
+auto fame::can_fame(vana::io::database &db, game_player_id from, game_player_id to, int32_t fame_time, int32_t fame_reset_time) -> int32_t {
+	if (get_last_fame_log(db, from, fame_time) == search_result::found) {
 		return packets::fame::errors::already_famed_today;
 	}
-	if (get_last_fame_sp_log(from, to) == search_result::found) {
+	if (get_last_fame_sp_log(db, from, to, fame_reset_time) == search_result::found) {
 		return packets::fame::errors::famed_this_month;
 	}
 	return 0;
 }
 
-auto fame::add_fame_log(game_player_id from, game_player_id to) -> void {
-	auto &db = vana::io::database::get_char_db();
+auto fame::add_fame_log(vana::io::database &db, game_player_id from, game_player_id to) -> void {
 	auto &sql = db.get_session();
 	sql.once
 		<< "INSERT INTO " << db.make_table(vana::table::fame_log) << " (from_character_id, to_character_id, fame_time) "
@@ -76,8 +123,7 @@ auto fame::add_fame_log(game_player_id from, game_player_id to) -> void {
 		soci::use(to, "to");
 }
 
-auto fame::get_last_fame_log(game_player_id from) -> search_result {
-	int32_t fame_time = static_cast<int32_t>(channel_server::get_instance().get_config().fame_time.count());
+auto fame::get_last_fame_log(vana::io::database &db, game_player_id from, int32_t fame_time) -> search_result {
 	if (fame_time == 0) {
 		return search_result::found;
 	}
@@ -85,7 +131,6 @@ auto fame::get_last_fame_log(game_player_id from) -> search_result {
 		return search_result::not_found;
 	}
 
-	auto &db = vana::io::database::get_char_db();
 	auto &sql = db.get_session();
 	optional<unix_time> time;
 
@@ -103,8 +148,7 @@ auto fame::get_last_fame_log(game_player_id from) -> search_result {
 		search_result::not_found;
 }
 
-auto fame::get_last_fame_sp_log(game_player_id from, game_player_id to) -> search_result {
-	int32_t fame_reset_time = static_cast<int32_t>(channel_server::get_instance().get_config().fame_reset_time.count());
+auto fame::get_last_fame_sp_log(vana::io::database &db, game_player_id from, game_player_id to, int32_t fame_reset_time) -> search_result {
 	if (fame_reset_time == 0) {
 		return search_result::found;
 	}
@@ -112,7 +156,6 @@ auto fame::get_last_fame_sp_log(game_player_id from, game_player_id to) -> searc
 		return search_result::not_found;
 	}
 
-	auto &db = vana::io::database::get_char_db();
 	auto &sql = db.get_session();
 	optional<unix_time> time;
 
@@ -21,16 +21,19 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace vana {
 	class packet_reader;
+	namespace io {
+		class database;
+	}
 
 	namespace channel_server {
 		class player;
 
 		namespace fame {
 			auto handle_fame(ref_ptr<player> player, packet_reader &reader) -> void;
-			auto can_fame(ref_ptr<player> player, game_player_id to) -> int32_t;
-			auto add_fame_log(game_player_id from, game_player_id to) -> void;
-			auto get_last_fame_log(game_player_id from) -> search_result;
-			auto get_last_fame_sp_log(game_player_id from, game_player_id to) -> search_result;
+			auto can_fame(vana::io::database &db, game_player_id from, game_player_id to, int32_t fame_time, int32_t fame_reset_time) -> int32_t;
+			auto add_fame_log(vana::io::database &db, game_player_id from, game_player_id to) -> void;
+			auto get_last_fame_log(vana::io::database &db, game_player_id from, int32_t fame_time) -> search_result;
+			auto get_last_fame_sp_log(vana::io::database &db, game_player_id from, game_player_id to, int32_t fame_reset_time) -> search_result;
 		}
 	}
 }
\ No newline at end of file
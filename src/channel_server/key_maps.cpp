@@ -17,6 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #include "key_maps.hpp"
 #include "common/io/database.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
@@ -82,6 +83,17 @@ auto key_maps::load(game_player_id char_id) -> void {
 	}
 }
 
+auto key_maps::load(const player_snapshot &snapshot, game_player_id char_id) -> void {
+	for (const auto &row : snapshot.key_maps) {
+		add(row.pos, key_map{static_cast<key_map_type>(row.type), row.action});
+	}
+	if (get_max() == -1) {
+		// No keymaps, set default map
+		default_map();
+		save(char_id);
+	}
+}
+
 auto key_maps::save(game_player_id char_id) -> void {
 	size_t i = 0;
 	int8_t type = 0;
@@ -113,5 +125,15 @@ auto key_maps::save(game_player_id char_id) -> void {
 	}
 }
 
+auto key_maps::fill_snapshot(player_snapshot &snapshot) const -> void {
+	for (const auto &kvp : m_key_maps) {
+		player_snapshot::key_map_row row;
+		row.pos = kvp.first;
+		row.type = static_cast<int8_t>(kvp.second.type);
+		row.action = kvp.second.action;
+		snapshot.key_maps.push_back(row);
+	}
+}
+
 }
 }
\ No newline at end of file
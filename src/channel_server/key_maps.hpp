@@ -25,6 +25,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace vana {
 	namespace channel_server {
+		struct player_snapshot;
+
 		class key_maps {
 			NONCOPYABLE(key_maps);
 		public:
@@ -39,7 +41,9 @@ namespace vana {
 			auto get_max() -> int32_t;
 
 			auto load(game_player_id char_id) -> void;
+			auto load(const player_snapshot &snapshot, game_player_id char_id) -> void;
 			auto save(game_player_id char_id) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 
 			static const size_t key_count = 90;
 		private:
@@ -27,11 +27,13 @@ namespace channel_server {
 namespace lua {
 
 lua_instance::lua_instance(const string &name, game_player_id player_id) :
-	lua_scriptable{channel_server::get_instance().get_script_data_provider().build_script_path(data::type::script_type::instance, name), player_id}
+	lua_scriptable{channel_server::get_instance().get_script_data_provider().build_script_path(data::type::script_type::instance, name), player_id, "instance"}
 {
 	set<string>("system_instance_name", name);
 
-	expose("createInstance", &lua_exports::create_instance_instance);
+	if (needs_bindings()) {
+		expose("createInstance", &lua_exports::create_instance_instance);
+	}
 
 	run(); // Running is loading the functions
 }
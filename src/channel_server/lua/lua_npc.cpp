@@ -30,35 +30,37 @@ namespace channel_server {
 namespace lua {
 
 lua_npc::lua_npc(const string &filename, game_player_id player_id) :
-	lua_scriptable{filename, player_id, true}
+	lua_scriptable{filename, player_id, "npc", true}
 {
-	set_npc_environment_variables();
-
-	// Miscellaneous
-	expose("getDistanceToPlayer", &lua_exports::get_distance_npc);
-	expose("getNpcId", &lua_exports::get_npc_id);
-	expose("runNpc", &lua_exports::run_npc_npc);
-	expose("showStorage", &lua_exports::show_storage);
-
-	// NPC interaction
-	expose("addText", &lua_exports::add_text);
-	expose("askAcceptDecline", &lua_exports::ask_accept_decline);
-	expose("askAcceptDeclineNoExit", &lua_exports::ask_accept_decline_no_exit);
-	expose("askChoice", &lua_exports::ask_choice);
-	expose("askNumber", &lua_exports::ask_number);
-	expose("askQuestion", &lua_exports::ask_question);
-	expose("askQuiz", &lua_exports::ask_quiz);
-	expose("askStyle", &lua_exports::ask_style);
-	expose("askText", &lua_exports::ask_text);
-	expose("askYesNo", &lua_exports::ask_yes_no);
-	expose("sendBackNext", &lua_exports::send_back_next);
-	expose("sendBackOk", &lua_exports::send_back_ok);
-	expose("sendNext", &lua_exports::send_next);
-	expose("sendOk", &lua_exports::send_ok);
-
-	// Quest
-	expose("addQuest", &lua_exports::add_quest);
-	expose("endQuest", &lua_exports::end_quest);
+	if (needs_bindings()) {
+		set_npc_environment_variables();
+
+		// Miscellaneous
+		expose("getDistanceToPlayer", &lua_exports::get_distance_npc);
+		expose("getNpcId", &lua_exports::get_npc_id);
+		expose("runNpc", &lua_exports::run_npc_npc);
+		expose("showStorage", &lua_exports::show_storage);
+
+		// NPC interaction
+		expose("addText", &lua_exports::add_text);
+		expose("askAcceptDecline", &lua_exports::ask_accept_decline);
+		expose("askAcceptDeclineNoExit", &lua_exports::ask_accept_decline_no_exit);
+		expose("askChoice", &lua_exports::ask_choice);
+		expose("askNumber", &lua_exports::ask_number);
+		expose("askQuestion", &lua_exports::ask_question);
+		expose("askQuiz", &lua_exports::ask_quiz);
+		expose("askStyle", &lua_exports::ask_style);
+		expose("askText", &lua_exports::ask_text);
+		expose("askYesNo", &lua_exports::ask_yes_no);
+		expose("sendBackNext", &lua_exports::send_back_next);
+		expose("sendBackOk", &lua_exports::send_back_ok);
+		expose("sendNext", &lua_exports::send_next);
+		expose("sendOk", &lua_exports::send_ok);
+
+		// Quest
+		expose("addQuest", &lua_exports::add_quest);
+		expose("endQuest", &lua_exports::end_quest);
+	}
 }
 
 auto lua_npc::set_npc_environment_variables() -> void {
@@ -26,16 +26,18 @@ namespace channel_server {
 namespace lua {
 
 lua_portal::lua_portal(const string &filename, game_player_id player_id, game_map_id map_id, const data::type::portal_info * const portal) :
-	lua_scriptable{filename, player_id}
+	lua_scriptable{filename, player_id, "portal"}
 {
 	set<game_portal_id>("system_portal_id", portal->id);
 	set<string>("system_portal_name", portal->name);
 	set<game_map_id>("system_map_id", map_id);
 
-	// Portal
-	expose("instantWarp", &lua_exports::instant_warp);
-	expose("playPortalSe", &lua_exports::play_portal_se);
-	expose("portalFailed", &lua_exports::portal_failed);
+	if (needs_bindings()) {
+		// Portal
+		expose("instantWarp", &lua_exports::instant_warp);
+		expose("playPortalSe", &lua_exports::play_portal_se);
+		expose("portalFailed", &lua_exports::portal_failed);
+	}
 
 	run();
 }
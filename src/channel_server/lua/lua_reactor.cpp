@@ -33,24 +33,26 @@ namespace channel_server {
 namespace lua {
 
 lua_reactor::lua_reactor(const string &filename, game_player_id player_id, game_reactor_id reactor_id, game_map_id map_id) :
-	lua_scriptable{filename, player_id},
+	lua_scriptable{filename, player_id, "reactor"},
 	m_reactor_id{reactor_id}
 {
 	set<game_reactor_id>("system_reactor_id", reactor_id);
 	set<game_map_id>("system_map_id", map_id);
 
-	// Reactor
-	expose("getState", &lua_exports::get_state);
-	expose("reset", &lua_exports::reset);
-	expose("setState", &lua_exports::set_state_reactor);
+	if (needs_bindings()) {
+		// Reactor
+		expose("getState", &lua_exports::get_state);
+		expose("reset", &lua_exports::reset);
+		expose("setState", &lua_exports::set_state_reactor);
 
-	// Miscellaneous
-	expose("dropItem", &lua_exports::drop_item_reactor);
-	expose("getDistanceToPlayer", &lua_exports::get_distance_reactor);
+		// Miscellaneous
+		expose("dropItem", &lua_exports::drop_item_reactor);
+		expose("getDistanceToPlayer", &lua_exports::get_distance_reactor);
 
-	// Mob
-	expose("spawnMob", &lua_exports::spawn_mob_reactor);
-	expose("spawnZakum", &lua_exports::spawn_zakum);
+		// Mob
+		expose("spawnMob", &lua_exports::spawn_mob_reactor);
+		expose("spawnZakum", &lua_exports::spawn_zakum);
+	}
 
 	run();
 }
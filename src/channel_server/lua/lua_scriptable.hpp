@@ -42,13 +42,14 @@ namespace vana {
 				NONCOPYABLE(lua_scriptable);
 				NO_DEFAULT_CONSTRUCTOR(lua_scriptable);
 			protected:
-				lua_scriptable(const string &filename, game_player_id player_id);
-				lua_scriptable(const string &filename, game_player_id player_id, bool use_thread);
+				lua_scriptable(const string &filename, game_player_id player_id, const string &pool_name);
+				lua_scriptable(const string &filename, game_player_id player_id, const string &pool_name, bool use_thread);
 
 				auto handle_error(const string &filename, const string &error) -> void override;
 				game_player_id m_player_id = -1;
 			private:
 				auto initialize() -> void;
+				auto expose_api() -> void;
 				auto set_environment_variables() -> void;
 				// TODO FIXME msvc
 				// Remove this when MSVC supports static init
@@ -20,6 +20,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/data/provider/item.hpp"
 #include "common/exit_code.hpp"
 #include "common/io/database.hpp"
+#include "common/io/write_behind.hpp"
+#include "common/timer/thread.hpp"
 #include "common/util/string.hpp"
 #include "channel_server/channel_server.hpp"
 #include "channel_server/inventory.hpp"
@@ -31,6 +33,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/player_packet.hpp"
 #include "channel_server/sync_packet.hpp"
 #include "channel_server/world_server_packet.hpp"
+#include <algorithm>
+#include <iomanip>
 
 namespace vana {
 namespace channel_server {
@@ -352,6 +356,64 @@ auto management_functions::lag(ref_ptr<player> player, const game_chat &args) ->
 	return chat_result::show_syntax;
 }
 
+auto management_functions::stats(ref_ptr<player> player, const game_chat &args) -> chat_result {
+	auto &server = channel_server::get_instance();
+	if (args == "reset") {
+		server.get_handler_stats().reset();
+		vana::timer::thread::get_instance().reset_lag_metrics();
+		chat_handler_functions::show_info(player, "Handler and timer lag statistics reset");
+		return chat_result::handled_display;
+	}
+	if (!args.empty()) {
+		return chat_result::show_syntax;
+	}
+
+	auto timer_lag = vana::timer::thread::get_instance().get_lag_metrics();
+	auto &maps = server.get_map_factory();
+	chat_handler_functions::show_info(player, [&](game_chat_stream &message) {
+		message << "Players: " << server.get_player_data_provider().get_player_count()
+			<< " | Maps: " << maps.get_active_count() << " active, " << maps.get_loaded_count() << " loaded";
+	});
+	chat_handler_functions::show_info(player, [&](game_chat_stream &message) {
+		message << "Timer lag: " << duration_cast<microseconds>(timer_lag.get_average_lag()).count() << "us average, "
+			<< duration_cast<microseconds>(timer_lag.max_lag).count() << "us max over " << timer_lag.timers_run << " runs, "
+			<< timer_lag.timers_pending << " pending";
+	});
+	chat_handler_functions::show_info(player, [&](game_chat_stream &message) {
+		message << "Database queue: " << server.get_database_executor().get_pending_count()
+			<< " | Write-behind queue: " << server.get_write_behind().get_pending_count();
+	});
+
+	struct handler_cost {
+		packet_header opcode;
+		uint64_t count;
+		microseconds mean;
+		microseconds total;
+	};
+
+	vector<handler_cost> costs;
+	server.get_handler_stats().for_each([&](packet_header opcode, const vana::util::opcode_stats::entry &entry) {
+		uint64_t count = entry.handler_time.get_count();
+		microseconds mean = entry.handler_time.get_mean();
+		costs.push_back(handler_cost{opcode, count, mean, mean * count});
+	});
+
+	size_t shown = std::min<size_t>(costs.size(), 5);
+	std::partial_sort(std::begin(costs), std::begin(costs) + shown, std::end(costs), [](const handler_cost &a, const handler_cost &b) {
+		return a.total > b.total;
+	});
+
+	for (size_t i = 0; i < shown; i++) {
+		const auto &cost = costs[i];
+		chat_handler_functions::show_info(player, [&](game_chat_stream &message) {
+			message << "Opcode 0x" << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << cost.opcode << std::dec
+				<< ": " << cost.count << " requests, " << cost.mean.count() << "us mean, "
+				<< duration_cast<milliseconds>(cost.total).count() << "ms total";
+		});
+	}
+	return chat_result::handled_display;
+}
+
 auto management_functions::header(ref_ptr<player> player, const game_chat &args) -> chat_result {
 	channel_server::get_instance().send_world(packets::interserver::config::scrolling_header(args));
 	return chat_result::handled_display;
@@ -29,6 +29,7 @@ namespace vana {
 			auto follow(ref_ptr<player> player, const game_chat &args) -> chat_result;
 			auto change_channel(ref_ptr<player> player, const game_chat &args) -> chat_result;
 			auto lag(ref_ptr<player> player, const game_chat &args) -> chat_result;
+			auto stats(ref_ptr<player> player, const game_chat &args) -> chat_result;
 			auto header(ref_ptr<player> player, const game_chat &args) -> chat_result;
 			auto shutdown(ref_ptr<player> player, const game_chat &args) -> chat_result;
 			auto kick(ref_ptr<player> player, const game_chat &args) -> chat_result;
@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/data/provider/npc.hpp"
 #include "common/packet_wrapper.hpp"
 #include "common/session.hpp"
+#include "common/shared_packet.hpp"
 #include "common/split_packet_builder.hpp"
 #include "common/timer/timer.hpp"
 #include "common/util/misc.hpp"
@@ -44,9 +45,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/party.hpp"
 #include "channel_server/player.hpp"
 #include "channel_server/player_packet.hpp"
+#include "channel_server/players_packet.hpp"
 #include "channel_server/reactor_packet.hpp"
 #include "channel_server/reactor.hpp"
 #include "channel_server/summon_handler.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <ctime>
 #include <functional>
 #include <initializer_list>
@@ -60,13 +64,22 @@ namespace channel_server {
 // TODO FIXME msvc
 // Remove this crap once MSVC supports static initializers
 int32_t map::s_map_unload_time = 0;
+int32_t map::s_interest_player_threshold = 0;
+game_coord map::s_interest_view_range = 0;
+milliseconds map::s_movement_coalesce_interval = milliseconds{0};
 
-map::map(ref_ptr<const data::type::map_info> info, game_map_id id) :
+map::map(ref_ptr<const data::type::map_info> info, game_map_id id, map_worker *worker) :
 	m_info{info},
+	m_footholds{info->link_info->footholds},
 	m_id{id},
+	m_worker{worker},
 	m_object_ids{1000},
 	m_music{info->default_music}
 {
+	if (m_worker != nullptr) {
+		get_timers()->set_executor([worker](function<void()> work) { worker->post(work); });
+	}
+
 	point right_bottom = info->dimensions.right_bottom();
 	double map_height = std::max<double>(right_bottom.y - 450, 600);
 	double map_width = std::max<double>(right_bottom.x, 800);
@@ -78,7 +91,11 @@ map::map(ref_ptr<const data::type::map_info> info, game_map_id id) :
 		m_real_dimensions = info->dimensions;
 	}
 
-	for (const auto &foothold : info->link_info->footholds) add_foothold(foothold);
+	if (m_infer_size_from_footholds) {
+		for (const auto &foothold : m_footholds) {
+			m_real_dimensions = m_real_dimensions.combine(foothold.line.make_rect());
+		}
+	}
 	for (const auto &mob : info->link_info->mobs) add_mob_spawn(mob);
 	for (const auto &npc : info->link_info->npcs) add_npc(npc);
 	for (const auto &portal : info->link_info->portals) add_portal(portal);
@@ -91,6 +108,15 @@ map::map(ref_ptr<const data::type::map_info> info, game_map_id id) :
 		[this](const time_point &now) { this->map_tick(now); },
 		vana::timer::id{vana::timer::type::map_timer, m_info->id},
 		get_timers(), seconds{0}, seconds{1});
+
+	// The interval is picked up when the map loads, a changed setting applies to maps loaded afterwards
+	m_coalesce_movement = s_movement_coalesce_interval.count() > 0;
+	if (m_coalesce_movement) {
+		vana::timer::timer::create(
+			[this](const time_point &now) { this->flush_movement(); },
+			vana::timer::id{vana::timer::type::movement_timer, m_info->id},
+			get_timers(), s_movement_coalesce_interval, s_movement_coalesce_interval);
+	}
 }
 
 // Map info
@@ -123,13 +149,6 @@ auto map::make_reactor_id() -> game_map_object {
 }
 
 // Data initialization
-auto map::add_foothold(const data::type::foothold_info &foothold) -> void {
-	m_footholds.push_back(foothold);
-	if (m_infer_size_from_footholds) {
-		m_real_dimensions = m_real_dimensions.combine(foothold.line.make_rect());
-	}
-}
-
 auto map::add_seat(const data::type::seat_info &seat) -> void {
 	map_seat record;
 	record.info = seat;
@@ -180,6 +199,10 @@ auto map::add_time_mob(data::type::time_mob_info info) -> void {
 // Players
 auto map::add_player(ref_ptr<player> player) -> void {
 	m_players.push_back(player);
+	player->set_map_worker(m_worker);
+	if (m_interest_cell_size > 0) {
+		update_interest_cell(player.get());
+	}
 	if (m_info->force_map_equip) {
 		player->send(packets::map::force_map_equip());
 	}
@@ -242,6 +265,15 @@ auto map::set_map_unload_time(seconds new_time) -> void {
 	s_map_unload_time = static_cast<int32_t>(new_time.count());
 }
 
+auto map::set_area_of_interest(int32_t player_threshold, game_coord view_range) -> void {
+	s_interest_player_threshold = player_threshold;
+	s_interest_view_range = view_range;
+}
+
+auto map::set_movement_coalesce_interval(milliseconds interval) -> void {
+	s_movement_coalesce_interval = interval;
+}
+
 auto map::get_num_players() const -> size_t {
 	return m_players.size();
 }
@@ -268,6 +300,14 @@ auto map::remove_player(ref_ptr<player> player) -> void {
 			break;
 		}
 	}
+	player->set_map_worker(nullptr);
+	if (m_coalesce_movement) {
+		owned_lock<mutex> l{m_movement_mutex};
+		m_pending_player_movement.erase(player_id);
+	}
+	if (m_interest_cell_size > 0) {
+		remove_interest_cell(player.get());
+	}
 
 	player->get_active_buffs()->reset_homing_beacon_mob();
 
@@ -390,8 +430,8 @@ auto map::find_floor(const point &pos, point &floor_pos, game_coord start_height
 	bool any_found = false;
 	data::type::foothold_info const * found_foothold = nullptr;
 
-	for (const auto &foothold : m_footholds) {
-		const line &line = foothold.line;
+	for (const auto &foothold : m_footholds.get_footholds_at(x)) {
+		const line &line = foothold->line;
 
 		if (line.within_range_x(x)) {
 			if (search_area.area() != 0) {
@@ -406,7 +446,7 @@ auto map::find_floor(const point &pos, point &floor_pos, game_coord start_height
 				if (value <= closest_value && value >= y) {
 					closest_value = value;
 					any_found = true;
-					found_foothold = &foothold;
+					found_foothold = foothold;
 				}
 			}
 		}
@@ -440,53 +480,56 @@ auto map::find_random_floor_pos() -> point {
 }
 
 auto map::find_random_floor_pos(const rect &area) -> point {
-	vector<const data::type::foothold_info *> valid_footholds;
 	rect inside_map_area = area.intersection(m_real_dimensions);
-	for (const auto &foothold : m_footholds) {
+	point left_top = inside_map_area.left_top();
+	point right_bottom = inside_map_area.right_bottom();
+
+	// Each usable foothold is weighted by how much floor it has inside the area
+	// Picking a spot on that floor directly means we never have to retry random points that land on nothing
+	struct floor_span {
+		const data::type::foothold_info *foothold;
+		game_coord left;
+		game_coord right;
+	};
+	vector<floor_span> spans;
+	int32_t total_width = 0;
+	for (const auto &foothold : m_footholds.get_footholds_in(left_top.x, right_bottom.x)) {
+		const line &line = foothold->line;
 		// Vertical lines can't be "floors"
-		if (!foothold.line.is_vertical() && inside_map_area.contains_any_part_of_line(foothold.line)) {
-			valid_footholds.push_back(&foothold);
+		if (line.is_vertical() || !inside_map_area.contains_any_part_of_line(line)) {
+			continue;
 		}
-	}
 
-	point left_top = inside_map_area.left_top();
-	point right_bottom = inside_map_area.right_bottom();
-	auto x_generate = [&right_bottom, &left_top]() -> game_coord { return vana::util::randomizer::rand<game_coord>(right_bottom.x, left_top.x); };
-	auto y_generate = [&right_bottom, &left_top]() -> game_coord { return vana::util::randomizer::rand<game_coord>(right_bottom.y, left_top.y); };
+		// within_range_x excludes the leftmost point of a line
+		game_coord left = std::max<game_coord>(std::min(line.pt1.x, line.pt2.x) + 1, left_top.x);
+		game_coord right = std::min<game_coord>(std::max(line.pt1.x, line.pt2.x), right_bottom.x);
+		if (left > right) {
+			continue;
+		}
+
+		spans.push_back(floor_span{foothold, left, right});
+		total_width += right - left + 1;
+	}
 
 	point ret;
-	if (valid_footholds.size() == 0) {
+	if (spans.size() == 0) {
 		// There's no saving this, just use a random point in the area
-		ret.x = x_generate();
-		ret.y = y_generate();
+		ret.x = vana::util::randomizer::rand<game_coord>(right_bottom.x, left_top.x);
+		ret.y = vana::util::randomizer::rand<game_coord>(right_bottom.y, left_top.y);
 		return ret;
 	}
 
-	do {
-		game_coord x = x_generate();
-		game_coord y = y_generate();
-		bool any_found = false;
-		game_coord closest_value = std::numeric_limits<game_coord>::max();
-
-		for (const auto &foothold : valid_footholds) {
-			if (foothold->line.within_range_x(x)) {
-				optional<game_coord> y_interpolation = foothold->line.interpolate_for_y(x);
-				if (y_interpolation.is_initialized()) {
-					auto value = y_interpolation.get();
-					if (value <= closest_value && value >= y) {
-						closest_value = value;
-						any_found = true;
-					}
-				}
-			}
-		}
-
-		if (any_found) {
-			ret.x = x;
-			ret.y = closest_value;
+	int32_t offset = vana::util::randomizer::rand<int32_t>(total_width - 1);
+	for (const auto &span : spans) {
+		int32_t width = span.right - span.left + 1;
+		if (offset < width) {
+			const line &line = span.foothold->line;
+			ret.x = static_cast<game_coord>(span.left + offset);
+			ret.y = line.interpolate_for_y(ret.x).get(line.center().y);
 			break;
 		}
-	} while (true);
+		offset -= width;
+	}
 
 	return ret;
 }
@@ -495,9 +538,9 @@ auto map::get_foothold_at_position(const point &pos) -> game_foothold_id {
 	// TODO FIXME
 	// Consider refactoring
 	game_foothold_id foothold = 0;
-	for (const auto &cur : m_footholds) {
-		if (cur.line.contains(pos)) {
-			foothold = cur.id;
+	for (const auto &cur : m_footholds.get_footholds_at(pos.x)) {
+		if (cur->line.contains(pos)) {
+			foothold = cur->id;
 			break;
 		}
 	}
@@ -505,28 +548,19 @@ auto map::get_foothold_at_position(const point &pos) -> game_foothold_id {
 }
 
 auto map::is_valid_foothold(game_foothold_id id) -> bool {
-	for (const auto &cur : m_footholds) {
-		if (cur.id == id) {
-			return true;
-		}
-	}
-	return false;
+	return m_footholds.find(id) != nullptr;
 }
 
 auto map::is_vertical_foothold(game_foothold_id id) -> bool {
-	for (const auto &cur : m_footholds) {
-		if (cur.id == id) {
-			return cur.line.is_vertical();
-		}
+	if (auto foothold = m_footholds.find(id)) {
+		return foothold->line.is_vertical();
 	}
 	return false;
 }
 
 auto map::get_position_at_foothold(game_foothold_id id) -> point {
-	for (const auto &cur : m_footholds) {
-		if (cur.id == id) {
-			return cur.line.center();
-		}
+	if (auto foothold = m_footholds.find(id)) {
+		return foothold->line.center();
 	}
 	return point{-1, -1};
 }
@@ -1206,7 +1240,10 @@ auto map::map_tick(const time_point &now) -> void {
 			else {
 				m_empty_map_ticks++;
 				if (m_empty_map_ticks > s_map_unload_time) {
-					maps::unload_map(get_id());
+					game_map_id map_id = get_id();
+					channel_server::get_instance().get_map_workers().run_global([map_id] {
+						maps::unload_map(map_id);
+					});
 					return;
 				}
 			}
@@ -1215,21 +1252,39 @@ auto map::map_tick(const time_point &now) -> void {
 
 	check_spawn(now);
 	clear_drops(now);
-	check_mists();
 
-	if (vana::util::time::get_second() % 3 == 0) {
-		check_shadow_web();
+	if (m_interest_cell_size > 0) {
+		// Cells otherwise only follow the players that broadcast, this catches everyone else within a tick
+		for (const auto &map_player : m_players) {
+			update_interest_cell(map_player.get());
+		}
+	}
+
+	// Mists, webs and map damage can kill mobs and players, which reaches into parties, quests and instances
+	// Each of these has to leave the map's worker, so only go when there's something to do
+	bool check_webs = vana::util::time::get_second() % 3 == 0 && m_webbed.size() > 0;
+	bool damage_players = m_info->damage_per_second > 0 && m_players_without_protect_item.size() > 0;
+	if (m_poison_mists.size() == 0 && !check_webs && !damage_players) {
+		return;
 	}
-	game_damage dps = m_info->damage_per_second;
-	if (dps > 0 && m_players_without_protect_item.size() > 0) {
-		for (const auto &kvp : m_players_without_protect_item) {
-			if (auto player = kvp.second) {
-				if (!player->get_stats()->is_dead() && !player->has_gm_benefits()) {
-					player->get_stats()->damage_hp(dps);
+
+	channel_server::get_instance().get_map_workers().run_global([this, check_webs, damage_players] {
+		check_mists();
+
+		if (check_webs) {
+			check_shadow_web();
+		}
+		if (damage_players) {
+			game_damage dps = m_info->damage_per_second;
+			for (const auto &kvp : m_players_without_protect_item) {
+				if (auto player = kvp.second) {
+					if (!player->get_stats()->is_dead() && !player->has_gm_benefits()) {
+						player->get_stats()->damage_hp(dps);
+					}
 				}
 			}
 		}
-	}
+	});
 }
 
 auto map::check_time_mob_spawn(bool first_load) -> void {
@@ -1357,29 +1412,278 @@ auto map::show_objects(ref_ptr<player> player) -> void {
 }
 
 auto map::send(const packet_builder &builder, ref_ptr<player> sender) -> void {
+	flush_player_movement(sender.get());
+	broadcast(builder, sender);
+}
+
+auto map::broadcast(const packet_builder &builder, ref_ptr<player> sender) -> void {
+	// Serialize the payload once, every session encrypts its own copy when it writes
+	ref_ptr<const shared_packet> packet;
 	for (const auto &map_player : m_players) {
 		if (map_player != sender) {
-			map_player->send(builder);
+			if (packet == nullptr) {
+				packet = make_ref_ptr<shared_packet>(builder);
+			}
+			map_player->send(packet);
 		}
 	}
 }
 
 auto map::send(const split_packet_builder &builder, ref_ptr<player> sender) -> void {
+	flush_player_movement(sender.get());
 	if (builder.player.get_size() > 0) {
 		sender->send(builder.player);
 	}
 
-	if (builder.map.get_size() > 0) {
+	if (builder.map.get_size() > 0 && !sender->is_using_gm_hide()) {
+		ref_ptr<const shared_packet> packet;
 		for (const auto &map_player : m_players) {
 			if (map_player != sender) {
-				if (!sender->is_using_gm_hide()) {
-					map_player->send(builder.map);
+				if (packet == nullptr) {
+					packet = make_ref_ptr<shared_packet>(builder.map);
+				}
+				map_player->send(packet);
+			}
+		}
+	}
+}
+
+auto map::send_nearby(const packet_builder &builder, ref_ptr<player> source, bool exclude_source) -> void {
+	flush_player_movement(source.get());
+	broadcast_nearby(builder, source, exclude_source);
+}
+
+auto map::broadcast_nearby(const packet_builder &builder, ref_ptr<player> source, bool exclude_source) -> void {
+	if (s_interest_player_threshold <= 0 || s_interest_view_range <= 0) {
+		broadcast(builder, exclude_source ? source : nullptr);
+		return;
+	}
+
+	if (m_interest_cell_size != s_interest_view_range) {
+		build_interest_grid();
+	}
+	else {
+		// Only the source's position matters here and every player that moves passes through this
+		update_interest_cell(source.get());
+	}
+
+	if (static_cast<int32_t>(m_players.size()) < s_interest_player_threshold) {
+		broadcast(builder, exclude_source ? source : nullptr);
+		return;
+	}
+
+	point pos = source->get_pos();
+	int32_t range = m_interest_cell_size;
+	int32_t first_column = get_interest_column(pos.x - range);
+	int32_t last_column = get_interest_column(pos.x + range);
+	int32_t first_row = get_interest_row(pos.y - range);
+	int32_t last_row = get_interest_row(pos.y + range);
+
+	ref_ptr<const shared_packet> packet;
+	for (int32_t row = first_row; row <= last_row; ++row) {
+		for (int32_t column = first_column; column <= last_column; ++column) {
+			for (player *map_player : m_interest_cells[row * m_interest_columns + column]) {
+				if (exclude_source && map_player == source.get()) continue;
+
+				point other = map_player->get_pos();
+				if (std::abs(other.x - pos.x) > range || std::abs(other.y - pos.y) > range) continue;
+
+				if (packet == nullptr) {
+					packet = make_ref_ptr<shared_packet>(builder);
 				}
+				map_player->send(packet);
 			}
 		}
 	}
 }
 
+auto map::send_nearby(const split_packet_builder &builder, ref_ptr<player> sender) -> void {
+	flush_player_movement(sender.get());
+	broadcast_nearby(builder, sender);
+}
+
+auto map::broadcast_nearby(const split_packet_builder &builder, ref_ptr<player> sender) -> void {
+	if (builder.player.get_size() > 0) {
+		sender->send(builder.player);
+	}
+
+	if (builder.map.get_size() > 0 && !sender->is_using_gm_hide()) {
+		broadcast_nearby(builder.map, sender, true);
+	}
+}
+
+auto map::send_player_movement(ref_ptr<player> player, const move_path &path) -> void {
+	if (m_interest_cell_size > 0) {
+		// The broadcast may be held, but other players' broadcasts need to find this one at its new position now
+		update_interest_cell(player.get());
+	}
+
+	if (!m_coalesce_movement) {
+		broadcast_nearby(packets::players::show_moving(player->get_id(), path), player);
+		return;
+	}
+
+	owned_lock<mutex> l{m_movement_mutex};
+	auto &pending = m_pending_player_movement[player->get_id()];
+	if (pending.path == nullptr) {
+		pending.mover = player;
+		pending.path = make_owned_ptr<move_path>();
+	}
+	if (pending.path->can_append(path)) {
+		pending.path->append(path);
+		return;
+	}
+
+	// Too many elements for one packet, send what is held and start over from this path
+	auto held = std::move(pending.path);
+	pending.path = make_owned_ptr<move_path>();
+	pending.path->append(path);
+	l.unlock();
+
+	broadcast_nearby(packets::players::show_moving(player->get_id(), *held), player);
+}
+
+auto map::send_mob_movement(ref_ptr<mob> mob, ref_ptr<player> controller, bool skill_possible, int8_t raw_action, game_mob_skill_id skill, game_mob_skill_level level, int16_t option, const move_path &path, bool immediate) -> void {
+	game_map_object map_mob_id = mob->get_map_mob_id();
+	if (!m_coalesce_movement) {
+		broadcast(packets::mobs::move_mob(map_mob_id, skill_possible, raw_action, skill, level, option, path), controller);
+		return;
+	}
+
+	owned_lock<mutex> l{m_movement_mutex};
+	pending_mob_movement held;
+	auto kvp = m_pending_mob_movement.find(map_mob_id);
+	if (kvp != std::end(m_pending_mob_movement)) {
+		auto &pending = kvp->second;
+		if (!immediate && pending.controller == controller && pending.path->can_append(path)) {
+			pending.skill_possible = skill_possible;
+			pending.raw_action = raw_action;
+			pending.skill = skill;
+			pending.level = level;
+			pending.option = option;
+			pending.path->append(path);
+			return;
+		}
+
+		// Whatever is held has to reach the map before this movement does
+		held = std::move(pending);
+		m_pending_mob_movement.erase(kvp);
+	}
+
+	if (!immediate) {
+		auto &pending = m_pending_mob_movement[map_mob_id];
+		pending.controller = controller;
+		pending.skill_possible = skill_possible;
+		pending.raw_action = raw_action;
+		pending.skill = skill;
+		pending.level = level;
+		pending.option = option;
+		pending.path = make_owned_ptr<move_path>();
+		pending.path->append(path);
+	}
+	l.unlock();
+
+	if (held.path != nullptr) {
+		broadcast(packets::mobs::move_mob(map_mob_id, held.skill_possible, held.raw_action, held.skill, held.level, held.option, *held.path), held.controller);
+	}
+	if (immediate) {
+		broadcast(packets::mobs::move_mob(map_mob_id, skill_possible, raw_action, skill, level, option, path), controller);
+	}
+}
+
+auto map::flush_movement() -> void {
+	hash_map<game_player_id, pending_player_movement> players;
+	hash_map<game_map_object, pending_mob_movement> mobs;
+	{
+		owned_lock<mutex> l{m_movement_mutex};
+		if (m_pending_player_movement.empty() && m_pending_mob_movement.empty()) {
+			return;
+		}
+		players.swap(m_pending_player_movement);
+		mobs.swap(m_pending_mob_movement);
+	}
+
+	for (const auto &kvp : players) {
+		const auto &pending = kvp.second;
+		if (pending.mover->get_map_id() != get_id()) continue;
+		broadcast_nearby(packets::players::show_moving(kvp.first, *pending.path), pending.mover);
+	}
+
+	for (const auto &kvp : mobs) {
+		const auto &pending = kvp.second;
+		if (get_mob(kvp.first) == nullptr) continue;
+		broadcast(packets::mobs::move_mob(kvp.first, pending.skill_possible, pending.raw_action, pending.skill, pending.level, pending.option, *pending.path), pending.controller);
+	}
+}
+
+auto map::flush_player_movement(player *sender) -> void {
+	if (!m_coalesce_movement || sender == nullptr) {
+		return;
+	}
+
+	owned_lock<mutex> l{m_movement_mutex};
+	auto kvp = m_pending_player_movement.find(sender->get_id());
+	if (kvp == std::end(m_pending_player_movement)) {
+		return;
+	}
+	auto pending = std::move(kvp->second);
+	m_pending_player_movement.erase(kvp);
+	l.unlock();
+
+	broadcast_nearby(packets::players::show_moving(sender->get_id(), *pending.path), pending.mover);
+}
+
+auto map::build_interest_grid() -> void {
+	m_interest_cell_size = s_interest_view_range;
+	m_interest_origin = m_real_dimensions.normalize().left_top();
+	m_interest_columns = m_real_dimensions.width() / m_interest_cell_size + 1;
+	m_interest_rows = m_real_dimensions.height() / m_interest_cell_size + 1;
+	m_interest_cells.clear();
+	m_interest_cells.resize(m_interest_columns * m_interest_rows);
+	m_interest_player_cells.clear();
+
+	for (const auto &map_player : m_players) {
+		update_interest_cell(map_player.get());
+	}
+}
+
+auto map::get_interest_column(int32_t x) const -> int32_t {
+	int32_t column = (x - m_interest_origin.x) / m_interest_cell_size;
+	return ext::constrain_range(column, 0, m_interest_columns - 1);
+}
+
+auto map::get_interest_row(int32_t y) const -> int32_t {
+	int32_t row = (y - m_interest_origin.y) / m_interest_cell_size;
+	return ext::constrain_range(row, 0, m_interest_rows - 1);
+}
+
+auto map::update_interest_cell(player *player) -> void {
+	point pos = player->get_pos();
+	size_t cell = static_cast<size_t>(get_interest_row(pos.y) * m_interest_columns + get_interest_column(pos.x));
+
+	auto kvp = m_interest_player_cells.find(player->get_id());
+	if (kvp != std::end(m_interest_player_cells)) {
+		if (kvp->second == cell) return;
+		remove_interest_cell(player);
+	}
+
+	m_interest_player_cells[player->get_id()] = cell;
+	m_interest_cells[cell].push_back(player);
+}
+
+auto map::remove_interest_cell(player *player) -> void {
+	auto kvp = m_interest_player_cells.find(player->get_id());
+	if (kvp == std::end(m_interest_player_cells)) return;
+
+	auto &cell = m_interest_cells[kvp->second];
+	auto iter = std::find(std::begin(cell), std::end(cell), player);
+	if (iter != std::end(cell)) {
+		*iter = cell.back();
+		cell.pop_back();
+	}
+	m_interest_player_cells.erase(kvp);
+}
+
 auto map::create_weather(ref_ptr<player> player, bool admin_weather, int32_t time, int32_t item_id, const string &message) -> bool {
 	vana::timer::id timer_id{vana::timer::type::weather_timer}; // Just to check if there's already a weather item running and adding a new one
 	if (get_timers()->is_timer_running(timer_id)) {
@@ -32,6 +32,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/util/id_pool.hpp"
 #include "channel_server/map_factory.hpp"
 #include "channel_server/mob.hpp"
+#include "channel_server/move_path.hpp"
 #include <ctime>
 #include <functional>
 #include <map>
@@ -48,6 +49,7 @@ namespace vana {
 	namespace channel_server {
 		class drop;
 		class instance;
+		class map_worker;
 		class mist;
 		class mob;
 		class player;
@@ -90,10 +92,13 @@ namespace vana {
 			NONCOPYABLE(map);
 			NO_DEFAULT_CONSTRUCTOR(map);
 		public:
-			map(ref_ptr<const data::type::map_info> info, game_map_id id);
+			// Timers for the map run on its worker when it has one
+			map(ref_ptr<const data::type::map_info> info, game_map_id id, map_worker *worker);
 
 			auto boat_dock(bool is_docked) -> void;
 			static auto set_map_unload_time(seconds new_time) -> void;
+			static auto set_area_of_interest(int32_t player_threshold, game_coord view_range) -> void;
+			static auto set_movement_coalesce_interval(milliseconds interval) -> void;
 
 			// Map info
 			static auto make_npc_id(game_map_object received_id) -> size_t;
@@ -109,6 +114,7 @@ namespace vana {
 			auto get_forced_return() const -> game_map_id { return m_info->forced_return; }
 			auto get_return_map() const -> game_map_id { return m_info->return_map; }
 			auto get_id() const -> game_map_id { return m_id; }
+			auto get_worker() const -> map_worker * { return m_worker; }
 			auto get_dimensions() const -> rect { return m_real_dimensions; }
 			auto get_music() const -> string { return m_music; }
 
@@ -197,6 +203,15 @@ namespace vana {
 			// Packet stuff
 			auto send(const packet_builder &builder, ref_ptr<player> sender = nullptr) -> void;
 			auto send(const split_packet_builder &builder, ref_ptr<player> sender) -> void;
+			// For packets that only matter on screen (movement, attacks, expressions)
+			// Once the map is crowded enough, only players within view range of the source receive them
+			auto send_nearby(const packet_builder &builder, ref_ptr<player> source, bool exclude_source) -> void;
+			auto send_nearby(const split_packet_builder &builder, ref_ptr<player> sender) -> void;
+			// Movement is held and merged per entity until the next flush when the map coalesces it
+			// Anything else the mover sends through the map flushes their held movement first so it arrives in order
+			auto send_player_movement(ref_ptr<player> player, const move_path &path) -> void;
+			auto flush_player_movement(player *sender) -> void;
+			auto send_mob_movement(ref_ptr<mob> mob, ref_ptr<player> controller, bool skill_possible, int8_t raw_action, game_mob_skill_id skill, game_mob_skill_level level, int16_t option, const move_path &path, bool immediate) -> void;
 
 			// Instance
 			auto set_instance(instance *inst) -> void { m_instance = inst; }
@@ -211,8 +226,25 @@ namespace vana {
 			// TODO FIXME msvc
 			// Remove this crap comment once MSVC supports static initializers
 			static int32_t s_map_unload_time/* = 0*/;
+			static int32_t s_interest_player_threshold/* = 0*/;
+			static game_coord s_interest_view_range/* = 0*/;
+			static milliseconds s_movement_coalesce_interval/* = milliseconds{0}*/;
+
+			struct pending_player_movement {
+				ref_ptr<player> mover;
+				owned_ptr<move_path> path;
+			};
+
+			struct pending_mob_movement {
+				ref_ptr<player> controller;
+				bool skill_possible = false;
+				int8_t raw_action = 0;
+				game_mob_skill_id skill = 0;
+				game_mob_skill_level level = 0;
+				int16_t option = 0;
+				owned_ptr<move_path> path;
+			};
 
-			auto add_foothold(const data::type::foothold_info &foothold) -> void;
 			auto add_seat(const data::type::seat_info &seat) -> void;
 			auto add_portal(const data::type::portal_info &portal) -> void;
 			auto add_mob_spawn(const data::type::mob_spawn_info &spawn) -> void;
@@ -235,29 +267,46 @@ namespace vana {
 			auto find_random_floor_pos() -> point;
 			auto find_random_floor_pos(const rect &area) -> point;
 			auto buff_players(game_item_id buff_id) -> void;
+			auto build_interest_grid() -> void;
+			auto get_interest_column(int32_t x) const -> int32_t;
+			auto get_interest_row(int32_t y) const -> int32_t;
+			auto update_interest_cell(player *player) -> void;
+			auto remove_interest_cell(player *player) -> void;
+			auto flush_movement() -> void;
+			// send/send_nearby without flushing the sender's held movement first
+			auto broadcast(const packet_builder &builder, ref_ptr<player> sender) -> void;
+			auto broadcast_nearby(const packet_builder &builder, ref_ptr<player> source, bool exclude_source) -> void;
+			auto broadcast_nearby(const split_packet_builder &builder, ref_ptr<player> sender) -> void;
 
 			// Longer-lived data
 			bool m_ship = false;
 			bool m_run_unloader = true;
 			bool m_infer_size_from_footholds = false;
+			bool m_coalesce_movement = false;
 			game_map_id m_id = 0;
+			map_worker *m_worker = nullptr;
 			game_map_object m_time_mob = 0;
 			game_mob_id m_spawn_mobs = -1;
 			int32_t m_empty_map_ticks = 0;
 			int32_t m_min_spawn_count = 0;
 			int32_t m_max_spawn_count = 0;
 			int32_t m_max_mob_spawn_time = -1;
+			int32_t m_interest_cell_size = 0;
+			int32_t m_interest_columns = 0;
+			int32_t m_interest_rows = 0;
 			instance *m_instance = nullptr;
 			seconds m_timer = seconds{0};
 			time_point m_timer_start = time_point{seconds{0}};
 			time_point m_last_spawn = time_point{seconds{0}};
 			string m_music;
 			rect m_real_dimensions;
+			point m_interest_origin;
 			vana::util::id_pool<game_map_object> m_object_ids;
 			vana::util::id_pool<game_mist_id> m_mist_ids;
 			recursive_mutex m_drops_mutex;
+			mutex m_movement_mutex;
 			ref_ptr<const data::type::map_info> m_info;
-			vector<data::type::foothold_info> m_footholds;
+			const data::type::foothold_index &m_footholds;
 			vector<data::type::reactor_spawn_info> m_reactor_spawns;
 			vector<data::type::npc_spawn_info> m_npc_spawns;
 			vector<data::type::mob_spawn_info> m_mob_spawns;
@@ -278,6 +327,11 @@ namespace vana {
 			hash_map<game_map_object, drop *> m_drops;
 			hash_map<game_mist_id, mist *> m_poison_mists;
 			hash_map<game_mist_id, mist *> m_mists;
+			hash_map<game_player_id, pending_player_movement> m_pending_player_movement;
+			hash_map<game_map_object, pending_mob_movement> m_pending_mob_movement;
+			// Uniform grid over m_real_dimensions with cells as wide as the view range, only built once a map gets crowded
+			vector<vector<player *>> m_interest_cells;
+			hash_map<game_player_id, size_t> m_interest_player_cells;
 		};
 	}
 }
\ No newline at end of file
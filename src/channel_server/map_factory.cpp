@@ -35,8 +35,9 @@ auto map_factory::get_map(game_map_id map_id) -> map * {
 		}
 	}
 
-	auto info = channel_server::get_instance().get_map_data_provider().get_map(map_id);
-	map *map = new vana::channel_server::map{info, map_id};
+	auto &channel = channel_server::get_instance();
+	auto info = channel.get_map_data_provider().get_map(map_id);
+	map *map = new vana::channel_server::map{info, map_id, channel.get_map_workers().assign()};
 	m_maps.push_back(map);
 	return map;
 }
@@ -50,6 +51,7 @@ auto map_factory::unload_map(game_map_id map_id) -> void {
 			// Reasons for this might be: Starting an instance, adding a player
 			// Once the code here advances, we have to ensure that we're doing the right thing, otherwise there could be a serious problem
 			if (map->get_num_players() == 0 && map->get_instance() == nullptr) {
+				channel_server::get_instance().get_map_workers().release(map->get_worker());
 				delete map;
 				m_maps.erase(std::begin(m_maps) + i);
 			}
@@ -58,5 +60,21 @@ auto map_factory::unload_map(game_map_id map_id) -> void {
 	}
 }
 
+auto map_factory::get_loaded_count() -> size_t {
+	owned_lock<mutex> l{m_load_mutex};
+	return m_maps.size();
+}
+
+auto map_factory::get_active_count() -> size_t {
+	owned_lock<mutex> l{m_load_mutex};
+	size_t active = 0;
+	for (const auto &map : m_maps) {
+		if (map->get_num_players() > 0) {
+			active++;
+		}
+	}
+	return active;
+}
+
 }
 }
\ No newline at end of file
@@ -35,6 +35,9 @@ namespace vana {
 		public:
 			auto get_map(game_map_id map_id) -> map *;
 			auto unload_map(game_map_id map_id) -> void;
+			auto get_loaded_count() -> size_t;
+			// Loaded maps that currently have players in them
+			auto get_active_count() -> size_t;
 		private:
 			mutex m_load_mutex;
 			vector<map *> m_maps;
@@ -0,0 +1,108 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "map_workers.hpp"
+#include "common/connection_manager.hpp"
+#include "common/util/shared_gate.hpp"
+#include "common/util/thread_pool.hpp"
+#include <algorithm>
+
+namespace vana {
+namespace channel_server {
+
+thread_local map_worker *map_workers::s_current = nullptr;
+
+map_worker::map_worker(map_workers &pool) :
+	m_pool{pool}
+{
+	m_work = make_owned_ptr<asio::io_service::work>(m_io_service);
+	m_thread = vana::util::thread_pool::lease(
+		[this] {
+			map_workers::s_current = this;
+			m_io_service.run();
+		},
+		[this] { m_work.reset(); });
+}
+
+map_worker::~map_worker() {
+	m_work.reset();
+}
+
+auto map_worker::post(function<void()> work) -> void {
+	m_io_service.post([this, work] {
+		vana::util::shared_gate::shared_lock l{m_pool.m_manager.get_dispatch_gate()};
+		work();
+	});
+}
+
+map_workers::map_workers(connection_manager &manager) :
+	m_manager{manager}
+{
+}
+
+auto map_workers::start(uint16_t worker_count) -> void {
+	for (uint16_t i = 0; i < worker_count; ++i) {
+		m_workers.push_back(make_owned_ptr<map_worker>(*this));
+	}
+}
+
+auto map_workers::is_enabled() const -> bool {
+	return !m_workers.empty();
+}
+
+auto map_workers::assign() -> map_worker * {
+	if (m_workers.empty()) {
+		return nullptr;
+	}
+
+	owned_lock<mutex> l{m_assign_mutex};
+	auto least_loaded = std::min_element(std::begin(m_workers), std::end(m_workers), [](const owned_ptr<map_worker> &a, const owned_ptr<map_worker> &b) {
+		return a->m_map_count < b->m_map_count;
+	});
+
+	map_worker *worker = least_loaded->get();
+	worker->m_map_count++;
+	return worker;
+}
+
+auto map_workers::release(map_worker *worker) -> void {
+	if (worker == nullptr) {
+		return;
+	}
+
+	owned_lock<mutex> l{m_assign_mutex};
+	worker->m_map_count--;
+}
+
+auto map_workers::run_global(function<void()> work) -> void {
+	if (s_current == nullptr) {
+		work();
+		return;
+	}
+	post_global(work);
+}
+
+auto map_workers::post_global(function<void()> work) -> void {
+	m_manager.dispatch(work);
+}
+
+auto map_workers::get_current() -> map_worker * {
+	return s_current;
+}
+
+}
+}
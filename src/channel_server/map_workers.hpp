@@ -0,0 +1,81 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <asio.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace vana {
+	class connection_manager;
+
+	namespace channel_server {
+		class map_workers;
+
+		// One thread that owns a set of maps, everything it runs holds the dispatch gate shared
+		class map_worker {
+			NONCOPYABLE(map_worker);
+			NO_DEFAULT_CONSTRUCTOR(map_worker);
+		public:
+			map_worker(map_workers &pool);
+			~map_worker();
+
+			auto post(function<void()> work) -> void;
+		private:
+			friend class map_workers;
+
+			map_workers &m_pool;
+			asio::io_service m_io_service;
+			owned_ptr<asio::io_service::work> m_work;
+			ref_ptr<std::thread> m_thread;
+			size_t m_map_count = 0;
+		};
+
+		// Spreads loaded maps across worker threads so map-local work for different maps runs in parallel
+		// Anything that reaches beyond a single map (map changes, parties, instances, the world server) stays on the dispatch strand
+		class map_workers {
+			NONCOPYABLE(map_workers);
+			NO_DEFAULT_CONSTRUCTOR(map_workers);
+		public:
+			map_workers(connection_manager &manager);
+
+			// 0 workers leaves every map on the dispatch strand
+			auto start(uint16_t worker_count) -> void;
+			auto is_enabled() const -> bool;
+			// Picks the worker with the fewest maps, nullptr when disabled
+			auto assign() -> map_worker *;
+			auto release(map_worker *worker) -> void;
+			// Runs work that belongs to the channel rather than one map
+			// From a map worker it's queued on the dispatch strand, anywhere else it runs immediately
+			auto run_global(function<void()> work) -> void;
+			auto post_global(function<void()> work) -> void;
+
+			static auto get_current() -> map_worker *;
+		private:
+			friend class map_worker;
+
+			connection_manager &m_manager;
+			vector<owned_ptr<map_worker>> m_workers;
+			mutex m_assign_mutex;
+
+			static thread_local map_worker *s_current;
+		};
+	}
+}
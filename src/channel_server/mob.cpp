@@ -746,11 +746,13 @@ auto mob::use_anticipated_skill() -> result {
 				string message = banish_info->message;
 				const data::type::portal_info * const portal = maps::get_map(field)->query_portal_name(banish_info->portal);
 
-				auto func = [&message, &field, &portal](ref_ptr<player> player) {
+				auto func = [&channel, &message, &field, &portal](ref_ptr<player> player) {
 					if (!message.empty()) {
 						player->send(packets::player::show_message(message, packets::player::notice_types::blue));
 					}
-					player->set_map(field, portal);
+					channel.get_map_workers().run_global([player, field, portal] {
+						player->set_map(field, portal);
+					});
 				};
 				map->run_function_players(skill_area, skill_level_info->prop, skill_level_info->count, func);
 			}
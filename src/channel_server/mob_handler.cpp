@@ -160,7 +160,8 @@ auto mob_handler::monster_control(ref_ptr<player> player, packet_reader &reader)
 
 	player->send(packets::mobs::move_mob_response(mob_id, move_id, next_movement_could_be_skill, mob->get_mp(), next_cast_skill, next_cast_skill_level));
 	
-	player->send_map(packets::mobs::move_mob(mob_id, next_movement_could_be_skill, raw_activity, use_skill_id, use_skill_level, option, path), true);
+	// Attacks and skills go out right away, plain movement can wait to be merged
+	map->send_mob_movement(mob, player, next_movement_could_be_skill, raw_activity, use_skill_id, use_skill_level, option, path, is_attack || is_skill);
 }
 
 auto mob_handler::handle_mob_status(game_player_id player_id, ref_ptr<mob> mob, game_skill_id skill_id, game_skill_level level, game_item_id weapon, int8_t hits, game_damage damage) -> int32_t {
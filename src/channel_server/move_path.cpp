@@ -17,6 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include "move_path.hpp"
+#include <limits>
 
 namespace vana {
 namespace channel_server {
@@ -203,5 +204,20 @@ auto move_path::write_to_packet(packet_builder &builder) const -> void {
 	// Note: keypad and boundary values are not read on the client side.
 }
 
+auto move_path::append(const move_path &next) -> void {
+	if (this->m_elements.empty()) {
+		this->m_original_position = next.m_original_position;
+	}
+	this->m_elements.insert(std::end(this->m_elements), std::begin(next.m_elements), std::end(next.m_elements));
+	this->m_new_position = next.m_new_position;
+	this->m_new_stance = next.m_new_stance;
+	this->m_new_foothold = next.m_new_foothold;
+}
+
+auto move_path::can_append(const move_path &next) const -> bool {
+	// The element count goes out as a single byte
+	return this->m_elements.size() + next.m_elements.size() <= std::numeric_limits<uint8_t>::max();
+}
+
 }
 }
\ No newline at end of file
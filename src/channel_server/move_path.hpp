@@ -64,10 +64,14 @@ namespace vana {
 
 			auto read_from_packet(packet_reader &reader) -> void;
 			auto write_to_packet(packet_builder &builder) const -> void;
+			// Continues this path with the elements of a later one so both can be sent as one movement
+			auto append(const move_path &next) -> void;
+			auto can_append(const move_path &next) const -> bool;
 
 			auto get_new_position() const -> const point { return m_new_position; }
 			auto get_new_stance() const -> int8_t { return m_new_stance; }
 			auto get_new_foothold() const -> game_foothold_id { return m_new_foothold; }
+			auto get_element_count() const -> size_t { return m_elements.size(); }
 		private:
 			point m_original_position;
 			point m_new_position;
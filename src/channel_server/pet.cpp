@@ -46,14 +46,14 @@ pet::pet(player *player, item *item) :
 	item->set_pet_id(m_id);
 }
 
-pet::pet(player *player, item *item, const soci::row &row) :
+pet::pet(player *player, item *item, const player_snapshot::pet_row &row, int8_t inventory_slot) :
 	movable_life{0, point{}, 0},
 	m_player{player},
 	m_id{item->get_pet_id()},
 	m_item_id{item->get_id()},
 	m_item{item}
 {
-	initialize_pet(row);
+	initialize_pet(row, inventory_slot);
 	if (is_summoned()) {
 		if (m_index.is_initialized() && m_index.get() == 1) {
 			start_timer();
@@ -136,13 +136,13 @@ auto pet::has_quote_item() const -> bool {
 	return false;
 }
 
-auto pet::initialize_pet(const soci::row &row) -> void {
-	m_index = row.get<opt_int8_t>("index");
-	m_name = row.get<string>("pet_name");
-	m_level = row.get<int8_t>("level");
-	m_closeness = row.get<int16_t>("closeness");
-	m_fullness = row.get<int8_t>("fullness");
-	m_inventory_slot = row.get<int8_t>("slot");
+auto pet::initialize_pet(const player_snapshot::pet_row &row, int8_t inventory_slot) -> void {
+	m_index = row.index;
+	m_name = row.name;
+	m_level = row.level;
+	m_closeness = row.closeness;
+	m_fullness = row.fullness;
+	m_inventory_slot = inventory_slot;
 }
 
 }
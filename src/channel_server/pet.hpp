@@ -21,7 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/point.hpp"
 #include "common/types.hpp"
 #include "channel_server/movable_life.hpp"
-#include <soci.h>
+#include "channel_server/player_snapshot.hpp"
 #include <string>
 
 namespace vana {
@@ -35,7 +35,7 @@ namespace vana {
 			NO_DEFAULT_CONSTRUCTOR(pet);
 		public:
 			pet(player *player, item *item);
-			pet(player *player, item *item, const soci::row &row);
+			pet(player *player, item *item, const player_snapshot::pet_row &row, int8_t inventory_slot);
 
 			auto summon(int8_t index) -> void { m_index = index; }
 			auto desummon() -> void { m_index.reset(); }
@@ -59,7 +59,7 @@ namespace vana {
 
 			auto start_timer() -> void;
 		private:
-			auto initialize_pet(const soci::row &row) -> void;
+			auto initialize_pet(const player_snapshot::pet_row &row, int8_t inventory_slot) -> void;
 			auto level_up() -> void;
 
 			opt_int8_t m_index;
@@ -44,6 +44,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/levels_packet.hpp"
 #include "channel_server/map.hpp"
 #include "channel_server/map_packet.hpp"
+#include "channel_server/map_workers.hpp"
 #include "channel_server/maps.hpp"
 #include "channel_server/mob_handler.hpp"
 #include "channel_server/monster_book_packet.hpp"
@@ -58,6 +59,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/player_data_provider.hpp"
 #include "channel_server/player_handler.hpp"
 #include "channel_server/player_packet.hpp"
+#include "channel_server/player_snapshot.hpp"
 #include "channel_server/quests.hpp"
 #include "channel_server/reactor_handler.hpp"
 #include "channel_server/server_packet.hpp"
@@ -74,6 +76,23 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 namespace channel_server {
 
+namespace {
+	// Requests that only touch the player and their map, these run on the map's worker when maps have workers
+	// Anything that can change maps or reach parties, trades, instances or the world server stays on the dispatch strand
+	auto is_map_local(packet_header opcode) -> bool {
+		switch (opcode) {
+			case CMSG_EMOTE:
+			case CMSG_MOB_CONTROL:
+			case CMSG_NPC_ANIMATE:
+			case CMSG_PET_MOVEMENT:
+			case CMSG_PLAYER_MOVE:
+			case CMSG_SUMMON_MOVEMENT:
+				return true;
+		}
+		return false;
+	}
+}
+
 player::player() :
 	movable_life{0, point{}, 0}
 {
@@ -198,16 +217,77 @@ auto player::handle(packet_reader &reader) -> result {
 				<< "; Packet: " << reader
 				<< "; Error: " << e.what();
 		});
-		disconnect();
+		// The session disconnects on failure from the dispatch strand, this may be running on a map worker
 		return result::failure;
 	}
 
 	return result::success;
 }
 
+auto player::route(packet_header opcode, function<void()> handle) -> bool {
+	if (!channel_server::get_instance().get_map_workers().is_enabled()) {
+		return false;
+	}
+
+	// Requests can run on different threads, so each player's are queued and run one at a time to keep them in order
+	owned_lock<mutex> l{m_requests_mutex};
+	m_requests.push_back(queued_request{opcode, handle});
+	if (m_running_request) {
+		return true;
+	}
+	m_running_request = true;
+	queued_request request = m_requests.front();
+	l.unlock();
+
+	run_request(request);
+	return true;
+}
+
+auto player::run_request(const queued_request &request) -> void {
+	auto self = shared_from_this();
+	map_worker *worker = is_map_local(request.opcode) ? m_map_worker.load() : nullptr;
+	if (worker == nullptr) {
+		channel_server::get_instance().get_map_workers().post_global([self, request] {
+			request.handle();
+			self->finish_request();
+		});
+		return;
+	}
+
+	worker->post([self, worker, request] {
+		if (self->m_map_worker.load() != worker) {
+			// The player changed maps while this was queued
+			self->run_request(request);
+			return;
+		}
+		request.handle();
+		self->finish_request();
+	});
+}
+
+auto player::finish_request() -> void {
+	owned_lock<mutex> l{m_requests_mutex};
+	m_requests.pop_front();
+	if (m_requests.empty()) {
+		m_running_request = false;
+		return;
+	}
+	queued_request request = m_requests.front();
+	l.unlock();
+
+	run_request(request);
+}
+
 auto player::on_disconnect() -> void {
 	m_disconnecting = true;
 
+	if (m_awaiting_snapshot) {
+		// Nothing was loaded yet, the provider expires the pending connection on its own
+		channel_server::get_instance().get_player_data_provider().wait_for_snapshot(m_id, nullptr);
+		channel_server::get_instance().finalize_player(shared_from_this());
+		return;
+	}
+
 	map *cur_map = maps::get_map(m_map);
 	if (get_map_chair() != 0) {
 		cur_map->player_seated(get_map_chair(), nullptr);
@@ -259,6 +339,11 @@ auto player::on_disconnect() -> void {
 }
 
 auto player::player_connect(packet_reader &reader) -> void {
+	if (m_awaiting_snapshot) {
+		// Already waiting on the character
+		return;
+	}
+
 	game_player_id id = reader.get<game_player_id>();
 	bool has_transfer_packet = false;
 	auto &channel = channel_server::get_instance();
@@ -270,70 +355,69 @@ auto player::player_connect(packet_reader &reader) -> void {
 	}
 
 	m_id = id;
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	soci::row row;
-	sql.once
-		<< "SELECT c.*, u.gm_level, u.admin "
-		<< "FROM " << db.make_table(vana::table::characters) << " c "
-		<< "INNER JOIN " << db.make_table(vana::table::accounts) << " u ON c.account_id = u.account_id "
-		<< "WHERE c.character_id = :char",
-		soci::use(id, "char"),
-		soci::into(row);
-
-	if (!sql.got_data()) {
+	finish_connect(has_transfer_packet);
+}
+
+auto player::finish_connect(bool has_transfer_packet) -> void {
+	game_player_id id = m_id;
+	auto &channel = channel_server::get_instance();
+	auto &provider = channel.get_player_data_provider();
+	auto snapshot = provider.take_snapshot(id);
+	if (snapshot == nullptr) {
+		// The old channel's handoff or the database hasn't delivered yet, the provider finishes the connect once it does
+		m_awaiting_snapshot = true;
+		provider.wait_for_snapshot(id, shared_from_this());
+		return;
+	}
+
+	m_awaiting_snapshot = false;
+	if (!snapshot->found) {
 		// Hacking
 		disconnect();
 		return;
 	}
 
-	m_name = row.get<string>("name");
-	m_account_id = row.get<game_account_id>("account_id");
-	m_map = row.get<game_map_id>("map");
-	m_gm_level = row.get<int32_t>("gm_level");
-	m_admin = row.get<bool>("admin");
-	m_face = row.get<game_face_id>("face");
-	m_hair = row.get<game_hair_id>("hair");
-	m_world_id = row.get<game_world_id>("world_id");
-	m_gender = row.get<game_gender_id>("gender");
-	m_skin = row.get<game_skin_id>("skin");
-	m_map_pos = row.get<game_portal_id>("pos");
-	m_buddylist_size = row.get<uint8_t>("buddylist_size");
+	m_name = snapshot->name;
+	m_account_id = snapshot->account_id;
+	m_map = snapshot->map;
+	m_gm_level = snapshot->gm_level;
+	m_admin = snapshot->admin;
+	m_face = snapshot->face;
+	m_hair = snapshot->hair;
+	m_world_id = snapshot->world_id;
+	m_gender = snapshot->gender;
+	m_skin = snapshot->skin;
+	m_map_pos = snapshot->map_pos;
+	m_buddylist_size = snapshot->buddylist_size;
 
 	// Stats
 	m_stats = make_owned_ptr<player_stats>(
 		shared_from_this(),
-		row.get<game_player_level>("level"),
-		row.get<game_job_id>("job"),
-		row.get<game_fame>("fame"),
-		row.get<game_stat>("str"),
-		row.get<game_stat>("dex"),
-		row.get<game_stat>("int"),
-		row.get<game_stat>("luk"),
-		row.get<game_stat>("ap"),
-		row.get<game_health_ap>("hpmp_ap"),
-		row.get<game_stat>("sp"),
-		row.get<game_health>("chp"),
-		row.get<game_health>("mhp"),
-		row.get<game_health>("cmp"),
-		row.get<game_health>("mmp"),
-		row.get<game_experience>("exp")
+		snapshot->level,
+		snapshot->job,
+		snapshot->fame,
+		snapshot->str,
+		snapshot->dex,
+		snapshot->intt,
+		snapshot->luk,
+		snapshot->ap,
+		snapshot->hpmp_ap,
+		snapshot->sp,
+		snapshot->hp,
+		snapshot->max_hp,
+		snapshot->mp,
+		snapshot->max_mp,
+		snapshot->exp
 	);
 
 	// Inventory
-	m_mounts = make_owned_ptr<player_mounts>(shared_from_this());
+	m_mounts = make_owned_ptr<player_mounts>(shared_from_this(), *snapshot);
 	m_pets = make_owned_ptr<player_pets>(shared_from_this());
-	array<game_inventory_slot_count, constant::inventory::count> max_slots;
-	max_slots[0] = row.get<game_inventory_slot_count>("equip_slots");
-	max_slots[1] = row.get<game_inventory_slot_count>("use_slots");
-	max_slots[2] = row.get<game_inventory_slot_count>("setup_slots");
-	max_slots[3] = row.get<game_inventory_slot_count>("etc_slots");
-	max_slots[4] = row.get<game_inventory_slot_count>("cash_slots");
-	m_inventory = make_owned_ptr<player_inventory>(shared_from_this(), max_slots, row.get<game_mesos>("mesos"));
-	m_storage = make_owned_ptr<player_storage>(shared_from_this());
+	m_inventory = make_owned_ptr<player_inventory>(shared_from_this(), *snapshot);
+	m_storage = make_owned_ptr<player_storage>(shared_from_this(), *snapshot);
 
 	// Skills
-	m_skills = make_owned_ptr<player_skills>(shared_from_this());
+	m_skills = make_owned_ptr<player_skills>(shared_from_this(), *snapshot);
 
 	// Buffs/summons
 	m_active_buffs = make_owned_ptr<player_active_buffs>(shared_from_this());
@@ -353,20 +437,19 @@ auto player::player_connect(packet_reader &reader) -> void {
 	provider.player_established(id);
 
 	// The rest
-	m_variables = make_owned_ptr<player_variables>(shared_from_this());
-	m_buddy_list = make_owned_ptr<player_buddy_list>(shared_from_this());
-	m_quests = make_owned_ptr<player_quests>(shared_from_this());
-	m_monster_book = make_owned_ptr<player_monster_book>(shared_from_this());
+	m_variables = make_owned_ptr<player_variables>(shared_from_this(), *snapshot);
+	m_buddy_list = make_owned_ptr<player_buddy_list>(shared_from_this(), *snapshot);
+	m_quests = make_owned_ptr<player_quests>(shared_from_this(), *snapshot);
+	m_monster_book = make_owned_ptr<player_monster_book>(shared_from_this(), *snapshot);
 
-	opt_int32_t book_cover = row.get<opt_int32_t>("book_cover");
-	get_monster_book()->set_cover(book_cover.get(0));
+	get_monster_book()->set_cover(snapshot->book_cover);
 
 	// Key Maps and Macros
-	key_maps key_maps;
-	key_maps.load(id);
+	m_key_maps = make_owned_ptr<key_maps>();
+	m_key_maps->load(*snapshot, id);
 
-	skill_macros skill_macros;
-	skill_macros.load(id);
+	m_skill_macros = make_owned_ptr<skill_macros>();
+	m_skill_macros->load(*snapshot);
 
 	// Adjust down HP or MP if necessary
 	get_stats()->check_hp_mp();
@@ -403,12 +486,12 @@ auto player::player_connect(packet_reader &reader) -> void {
 		}
 	}
 
-	send(packets::player::show_keys(&key_maps));
+	send(packets::player::show_keys(m_key_maps.get()));
 
 	send(packets::buddy::update(shared_from_this(), packets::buddy::action_types::add));
 	get_buddy_list()->check_for_pending_buddy();
 
-	send(packets::player::show_skill_macros(&skill_macros));
+	send(packets::player::show_skill_macros(m_skill_macros.get()));
 	for (auto &packet : packets::npc::npc_set_script(channel_server::get_instance().get_config().npc_forced_script)) {
 		send(packet);
 	}
@@ -578,8 +661,6 @@ auto player::change_key(packet_reader &reader) -> void {
 			return;
 		}
 
-		key_maps key_maps;
-		key_maps.load(m_id);
 		for (int32_t i = 0; i < how_many; i++) {
 			int32_t pos = reader.get<int32_t>();
 			key_map_type type;
@@ -588,10 +669,10 @@ auto player::change_key(packet_reader &reader) -> void {
 				return;
 			}
 			int32_t action = reader.get<int32_t>();
-			key_maps.add(pos, key_maps::key_map{type, action});
+			m_key_maps->add(pos, key_maps::key_map{type, action});
 		}
 
-		key_maps.save(m_id);
+		m_key_maps->save(m_id);
 	}
 	else if (mode == auto_hp_potion) {
 		get_inventory()->set_auto_hp_pot(how_many);
@@ -606,7 +687,6 @@ auto player::change_skill_macros(packet_reader &reader) -> void {
 	if (num == 0) {
 		return;
 	}
-	skill_macros macros;
 	for (uint8_t i = 0; i < num; i++) {
 		string name = reader.get<string>();
 		bool shout = reader.get<bool>();
@@ -614,9 +694,9 @@ auto player::change_skill_macros(packet_reader &reader) -> void {
 		game_skill_id skill2 = reader.get<game_skill_id>();
 		game_skill_id skill3 = reader.get<game_skill_id>();
 
-		macros.add(i, new skill_macros::skill_macro{name, shout, skill1, skill2, skill3});
+		m_skill_macros->add(i, new skill_macros::skill_macro{name, shout, skill1, skill2, skill3});
 	}
-	macros.save(get_id());
+	m_skill_macros->save(get_id());
 }
 
 auto player::set_hair(game_hair_id id) -> void {
@@ -634,11 +714,12 @@ auto player::set_skin(game_skin_id id) -> void {
 	send(packets::player::update_stat(constant::stat::skin, id));
 }
 
-auto player::save_stats() -> void {
+auto player::save_stats(vana::io::write_behind::batch &batch) -> void {
 	player_stats *s = get_stats();
 	player_inventory *i = get_inventory();
 	// Need local bindings
 	// Stats
+	game_player_id char_id = m_id;
 	game_player_level level = s->get_level();
 	game_job_id job = s->get_job();
 	game_stat str = s->get_str();
@@ -654,6 +735,13 @@ auto player::save_stats() -> void {
 	game_stat sp = s->get_sp();
 	game_fame fame = s->get_fame();
 	game_experience exp = s->get_exp();
+	// Location and look
+	game_map_id map = m_map;
+	game_portal_id map_pos = m_map_pos;
+	game_gender_id gender = m_gender;
+	game_skin_id skin = m_skin;
+	game_face_id face = m_face;
+	game_hair_id hair = m_hair;
 	// Inventory
 	game_inventory_slot_count equip = i->get_max_slots(constant::inventory::equip);
 	game_inventory_slot_count use = i->get_max_slots(constant::inventory::use);
@@ -662,105 +750,182 @@ auto player::save_stats() -> void {
 	game_inventory_slot_count cash = i->get_max_slots(constant::inventory::cash);
 	game_mesos money = i->get_mesos();
 	// Other
+	uint8_t buddylist_size = m_buddylist_size;
 	int32_t raw_cover = get_monster_book()->get_cover();
 	opt_int32_t cover;
 	if (raw_cover != 0) {
 		cover = raw_cover;
 	}
 
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	sql.once
-		<< "UPDATE " << db.make_table(vana::table::characters) << " "
-		<< "SET "
-		<< "	level = :level, "
-		<< "	job = :job, "
-		<< "	str = :str, "
-		<< "	dex = :dex, "
-		<< "	`int` = :int, "
-		<< "	luk = :luk, "
-		<< "	chp = :hp, "
-		<< "	mhp = :maxhp, "
-		<< "	cmp = :mp, "
-		<< "	mmp = :maxmp, "
-		<< "	hpmp_ap = :hpmpap, "
-		<< "	ap = :ap, "
-		<< "	sp = :sp, "
-		<< "	exp = :exp, "
-		<< "	fame = :fame, "
-		<< "	map = :map, "
-		<< "	pos = :pos, "
-		<< "	gender = :gender, "
-		<< "	skin = :skin, "
-		<< "	face = :face, "
-		<< "	hair = :hair, "
-		<< "	mesos = :money, "
-		<< "	equip_slots = :equip, "
-		<< "	use_slots = :use, "
-		<< "	setup_slots = :setup, "
-		<< "	etc_slots = :etc, "
-		<< "	cash_slots = :cash, "
-		<< "	buddylist_size = :buddylist, "
-		<< "	book_cover = :cover "
-		<< "WHERE character_id = :char",
-		soci::use(m_id, "char"),
-		soci::use(level, "level"),
-		soci::use(job, "job"),
-		soci::use(str, "str"),
-		soci::use(dex, "dex"),
-		soci::use(intl, "int"),
-		soci::use(luk, "luk"),
-		soci::use(hp, "hp"),
-		soci::use(max_hp, "maxhp"),
-		soci::use(mp, "mp"),
-		soci::use(max_mp, "maxmp"),
-		soci::use(hp_mp_ap, "hpmpap"),
-		soci::use(ap, "ap"),
-		soci::use(sp, "sp"),
-		soci::use(exp, "exp"),
-		soci::use(fame, "fame"),
-		soci::use(m_map, "map"),
-		soci::use(m_map_pos, "pos"),
-		soci::use(m_gender, "gender"),
-		soci::use(m_skin, "skin"),
-		soci::use(m_face, "face"),
-		soci::use(m_hair, "hair"),
-		soci::use(money, "money"),
-		soci::use(equip, "equip"),
-		soci::use(use, "use"),
-		soci::use(setup, "setup"),
-		soci::use(etc, "etc"),
-		soci::use(cash, "cash"),
-		soci::use(m_buddylist_size, "buddylist"),
-		soci::use(cover, "cover");
+	vector<int64_t> row = {
+		level, job, str, dex, intl, luk, hp, max_hp, mp, max_mp, hp_mp_ap, ap, sp, fame, exp,
+		map, map_pos, gender, skin, face, hair,
+		equip, use, setup, etc, cash, money,
+		buddylist_size, raw_cover,
+	};
+	if (m_saved_stats.diff(stats_tracker::rows{{0, row}}, batch).empty()) {
+		return;
+	}
+
+	batch.add([=](vana::io::database &db) {
+		auto &sql = db.get_session();
+		sql.once
+			<< "UPDATE " << db.make_table(vana::table::characters) << " "
+			<< "SET "
+			<< "	level = :level, "
+			<< "	job = :job, "
+			<< "	str = :str, "
+			<< "	dex = :dex, "
+			<< "	`int` = :int, "
+			<< "	luk = :luk, "
+			<< "	chp = :hp, "
+			<< "	mhp = :maxhp, "
+			<< "	cmp = :mp, "
+			<< "	mmp = :maxmp, "
+			<< "	hpmp_ap = :hpmpap, "
+			<< "	ap = :ap, "
+			<< "	sp = :sp, "
+			<< "	exp = :exp, "
+			<< "	fame = :fame, "
+			<< "	map = :map, "
+			<< "	pos = :pos, "
+			<< "	gender = :gender, "
+			<< "	skin = :skin, "
+			<< "	face = :face, "
+			<< "	hair = :hair, "
+			<< "	mesos = :money, "
+			<< "	equip_slots = :equip, "
+			<< "	use_slots = :use, "
+			<< "	setup_slots = :setup, "
+			<< "	etc_slots = :etc, "
+			<< "	cash_slots = :cash, "
+			<< "	buddylist_size = :buddylist, "
+			<< "	book_cover = :cover "
+			<< "WHERE character_id = :char",
+			soci::use(char_id, "char"),
+			soci::use(level, "level"),
+			soci::use(job, "job"),
+			soci::use(str, "str"),
+			soci::use(dex, "dex"),
+			soci::use(intl, "int"),
+			soci::use(luk, "luk"),
+			soci::use(hp, "hp"),
+			soci::use(max_hp, "maxhp"),
+			soci::use(mp, "mp"),
+			soci::use(max_mp, "maxmp"),
+			soci::use(hp_mp_ap, "hpmpap"),
+			soci::use(ap, "ap"),
+			soci::use(sp, "sp"),
+			soci::use(exp, "exp"),
+			soci::use(fame, "fame"),
+			soci::use(map, "map"),
+			soci::use(map_pos, "pos"),
+			soci::use(gender, "gender"),
+			soci::use(skin, "skin"),
+			soci::use(face, "face"),
+			soci::use(hair, "hair"),
+			soci::use(money, "money"),
+			soci::use(equip, "equip"),
+			soci::use(use, "use"),
+			soci::use(setup, "setup"),
+			soci::use(etc, "etc"),
+			soci::use(cash, "cash"),
+			soci::use(buddylist_size, "buddylist"),
+			soci::use(cover, "cover");
+	});
 }
 
 auto player::save_all(bool save_cooldowns) -> void {
-	save_stats();
-	get_inventory()->save();
-	get_storage()->save();
-	get_monster_book()->save();
-	get_mounts()->save();
-	get_pets()->save();
-	get_quests()->save();
-	get_skills()->save(save_cooldowns);
-	get_variables()->save();
+	// Components only queue what changed since their last save, the writes happen on the write-behind thread
+	vana::io::write_behind::batch batch;
+	save_stats(batch);
+	get_inventory()->save(batch);
+	get_storage()->save(batch);
+	get_monster_book()->save(batch);
+	get_mounts()->save(batch);
+	get_pets()->save(batch);
+	get_quests()->save(batch);
+	get_skills()->save(batch, save_cooldowns);
+	get_variables()->save(batch);
+	submit_save(std::move(batch));
 }
 
 auto player::set_online(bool online) -> void {
+	// Queued behind any pending save so the character doesn't show as offline before its data is written
+	submit_save(make_online_batch(m_id, online));
+}
+
+auto player::make_online_batch(game_player_id char_id, bool online) -> vana::io::write_behind::batch {
 	int32_t online_id = online ? channel_server::get_instance().get_online_id() : 0;
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	sql.once
-		<< "UPDATE " << db.make_table(vana::table::accounts) << " u "
-		<< "INNER JOIN " << db.make_table(vana::table::characters) << " c ON u.account_id = c.account_id "
-		<< "SET "
-		<< "	u.online = :online_id, "
-		<< "	c.online = :online "
-		<< "WHERE c.character_id = :char",
-		soci::use(m_id, "char"),
-		soci::use(online, "online"),
-		soci::use(online_id, "online_id");
+
+	vana::io::write_behind::batch batch;
+	batch.add([=](vana::io::database &db) {
+		auto &sql = db.get_session();
+		sql.once
+			<< "UPDATE " << db.make_table(vana::table::accounts) << " u "
+			<< "INNER JOIN " << db.make_table(vana::table::characters) << " c ON u.account_id = c.account_id "
+			<< "SET "
+			<< "	u.online = :online_id, "
+			<< "	c.online = :online "
+			<< "WHERE c.character_id = :char",
+			soci::use(char_id, "char"),
+			soci::use(online, "online"),
+			soci::use(online_id, "online_id");
+	});
+	return batch;
+}
+
+auto player::make_snapshot() const -> ref_ptr<player_snapshot> {
+	auto snapshot = make_ref_ptr<player_snapshot>();
+	snapshot->found = true;
+	snapshot->name = m_name;
+	snapshot->account_id = m_account_id;
+	snapshot->world_id = m_world_id;
+	snapshot->map = m_map;
+	snapshot->map_pos = m_map_pos;
+	snapshot->gm_level = m_gm_level;
+	snapshot->admin = m_admin;
+	snapshot->face = m_face;
+	snapshot->hair = m_hair;
+	snapshot->gender = m_gender;
+	snapshot->skin = m_skin;
+	snapshot->buddylist_size = m_buddylist_size;
+
+	player_stats *s = get_stats();
+	snapshot->level = s->get_level();
+	snapshot->job = s->get_job();
+	snapshot->fame = s->get_fame();
+	snapshot->str = s->get_str();
+	snapshot->dex = s->get_dex();
+	snapshot->intt = s->get_int();
+	snapshot->luk = s->get_luk();
+	snapshot->ap = s->get_ap();
+	snapshot->hpmp_ap = s->get_hp_mp_ap();
+	snapshot->sp = s->get_sp();
+	snapshot->hp = s->get_hp();
+	snapshot->max_hp = s->get_max_hp(true);
+	snapshot->mp = s->get_mp();
+	snapshot->max_mp = s->get_max_mp(true);
+	snapshot->exp = s->get_exp();
+
+	get_inventory()->fill_snapshot(*snapshot);
+	get_storage()->fill_snapshot(*snapshot);
+	get_buddy_list()->fill_snapshot(*snapshot);
+	get_quests()->fill_snapshot(*snapshot);
+	get_mounts()->fill_snapshot(*snapshot);
+	get_monster_book()->fill_snapshot(*snapshot);
+	get_skills()->fill_snapshot(*snapshot);
+	get_variables()->fill_snapshot(*snapshot);
+	m_key_maps->fill_snapshot(*snapshot);
+	m_skill_macros->fill_snapshot(*snapshot);
+	return snapshot;
+}
+
+auto player::submit_save(vana::io::write_behind::batch &&batch) -> void {
+	if (batch.empty()) {
+		return;
+	}
+	m_save_ticket = channel_server::get_instance().get_write_behind().submit(std::move(batch));
 }
 
 auto player::set_level_date() -> void {
@@ -850,13 +1015,32 @@ auto player::send(const split_packet_builder &builder) -> void {
 	send(builder.player);
 }
 
+auto player::send(ref_ptr<const shared_packet> packet) -> void {
+	// TODO FIXME resource
+	if (is_disconnecting()) return;
+	packet_handler::send(packet);
+}
+
 auto player::send_map(const packet_builder &builder, bool exclude_self) -> void {
-	get_map()->send(builder, exclude_self ? shared_from_this() : nullptr);
+	map *map = get_map();
+	if (!exclude_self) {
+		// Without a sender the map can't tell whose held movement goes first
+		map->flush_player_movement(this);
+	}
+	map->send(builder, exclude_self ? shared_from_this() : nullptr);
 }
 
 auto player::send_map(const split_packet_builder &builder) -> void {
 	get_map()->send(builder, shared_from_this());
 }
 
+auto player::send_nearby(const packet_builder &builder, bool exclude_self) -> void {
+	get_map()->send_nearby(builder, shared_from_this(), exclude_self);
+}
+
+auto player::send_nearby(const split_packet_builder &builder) -> void {
+	get_map()->send_nearby(builder, shared_from_this());
+}
+
 }
 }
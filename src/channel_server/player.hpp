@@ -19,9 +19,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "common/charge_or_stationary_skill_data.hpp"
 #include "common/data/provider/skill.hpp"
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/packet_handler.hpp"
 #include "common/timer/container_holder.hpp"
 #include "common/util/tausworthe_generator.hpp"
+#include "channel_server/key_maps.hpp"
 #include "channel_server/movable_life.hpp"
 #include "channel_server/npc.hpp"
 #include "channel_server/player_active_buffs.hpp"
@@ -36,7 +39,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/player_storage.hpp"
 #include "channel_server/player_summons.hpp"
 #include "channel_server/player_variables.hpp"
+#include "channel_server/skill_macros.hpp"
+#include <atomic>
 #include <ctime>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -55,7 +61,9 @@ namespace vana {
 	namespace channel_server {
 		class instance;
 		class map;
+		class map_worker;
 		class party;
+		struct player_snapshot;
 
 		class player : public packet_handler, public enable_shared<player>, public vana::timer::container_holder, public movable_life {
 			NONCOPYABLE(player);
@@ -66,6 +74,8 @@ namespace vana {
 			auto set_save_on_dc(bool save) -> void { m_save_on_dc = save; }
 			auto set_trading(bool state) -> void { m_trade_state = state; }
 			auto set_changing_channel(bool v) -> void { m_changing_channel = v; }
+			auto set_fame_pending(bool v) -> void { m_fame_pending = v; }
+			auto set_map_worker(map_worker *worker) -> void { m_map_worker = worker; }
 			auto set_skin(game_skin_id id) -> void;
 			auto set_fall_counter(int8_t falls) -> void { m_fall_counter = falls; }
 			auto set_map_chair(game_seat_id s) -> void { m_map_chair = s; }
@@ -92,6 +102,8 @@ namespace vana {
 			auto is_admin() const -> bool { return m_admin; }
 			auto is_changing_channel() const -> bool { return m_changing_channel; }
 			auto is_trading() const -> bool { return m_trade_state; }
+			auto is_fame_pending() const -> bool { return m_fame_pending; }
+			auto get_save_ticket() const -> vana::io::write_behind::ticket { return m_save_ticket; }
 			auto is_disconnecting() const -> bool { return m_disconnecting; }
 			auto has_gm_equip() const -> bool;
 			auto is_using_gm_hide() const -> bool;
@@ -150,31 +162,51 @@ namespace vana {
 			auto change_channel(game_channel_id channel) -> void;
 			auto save_all(bool save_cooldowns = false) -> void;
 			auto set_online(bool online) -> void;
+			auto make_snapshot() const -> ref_ptr<player_snapshot>;
+			auto finish_connect(bool has_transfer_packet) -> void;
 			auto set_level_date() -> void;
 			auto accept_death(bool wheel) -> void;
 			auto initialize_rng(packet_builder &builder) -> void;
 
 			auto send(const packet_builder &builder) -> void;
 			auto send(const split_packet_builder &builder) -> void;
+			auto send(ref_ptr<const shared_packet> packet) -> void;
 			auto send_map(const packet_builder &builder, bool exclude_self = false) -> void;
 			auto send_map(const split_packet_builder &builder) -> void;
+			auto send_nearby(const packet_builder &builder, bool exclude_self = false) -> void;
+			auto send_nearby(const split_packet_builder &builder) -> void;
+
+			static auto make_online_batch(game_player_id char_id, bool online) -> vana::io::write_behind::batch;
 		protected:
 			auto handle(packet_reader &reader) -> result override;
+			auto route(packet_header opcode, function<void()> handle) -> bool override;
 			auto on_disconnect() -> void override;
 		private:
+			using stats_tracker = vana::io::row_tracker<int8_t, vector<int64_t>>;
+
+			struct queued_request {
+				packet_header opcode;
+				function<void()> handle;
+			};
+
+			auto run_request(const queued_request &request) -> void;
+			auto finish_request() -> void;
 			auto player_connect(packet_reader &reader) -> void;
 			auto change_key(packet_reader &reader) -> void;
 			auto change_skill_macros(packet_reader &reader) -> void;
-			auto save_stats() -> void;
+			auto save_stats(vana::io::write_behind::batch &batch) -> void;
+			auto submit_save(vana::io::write_behind::batch &&batch) -> void;
 			auto internal_set_map(game_map_id map_id, game_portal_id portal_id, const point &pos, bool from_position) -> void;
 
 			bool m_trade_state = false;
 			bool m_save_on_dc = true;
 			bool m_is_connect = false;
 			bool m_changing_channel = false;
+			bool m_fame_pending = false;
 			bool m_admin = false;
 			bool m_gm_chat = false;
 			bool m_disconnecting = false;
+			bool m_awaiting_snapshot = false;
 			game_world_id m_world_id = -1;
 			game_portal_id m_map_pos = -1;
 			game_gender_id m_gender = -1;
@@ -195,6 +227,7 @@ namespace vana {
 			int32_t m_gm_level = 0;
 			game_trade_id m_trade_id = 0;
 			int64_t m_online_time = 0;
+			vana::io::write_behind::ticket m_save_ticket = 0;
 			instance *m_instance = nullptr;
 			party *m_party = nullptr;
 			string m_chalkboard;
@@ -205,6 +238,7 @@ namespace vana {
 			owned_ptr<player_active_buffs> m_active_buffs;
 			owned_ptr<player_buddy_list> m_buddy_list;
 			owned_ptr<player_inventory> m_inventory;
+			owned_ptr<key_maps> m_key_maps;
 			owned_ptr<player_monster_book> m_monster_book;
 			owned_ptr<player_mounts> m_mounts;
 			owned_ptr<player_pets> m_pets;
@@ -214,8 +248,15 @@ namespace vana {
 			owned_ptr<player_storage> m_storage;
 			owned_ptr<player_summons> m_summons;
 			owned_ptr<player_variables> m_variables;
+			owned_ptr<skill_macros> m_skill_macros;
 			owned_ptr<vana::util::tausworthe_generator> m_rand_stream;
 			hash_set<game_portal_id> m_used_portals;
+			stats_tracker m_saved_stats;
+			// Only written while the map it refers to is being entered or left, read when routing requests
+			std::atomic<map_worker *> m_map_worker{nullptr};
+			mutex m_requests_mutex;
+			std::deque<queued_request> m_requests;
+			bool m_running_request = false;
 		};
 	}
 }
\ No newline at end of file
@@ -198,6 +198,8 @@ auto player_active_buffs::add_buff(const data::type::buff_source &source, const
 			auto &existing = m_buffs[i];
 			if (existing.type == source.get_type() && existing.identifier == source.get_id()) {
 				m_buffs.erase(std::begin(m_buffs) + i);
+				// Rebuilt after every change to m_buffs, the timers and values below read buffs back through it
+				update_bit_index();
 				break;
 			}
 		}
@@ -256,6 +258,7 @@ auto player_active_buffs::add_buff(const data::type::buff_source &source, const
 					else {
 						existing.raw = existing.raw.with_buffs(applicable);
 					}
+					update_bit_index();
 				}
 			}
 		}
@@ -307,6 +310,7 @@ auto player_active_buffs::add_buff(const data::type::buff_source &source, const
 		}
 
 		m_buffs.push_back(local);
+		update_bit_index();
 
 		player->send_map(
 			packets::add_buff(
@@ -381,6 +385,7 @@ auto player_active_buffs::remove_buff(const data::type::buff_source &source, con
 				}
 
 				m_buffs.erase(m_buffs.begin() + i);
+				update_bit_index();
 				break;
 			}
 		}
@@ -481,36 +486,23 @@ auto player_active_buffs::get_map_buff_values() -> buff_packet_structure {
 	auto &basics = buff_provider.get_buffs_by_effect();
 	buff_packet_structure result;
 
-	using tuple_type = tuple<uint8_t, const data::type::buff_info *, data::type::buff_source>;
-	vector<tuple_type> map_buffs;
-
-	for (const auto &buff : m_buffs) {
-		for (const auto &info : buff.raw.get_buff_info()) {
-			if (info.has_map_info()) {
-				map_buffs.emplace_back(
-					info.get_bit_position(),
-					&info,
-					buff.to_source());
-			}
-		}
-	}
-
-	std::sort(std::begin(map_buffs), std::end(map_buffs), [](const tuple_type &a, const tuple_type &b) -> bool {
-		return std::get<0>(a) < std::get<0>(b);
-	});
-
 	if (auto player = m_player.lock()) {
-		for (const auto &tup : map_buffs) {
-			const auto &info = std::get<1>(tup);
-			const auto &source = std::get<2>(tup);
+		// Walking the mask yields the buffs already ordered by bit position
+		for (size_t bit = 0; bit < bit_count; ++bit) {
+			if (!m_map_bits.test(bit)) continue;
+
+			const auto &owner = m_bit_owners[bit];
+			const auto &buff = m_buffs[owner.buff_index];
+			const auto &info = buff.raw.get_buff_info()[owner.info_index];
+			auto source = buff.to_source();
 
-			result.types[info->get_buff_byte()] |= info->get_buff_type();
+			result.types[info.get_buff_byte()] |= info.get_buff_type();
 			result.values.push_back(buffs::get_value(
 				player,
 				source,
 				get_buff_seconds_remaining(source),
-				info->get_bit_position(),
-				info->get_map_info()));
+				info.get_bit_position(),
+				info.get_map_info()));
 		}
 
 		return result;
@@ -826,14 +818,10 @@ auto player_active_buffs::has_buff(const data::type::buff_info &buff) const -> b
 }
 
 auto player_active_buffs::has_buff(uint8_t bit_position) const -> bool {
-	for (const auto &buff : m_buffs) {
-		for (const auto &info : buff.raw.get_buff_info()) {
-			if (bit_position == info) {
-				return true;
-			}
-		}
+	if (bit_position == 0 || bit_position > bit_count) {
+		return false;
 	}
-	return false;
+	return m_active_bits.test(bit_position - 1);
 }
 
 auto player_active_buffs::get_buff_source(const data::type::buff_info &buff) const -> optional<data::type::buff_source> {
@@ -841,14 +829,35 @@ auto player_active_buffs::get_buff_source(const data::type::buff_info &buff) con
 }
 
 auto player_active_buffs::get_buff(uint8_t bit_position) const -> optional<data::type::buff_source> {
-	for (const auto &buff : m_buffs) {
-		for (const auto &info : buff.raw.get_buff_info()) {
-			if (bit_position == info) {
-				return buff.to_source();
+	if (!has_buff(bit_position)) {
+		return optional<data::type::buff_source>{};
+	}
+	return m_buffs[m_bit_owners[bit_position - 1].buff_index].to_source();
+}
+
+auto player_active_buffs::update_bit_index() -> void {
+	m_active_bits.reset();
+	m_map_bits.reset();
+
+	for (size_t i = 0; i < m_buffs.size(); ++i) {
+		const auto &buff_info = m_buffs[i].raw.get_buff_info();
+		for (size_t j = 0; j < buff_info.size(); ++j) {
+			const auto &info = buff_info[j];
+			uint8_t bit_position = info.get_bit_position();
+			if (bit_position == 0 || bit_position > bit_count) continue;
+
+			// The first buff holding a bit owns it, same as the old linear lookup
+			size_t bit = bit_position - 1;
+			if (m_active_bits.test(bit)) continue;
+
+			m_active_bits.set(bit);
+			m_bit_owners[bit].buff_index = static_cast<uint16_t>(i);
+			m_bit_owners[bit].info_index = static_cast<uint16_t>(j);
+			if (info.has_map_info()) {
+				m_map_bits.set(bit);
 			}
 		}
 	}
-	return optional<data::type::buff_source>{};
 }
 
 auto player_active_buffs::has_ice_charge() const -> bool {
@@ -1137,6 +1146,7 @@ auto player_active_buffs::parse_transfer_packet(packet_reader &reader) -> void {
 				valid_bits);
 
 			m_buffs.push_back(buff);
+			update_bit_index();
 
 			vana::timer::id id{vana::timer::type::buff_timer, static_cast<int32_t>(buff.type), buff.identifier};
 			vana::timer::timer::create(
@@ -18,10 +18,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/data/type/buff_info.hpp"
+#include "common/constant/buff.hpp"
 #include "common/data/type/buff_source_type.hpp"
 #include "common/i_packet.hpp"
 #include "common/types.hpp"
 #include "channel_server/buffs.hpp"
+#include <bitset>
 #include <memory>
 #include <queue>
 #include <unordered_map>
@@ -136,6 +138,14 @@ namespace vana {
 				auto to_source() const -> data::type::buff_source;
 			};
 
+			// Which buff (and which of its buff_info entries) currently owns a bit position
+			struct bit_owner {
+				uint16_t buff_index = 0;
+				uint16_t info_index = 0;
+			};
+
+			static const size_t bit_count = constant::buff::byte_quantity * 8;
+
 			auto translate_to_packet(const data::type::buff_source &source) const -> int32_t;
 			auto has_buff(const data::type::buff_info &buff) const -> bool;
 			auto has_buff(uint8_t bit_position) const -> bool;
@@ -151,6 +161,7 @@ namespace vana {
 			auto stop_bullet_skills() -> void;
 			auto stop_skill(const data::type::buff_source &source) -> void;
 			auto set_combo(uint8_t combo) -> void;
+			auto update_bit_index() -> void;
 
 			bool m_berserk = false;
 			uint8_t m_combo = 0;
@@ -164,6 +175,9 @@ namespace vana {
 			uint32_t m_debuff_mask = 0;
 			view_ptr<player> m_player;
 			vector<local_buff_info> m_buffs;
+			std::bitset<bit_count> m_active_bits;
+			std::bitset<bit_count> m_map_bits;
+			array<bit_owner, bit_count> m_bit_owners;
 		};
 	}
 }
\ No newline at end of file
@@ -23,52 +23,52 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/buddy_list_packet.hpp"
 #include "channel_server/channel_server.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 #include "channel_server/sync_packet.hpp"
 #include <algorithm>
 
 namespace vana {
 namespace channel_server {
 
-player_buddy_list::player_buddy_list(ref_ptr<player> player) :
+player_buddy_list::player_buddy_list(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
-auto player_buddy_list::load() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
+auto player_buddy_list::load(const player_snapshot &snapshot) -> void {
+	for (const auto &row : snapshot.buddies) {
+		ref_ptr<buddy> value = make_ref_ptr<buddy>();
+		value->char_id = row.char_id;
+		value->name = row.name;
+		value->group_name = row.group_name;
+		value->opposite_status = row.opposite_registered ?
+			packets::buddy::opposite_status::registered :
+			packets::buddy::opposite_status::unregistered;
+		m_buddies[row.char_id] = value;
+	}
 
-	if (auto player = m_player.lock()) {
-		soci::rowset<> rs = (sql.prepare
-			<< "SELECT bl.id, bl.buddy_character_id, bl.name AS name_cache, c.name, bl.group_name, CASE WHEN c.online = 1 THEN u.online ELSE 0 END AS `online` "
-			<< "FROM " << db.make_table(vana::table::buddylist) << " bl "
-			<< "LEFT JOIN " << db.make_table(vana::table::characters) << " c ON bl.buddy_character_id = c.character_id "
-			<< "LEFT JOIN " << db.make_table(vana::table::accounts) << " u ON c.account_id = u.account_id "
-			<< "WHERE bl.character_id = :char",
-			soci::use(player->get_id(), "char"));
-
-		for (const auto &row : rs) {
-			add_buddy(db, row);
-		}
+	for (const auto &row : snapshot.pending_buddies) {
+		buddy_invite invite;
+		invite.id = row.first;
+		invite.name = row.second;
+		m_pending_buddies.push_back(invite);
+	}
+}
 
-		rs = (sql.prepare
-			<< "SELECT p.* "
-			<< "FROM " << db.make_table(vana::table::buddylist_pending) << " p "
-			<< "LEFT JOIN " << db.make_table(vana::table::characters) << " c ON c.character_id = p.inviter_character_id "
-			<< "WHERE c.world_id = :world AND p.character_id = :char ",
-			soci::use(player->get_id(), "char"),
-			soci::use(channel_server::get_instance().get_world_id(), "world"));
+auto player_buddy_list::fill_snapshot(player_snapshot &snapshot) const -> void {
+	for (const auto &kvp : m_buddies) {
+		player_snapshot::buddy_row row;
+		row.char_id = kvp.second->char_id;
+		row.name = kvp.second->name;
+		row.group_name = kvp.second->group_name;
+		row.opposite_registered = kvp.second->opposite_status == packets::buddy::opposite_status::registered;
+		snapshot.buddies.push_back(std::move(row));
+	}
 
-		buddy_invite invite;
-		for (const auto &row : rs) {
-			invite = buddy_invite{};
-			invite.id = row.get<game_player_id>("inviter_character_id");
-			invite.name = row.get<string>("inviter_name");
-			m_pending_buddies.push_back(invite);
-		}
+	for (const auto &invite : m_pending_buddies) {
+		snapshot.pending_buddies.emplace_back(invite.id, invite.name);
 	}
-	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
 auto player_buddy_list::add_buddy(const string &name, const string &group, bool invite) -> uint8_t {
@@ -33,6 +33,7 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		struct buddy {
 			uint8_t opposite_status = 0;
@@ -51,7 +52,7 @@ namespace vana {
 			NONCOPYABLE(player_buddy_list);
 			NO_DEFAULT_CONSTRUCTOR(player_buddy_list);
 		public:
-			player_buddy_list(ref_ptr<player> player);
+			player_buddy_list(ref_ptr<player> player, const player_snapshot &snapshot);
 
 			auto add_buddy(const string &name, const string &group, bool invite = true) -> uint8_t;
 			auto remove_buddy(game_player_id char_id) -> void;
@@ -65,9 +66,10 @@ namespace vana {
 			auto check_for_pending_buddy() -> void;
 			auto buddy_accepted(game_player_id buddy_id) -> void;
 			auto remove_pending_buddy(game_player_id id, bool accepted) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 		private:
 			auto add_buddy(vana::io::database &db, const soci::row &row) -> void;
-			auto load() -> void;
+			auto load(const player_snapshot &snapshot) -> void;
 
 			bool m_sent_request = false;
 			view_ptr<player> m_player;
@@ -25,14 +25,17 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/packet_wrapper.hpp"
 #include "common/party_data.hpp"
 #include "common/session.hpp"
+#include "common/timer/timer.hpp"
 #include "common/util/string.hpp"
 #include "common/util/time.hpp"
 #include "channel_server/buddy_list_packet.hpp"
 #include "channel_server/channel_server.hpp"
+#include "channel_server/map_workers.hpp"
 #include "channel_server/party.hpp"
 #include "channel_server/party_packet.hpp"
 #include "channel_server/player.hpp"
 #include "channel_server/player_packet.hpp"
+#include "channel_server/player_snapshot.hpp"
 #include "channel_server/players_packet.hpp"
 #include "channel_server/smsg_header.hpp"
 #include "channel_server/sync_packet.hpp"
@@ -169,6 +172,10 @@ auto player_data_provider::get_player(const string &name) -> ref_ptr<player> {
 	return kvp != std::end(m_players_by_name) ? kvp->second : nullptr;
 }
 
+auto player_data_provider::get_player_count() const -> size_t {
+	return m_players.size();
+}
+
 auto player_data_provider::run(function<void(ref_ptr<player>)> func) -> void {
 	for (const auto &kvp : m_players) {
 		func(kvp.second);
@@ -300,6 +307,20 @@ auto player_data_provider::new_player(game_player_id id, const ip &ip, packet_re
 	if (packet_size > 0) {
 		player.held_packet.reset(new unsigned char[packet_size]);
 		memcpy(player.held_packet.get(), reader.get_buffer(), packet_size);
+		player.awaiting_handoff = true;
+
+		time_point connect_time = player.connect_time;
+		// Copied so the duration constructor doesn't odr-use the in-class constant
+		uint32_t timeout = max_connection_milliseconds;
+		vana::timer::timer::create(
+			[this, id, connect_time](const time_point &now) {
+				channel_server::get_instance().get_map_workers().post_global([this, id, connect_time] {
+					this->expire_handoff(id, connect_time);
+				});
+			},
+			vana::timer::id{vana::timer::type::handoff_timer, id},
+			nullptr,
+			milliseconds{timeout});
 	}
 
 	m_connections[id] = player;
@@ -332,6 +353,72 @@ auto player_data_provider::player_established(game_player_id id) -> void {
 	m_connections.erase(id);
 }
 
+auto player_data_provider::take_snapshot(game_player_id id) -> ref_ptr<player_snapshot> {
+	auto kvp = m_connections.find(id);
+	if (kvp == std::end(m_connections)) {
+		// Not found, which fails the connect
+		return make_ref_ptr<player_snapshot>();
+	}
+
+	auto &connection = kvp->second;
+	if (connection.handoff != nullptr) {
+		return connection.handoff;
+	}
+	if (connection.snapshot != nullptr) {
+		return connection.snapshot;
+	}
+	if (!connection.awaiting_handoff && !connection.loading) {
+		prefetch_player(id);
+	}
+	return nullptr;
+}
+
+auto player_data_provider::wait_for_snapshot(game_player_id id, ref_ptr<player> player) -> void {
+	auto kvp = m_connections.find(id);
+	if (kvp != std::end(m_connections)) {
+		kvp->second.waiting = player;
+	}
+}
+
+auto player_data_provider::prefetch_player(game_player_id id) -> void {
+	auto &connection = m_connections[id];
+	connection.loading = true;
+	connection.snapshot = nullptr;
+
+	// The connect time tells this load apart from one for a later connection of the same character
+	time_point connect_time = connection.connect_time;
+	game_world_id world_id = channel_server::get_instance().get_world_id();
+	channel_server::get_instance().get_database_executor().post<ref_ptr<player_snapshot>>(
+		"player_load",
+		[id, world_id](vana::io::database &db) -> ref_ptr<player_snapshot> {
+			return player_snapshot::fetch(db, id, world_id);
+		},
+		[this, id, connect_time](ref_ptr<player_snapshot> snapshot) {
+			this->snapshot_loaded(id, connect_time, snapshot);
+		},
+		[this, id, connect_time] {
+			// Not found, which fails the connect
+			this->snapshot_loaded(id, connect_time, make_ref_ptr<player_snapshot>());
+		});
+}
+
+auto player_data_provider::snapshot_loaded(game_player_id id, time_point connect_time, ref_ptr<player_snapshot> snapshot) -> void {
+	auto kvp = m_connections.find(id);
+	if (kvp == std::end(m_connections) || kvp->second.connect_time != connect_time) {
+		return;
+	}
+
+	auto &connection = kvp->second;
+	connection.loading = false;
+	connection.snapshot = snapshot;
+
+	// Finishing the connect establishes the player, which erases the connection
+	bool has_transfer_packet = connection.packet_size > 0;
+	if (auto waiting = connection.waiting.lock()) {
+		waiting->finish_connect(has_transfer_packet);
+	}
+}
+
 auto player_data_provider::handle_player_sync(packet_reader &reader) -> void {
 	switch (reader.get<protocol_sync>()) {
 		case sync::player::new_connectable: handle_new_connectable(reader); break;
@@ -340,6 +427,7 @@ auto player_data_provider::handle_player_sync(packet_reader &reader) -> void {
 		case sync::player::update_player: handle_update_player(reader); break;
 		case sync::player::character_created: handle_character_created(reader); break;
 		case sync::player::character_deleted: handle_character_deleted(reader); break;
+		case sync::player::handoff: handle_handoff(reader); break;
 		default: THROW_CODE_EXCEPTION(not_implemented_exception, "player_sync type");
 	}
 }
@@ -392,9 +480,24 @@ auto player_data_provider::handle_change_channel(packet_reader &reader) -> void
 				m_followers.erase(kvp);
 			}
 
-			player->set_online(false); // Set online to false BEFORE CC packet is sent to player
-			player->send(packets::player::change_channel(ip_value, port));
 			player->save_all(true);
+			// The destination builds the character from this instead of the database
+			packet_builder handoff = packets::interserver::player::handoff(player_id, channel_id, player->make_snapshot());
+			if (handoff.get_size() > max_handoff_bytes) {
+				player->set_online(false); // Set online to false BEFORE CC packet is sent to player
+				// The destination channel loads the character from the database instead
+				handoff = packets::interserver::player::handoff(player_id, channel_id, nullptr);
+			}
+
+			// The destination saves over this character as soon as it takes over, so the handoff waits for the save to be written
+			// The client is parked on the destination until the handoff arrives
+			auto &server = channel_server::get_instance();
+			server.get_write_behind().on_completed(player->get_save_ticket(), [handoff] {
+				channel_server::get_instance().get_map_workers().post_global([handoff] {
+					channel_server::get_instance().send_world(handoff);
+				});
+			});
+			player->send(packets::player::change_channel(ip_value, port));
 			player->set_save_on_dc(false);
 		}
 	}
@@ -404,6 +507,10 @@ auto player_data_provider::handle_new_connectable(packet_reader &reader) -> void
 	game_player_id player_id = reader.get<game_player_id>();
 	ip ip_value = reader.get<ip>();
 	new_player(player_id, ip_value, reader);
+	if (m_connections[player_id].packet_size == 0) {
+		// Fresh logins can be read ahead of the client; a channel change still has the old channel's save in flight
+		prefetch_player(player_id);
+	}
 	send_sync(packets::interserver::player::connectable_established(player_id));
 }
 
@@ -412,6 +519,58 @@ auto player_data_provider::handle_delete_connectable(packet_reader &reader) -> v
 	player_established(id);
 }
 
+auto player_data_provider::handle_handoff(packet_reader &reader) -> void {
+	game_player_id player_id = reader.get<game_player_id>();
+	ref_ptr<player_snapshot> snapshot;
+	if (reader.get<bool>()) {
+		snapshot = player_snapshot::read_from_packet(reader);
+	}
+
+	auto kvp = m_connections.find(player_id);
+	if (kvp == std::end(m_connections) || !kvp->second.awaiting_handoff) {
+		if (snapshot != nullptr) {
+			// The connection expired first, the old channel left the character marked online
+			channel_server::get_instance().get_write_behind().submit(player::make_online_batch(player_id, false));
+		}
+		return;
+	}
+
+	auto &connection = kvp->second;
+	connection.awaiting_handoff = false;
+	connection.handoff = snapshot;
+	if (snapshot == nullptr) {
+		// Too big to send, the old channel only sends the handoff once its save is written so the database is current
+		// The load finishes the connect
+		prefetch_player(player_id);
+		return;
+	}
+
+	// Finishing the connect establishes the player, which erases the connection
+	auto waiting = connection.waiting.lock();
+	if (waiting != nullptr) {
+		waiting->finish_connect(true);
+	}
+}
+
+auto player_data_provider::expire_handoff(game_player_id id, time_point connect_time) -> void {
+	auto kvp = m_connections.find(id);
+	if (kvp == std::end(m_connections) || kvp->second.connect_time != connect_time || kvp->second.loading) {
+		// Anything still loading was handed over already and is waiting on the database instead
+		return;
+	}
+
+	auto &connection = kvp->second;
+	if (auto waiting = connection.waiting.lock()) {
+		// The old channel never sent the character over
+		waiting->disconnect();
+	}
+	if (connection.handoff != nullptr) {
+		// The client never showed up, the old channel left the character marked online
+		channel_server::get_instance().get_write_behind().submit(player::make_online_batch(id, false));
+	}
+	m_connections.erase(kvp);
+}
+
 auto player_data_provider::handle_update_player(packet_reader &reader) -> void {
 	game_player_id player_id = reader.get<game_player_id>();
 	auto &player = m_player_data[player_id];
@@ -34,6 +34,7 @@ namespace vana {
 	namespace channel_server {
 		class party;
 		class player;
+		struct player_snapshot;
 
 		struct connecting_player {
 			connecting_player() : connect_ip{0} { }
@@ -44,6 +45,14 @@ namespace vana {
 			string portal;
 			uint16_t packet_size;
 			vana::util::shared_array<unsigned char> held_packet;
+			// Channel changes wait on the old channel to send the character over
+			bool awaiting_handoff = false;
+			ref_ptr<player_snapshot> handoff;
+			// Otherwise the character is read on the database executor
+			bool loading = false;
+			ref_ptr<player_snapshot> snapshot;
+			// Parked until the handoff or the load arrives
+			view_ptr<player> waiting;
 		};
 
 		class player_data_provider {
@@ -58,6 +67,7 @@ namespace vana {
 			auto update_player_job(ref_ptr<player> player) -> void;
 			auto get_player(game_player_id id) -> ref_ptr<player>;
 			auto get_player(const string &name) -> ref_ptr<player>;
+			auto get_player_count() const -> size_t;
 			auto run(function<void(ref_ptr<player>)> func) -> void;
 			auto send(game_player_id player_id, const packet_builder &builder) -> void;
 			auto send(const vector<game_player_id> &player_ids, const packet_builder &builder) -> void;
@@ -81,6 +91,9 @@ namespace vana {
 			auto check_player(game_player_id id, const ip &ip, bool &has_packet) const -> result;
 			auto get_packet(game_player_id id) const -> packet_reader;
 			auto player_established(game_player_id id) -> void;
+			// Null while the character is still on its way, the player then waits for it with wait_for_snapshot
+			auto take_snapshot(game_player_id id) -> ref_ptr<player_snapshot>;
+			auto wait_for_snapshot(game_player_id id, ref_ptr<player> player) -> void;
 		private:
 			auto parse_channel_connect_packet(packet_reader &reader) -> void;
 
@@ -95,6 +108,8 @@ namespace vana {
 			auto handle_change_channel(packet_reader &reader) -> void;
 			auto handle_new_connectable(packet_reader &reader) -> void;
 			auto handle_delete_connectable(packet_reader &reader) -> void;
+			auto handle_handoff(packet_reader &reader) -> void;
+			auto expire_handoff(game_player_id id, time_point connect_time) -> void;
 			auto handle_update_player(packet_reader &reader) -> void;
 
 			auto handle_create_party(game_party_id id, game_player_id leader_id) -> void;
@@ -109,8 +124,12 @@ namespace vana {
 			auto readd_buddy(packet_reader &reader) -> void;
 
 			auto new_player(game_player_id id, const ip &ip, packet_reader &reader) -> void;
+			auto prefetch_player(game_player_id id) -> void;
+			auto snapshot_loaded(game_player_id id, time_point connect_time, ref_ptr<player_snapshot> snapshot) -> void;
 
 			const static uint32_t max_connection_milliseconds = 5000;
+			// Inter-server packets carry a 16-bit length, anything bigger goes through the database instead
+			const static size_t max_handoff_bytes = 60000;
 
 			hash_set<game_player_id> m_gm_list;
 			hash_map<game_player_id, player_data> m_player_data;
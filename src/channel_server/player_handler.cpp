@@ -286,12 +286,12 @@ auto player_handler::handle_damage(ref_ptr<player> player, packet_reader &reader
 
 		player->get_active_buffs()->take_damage(damage);
 	}
-	player->send_map(packets::players::damage_player(player->get_id(), damage, mob_id, hit, type, stance, no_damage_id, pgmr));
+	player->send_nearby(packets::players::damage_player(player->get_id(), damage, mob_id, hit, type, stance, no_damage_id, pgmr));
 }
 
 auto player_handler::handle_facial_expression(ref_ptr<player> player, packet_reader &reader) -> void {
 	int32_t face = reader.get<int32_t>();
-	player->send_map(packets::players::face_expression(player->get_id(), face));
+	player->send_nearby(packets::players::face_expression(player->get_id(), face));
 }
 
 auto player_handler::handle_get_info(ref_ptr<player> player, packet_reader &reader) -> void {
@@ -324,7 +324,7 @@ auto player_handler::handle_moving(ref_ptr<player> player, packet_reader &reader
 	
 	move_path path(reader);
 	player->reset_from_move_path(path);
-	player->send_map(packets::players::show_moving(player->get_id(), path));
+	player->get_map()->send_player_movement(player, path);
 
 	if (player->get_foothold() == 0 && !player->is_using_gm_hide()) {
 		// Player is floating in the air
@@ -339,7 +339,12 @@ auto player_handler::handle_moving(ref_ptr<player> player, packet_reader &reader
 			// There are no footholds below the player
 			int8_t count = player->get_fall_counter();
 			if (count > 3) {
-				player->set_map(map_id);
+				// Respawning goes through a map change, which belongs to the channel
+				channel_server::get_instance().get_map_workers().run_global([player, map_id] {
+					if (player->get_map_id() == map_id) {
+						player->set_map(map_id);
+					}
+				});
 			}
 			else {
 				player->set_fall_counter(++count);
@@ -468,7 +473,7 @@ auto player_handler::use_bomb_skill(ref_ptr<player> player, packet_reader &reade
 		return;
 	}
 
-	player->send_map(packets::players::use_bomb_attack(player->get_id(), charge, skill_id, player_pos));
+	player->send_nearby(packets::players::use_bomb_attack(player->get_id(), charge, skill_id, player_pos));
 }
 
 auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &reader) -> void {
@@ -489,7 +494,7 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 		}
 	}
 
-	player->send_map(packets::players::use_melee_attack(player->get_id(), mastery_id, player->get_skills()->get_skill_level(mastery_id), attack));
+	player->send_nearby(packets::players::use_melee_attack(player->get_id(), mastery_id, player->get_skills()->get_skill_level(mastery_id), attack));
 
 	game_map_id map_id = player->get_map_id();
 	map *map = maps::get_map(map_id);
@@ -501,7 +506,8 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 	auto pickpocket = player->get_active_buffs()->get_pickpocket_source();
 	bool ppok = !attack.is_meso_explosion && pickpocket.is_initialized();
 	point origin;
-	vector<game_damage> pp_damages;
+	array<game_damage, attack_target::max_hits> pp_damages;
+	uint8_t pp_size = 0;
 	auto picking = !pickpocket.is_initialized() ?
 		nullptr :
 		player->get_active_buffs()->get_buff_skill_info(pickpocket.get());
@@ -510,7 +516,7 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 	for (const auto &target : attack.damages) {
 		game_damage target_total = 0;
 		int8_t connected_hits = 0;
-		auto mob = map->get_mob(target.first);
+		auto mob = map->get_mob(target.get_map_mob_id());
 		if (mob == nullptr) {
 			continue;
 		}
@@ -522,7 +528,7 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 		}
 
 		origin = mob->get_pos(); // Info for pickpocket before mob is set to nullptr (in the case that mob dies)
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			game_damage damage = hit;
 			if (damage != 0) {
 				connected_hits++;
@@ -530,7 +536,7 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 			}
 			if (ppok && vana::util::randomizer::percentage<uint16_t>() < picking->prop) {
 				 // Make sure this is a melee attack and not meso explosion, plus pickpocket being active
-				pp_damages.push_back(damage);
+				pp_damages[pp_size++] = damage;
 			}
 			if (mob == nullptr) {
 				if (ppok) {
@@ -561,7 +567,6 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 			}
 			damaged_targets++;
 		}
-		uint8_t pp_size = static_cast<uint8_t>(pp_damages.size());
 		for (uint8_t pickpocket = 0; pickpocket < pp_size; ++pickpocket) {
 			// Drop stuff for Pickpocket
 			point pp_pos = origin;
@@ -582,7 +587,7 @@ auto player_handler::use_melee_attack(ref_ptr<player> player, packet_reader &rea
 				nullptr,
 				milliseconds{175 * pickpocket});
 		}
-		pp_damages.clear();
+		pp_size = 0;
 	}
 
 	if (player->get_skills()->has_energy_charge()) {
@@ -707,7 +712,7 @@ auto player_handler::use_ranged_attack(ref_ptr<player> player, packet_reader &re
 		return;
 	}
 
-	player->send_map(packets::players::use_ranged_attack(player->get_id(), mastery_id, player->get_skills()->get_skill_level(mastery_id), attack));
+	player->send_nearby(packets::players::use_ranged_attack(player->get_id(), mastery_id, player->get_skills()->get_skill_level(mastery_id), attack));
 
 	switch (skill_id) {
 		case constant::skill::bowmaster::hurricane:
@@ -729,7 +734,7 @@ auto player_handler::use_ranged_attack(ref_ptr<player> player, packet_reader &re
 	game_damage first_hit = 0;
 	bool reflect_applied = player->has_gm_benefits();
 	for (const auto &target : attack.damages) {
-		game_map_object map_mob_id = target.first;
+		game_map_object map_mob_id = target.get_map_mob_id();
 		auto mob = player->get_map()->get_mob(map_mob_id);
 		if (mob == nullptr) {
 			continue;
@@ -743,7 +748,7 @@ auto player_handler::use_ranged_attack(ref_ptr<player> player, packet_reader &re
 		game_damage target_total = 0;
 		int8_t connected_hits = 0;
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			game_damage damage = hit;
 
 			if (damage != 0) {
@@ -842,7 +847,7 @@ auto player_handler::use_spell_attack(ref_ptr<player> player, packet_reader &rea
 		}
 	}
 
-	player->send_map(packets::players::use_spell_attack(player->get_id(), attack));
+	player->send_nearby(packets::players::use_spell_attack(player->get_id(), attack));
 
 	mp_eater_data eater;
 	eater.skill_id = player->get_skills()->get_mp_eater();
@@ -856,7 +861,7 @@ auto player_handler::use_spell_attack(ref_ptr<player> player, packet_reader &rea
 	bool reflect_applied = player->has_gm_benefits();
 	for (const auto &target : attack.damages) {
 		game_damage target_total = 0;
-		game_map_object map_mob_id = target.first;
+		game_map_object map_mob_id = target.get_map_mob_id();
 		int8_t connected_hits = 0;
 		auto mob = player->get_map()->get_mob(map_mob_id);
 		if (mob == nullptr) {
@@ -873,7 +878,7 @@ auto player_handler::use_spell_attack(ref_ptr<player> player, packet_reader &rea
 			reflect_applied = true;
 		}
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			game_damage damage = hit;
 			if (damage != 0) {
 				connected_hits++;
@@ -912,7 +917,7 @@ auto player_handler::use_spell_attack(ref_ptr<player> player, packet_reader &rea
 auto player_handler::use_energy_charge_attack(ref_ptr<player> player, packet_reader &reader) -> void {
 	attack_data attack = compile_attack(player, reader, data::type::skill_type::energy_charge);
 	game_skill_id mastery_id = player->get_skills()->get_mastery();
-	player->send_map(packets::players::use_energy_charge_attack(player->get_id(), mastery_id, player->get_skills()->get_skill_level(mastery_id), attack));
+	player->send_nearby(packets::players::use_energy_charge_attack(player->get_id(), mastery_id, player->get_skills()->get_skill_level(mastery_id), attack));
 
 	game_skill_id skill_id = attack.skill_id;
 	game_skill_level level = attack.skill_level;
@@ -920,7 +925,7 @@ auto player_handler::use_energy_charge_attack(ref_ptr<player> player, packet_rea
 
 	for (const auto &target : attack.damages) {
 		game_damage target_total = 0;
-		game_map_object map_mob_id = target.first;
+		game_map_object map_mob_id = target.get_map_mob_id();
 		int8_t connected_hits = 0;
 		auto mob = player->get_map()->get_mob(map_mob_id);
 		if (mob == nullptr) {
@@ -933,7 +938,7 @@ auto player_handler::use_energy_charge_attack(ref_ptr<player> player, packet_rea
 			reflect_applied = true;
 		}
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			game_damage damage = hit;
 			if (damage != 0) {
 				connected_hits++;
@@ -963,16 +968,16 @@ auto player_handler::use_summon_attack(ref_ptr<player> player, packet_reader &re
 		// Hacking or some other form of tomfoolery
 		return;
 	}
-	player->send_map(packets::players::use_summon_attack(player->get_id(), attack));
+	player->send_nearby(packets::players::use_summon_attack(player->get_id(), attack));
 	for (const auto &target : attack.damages) {
 		game_damage target_total = 0;
-		game_map_object map_mob_id = target.first;
+		game_map_object map_mob_id = target.get_map_mob_id();
 		int8_t connected_hits = 0;
 		auto mob = player->get_map()->get_mob(map_mob_id);
 		if (mob == nullptr) {
 			continue;
 		}
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			game_damage damage = hit;
 			if (damage != 0) {
 				connected_hits++;
@@ -1004,7 +1009,6 @@ auto player_handler::compile_attack(ref_ptr<player> player, packet_reader &reade
 	int8_t targets = 0;
 	int8_t hits = 0;
 	game_skill_id skill_id = 0;
-	bool meso_explosion = false;
 	bool shadow_meso = false;
 
 	if (skill_type != data::type::skill_type::summon) {
@@ -1030,7 +1034,6 @@ auto player_handler::compile_attack(ref_ptr<player> player, packet_reader &reade
 				break;
 			case constant::skill::chief_bandit::meso_explosion:
 				attack.is_meso_explosion = true;
-				meso_explosion = true;
 				break;
 			case constant::skill::cleric::heal:
 				attack.is_heal = true;
@@ -1092,40 +1095,7 @@ auto player_handler::compile_attack(ref_ptr<player> player, packet_reader &reade
 	attack.hits = hits;
 	attack.skill_id = skill_id;
 
-	for (int8_t i = 0; i < targets; ++i) {
-		game_map_object map_mob_id = reader.get<game_map_object>();
-		// hitAction is calculated using: rand() % hitAnimation + 7
-		// However, it doesn't match with the standard 6 outcome (when there's only 1 animation)
-		// This should be -1 when there's no hit animation
-		auto hitAction = reader.get<int8_t>();
-		
-		auto tmp = reader.get<uint8_t>();
-		// The imgActionNodeIndex is the wz property node index of the action/animation of the mob
-		// This would be used for mob position checking (in combination with frameIdx)
-		auto imgActionNodeIndex = (tmp & 0x7F);
-		auto facingLeft = (int)((tmp >> 7) & 1);
-
-		auto frameIdx = reader.get<int8_t>(); // Mob animation frame index
-
-		reader.skip<uint8_t>(); // Damage stats calculator index. Bit 8 == mob doomed
-		
-		reader.skip<point>(); // Mob pos
-		reader.skip<point>(); // Damage pos
-		if (!meso_explosion) {
-			reader.skip<uint16_t>(); // Delay per hit
-		}
-		else {
-			hits = reader.get<int8_t>(); // Hits for Meso Explosion
-		}
-		for (int8_t k = 0; k < hits; ++k) {
-			game_damage damage = reader.get<game_damage>();
-			attack.damages[map_mob_id].push_back(damage);
-			attack.total_damage += damage;
-		}
-		if (skill_type != data::type::skill_type::summon) {
-			reader.skip<game_checksum>();
-		}
-	}
+	attack.read_targets(reader, skill_type == data::type::skill_type::summon);
 
 	if (skill_type == data::type::skill_type::ranged) {
 		attack.projectile_pos = reader.get<point>();
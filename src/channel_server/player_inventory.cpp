@@ -34,13 +34,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/player.hpp"
 #include "channel_server/player_packet.hpp"
 #include "channel_server/player_packet_helper.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
 
-player_inventory::player_inventory(ref_ptr<player> player, const array<game_inventory_slot_count, constant::inventory::count> &max_slots, game_mesos mesos) :
-	m_max_slots{max_slots},
-	m_mesos{mesos},
+player_inventory::player_inventory(ref_ptr<player> player, const player_snapshot &snapshot) :
+	m_max_slots{snapshot.max_slots},
+	m_mesos{snapshot.mesos},
 	m_player{player}
 {
 	array<game_item_id, 2> init = {0};
@@ -49,7 +50,7 @@ player_inventory::player_inventory(ref_ptr<player> player, const array<game_inve
 		m_equipped[i] = init;
 	}
 
-	load();
+	load(snapshot);
 }
 
 player_inventory::~player_inventory() {
@@ -59,109 +60,164 @@ player_inventory::~player_inventory() {
 	}
 }
 
-auto player_inventory::load() -> void {
+auto player_inventory::load(const player_snapshot &snapshot) -> void {
 	if (auto player = m_player.lock()) {
-		using namespace soci;
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
-		game_player_id char_id = player->get_id();
-		string location = "inventory";
-
-		soci::rowset<> rs = (sql.prepare
-			<< "SELECT i.*, p.index, p.name AS pet_name, p.level, p.closeness, p.fullness "
-			<< "FROM " << db.make_table(vana::table::items) << " i "
-			<< "LEFT OUTER JOIN " << db.make_table(vana::table::pets) << " p ON i.pet_id = p.pet_id "
-			<< "WHERE i.location = :location AND i.character_id = :char",
-			soci::use(player->get_id(), "char"),
-			soci::use(location, "location"));
-
-		for (const auto &row : rs) {
-			item *item_record = new item(row);
-			add_item(row.get<game_inventory>("inv"), row.get<game_inventory_slot>("slot"), item_record, true);
-
-			if (item_record->get_pet_id() != 0) {
-				pet *pet_value = new pet{player.get(), item_record, row};
+		for (const auto &row : snapshot.items) {
+			item *item_record = new item{row.value};
+			add_item(row.inventory, row.slot, item_record, true);
+
+			if (row.pet.is_initialized()) {
+				pet *pet_value = new pet{player.get(), item_record, row.pet.get(), static_cast<int8_t>(row.slot)};
 				player->get_pets()->add_pet(pet_value);
 			}
 		}
 
-		rs = (sql.prepare << "SELECT t.map_index, t.map_id FROM " << db.make_table(vana::table::teleport_rock_locations) << " t WHERE t.character_id = :char",
-			soci::use(player->get_id(), "char"));
-
-		for (const auto &row : rs) {
-			int8_t index = row.get<int8_t>("map_index");
-			game_map_id map_id = row.get<game_map_id>("map_id");
-
-			if (index >= constant::inventory::teleport_rock_max) {
-				m_vip_locations.push_back(map_id);
+		for (const auto &rock : snapshot.teleport_rocks) {
+			if (rock.first >= constant::inventory::teleport_rock_max) {
+				m_vip_locations.push_back(rock.second);
 			}
 			else {
-				m_rock_locations.push_back(map_id);
+				m_rock_locations.push_back(rock.second);
 			}
 		}
+
+		m_saved_items.reset(get_item_rows());
+		m_saved_rocks.reset(get_rock_rows());
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_inventory::save() -> void {
+auto player_inventory::fill_snapshot(player_snapshot &snapshot) const -> void {
 	if (auto player = m_player.lock()) {
-		using namespace soci;
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
-		game_player_id char_id = player->get_id();
+		snapshot.max_slots = m_max_slots;
+		snapshot.mesos = get_mesos();
 
-		sql.once << "DELETE FROM " << db.make_table(vana::table::teleport_rock_locations) << " WHERE character_id = :char",
-			use(char_id, "char");
+		for (const auto &kvp : get_item_rows()) {
+			player_snapshot::inventory_row row;
+			row.inventory = kvp.first.first;
+			row.slot = kvp.first.second;
+			row.value = kvp.second;
+			if (pet *pet_value = player->get_pets()->get_pet(row.value.get_pet_id())) {
+				player_snapshot::pet_row pet_row;
+				pet_row.index = pet_value->get_index();
+				pet_row.name = pet_value->get_name();
+				pet_row.level = pet_value->get_level();
+				pet_row.closeness = pet_value->get_closeness();
+				pet_row.fullness = pet_value->get_fullness();
+				row.pet = pet_row;
+			}
+			snapshot.items.push_back(std::move(row));
+		}
 
-		if (m_rock_locations.size() > 0 || m_vip_locations.size() > 0) {
-			game_map_id map_id = 0;
-			size_t rock_index = 0;
+		for (const auto &kvp : get_rock_rows()) {
+			snapshot.teleport_rocks.emplace_back(kvp.first, kvp.second);
+		}
+	}
+	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
+}
 
-			statement st = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::teleport_rock_locations) << " "
-				<< "VALUES (:char, :i, :map)",
-				use(char_id, "char"),
-				use(map_id, "map"),
-				use(rock_index, "i"));
+auto player_inventory::save(vana::io::write_behind::batch &batch) -> void {
+	if (auto player = m_player.lock()) {
+		game_player_id char_id = player->get_id();
+		game_account_id account_id = player->get_account_id();
+		game_world_id world_id = player->get_world_id();
+
+		auto rock_changes = m_saved_rocks.diff(get_rock_rows(), batch);
+		if (!rock_changes.empty()) {
+			batch.add([char_id, rock_changes](vana::io::database &db) {
+				using namespace soci;
+				auto &sql = db.get_session();
+				int8_t rock_index = 0;
+				game_map_id map_id = 0;
+
+				if (rock_changes.deletes.size() > 0) {
+					statement st = (sql.prepare
+						<< "DELETE FROM " << db.make_table(vana::table::teleport_rock_locations) << " "
+						<< "WHERE character_id = :char AND map_index = :i",
+						use(char_id, "char"),
+						use(rock_index, "i"));
+
+					for (const auto &index : rock_changes.deletes) {
+						rock_index = index;
+						st.execute(true);
+					}
+				}
 
-			for (rock_index = 0; rock_index < m_rock_locations.size(); ++rock_index) {
-				map_id = m_rock_locations[rock_index];
-				st.execute(true);
-			}
+				if (rock_changes.upserts.size() > 0) {
+					statement st = (sql.prepare
+						<< "REPLACE INTO " << db.make_table(vana::table::teleport_rock_locations) << " "
+						<< "VALUES (:char, :i, :map)",
+						use(char_id, "char"),
+						use(map_id, "map"),
+						use(rock_index, "i"));
+
+					for (const auto &kvp : rock_changes.upserts) {
+						rock_index = kvp.first;
+						map_id = kvp.second;
+						st.execute(true);
+					}
+				}
+			});
+		}
+
+		auto item_changes = m_saved_items.diff(get_item_rows(), batch);
+		if (!item_changes.empty()) {
+			batch.add([char_id, account_id, world_id, item_changes](vana::io::database &db) mutable {
+				using namespace soci;
+				auto &sql = db.get_session();
+
+				if (item_changes.deletes.size() > 0) {
+					game_inventory inv = 0;
+					game_inventory_slot slot = 0;
+
+					statement st = (sql.prepare
+						<< "DELETE FROM " << db.make_table(vana::table::items) << " "
+						<< "WHERE location = :location AND character_id = :char AND inv = :inv AND slot = :slot",
+						use(item::inventory, "location"),
+						use(char_id, "char"),
+						use(inv, "inv"),
+						use(slot, "slot"));
+
+					for (const auto &key : item_changes.deletes) {
+						inv = key.first;
+						slot = key.second;
+						st.execute(true);
+					}
+				}
 
-			rock_index = constant::inventory::teleport_rock_max;
-			for (size_t i = 0; i < m_vip_locations.size(); ++i) {
-				map_id = m_vip_locations[i];
-				st.execute(true);
-				++rock_index;
-			}
-		}
+				vector<item_db_record> v;
+				for (auto &kvp : item_changes.upserts) {
+					v.emplace_back(kvp.first.second, char_id, account_id, world_id, item::inventory, &kvp.second);
+				}
 
-		sql.once
-			<< "DELETE FROM " << db.make_table(vana::table::items) << " "
-			<< "WHERE location = :inv AND character_id = :char",
-			use(char_id, "char"),
-			use(item::inventory, "inv");
+				if (v.size() > 0) {
+					item::database_insert(db, v, true);
+				}
+			});
+		}
+	}
+	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
+}
 
-		vector<item_db_record> v;
-		for (game_inventory i = constant::inventory::equip; i <= constant::inventory::count; ++i) {
-			const auto &items_inv = m_items[i - 1];
-			for (const auto &kvp : items_inv) {
-				item_db_record rec{
-					kvp.first,
-					char_id,
-					player->get_account_id(),
-					player->get_world_id(),
-					item::inventory,
-					kvp.second
-				};
-				v.push_back(rec);
-			}
+auto player_inventory::get_item_rows() const -> item_tracker::rows {
+	item_tracker::rows rows;
+	for (game_inventory i = constant::inventory::equip; i <= constant::inventory::count; ++i) {
+		for (const auto &kvp : m_items[i - 1]) {
+			rows.emplace(std::make_pair(i, kvp.first), item{kvp.second});
 		}
+	}
+	return rows;
+}
 
-		item::database_insert(db, v);
+auto player_inventory::get_rock_rows() const -> rock_tracker::rows {
+	rock_tracker::rows rows;
+	for (size_t i = 0; i < m_rock_locations.size(); ++i) {
+		rows[static_cast<int8_t>(i)] = m_rock_locations[i];
 	}
-	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
+	for (size_t i = 0; i < m_vip_locations.size(); ++i) {
+		rows[static_cast<int8_t>(constant::inventory::teleport_rock_max + i)] = m_vip_locations[i];
+	}
+	return rows;
 }
 
 auto player_inventory::add_max_slots(game_inventory inventory, game_inventory_slot_count rows) -> void {
@@ -18,6 +18,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/constant/inventory.hpp"
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/item.hpp"
 #include "common/types.hpp"
 #include "common/util/meso_inventory.hpp"
@@ -32,16 +34,18 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		class player_inventory {
 			NONCOPYABLE(player_inventory);
 			NO_DEFAULT_CONSTRUCTOR(player_inventory);
 		public:
-			player_inventory(ref_ptr<player> player, const array<game_inventory_slot_count, constant::inventory::count> &max_slots, game_mesos mesos);
+			player_inventory(ref_ptr<player> player, const player_snapshot &snapshot);
 			~player_inventory();
 
-			auto load() -> void;
-			auto save() -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto save(vana::io::write_behind::batch &batch) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 
 			auto connect_packet(packet_builder &builder) -> void;
 			auto add_equipped_packet(packet_builder &builder) -> void;
@@ -93,8 +97,13 @@ namespace vana {
 			auto add_wish_list_item(game_item_id item_id) -> void;
 			auto check_expired_items() -> void;
 		private:
+			using item_tracker = vana::io::row_tracker<pair<game_inventory, game_inventory_slot>, item>;
+			using rock_tracker = vana::io::row_tracker<int8_t, game_map_id>;
+
 			auto add_equipped(game_inventory_slot slot, game_item_id item_id) -> void;
 			auto modify_mesos_internal(vana::util::meso_modify_result query, bool send_packet) -> vana::util::meso_modify_result;
+			auto get_item_rows() const -> item_tracker::rows;
+			auto get_rock_rows() const -> rock_tracker::rows;
 
 			game_inventory_slot m_hammer = -1;
 			game_item_id m_auto_hp_pot_id = 0;
@@ -108,6 +117,8 @@ namespace vana {
 			vector<game_map_id> m_rock_locations;
 			vector<game_item_id> m_wishlist;
 			hash_map<game_item_id, game_slot_qty> m_item_amounts;
+			item_tracker m_saved_items;
+			rock_tracker m_saved_rocks;
 		};
 	}
 }
\ No newline at end of file
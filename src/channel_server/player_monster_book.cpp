@@ -22,69 +22,86 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/channel_server.hpp"
 #include "channel_server/monster_book_packet.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
 
-player_monster_book::player_monster_book(ref_ptr<player> player) :
+player_monster_book::player_monster_book(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
-auto player_monster_book::load() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	if (auto player = m_player.lock()) {
-		game_player_id char_id = player->get_id();
-
-		soci::rowset<> rs = (sql.prepare
-			<< "SELECT b.card_id, b.level "
-			<< "FROM " << db.make_table(vana::table::monster_book) << " b "
-			<< "WHERE b.character_id = :char "
-			<< "ORDER BY b.card_id ASC",
-			soci::use(char_id, "char"));
+auto player_monster_book::load(const player_snapshot &snapshot) -> void {
+	for (const auto &row : snapshot.monster_book) {
+		add_card(row.first, row.second, true);
+	}
 
-		for (const auto &row : rs) {
-			add_card(row.get<game_item_id>("card_id"), row.get<uint8_t>("level"), true);
-		}
+	calculate_level();
+	m_saved_cards.reset(get_card_rows());
+}
 
-		calculate_level();
+auto player_monster_book::fill_snapshot(player_snapshot &snapshot) const -> void {
+	snapshot.book_cover = m_cover;
+	for (const auto &kvp : get_card_rows()) {
+		snapshot.monster_book.emplace_back(kvp.first, kvp.second);
 	}
-	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_monster_book::save() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
+auto player_monster_book::save(vana::io::write_behind::batch &batch) -> void {
 	if (auto player = m_player.lock()) {
 		game_player_id char_id = player->get_id();
 
-		sql.once << "DELETE FROM " << db.make_table(vana::table::monster_book) << " WHERE character_id = :char",
-			soci::use(char_id, "char");
+		auto changes = m_saved_cards.diff(get_card_rows(), batch);
+		if (changes.empty()) {
+			return;
+		}
 
-		if (m_cards.size() > 0) {
+		batch.add([char_id, changes](vana::io::database &db) {
+			auto &sql = db.get_session();
 			game_item_id card_id = 0;
 			uint8_t level = 0;
 
-			soci::statement st = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::monster_book) << " "
-				<< "VALUES (:char, :card, :level) ",
-				soci::use(char_id, "char"),
-				soci::use(card_id, "card"),
-				soci::use(level, "level"));
-
-			for (const auto &kvp : m_cards) {
-				const monster_card &c = kvp.second;
-				card_id = c.id;
-				level = c.level;
-				st.execute(true);
+			if (changes.deletes.size() > 0) {
+				soci::statement st = (sql.prepare
+					<< "DELETE FROM " << db.make_table(vana::table::monster_book) << " WHERE character_id = :char AND card_id = :card",
+					soci::use(char_id, "char"),
+					soci::use(card_id, "card"));
+
+				for (const auto &card : changes.deletes) {
+					card_id = card;
+					st.execute(true);
+				}
 			}
-		}
+
+			if (changes.upserts.size() > 0) {
+				soci::statement st = (sql.prepare
+					<< "REPLACE INTO " << db.make_table(vana::table::monster_book) << " "
+					<< "VALUES (:char, :card, :level) ",
+					soci::use(char_id, "char"),
+					soci::use(card_id, "card"),
+					soci::use(level, "level"));
+
+				for (const auto &kvp : changes.upserts) {
+					card_id = kvp.first;
+					level = kvp.second;
+					st.execute(true);
+				}
+			}
+		});
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
+auto player_monster_book::get_card_rows() const -> card_tracker::rows {
+	card_tracker::rows rows;
+	for (const auto &kvp : m_cards) {
+		rows[kvp.first] = kvp.second.level;
+	}
+	return rows;
+}
+
 auto player_monster_book::get_card_level(int32_t card_id) -> uint8_t {
 	return m_cards[card_id].level;
 }
@@ -18,6 +18,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #pragma once
 
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/types.hpp"
 #include <unordered_map>
 
@@ -26,6 +28,7 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		struct monster_card {
 			monster_card() = default;
@@ -39,10 +42,11 @@ namespace vana {
 			NONCOPYABLE(player_monster_book);
 			NO_DEFAULT_CONSTRUCTOR(player_monster_book);
 		public:
-			player_monster_book(ref_ptr<player> player);
+			player_monster_book(ref_ptr<player> player, const player_snapshot &snapshot);
 
-			auto load() -> void;
-			auto save() -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto save(vana::io::write_behind::batch &batch) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 			auto connect_packet(packet_builder &builder) -> void;
 			auto info_packet(packet_builder &builder) -> void;
 
@@ -59,12 +63,17 @@ namespace vana {
 			auto get_cover() const -> int32_t { return m_cover; }
 			auto is_full(game_item_id card_id) -> bool;
 		private:
+			using card_tracker = vana::io::row_tracker<game_item_id, uint8_t>;
+
+			auto get_card_rows() const -> card_tracker::rows;
+
 			int32_t m_special_count = 0;
 			int32_t m_normal_count = 0;
 			int32_t m_level = 1;
 			int32_t m_cover = 0;
 			view_ptr<player> m_player;
 			hash_map<game_item_id, monster_card> m_cards;
+			card_tracker m_saved_cards;
 		};
 	}
 }
\ No newline at end of file
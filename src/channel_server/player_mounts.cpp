@@ -18,70 +18,97 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "player_mounts.hpp"
 #include "common/io/database.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
 
-player_mounts::player_mounts(ref_ptr<player> player) :
+player_mounts::player_mounts(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
-auto player_mounts::save() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
+auto player_mounts::save(vana::io::write_behind::batch &batch) -> void {
 	if (auto player = m_player.lock()) {
 		game_player_id char_id = player->get_id();
-		game_item_id item_id = 0;
-		int16_t exp = 0;
-		uint8_t tiredness = 0;
-		uint8_t level = 0;
-
-		sql.once << "DELETE FROM " << db.make_table(vana::table::mounts) << " WHERE character_id = :char",
-			soci::use(char_id, "char");
-
-		if (m_mounts.size() > 0) {
-			soci::statement st = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::mounts) << " "
-				<< "VALUES (:char, :item, :exp, :level, :tiredness) ",
-				soci::use(char_id, "char"),
-				soci::use(item_id, "item"),
-				soci::use(exp, "exp"),
-				soci::use(level, "level"),
-				soci::use(tiredness, "tiredness"));
-
-			for (const auto &kvp : m_mounts) {
-				const mount_data &c = kvp.second;
-				item_id = kvp.first;
-				exp = c.exp;
-				level = c.level;
-				tiredness = c.tiredness;
-				st.execute(true);
-			}
+
+		auto changes = m_saved_mounts.diff(get_mount_rows(), batch);
+		if (changes.empty()) {
+			return;
 		}
+
+		batch.add([char_id, changes](vana::io::database &db) {
+			auto &sql = db.get_session();
+			game_item_id item_id = 0;
+			int16_t exp = 0;
+			uint8_t tiredness = 0;
+			uint8_t level = 0;
+
+			if (changes.deletes.size() > 0) {
+				soci::statement st = (sql.prepare
+					<< "DELETE FROM " << db.make_table(vana::table::mounts) << " WHERE character_id = :char AND mount_id = :item",
+					soci::use(char_id, "char"),
+					soci::use(item_id, "item"));
+
+				for (const auto &mount : changes.deletes) {
+					item_id = mount;
+					st.execute(true);
+				}
+			}
+
+			if (changes.upserts.size() > 0) {
+				soci::statement st = (sql.prepare
+					<< "REPLACE INTO " << db.make_table(vana::table::mounts) << " "
+					<< "VALUES (:char, :item, :exp, :level, :tiredness) ",
+					soci::use(char_id, "char"),
+					soci::use(item_id, "item"),
+					soci::use(exp, "exp"),
+					soci::use(level, "level"),
+					soci::use(tiredness, "tiredness"));
+
+				for (const auto &kvp : changes.upserts) {
+					item_id = kvp.first;
+					exp = std::get<0>(kvp.second);
+					level = std::get<1>(kvp.second);
+					tiredness = std::get<2>(kvp.second);
+					st.execute(true);
+				}
+			}
+		});
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_mounts::load() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	if (auto player = m_player.lock()) {
-		game_player_id char_id = player->get_id();
+auto player_mounts::get_mount_rows() const -> mount_tracker::rows {
+	mount_tracker::rows rows;
+	for (const auto &kvp : m_mounts) {
+		rows.emplace(kvp.first, std::make_tuple(kvp.second.exp, kvp.second.level, kvp.second.tiredness));
+	}
+	return rows;
+}
 
-		soci::rowset<> rs = (sql.prepare << "SELECT m.* FROM " << db.make_table(vana::table::mounts) << " m WHERE m.character_id = :char ",
-			soci::use(char_id, "char"));
+auto player_mounts::load(const player_snapshot &snapshot) -> void {
+	for (const auto &row : snapshot.mounts) {
+		mount_data c;
+		c.exp = row.exp;
+		c.level = row.level;
+		c.tiredness = row.tiredness;
+		m_mounts[row.mount_id] = c;
+	}
 
-		for (const auto &row : rs) {
-			mount_data c;
-			c.exp = row.get<int16_t>("exp");
-			c.level = row.get<int8_t>("level");
-			c.tiredness = row.get<int8_t>("tiredness");
-			m_mounts[row.get<game_item_id>("mount_id")] = c;
-		}
+	m_saved_mounts.reset(get_mount_rows());
+}
+
+auto player_mounts::fill_snapshot(player_snapshot &snapshot) const -> void {
+	for (const auto &kvp : m_mounts) {
+		player_snapshot::mount_row row;
+		row.mount_id = kvp.first;
+		row.exp = kvp.second.exp;
+		row.level = kvp.second.level;
+		row.tiredness = kvp.second.tiredness;
+		snapshot.mounts.push_back(row);
 	}
-	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
 auto player_mounts::get_current_exp() -> int16_t {
@@ -17,7 +17,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/types.hpp"
+#include <tuple>
 #include <unordered_map>
 
 namespace vana {
@@ -25,6 +28,7 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		struct mount_data {
 			int16_t exp = 0;
@@ -36,10 +40,11 @@ namespace vana {
 			NONCOPYABLE(player_mounts);
 			NO_DEFAULT_CONSTRUCTOR(player_mounts);
 		public:
-			player_mounts(ref_ptr<player> player);
+			player_mounts(ref_ptr<player> player, const player_snapshot &snapshot);
 
-			auto save() -> void;
-			auto load() -> void;
+			auto save(vana::io::write_behind::batch &batch) -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 
 			auto mount_info_packet(packet_builder &builder) -> void;
 			auto mount_info_map_spawn_packet(packet_builder &builder) -> void;
@@ -59,9 +64,14 @@ namespace vana {
 			auto get_mount_level(game_item_id id) -> int8_t;
 			auto get_mount_tiredness(game_item_id id) -> int8_t;
 		private:
+			using mount_tracker = vana::io::row_tracker<game_item_id, tuple<int16_t, int8_t, int8_t>>;
+
+			auto get_mount_rows() const -> mount_tracker::rows;
+
 			game_item_id m_current_mount = 0;
 			view_ptr<player> m_player;
 			hash_map<game_item_id, mount_data> m_mounts;
+			mount_tracker m_saved_mounts;
 		};
 	}
 }
\ No newline at end of file
@@ -48,9 +48,20 @@ auto player_pets::get_summoned(int8_t index) -> pet * {
 	return m_summoned[index] > 0 ? m_pets[m_summoned[index]] : nullptr;
 }
 
-auto player_pets::save() -> void {
-	if (m_pets.size() > 0) {
-		auto &db = vana::io::database::get_char_db();
+auto player_pets::save(vana::io::write_behind::batch &batch) -> void {
+	pet_tracker::rows rows;
+	for (const auto &kvp : m_pets) {
+		pet *p = kvp.second;
+		rows.emplace(kvp.first, std::make_tuple(p->get_index(), p->get_name(), p->get_level(), p->get_closeness(), p->get_fullness()));
+	}
+
+	// Pet rows are created and removed along with their items, only updates are written here
+	auto changes = m_saved_pets.diff(std::move(rows), batch);
+	if (changes.upserts.size() == 0) {
+		return;
+	}
+
+	batch.add([changes](vana::io::database &db) {
 		auto &sql = db.get_session();
 		opt_int8_t index = 0;
 		string name = "";
@@ -75,17 +86,16 @@ auto player_pets::save() -> void {
 			soci::use(closeness, "closeness"),
 			soci::use(fullness, "fullness"));
 
-		for (const auto &kvp : m_pets) {
-			pet *p = kvp.second;
-			index = p->get_index();
-			name = p->get_name();
-			level = p->get_level();
-			closeness = p->get_closeness();
-			fullness = p->get_fullness();
-			pet_id = p->get_id();
+		for (const auto &kvp : changes.upserts) {
+			pet_id = kvp.first;
+			index = std::get<0>(kvp.second);
+			name = std::get<1>(kvp.second);
+			level = std::get<2>(kvp.second);
+			closeness = std::get<3>(kvp.second);
+			fullness = std::get<4>(kvp.second);
 			st.execute(true);
 		}
-	}
+	});
 }
 
 auto player_pets::pet_info_packet(packet_builder &builder) -> void {
@@ -17,7 +17,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/types.hpp"
+#include <string>
+#include <tuple>
 #include <unordered_map>
 
 namespace vana {
@@ -33,7 +37,7 @@ namespace vana {
 		public:
 			player_pets(ref_ptr<player> player);
 
-			auto save() -> void;
+			auto save(vana::io::write_behind::batch &batch) -> void;
 			auto pet_info_packet(packet_builder &builder) -> void;
 			auto connect_packet(packet_builder &builder) -> void;
 
@@ -43,9 +47,12 @@ namespace vana {
 			auto add_pet(pet *pet) -> void;
 			auto set_summoned(int8_t index, game_pet_id pet_id) -> void;
 		private:
+			using pet_tracker = vana::io::row_tracker<game_pet_id, tuple<opt_int8_t, string, int8_t, int16_t, int8_t>>;
+
 			view_ptr<player> m_player;
 			hash_map<game_pet_id, pet *> m_pets;
 			hash_map<int8_t, game_pet_id> m_summoned;
+			pet_tracker m_saved_pets;
 		};
 	}
 }
\ No newline at end of file
@@ -25,146 +25,203 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/channel_server.hpp"
 #include "channel_server/inventory.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 #include "channel_server/quests_packet.hpp"
 #include <array>
 
 namespace vana {
 namespace channel_server {
 
-player_quests::player_quests(ref_ptr<player> player) :
+player_quests::player_quests(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
-auto player_quests::save() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
+auto player_quests::save(vana::io::write_behind::batch &batch) -> void {
 	if (auto player = m_player.lock()) {
 		game_player_id char_id = player->get_id();
-		game_quest_id quest_id = 0;
-
-		sql.once << "DELETE FROM " << db.make_table(vana::table::active_quests) << " WHERE character_id = :char",
-			soci::use(char_id, "char");
-		sql.once << "DELETE FROM " << db.make_table(vana::table::completed_quests) << " WHERE character_id = :char",
-			soci::use(char_id, "char");
-
-		if (m_quests.size() > 0) {
-			game_mob_id mob_id = 0;
-			uint16_t killed = 0;
-			int64_t id = 0;
-			opt_string data;
-			// GCC, as usual, bad with operators
-			data = "";
-
-			soci::statement st = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::active_quests) << " (character_id, quest_id, data) "
-				<< "VALUES (:char, :quest, :data)",
-				soci::use(char_id, "char"),
-				soci::use(quest_id, "quest"),
-				soci::use(data, "data"));
-
-			soci::statement st_mobs = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::active_quests_mobs) << " (active_quest_id, mob_id, quantity_killed) "
-				<< "VALUES (:id, :mob, :killed)",
-				soci::use(id, "id"),
-				soci::use(mob_id, "mob"),
-				soci::use(killed, "killed"));
-
-			for (const auto &kvp : m_quests) {
-				const string &d = kvp.second.data;
-				quest_id = kvp.first;
-				if (d.empty()) {
-					data.reset();
-				}
-				else {
-					data = d;
+
+		auto active_changes = m_saved_active.diff(get_active_rows(), batch);
+		if (!active_changes.empty()) {
+			batch.add([char_id, active_changes](vana::io::database &db) {
+				auto &sql = db.get_session();
+				game_quest_id quest_id = 0;
+
+				// Kill counts hang off the generated row ID, so a changed quest is rewritten along with its mobs
+				soci::statement st_delete = (sql.prepare
+					<< "DELETE FROM " << db.make_table(vana::table::active_quests) << " WHERE character_id = :char AND quest_id = :quest",
+					soci::use(char_id, "char"),
+					soci::use(quest_id, "quest"));
+
+				for (const auto &quest : active_changes.deletes) {
+					quest_id = quest;
+					st_delete.execute(true);
 				}
-				st.execute(true);
-
-				if (kvp.second.kills.size() > 0) {
-					id = db.get_last_id<int64_t>();
-					for (const auto &kill_pair : kvp.second.kills) {
-						mob_id = kill_pair.first;
-						killed = kill_pair.second;
-						st_mobs.execute(true);
+
+				if (active_changes.upserts.size() > 0) {
+					game_mob_id mob_id = 0;
+					uint16_t killed = 0;
+					int64_t id = 0;
+					opt_string data;
+					// GCC, as usual, bad with operators
+					data = "";
+
+					soci::statement st = (sql.prepare
+						<< "INSERT INTO " << db.make_table(vana::table::active_quests) << " (character_id, quest_id, data) "
+						<< "VALUES (:char, :quest, :data)",
+						soci::use(char_id, "char"),
+						soci::use(quest_id, "quest"),
+						soci::use(data, "data"));
+
+					soci::statement st_mobs = (sql.prepare
+						<< "INSERT INTO " << db.make_table(vana::table::active_quests_mobs) << " (active_quest_id, mob_id, quantity_killed) "
+						<< "VALUES (:id, :mob, :killed)",
+						soci::use(id, "id"),
+						soci::use(mob_id, "mob"),
+						soci::use(killed, "killed"));
+
+					for (const auto &kvp : active_changes.upserts) {
+						const string &d = kvp.second.first;
+						quest_id = kvp.first;
+						st_delete.execute(true);
+
+						if (d.empty()) {
+							data.reset();
+						}
+						else {
+							data = d;
+						}
+						st.execute(true);
+
+						if (kvp.second.second.size() > 0) {
+							id = db.get_last_id<int64_t>();
+							for (const auto &kill_pair : kvp.second.second) {
+								mob_id = kill_pair.first;
+								killed = kill_pair.second;
+								st_mobs.execute(true);
+							}
+						}
 					}
 				}
-			}
+			});
 		}
 
-		if (m_completed.size() > 0) {
-			int64_t time = 0;
-
-			soci::statement st = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::completed_quests) << " "
-				<< "VALUES (:char, :quest, :time)",
-				soci::use(char_id, "char"),
-				soci::use(quest_id, "quest"),
-				soci::use(time, "time"));
+		auto completed_changes = m_saved_completed.diff(get_completed_rows(), batch);
+		if (!completed_changes.empty()) {
+			batch.add([char_id, completed_changes](vana::io::database &db) {
+				auto &sql = db.get_session();
+				game_quest_id quest_id = 0;
+				int64_t time = 0;
+
+				if (completed_changes.deletes.size() > 0) {
+					soci::statement st = (sql.prepare
+						<< "DELETE FROM " << db.make_table(vana::table::completed_quests) << " WHERE character_id = :char AND quest_id = :quest",
+						soci::use(char_id, "char"),
+						soci::use(quest_id, "quest"));
+
+					for (const auto &quest : completed_changes.deletes) {
+						quest_id = quest;
+						st.execute(true);
+					}
+				}
 
-			for (const auto &kvp : m_completed) {
-				quest_id = kvp.first;
-				time = kvp.second.get_value();
-				st.execute(true);
-			}
+				if (completed_changes.upserts.size() > 0) {
+					soci::statement st = (sql.prepare
+						<< "REPLACE INTO " << db.make_table(vana::table::completed_quests) << " "
+						<< "VALUES (:char, :quest, :time)",
+						soci::use(char_id, "char"),
+						soci::use(quest_id, "quest"),
+						soci::use(time, "time"));
+
+					for (const auto &kvp : completed_changes.upserts) {
+						quest_id = kvp.first;
+						time = kvp.second;
+						st.execute(true);
+					}
+				}
+			});
 		}
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_quests::load() -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	if (auto player = m_player.lock()) {
-		game_player_id char_id = player->get_id();
-		game_quest_id previous = 0;
-		game_quest_id current = 0;
-		bool init = true;
-		active_quest cur_quest;
-
-		soci::rowset<> rs = (sql.prepare
-			<< "SELECT a.quest_id, am.mob_id, am.quantity_killed, a.data "
-			<< "FROM " << db.make_table(vana::table::active_quests) << " a "
-			<< "LEFT OUTER JOIN " << db.make_table(vana::table::active_quests_mobs) << " am ON am.active_quest_id = a.id "
-			<< "WHERE a.character_id = :char ORDER BY a.quest_id ASC",
-			soci::use(char_id, "char"));
-
-		for (const auto &row : rs) {
-			current = row.get<game_quest_id>("quest_id");
-			game_mob_id mob = row.get<game_mob_id>("mob_id");
-			string data = row.get<string>("data");
-
-			if (init) {
-				cur_quest.id = current;
-				cur_quest.data = data;
-				init = false;
-			}
-			else if (previous != -1 && current != previous) {
-				m_quests[previous] = cur_quest;
-				cur_quest = active_quest{};
-				cur_quest.id = current;
-				cur_quest.data = data;
-			}
-			if (mob != 0) {
-				uint16_t kills = row.get<uint16_t>("quantity_killed");
-				cur_quest.kills[mob] = kills;
-				m_mob_to_quest_mapping[mob].push_back(current);
-			}
-			previous = current;
+auto player_quests::get_active_rows() const -> active_quest_tracker::rows {
+	active_quest_tracker::rows rows;
+	for (const auto &kvp : m_quests) {
+		rows.emplace(kvp.first, std::make_pair(kvp.second.data, kvp.second.kills));
+	}
+	return rows;
+}
+
+auto player_quests::get_completed_rows() const -> completed_quest_tracker::rows {
+	completed_quest_tracker::rows rows;
+	for (const auto &kvp : m_completed) {
+		rows[kvp.first] = kvp.second.get_value();
+	}
+	return rows;
+}
+
+auto player_quests::load(const player_snapshot &snapshot) -> void {
+	game_quest_id previous = 0;
+	game_quest_id current = 0;
+	bool init = true;
+	active_quest cur_quest;
+
+	for (const auto &row : snapshot.active_quests) {
+		current = row.quest_id;
+		game_mob_id mob = row.mob_id;
+
+		if (init) {
+			cur_quest.id = current;
+			cur_quest.data = row.data;
+			init = false;
 		}
-		if (!init) {
+		else if (previous != -1 && current != previous) {
 			m_quests[previous] = cur_quest;
+			cur_quest = active_quest{};
+			cur_quest.id = current;
+			cur_quest.data = row.data;
 		}
+		if (mob != 0) {
+			cur_quest.kills[mob] = row.kills;
+			m_mob_to_quest_mapping[mob].push_back(current);
+		}
+		previous = current;
+	}
+	if (!init) {
+		m_quests[previous] = cur_quest;
+	}
 
-		rs = (sql.prepare << "SELECT c.quest_id, c.end_time FROM " << db.make_table(vana::table::completed_quests) << " c WHERE c.character_id = :char",
-			soci::use(char_id, "char"));
+	for (const auto &row : snapshot.completed_quests) {
+		m_completed[row.first] = file_time{row.second};
+	}
 
-		for (const auto &row : rs) {
-			m_completed[row.get<game_quest_id>("quest_id")] = file_time{row.get<int64_t>("end_time")};
+	m_saved_active.reset(get_active_rows());
+	m_saved_completed.reset(get_completed_rows());
+}
+
+auto player_quests::fill_snapshot(player_snapshot &snapshot) const -> void {
+	for (const auto &kvp : m_quests) {
+		const auto &quest = kvp.second;
+		player_snapshot::active_quest_row row;
+		row.quest_id = kvp.first;
+		row.data = quest.data;
+		if (quest.kills.empty()) {
+			snapshot.active_quests.push_back(row);
+			continue;
+		}
+		// One row per mob, the same shape the database join produces
+		for (const auto &kill : quest.kills) {
+			row.mob_id = kill.first;
+			row.kills = kill.second;
+			snapshot.active_quests.push_back(row);
 		}
 	}
-	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
+
+	for (const auto &kvp : m_completed) {
+		snapshot.completed_quests.emplace_back(kvp.first, kvp.second.get_value());
+	}
 }
 
 auto player_quests::add_quest(game_quest_id quest_id, game_npc_id npc_id) -> void {
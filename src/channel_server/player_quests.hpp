@@ -19,6 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "common/data/provider/quest.hpp"
 #include "common/file_time.hpp"
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/quest.hpp"
 #include "common/types.hpp"
 #include "channel_server/quests.hpp"
@@ -34,6 +36,7 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		struct active_quest {
 			auto get_quest_data() const -> string {
@@ -65,10 +68,11 @@ namespace vana {
 			NONCOPYABLE(player_quests);
 			NO_DEFAULT_CONSTRUCTOR(player_quests);
 		public:
-			player_quests(ref_ptr<player> player);
+			player_quests(ref_ptr<player> player, const player_snapshot &snapshot);
 
-			auto load() -> void;
-			auto save() -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto save(vana::io::write_behind::batch &batch) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 			auto connect_packet(packet_builder &builder) -> void;
 
 			auto item_drop_allowed(game_item_id item_id, game_quest_id quest_id) -> allow_quest_item_result;
@@ -82,12 +86,19 @@ namespace vana {
 			auto set_quest_data(game_quest_id id, const string &data) -> void;
 			auto get_quest_data(game_quest_id id) -> string;
 		private:
+			using active_quest_tracker = vana::io::row_tracker<game_quest_id, pair<string, ord_map<game_mob_id, uint16_t>>>;
+			using completed_quest_tracker = vana::io::row_tracker<game_quest_id, int64_t>;
+
 			auto give_rewards(game_quest_id quest_id, bool start) -> result;
+			auto get_active_rows() const -> active_quest_tracker::rows;
+			auto get_completed_rows() const -> completed_quest_tracker::rows;
 
 			view_ptr<player> m_player;
 			hash_map<game_mob_id, vector<game_quest_id>> m_mob_to_quest_mapping;
 			ord_map<game_quest_id, active_quest> m_quests;
 			ord_map<game_quest_id, file_time> m_completed;
+			active_quest_tracker m_saved_active;
+			completed_quest_tracker m_saved_completed;
 		};
 	}
 }
\ No newline at end of file
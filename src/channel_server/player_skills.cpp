@@ -32,144 +32,156 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/party.hpp"
 #include "channel_server/party_packet.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 #include "channel_server/skills.hpp"
 #include "channel_server/skills_packet.hpp"
 
 namespace vana {
 namespace channel_server {
 
-player_skills::player_skills(ref_ptr<player> player) :
+player_skills::player_skills(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
-auto player_skills::load() -> void {
+auto player_skills::load(const player_snapshot &snapshot) -> void {
 	if (auto player = m_player.lock()) {
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
 		player_skill_info skill;
-		game_player_id player_id = player->get_id();
-		game_skill_id skill_id = 0;
-
-		soci::rowset<> rs = (sql.prepare
-			<< "SELECT s.skill_id, s.points, s.max_level "
-			<< "FROM " << db.make_table(vana::table::skills) << " s "
-			<< "WHERE s.character_id = :char",
-			soci::use(player_id, "char"));
 
-		for (const auto &row : rs) {
-			skill_id = row.get<game_skill_id>("skill_id");
-			if (vana::util::game_logic::player_skill::is_blessing_of_the_fairy(skill_id)) {
+		for (const auto &row : snapshot.skills) {
+			if (vana::util::game_logic::player_skill::is_blessing_of_the_fairy(row.skill_id)) {
 				continue;
 			}
 
 			skill = player_skill_info{};
-			skill.level = row.get<game_skill_level>("points");
-			skill.max_skill_level = channel_server::get_instance().get_skill_data_provider().get_max_level(skill_id);
-			skill.player_max_skill_level = row.get<game_skill_level>("max_level");
-			m_skills[skill_id] = skill;
+			skill.level = row.points;
+			skill.max_skill_level = channel_server::get_instance().get_skill_data_provider().get_max_level(row.skill_id);
+			skill.player_max_skill_level = row.max_level;
+			m_skills[row.skill_id] = skill;
 		}
 
-		rs = (sql.prepare
-			<< "SELECT c.* "
-			<< "FROM " << db.make_table(vana::table::cooldowns) << " c "
-			<< "WHERE c.character_id = :char",
-			soci::use(player_id, "char"));
-
-		for (const auto &row : rs) {
-			game_skill_id skill_id = row.get<game_skill_id>("skill_id");
-			seconds time_left = seconds{row.get<int16_t>("remaining_time")};
-			skills::start_cooldown(player, skill_id, time_left, true);
-			m_cooldowns[skill_id] = time_left;
-		}
-
-		skill_id = get_blessing_of_the_fairy();
-
-		opt_string blessing_player_name;
-		optional<game_player_level> blessing_player_level;
-
-		game_account_id account_id = player->get_account_id();
-		game_world_id world_id = player->get_world_id();
-
-		// TODO FIXME skill
-		// Allow Cygnus <-> Adventurer selection here or allow it to be ignored
-		// That is, some versions only allowed Adv. Blessing to be populated by Cygnus levels and vice versa
-		// Some later versions lifted this restriction entirely
-		sql.once
-			<< "SELECT c.name, c.level "
-			<< "FROM " << db.make_table(vana::table::characters) << " c "
-			<< "WHERE c.world_id = :world AND c.account_id = :account AND c.character_id <> :char "
-			<< "ORDER BY c.level DESC "
-			<< "LIMIT 1 ",
-			soci::use(account_id, "account"),
-			soci::use(world_id, "world"),
-			soci::use(player_id, "char"),
-			soci::into(blessing_player_name),
-			soci::into(blessing_player_level);
-
-		if (blessing_player_level.is_initialized()) {
+		m_saved_skills.reset(get_skill_rows());
+
+		for (const auto &row : snapshot.cooldowns) {
+			seconds time_left = seconds{row.second};
+			skills::start_cooldown(player, row.first, time_left, true);
+			m_cooldowns[row.first] = time_left;
+		}
+
+		if (snapshot.blessing_player_level.is_initialized()) {
+			game_skill_id skill_id = get_blessing_of_the_fairy();
 			skill = player_skill_info{};
 			skill.max_skill_level = channel_server::get_instance().get_skill_data_provider().get_max_level(skill_id);
-			skill.level = std::min<game_skill_level>(blessing_player_level.get() / 10, skill.max_skill_level);
-			m_blessing_player = blessing_player_name.get();
+			skill.level = std::min<game_skill_level>(snapshot.blessing_player_level.get() / 10, skill.max_skill_level);
+			m_blessing_player = snapshot.blessing_player_name.get();
 			m_skills[skill_id] = skill;
 		}
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_skills::save(bool save_cooldowns) -> void {
+auto player_skills::fill_snapshot(player_snapshot &snapshot) const -> void {
 	if (auto player = m_player.lock()) {
-		using namespace soci;
-		game_player_id player_id = player->get_id();
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
-
-		game_skill_id skill_id = 0;
-		game_skill_level level = 0;
-		game_skill_level max_level = 0;
-		statement st = (sql.prepare
-			<< "REPLACE INTO " << db.make_table(vana::table::skills) << " VALUES (:player, :skill, :level, :max_level)",
-			use(player_id, "player"),
-			use(skill_id, "skill"),
-			use(level, "level"),
-			use(max_level, "max_level"));
-
-		for (const auto &kvp : m_skills) {
-			if (vana::util::game_logic::player_skill::is_blessing_of_the_fairy(kvp.first)) {
-				continue;
-			}
-			skill_id = kvp.first;
-			level = kvp.second.level;
-			max_level = kvp.second.player_max_skill_level;
-			st.execute(true);
+		for (const auto &kvp : get_skill_rows()) {
+			player_snapshot::skill_row row;
+			row.skill_id = kvp.first;
+			row.points = kvp.second.first;
+			row.max_level = kvp.second.second;
+			snapshot.skills.push_back(row);
 		}
 
-		if (save_cooldowns) {
-			sql.once << "DELETE FROM " << db.make_table(vana::table::cooldowns) << " WHERE character_id = :char",
-				soci::use(player_id, "char");
-
-			if (m_cooldowns.size() > 0) {
-				int16_t remaining_time = 0;
-				st = (sql.prepare
-					<< "INSERT INTO " << db.make_table(vana::table::cooldowns) << " (character_id, skill_id, remaining_time) "
-					<< "VALUES (:char, :skill, :time)",
-					use(player_id, "char"),
+		for (const auto &kvp : m_cooldowns) {
+			snapshot.cooldowns.emplace_back(kvp.first, skills::get_cooldown_time_left(player, kvp.first));
+		}
+
+		auto blessing = m_skills.find(get_blessing_of_the_fairy());
+		if (blessing != std::end(m_skills)) {
+			// Loading divides the other character's level by 10, so this gives back the same skill level
+			snapshot.blessing_player_name = m_blessing_player;
+			snapshot.blessing_player_level = static_cast<game_player_level>(blessing->second.level * 10);
+		}
+	}
+	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
+}
+
+auto player_skills::save(vana::io::write_behind::batch &batch, bool save_cooldowns) -> void {
+	if (auto player = m_player.lock()) {
+		game_player_id player_id = player->get_id();
+
+		// Skills are never removed from the table, only new and changed levels are written
+		auto changes = m_saved_skills.diff(get_skill_rows(), batch);
+		if (changes.upserts.size() > 0) {
+			batch.add([player_id, changes](vana::io::database &db) {
+				using namespace soci;
+				auto &sql = db.get_session();
+				game_skill_id skill_id = 0;
+				game_skill_level level = 0;
+				game_skill_level max_level = 0;
+
+				statement st = (sql.prepare
+					<< "REPLACE INTO " << db.make_table(vana::table::skills) << " VALUES (:player, :skill, :level, :max_level)",
+					use(player_id, "player"),
 					use(skill_id, "skill"),
-					use(remaining_time, "time"));
+					use(level, "level"),
+					use(max_level, "max_level"));
 
-				for (const auto &kvp : m_cooldowns) {
+				for (const auto &kvp : changes.upserts) {
 					skill_id = kvp.first;
-					remaining_time = skills::get_cooldown_time_left(player, kvp.first);
+					level = kvp.second.first;
+					max_level = kvp.second.second;
 					st.execute(true);
 				}
+			});
+		}
+
+		if (save_cooldowns) {
+			// Remaining time is only meaningful at the moment of the save, so these are captured now and rewritten wholesale
+			vector<pair<game_skill_id, int16_t>> cooldowns;
+			for (const auto &kvp : m_cooldowns) {
+				cooldowns.emplace_back(kvp.first, skills::get_cooldown_time_left(player, kvp.first));
 			}
+
+			batch.add([player_id, cooldowns](vana::io::database &db) {
+				using namespace soci;
+				auto &sql = db.get_session();
+
+				sql.once << "DELETE FROM " << db.make_table(vana::table::cooldowns) << " WHERE character_id = :char",
+					soci::use(player_id, "char");
+
+				if (cooldowns.size() > 0) {
+					game_skill_id skill_id = 0;
+					int16_t remaining_time = 0;
+					statement st = (sql.prepare
+						<< "INSERT INTO " << db.make_table(vana::table::cooldowns) << " (character_id, skill_id, remaining_time) "
+						<< "VALUES (:char, :skill, :time)",
+						use(player_id, "char"),
+						use(skill_id, "skill"),
+						use(remaining_time, "time"));
+
+					for (const auto &cooldown : cooldowns) {
+						skill_id = cooldown.first;
+						remaining_time = cooldown.second;
+						st.execute(true);
+					}
+				}
+			});
 		}
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
+auto player_skills::get_skill_rows() const -> skill_tracker::rows {
+	skill_tracker::rows rows;
+	for (const auto &kvp : m_skills) {
+		if (vana::util::game_logic::player_skill::is_blessing_of_the_fairy(kvp.first)) {
+			continue;
+		}
+		rows.emplace(kvp.first, std::make_pair(kvp.second.level, kvp.second.player_max_skill_level));
+	}
+	return rows;
+}
+
 auto player_skills::add_skill_level(game_skill_id skill_id, game_skill_level amount, bool send_packet) -> bool {
 	if (!channel_server::get_instance().get_skill_data_provider().is_valid_skill(skill_id)) {
 		return false;
@@ -17,6 +17,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/types.hpp"
 #include <unordered_map>
 
@@ -33,6 +35,7 @@ namespace vana {
 		class mystic_door;
 		class party;
 		class player;
+		struct player_snapshot;
 
 		struct player_skill_info {
 			game_skill_level level = 0;
@@ -44,10 +47,11 @@ namespace vana {
 			NONCOPYABLE(player_skills);
 			NO_DEFAULT_CONSTRUCTOR(player_skills);
 		public:
-			player_skills(ref_ptr<player> player);
+			player_skills(ref_ptr<player> player, const player_snapshot &snapshot);
 
-			auto load() -> void;
-			auto save(bool save_cooldowns = false) -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto save(vana::io::write_behind::batch &batch, bool save_cooldowns = false) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 			auto connect_packet(packet_builder &builder) const -> void;
 			auto connect_packet_for_blessing(packet_builder &builder) const -> void;
 
@@ -100,13 +104,17 @@ namespace vana {
 			auto on_map_change() const -> void;
 			auto on_disconnect() -> void;
 		private:
+			using skill_tracker = vana::io::row_tracker<game_skill_id, pair<game_skill_level, game_skill_level>>;
+
 			auto has_skill(game_skill_id skill_id) const -> bool;
+			auto get_skill_rows() const -> skill_tracker::rows;
 
 			view_ptr<player> m_player;
 			hash_map<game_skill_id, player_skill_info> m_skills;
 			hash_map<game_skill_id, seconds> m_cooldowns;
 			ref_ptr<mystic_door> m_mystic_door;
 			string m_blessing_player;
+			skill_tracker m_saved_skills;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,672 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "player_snapshot.hpp"
+#include "common/io/database.hpp"
+#include "common/packet_builder.hpp"
+#include "common/packet_reader.hpp"
+
+namespace vana {
+namespace channel_server {
+
+auto player_snapshot::fetch(vana::io::database &db, game_player_id player_id, game_world_id channel_world_id) -> ref_ptr<player_snapshot> {
+	auto &sql = db.get_session();
+	auto ret = make_ref_ptr<player_snapshot>();
+
+	soci::row row;
+	sql.once
+		<< "SELECT c.*, u.gm_level, u.admin "
+		<< "FROM " << db.make_table(vana::table::characters) << " c "
+		<< "INNER JOIN " << db.make_table(vana::table::accounts) << " u ON c.account_id = u.account_id "
+		<< "WHERE c.character_id = :char",
+		soci::use(player_id, "char"),
+		soci::into(row);
+
+	if (!sql.got_data()) {
+		return ret;
+	}
+
+	ret->found = true;
+	ret->name = row.get<string>("name");
+	ret->account_id = row.get<game_account_id>("account_id");
+	ret->world_id = row.get<game_world_id>("world_id");
+	ret->map = row.get<game_map_id>("map");
+	ret->map_pos = row.get<game_portal_id>("pos");
+	ret->gm_level = row.get<int32_t>("gm_level");
+	ret->admin = row.get<bool>("admin");
+	ret->face = row.get<game_face_id>("face");
+	ret->hair = row.get<game_hair_id>("hair");
+	ret->gender = row.get<game_gender_id>("gender");
+	ret->skin = row.get<game_skin_id>("skin");
+	ret->buddylist_size = row.get<uint8_t>("buddylist_size");
+	ret->level = row.get<game_player_level>("level");
+	ret->job = row.get<game_job_id>("job");
+	ret->fame = row.get<game_fame>("fame");
+	ret->str = row.get<game_stat>("str");
+	ret->dex = row.get<game_stat>("dex");
+	ret->intt = row.get<game_stat>("int");
+	ret->luk = row.get<game_stat>("luk");
+	ret->ap = row.get<game_stat>("ap");
+	ret->hpmp_ap = row.get<game_health_ap>("hpmp_ap");
+	ret->sp = row.get<game_stat>("sp");
+	ret->hp = row.get<game_health>("chp");
+	ret->max_hp = row.get<game_health>("mhp");
+	ret->mp = row.get<game_health>("cmp");
+	ret->max_mp = row.get<game_health>("mmp");
+	ret->exp = row.get<game_experience>("exp");
+	ret->max_slots[0] = row.get<game_inventory_slot_count>("equip_slots");
+	ret->max_slots[1] = row.get<game_inventory_slot_count>("use_slots");
+	ret->max_slots[2] = row.get<game_inventory_slot_count>("setup_slots");
+	ret->max_slots[3] = row.get<game_inventory_slot_count>("etc_slots");
+	ret->max_slots[4] = row.get<game_inventory_slot_count>("cash_slots");
+	ret->mesos = row.get<game_mesos>("mesos");
+	ret->book_cover = row.get<opt_int32_t>("book_cover").get(0);
+
+	game_account_id account_id = ret->account_id;
+	game_world_id world_id = ret->world_id;
+
+	string location = "inventory";
+	soci::rowset<> rs = (sql.prepare
+		<< "SELECT i.*, p.index, p.name AS pet_name, p.level, p.closeness, p.fullness "
+		<< "FROM " << db.make_table(vana::table::items) << " i "
+		<< "LEFT OUTER JOIN " << db.make_table(vana::table::pets) << " p ON i.pet_id = p.pet_id "
+		<< "WHERE i.location = :location AND i.character_id = :char",
+		soci::use(player_id, "char"),
+		soci::use(location, "location"));
+
+	for (const auto &row : rs) {
+		inventory_row value;
+		value.inventory = row.get<game_inventory>("inv");
+		value.slot = row.get<game_inventory_slot>("slot");
+		value.value = item{row};
+		if (value.value.get_pet_id() != 0) {
+			pet_row pet;
+			pet.index = row.get<opt_int8_t>("index");
+			pet.name = row.get<string>("pet_name");
+			pet.level = row.get<int8_t>("level");
+			pet.closeness = row.get<int16_t>("closeness");
+			pet.fullness = row.get<int8_t>("fullness");
+			value.pet = pet;
+		}
+		ret->items.push_back(std::move(value));
+	}
+
+	rs = (sql.prepare << "SELECT t.map_index, t.map_id FROM " << db.make_table(vana::table::teleport_rock_locations) << " t WHERE t.character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		ret->teleport_rocks.emplace_back(row.get<int8_t>("map_index"), row.get<game_map_id>("map_id"));
+	}
+
+	soci::row storage_row;
+	sql.once
+		<< "SELECT s.slots, s.mesos, s.char_slots "
+		<< "FROM " << db.make_table(vana::table::storage) << " s "
+		<< "WHERE s.account_id = :account AND s.world_id = :world "
+		<< "LIMIT 1",
+		soci::use(account_id, "account"),
+		soci::use(world_id, "world"),
+		soci::into(storage_row);
+
+	if (sql.got_data()) {
+		ret->storage_found = true;
+		ret->storage_slots = storage_row.get<game_storage_slot>("slots");
+		ret->storage_mesos = storage_row.get<game_mesos>("mesos");
+		ret->storage_char_slots = storage_row.get<int32_t>("char_slots");
+	}
+
+	location = "storage";
+	rs = (sql.prepare
+		<< "SELECT i.* "
+		<< "FROM " << db.make_table(vana::table::items) << " i "
+		<< "WHERE i.location = :location AND i.account_id = :account AND i.world_id = :world "
+		<< "ORDER BY i.slot ASC",
+		soci::use(location, "location"),
+		soci::use(account_id, "account"),
+		soci::use(world_id, "world"));
+
+	for (const auto &row : rs) {
+		ret->storage_items.emplace_back(row.get<game_storage_slot>("slot"), item{row});
+	}
+
+	// The reverse entry is joined in so each buddy doesn't need its own lookup
+	rs = (sql.prepare
+		<< "SELECT bl.id, bl.buddy_character_id, bl.name AS name_cache, c.name, bl.group_name, r.id AS reverse_id "
+		<< "FROM " << db.make_table(vana::table::buddylist) << " bl "
+		<< "LEFT JOIN " << db.make_table(vana::table::characters) << " c ON bl.buddy_character_id = c.character_id "
+		<< "LEFT JOIN " << db.make_table(vana::table::buddylist) << " r ON r.character_id = bl.buddy_character_id AND r.buddy_character_id = bl.character_id "
+		<< "WHERE bl.character_id = :char",
+		soci::use(player_id, "char"));
+
+	vector<pair<int32_t, string>> stale_names;
+	vector<game_player_id> missing_groups;
+	for (const auto &row : rs) {
+		buddy_row value;
+		int32_t row_id = row.get<int32_t>("id");
+		opt_string name = row.get<opt_string>("name");
+		opt_string group = row.get<opt_string>("group_name");
+		string cache = row.get<string>("name_cache");
+
+		value.char_id = row.get<game_player_id>("buddy_character_id");
+		// Note that the cache is for displaying the character name when the character in question is deleted
+		value.name = name.get(cache);
+		value.group_name = group.get("default group");
+		value.opposite_registered = row.get<opt_int32_t>("reverse_id").is_initialized();
+
+		if (name.is_initialized() && name.get() != cache) {
+			// Outdated name cache, i.e. character renamed
+			stale_names.emplace_back(row_id, name.get());
+		}
+		if (!group.is_initialized()) {
+			missing_groups.push_back(value.char_id);
+		}
+		ret->buddies.push_back(std::move(value));
+	}
+
+	for (const auto &stale : stale_names) {
+		sql.once
+			<< "UPDATE " << db.make_table(vana::table::buddylist) << " "
+			<< "SET name = :name "
+			<< "WHERE id = :id ",
+			soci::use(stale.second, "name"),
+			soci::use(stale.first, "id");
+	}
+
+	string default_group = "default group";
+	for (const auto &buddy_id : missing_groups) {
+		sql.once
+			<< "UPDATE " << db.make_table(vana::table::buddylist) << " "
+			<< "SET group_name = :name "
+			<< "WHERE buddy_character_id = :buddy AND character_id = :owner ",
+			soci::use(default_group, "name"),
+			soci::use(buddy_id, "buddy"),
+			soci::use(player_id, "owner");
+	}
+
+	rs = (sql.prepare
+		<< "SELECT p.* "
+		<< "FROM " << db.make_table(vana::table::buddylist_pending) << " p "
+		<< "LEFT JOIN " << db.make_table(vana::table::characters) << " c ON c.character_id = p.inviter_character_id "
+		<< "WHERE c.world_id = :world AND p.character_id = :char ",
+		soci::use(player_id, "char"),
+		soci::use(channel_world_id, "world"));
+
+	for (const auto &row : rs) {
+		ret->pending_buddies.emplace_back(row.get<game_player_id>("inviter_character_id"), row.get<string>("inviter_name"));
+	}
+
+	rs = (sql.prepare
+		<< "SELECT a.quest_id, am.mob_id, am.quantity_killed, a.data "
+		<< "FROM " << db.make_table(vana::table::active_quests) << " a "
+		<< "LEFT OUTER JOIN " << db.make_table(vana::table::active_quests_mobs) << " am ON am.active_quest_id = a.id "
+		<< "WHERE a.character_id = :char ORDER BY a.quest_id ASC",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		active_quest_row value;
+		value.quest_id = row.get<game_quest_id>("quest_id");
+		value.mob_id = row.get<game_mob_id>("mob_id");
+		value.data = row.get<string>("data");
+		if (value.mob_id != 0) {
+			value.kills = row.get<uint16_t>("quantity_killed");
+		}
+		ret->active_quests.push_back(std::move(value));
+	}
+
+	rs = (sql.prepare << "SELECT c.quest_id, c.end_time FROM " << db.make_table(vana::table::completed_quests) << " c WHERE c.character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		ret->completed_quests.emplace_back(row.get<game_quest_id>("quest_id"), row.get<int64_t>("end_time"));
+	}
+
+	rs = (sql.prepare << "SELECT m.* FROM " << db.make_table(vana::table::mounts) << " m WHERE m.character_id = :char ",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		mount_row value;
+		value.mount_id = row.get<game_item_id>("mount_id");
+		value.exp = row.get<int16_t>("exp");
+		value.level = row.get<int8_t>("level");
+		value.tiredness = row.get<int8_t>("tiredness");
+		ret->mounts.push_back(value);
+	}
+
+	rs = (sql.prepare
+		<< "SELECT b.card_id, b.level "
+		<< "FROM " << db.make_table(vana::table::monster_book) << " b "
+		<< "WHERE b.character_id = :char "
+		<< "ORDER BY b.card_id ASC",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		ret->monster_book.emplace_back(row.get<game_item_id>("card_id"), row.get<uint8_t>("level"));
+	}
+
+	rs = (sql.prepare
+		<< "SELECT s.skill_id, s.points, s.max_level "
+		<< "FROM " << db.make_table(vana::table::skills) << " s "
+		<< "WHERE s.character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		skill_row value;
+		value.skill_id = row.get<game_skill_id>("skill_id");
+		value.points = row.get<game_skill_level>("points");
+		value.max_level = row.get<game_skill_level>("max_level");
+		ret->skills.push_back(value);
+	}
+
+	rs = (sql.prepare
+		<< "SELECT c.* "
+		<< "FROM " << db.make_table(vana::table::cooldowns) << " c "
+		<< "WHERE c.character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		ret->cooldowns.emplace_back(row.get<game_skill_id>("skill_id"), row.get<int16_t>("remaining_time"));
+	}
+
+	// TODO FIXME skill
+	// Allow Cygnus <-> Adventurer selection here or allow it to be ignored
+	// That is, some versions only allowed Adv. Blessing to be populated by Cygnus levels and vice versa
+	// Some later versions lifted this restriction entirely
+	sql.once
+		<< "SELECT c.name, c.level "
+		<< "FROM " << db.make_table(vana::table::characters) << " c "
+		<< "WHERE c.world_id = :world AND c.account_id = :account AND c.character_id <> :char "
+		<< "ORDER BY c.level DESC "
+		<< "LIMIT 1 ",
+		soci::use(account_id, "account"),
+		soci::use(world_id, "world"),
+		soci::use(player_id, "char"),
+		soci::into(ret->blessing_player_name),
+		soci::into(ret->blessing_player_level);
+
+	rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::table::character_variables) << " WHERE character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		ret->variables.emplace_back(row.get<string>("key"), row.get<string>("value"));
+	}
+
+	rs = (sql.prepare
+		<< "SELECT k.* "
+		<< "FROM " << db.make_table(vana::table::keymap) << " k "
+		<< "WHERE k.character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		key_map_row value;
+		value.pos = row.get<int32_t>("pos");
+		value.type = row.get<int8_t>("type");
+		value.action = row.get<int32_t>("action");
+		ret->key_maps.push_back(value);
+	}
+
+	rs = (sql.prepare << "SELECT s.* FROM " << db.make_table(vana::table::skill_macros) << " s WHERE s.character_id = :char",
+		soci::use(player_id, "char"));
+
+	for (const auto &row : rs) {
+		skill_macro_row value;
+		value.pos = row.get<int8_t>("pos");
+		value.name = row.get<string>("name");
+		value.shout = row.get<bool>("shout");
+		value.skill_1 = row.get<game_skill_id>("skill_1");
+		value.skill_2 = row.get<game_skill_id>("skill_2");
+		value.skill_3 = row.get<game_skill_id>("skill_3");
+		ret->skill_macros.push_back(std::move(value));
+	}
+
+	return ret;
+}
+
+auto player_snapshot::read_from_packet(packet_reader &reader) -> ref_ptr<player_snapshot> {
+	auto ret = make_ref_ptr<player_snapshot>();
+	ret->found = true;
+	ret->name = reader.get<string>();
+	ret->account_id = reader.get<game_account_id>();
+	ret->world_id = reader.get<game_world_id>();
+	ret->map = reader.get<game_map_id>();
+	ret->map_pos = reader.get<game_portal_id>();
+	ret->gm_level = reader.get<int32_t>();
+	ret->admin = reader.get<bool>();
+	ret->face = reader.get<game_face_id>();
+	ret->hair = reader.get<game_hair_id>();
+	ret->gender = reader.get<game_gender_id>();
+	ret->skin = reader.get<game_skin_id>();
+	ret->buddylist_size = reader.get<uint8_t>();
+	ret->level = reader.get<game_player_level>();
+	ret->job = reader.get<game_job_id>();
+	ret->fame = reader.get<game_fame>();
+	ret->str = reader.get<game_stat>();
+	ret->dex = reader.get<game_stat>();
+	ret->intt = reader.get<game_stat>();
+	ret->luk = reader.get<game_stat>();
+	ret->ap = reader.get<game_stat>();
+	ret->hpmp_ap = reader.get<game_health_ap>();
+	ret->sp = reader.get<game_stat>();
+	ret->hp = reader.get<game_health>();
+	ret->max_hp = reader.get<game_health>();
+	ret->mp = reader.get<game_health>();
+	ret->max_mp = reader.get<game_health>();
+	ret->exp = reader.get<game_experience>();
+	for (auto &slots : ret->max_slots) {
+		slots = reader.get<game_inventory_slot_count>();
+	}
+	ret->mesos = reader.get<game_mesos>();
+	ret->book_cover = reader.get<int32_t>();
+
+	uint32_t count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		inventory_row value;
+		value.inventory = reader.get<game_inventory>();
+		value.slot = reader.get<game_inventory_slot>();
+		value.value = reader.get<item>();
+		if (reader.get<bool>()) {
+			pet_row pet;
+			pet.index = reader.get<opt_int8_t>();
+			pet.name = reader.get<string>();
+			pet.level = reader.get<int8_t>();
+			pet.closeness = reader.get<int16_t>();
+			pet.fullness = reader.get<int8_t>();
+			value.pet = pet;
+		}
+		ret->items.push_back(std::move(value));
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		int8_t index = reader.get<int8_t>();
+		ret->teleport_rocks.emplace_back(index, reader.get<game_map_id>());
+	}
+
+	ret->storage_found = reader.get<bool>();
+	ret->storage_slots = reader.get<game_storage_slot>();
+	ret->storage_mesos = reader.get<game_mesos>();
+	ret->storage_char_slots = reader.get<int32_t>();
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		game_storage_slot slot = reader.get<game_storage_slot>();
+		ret->storage_items.emplace_back(slot, reader.get<item>());
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		buddy_row value;
+		value.char_id = reader.get<game_player_id>();
+		value.name = reader.get<string>();
+		value.group_name = reader.get<string>();
+		value.opposite_registered = reader.get<bool>();
+		ret->buddies.push_back(std::move(value));
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		game_player_id inviter_id = reader.get<game_player_id>();
+		ret->pending_buddies.emplace_back(inviter_id, reader.get<string>());
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		active_quest_row value;
+		value.quest_id = reader.get<game_quest_id>();
+		value.mob_id = reader.get<game_mob_id>();
+		value.kills = reader.get<uint16_t>();
+		value.data = reader.get<string>();
+		ret->active_quests.push_back(std::move(value));
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		game_quest_id quest_id = reader.get<game_quest_id>();
+		ret->completed_quests.emplace_back(quest_id, reader.get<int64_t>());
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		mount_row value;
+		value.mount_id = reader.get<game_item_id>();
+		value.exp = reader.get<int16_t>();
+		value.level = reader.get<int8_t>();
+		value.tiredness = reader.get<int8_t>();
+		ret->mounts.push_back(value);
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		game_item_id card_id = reader.get<game_item_id>();
+		ret->monster_book.emplace_back(card_id, reader.get<uint8_t>());
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		skill_row value;
+		value.skill_id = reader.get<game_skill_id>();
+		value.points = reader.get<game_skill_level>();
+		value.max_level = reader.get<game_skill_level>();
+		ret->skills.push_back(value);
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		game_skill_id skill_id = reader.get<game_skill_id>();
+		ret->cooldowns.emplace_back(skill_id, reader.get<int16_t>());
+	}
+
+	ret->blessing_player_name = reader.get<opt_string>();
+	ret->blessing_player_level = reader.get<optional<game_player_level>>();
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		string key = reader.get<string>();
+		ret->variables.emplace_back(key, reader.get<string>());
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		key_map_row value;
+		value.pos = reader.get<int32_t>();
+		value.type = reader.get<int8_t>();
+		value.action = reader.get<int32_t>();
+		ret->key_maps.push_back(value);
+	}
+
+	count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		skill_macro_row value;
+		value.pos = reader.get<int8_t>();
+		value.name = reader.get<string>();
+		value.shout = reader.get<bool>();
+		value.skill_1 = reader.get<game_skill_id>();
+		value.skill_2 = reader.get<game_skill_id>();
+		value.skill_3 = reader.get<game_skill_id>();
+		ret->skill_macros.push_back(std::move(value));
+	}
+
+	return ret;
+}
+
+auto player_snapshot::write_to_packet(packet_builder &builder) const -> void {
+	builder
+		.add<string>(name)
+		.add<game_account_id>(account_id)
+		.add<game_world_id>(world_id)
+		.add<game_map_id>(map)
+		.add<game_portal_id>(map_pos)
+		.add<int32_t>(gm_level)
+		.add<bool>(admin)
+		.add<game_face_id>(face)
+		.add<game_hair_id>(hair)
+		.add<game_gender_id>(gender)
+		.add<game_skin_id>(skin)
+		.add<uint8_t>(buddylist_size)
+		.add<game_player_level>(level)
+		.add<game_job_id>(job)
+		.add<game_fame>(fame)
+		.add<game_stat>(str)
+		.add<game_stat>(dex)
+		.add<game_stat>(intt)
+		.add<game_stat>(luk)
+		.add<game_stat>(ap)
+		.add<game_health_ap>(hpmp_ap)
+		.add<game_stat>(sp)
+		.add<game_health>(hp)
+		.add<game_health>(max_hp)
+		.add<game_health>(mp)
+		.add<game_health>(max_mp)
+		.add<game_experience>(exp);
+	for (const auto &slots : max_slots) {
+		builder.add<game_inventory_slot_count>(slots);
+	}
+	builder
+		.add<game_mesos>(mesos)
+		.add<int32_t>(book_cover);
+
+	builder.add<uint32_t>(static_cast<uint32_t>(items.size()));
+	for (const auto &row : items) {
+		builder
+			.add<game_inventory>(row.inventory)
+			.add<game_inventory_slot>(row.slot)
+			.add<item>(row.value)
+			.add<bool>(row.pet.is_initialized());
+		if (row.pet.is_initialized()) {
+			const auto &pet = row.pet.get();
+			builder
+				.add<opt_int8_t>(pet.index)
+				.add<string>(pet.name)
+				.add<int8_t>(pet.level)
+				.add<int16_t>(pet.closeness)
+				.add<int8_t>(pet.fullness);
+		}
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(teleport_rocks.size()));
+	for (const auto &rock : teleport_rocks) {
+		builder
+			.add<int8_t>(rock.first)
+			.add<game_map_id>(rock.second);
+	}
+
+	builder
+		.add<bool>(storage_found)
+		.add<game_storage_slot>(storage_slots)
+		.add<game_mesos>(storage_mesos)
+		.add<int32_t>(storage_char_slots);
+	builder.add<uint32_t>(static_cast<uint32_t>(storage_items.size()));
+	for (const auto &row : storage_items) {
+		builder
+			.add<game_storage_slot>(row.first)
+			.add<item>(row.second);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(buddies.size()));
+	for (const auto &row : buddies) {
+		builder
+			.add<game_player_id>(row.char_id)
+			.add<string>(row.name)
+			.add<string>(row.group_name)
+			.add<bool>(row.opposite_registered);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(pending_buddies.size()));
+	for (const auto &row : pending_buddies) {
+		builder
+			.add<game_player_id>(row.first)
+			.add<string>(row.second);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(active_quests.size()));
+	for (const auto &row : active_quests) {
+		builder
+			.add<game_quest_id>(row.quest_id)
+			.add<game_mob_id>(row.mob_id)
+			.add<uint16_t>(row.kills)
+			.add<string>(row.data);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(completed_quests.size()));
+	for (const auto &row : completed_quests) {
+		builder
+			.add<game_quest_id>(row.first)
+			.add<int64_t>(row.second);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(mounts.size()));
+	for (const auto &row : mounts) {
+		builder
+			.add<game_item_id>(row.mount_id)
+			.add<int16_t>(row.exp)
+			.add<int8_t>(row.level)
+			.add<int8_t>(row.tiredness);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(monster_book.size()));
+	for (const auto &row : monster_book) {
+		builder
+			.add<game_item_id>(row.first)
+			.add<uint8_t>(row.second);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(skills.size()));
+	for (const auto &row : skills) {
+		builder
+			.add<game_skill_id>(row.skill_id)
+			.add<game_skill_level>(row.points)
+			.add<game_skill_level>(row.max_level);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(cooldowns.size()));
+	for (const auto &row : cooldowns) {
+		builder
+			.add<game_skill_id>(row.first)
+			.add<int16_t>(row.second);
+	}
+
+	builder
+		.add<opt_string>(blessing_player_name)
+		.add<optional<game_player_level>>(blessing_player_level);
+
+	builder.add<uint32_t>(static_cast<uint32_t>(variables.size()));
+	for (const auto &row : variables) {
+		builder
+			.add<string>(row.first)
+			.add<string>(row.second);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(key_maps.size()));
+	for (const auto &row : key_maps) {
+		builder
+			.add<int32_t>(row.pos)
+			.add<int8_t>(row.type)
+			.add<int32_t>(row.action);
+	}
+
+	builder.add<uint32_t>(static_cast<uint32_t>(skill_macros.size()));
+	for (const auto &row : skill_macros) {
+		builder
+			.add<int8_t>(row.pos)
+			.add<string>(row.name)
+			.add<bool>(row.shout)
+			.add<game_skill_id>(row.skill_1)
+			.add<game_skill_id>(row.skill_2)
+			.add<game_skill_id>(row.skill_3);
+	}
+}
+
+}
+}
@@ -0,0 +1,167 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/constant/inventory.hpp"
+#include "common/item.hpp"
+#include "common/types.hpp"
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vana {
+	class packet_builder;
+	class packet_reader;
+
+	namespace io {
+		class database;
+	}
+
+	namespace channel_server {
+		// Everything a player needs from the character database on connect, read in one pass on a database executor thread
+		// The components copy out of it on the dispatch thread, so nothing here may touch game state
+		struct player_snapshot {
+			struct pet_row {
+				opt_int8_t index;
+				string name;
+				int8_t level = 0;
+				int16_t closeness = 0;
+				int8_t fullness = 0;
+			};
+
+			struct inventory_row {
+				game_inventory inventory = 0;
+				game_inventory_slot slot = 0;
+				item value;
+				optional<pet_row> pet;
+			};
+
+			struct buddy_row {
+				game_player_id char_id = 0;
+				string name;
+				string group_name;
+				bool opposite_registered = false;
+			};
+
+			struct active_quest_row {
+				game_quest_id quest_id = 0;
+				game_mob_id mob_id = 0;
+				uint16_t kills = 0;
+				string data;
+			};
+
+			struct mount_row {
+				game_item_id mount_id = 0;
+				int16_t exp = 0;
+				int8_t level = 0;
+				int8_t tiredness = 0;
+			};
+
+			struct skill_row {
+				game_skill_id skill_id = 0;
+				game_skill_level points = 0;
+				game_skill_level max_level = 0;
+			};
+
+			struct key_map_row {
+				int32_t pos = 0;
+				int8_t type = 0;
+				int32_t action = 0;
+			};
+
+			struct skill_macro_row {
+				int8_t pos = 0;
+				string name;
+				bool shout = false;
+				game_skill_id skill_1 = 0;
+				game_skill_id skill_2 = 0;
+				game_skill_id skill_3 = 0;
+			};
+
+			static auto fetch(vana::io::database &db, game_player_id player_id, game_world_id channel_world_id) -> ref_ptr<player_snapshot>;
+			// Channel changes carry the character over in this form so the destination doesn't have to read it back
+			static auto read_from_packet(packet_reader &reader) -> ref_ptr<player_snapshot>;
+			auto write_to_packet(packet_builder &builder) const -> void;
+
+			bool found = false;
+
+			// Character
+			string name;
+			game_account_id account_id = 0;
+			game_world_id world_id = 0;
+			game_map_id map = 0;
+			game_portal_id map_pos = 0;
+			int32_t gm_level = 0;
+			bool admin = false;
+			game_face_id face = 0;
+			game_hair_id hair = 0;
+			game_gender_id gender = 0;
+			game_skin_id skin = 0;
+			uint8_t buddylist_size = 0;
+			game_player_level level = 0;
+			game_job_id job = 0;
+			game_fame fame = 0;
+			game_stat str = 0;
+			game_stat dex = 0;
+			game_stat intt = 0;
+			game_stat luk = 0;
+			game_stat ap = 0;
+			game_health_ap hpmp_ap = 0;
+			game_stat sp = 0;
+			game_health hp = 0;
+			game_health max_hp = 0;
+			game_health mp = 0;
+			game_health max_mp = 0;
+			game_experience exp = 0;
+			array<game_inventory_slot_count, constant::inventory::count> max_slots;
+			game_mesos mesos = 0;
+			int32_t book_cover = 0;
+
+			// Inventory
+			vector<inventory_row> items;
+			vector<pair<int8_t, game_map_id>> teleport_rocks;
+
+			// Storage, absent until the account first connects to this world
+			bool storage_found = false;
+			game_storage_slot storage_slots = 0;
+			game_mesos storage_mesos = 0;
+			int32_t storage_char_slots = 0;
+			vector<pair<game_storage_slot, item>> storage_items;
+
+			// Social
+			vector<buddy_row> buddies;
+			vector<pair<game_player_id, string>> pending_buddies;
+
+			// Progress
+			vector<active_quest_row> active_quests;
+			vector<pair<game_quest_id, int64_t>> completed_quests;
+			vector<mount_row> mounts;
+			vector<pair<game_item_id, uint8_t>> monster_book;
+			vector<skill_row> skills;
+			vector<pair<game_skill_id, int16_t>> cooldowns;
+			opt_string blessing_player_name;
+			optional<game_player_level> blessing_player_level;
+			vector<pair<string, string>> variables;
+
+			// Client settings
+			vector<key_map_row> key_maps;
+			vector<skill_macro_row> skill_macros;
+		};
+	}
+}
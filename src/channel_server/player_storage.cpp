@@ -23,16 +23,17 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/channel_server.hpp"
 #include "channel_server/inventory.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 #include "channel_server/storage_packet.hpp"
 #include <algorithm>
 
 namespace vana {
 namespace channel_server {
 
-player_storage::player_storage(ref_ptr<player> player) :
+player_storage::player_storage(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
 player_storage::~player_storage() {
@@ -93,29 +94,18 @@ auto player_storage::can_modify_mesos(game_mesos mesos) const -> stack_result {
 	return m_mesos.can_modify_mesos(mesos);
 }
 
-auto player_storage::load() -> void {
+auto player_storage::load(const player_snapshot &snapshot) -> void {
 	if (auto player = m_player.lock()) {
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
-		soci::row row;
-		game_account_id account_id = player->get_account_id();
-		game_world_id world_id = player->get_world_id();
-
-		sql.once
-			<< "SELECT s.slots, s.mesos, s.char_slots "
-			<< "FROM " << db.make_table(vana::table::storage) << " s "
-			<< "WHERE s.account_id = :account AND s.world_id = :world "
-			<< "LIMIT 1",
-			soci::use(account_id, "account"),
-			soci::use(world_id, "world"),
-			soci::into(row);
-
-		if (sql.got_data()) {
-			m_slots = row.get<game_storage_slot>("slots");
-			m_mesos.set_mesos(row.get<game_mesos>("mesos"));
-			m_char_slots = row.get<int32_t>("char_slots");
+		if (snapshot.storage_found) {
+			m_slots = snapshot.storage_slots;
+			m_mesos.set_mesos(snapshot.storage_mesos);
+			m_char_slots = snapshot.storage_char_slots;
 		}
 		else {
+			auto &db = vana::io::database::get_char_db();
+			auto &sql = db.get_session();
+			game_account_id account_id = player->get_account_id();
+			game_world_id world_id = player->get_world_id();
 			auto &config = channel_server::get_instance().get_config();
 			m_slots = config.default_storage_slots;
 			m_mesos = 0;
@@ -132,64 +122,103 @@ auto player_storage::load() -> void {
 
 		m_items.reserve(m_slots);
 
-		string location = "storage";
-
-		soci::rowset<> rs = (sql.prepare
-			<< "SELECT i.* "
-			<< "FROM " << db.make_table(vana::table::items) << " i "
-			<< "WHERE i.location = :location AND i.account_id = :account AND i.world_id = :world "
-			<< "ORDER BY i.slot ASC",
-			soci::use(location, "location"),
-			soci::use(account_id, "account"),
-			soci::use(world_id, "world"));
-
-		for (const auto &row : rs) {
-			item *value = new item{row};
-			add_item(value);
+		item_tracker::rows saved_items;
+		for (const auto &row : snapshot.storage_items) {
+			add_item(new item{row.second});
+			// Slots are compacted by inventory in memory, the baseline has to match what the table actually holds
+			saved_items.emplace(row.first, row.second);
 		}
+
+		m_saved_items.reset(std::move(saved_items));
+		m_saved_header.reset(header_tracker::rows{{0, get_header_row()}});
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_storage::save() -> void {
+auto player_storage::fill_snapshot(player_snapshot &snapshot) const -> void {
+	snapshot.storage_found = true;
+	snapshot.storage_slots = m_slots;
+	snapshot.storage_mesos = get_mesos();
+	snapshot.storage_char_slots = m_char_slots;
+	for (const auto &kvp : get_item_rows()) {
+		snapshot.storage_items.emplace_back(kvp.first, kvp.second);
+	}
+}
+
+auto player_storage::save(vana::io::write_behind::batch &batch) -> void {
 	if (auto player = m_player.lock()) {
-		using namespace soci;
 		game_world_id world_id = player->get_world_id();
 		game_account_id account_id = player->get_account_id();
 		game_player_id player_id = player->get_id();
 
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
-		sql.once
-			<< "UPDATE " << db.make_table(vana::table::storage) << " "
-			<< "SET slots = :slots, mesos = :mesos, char_slots = :chars "
-			<< "WHERE account_id = :account AND world_id = :world",
-			use(account_id, "account"),
-			use(world_id, "world"),
-			use(m_slots, "slots"),
-			use(m_mesos.get_mesos(), "mesos"),
-			use(m_char_slots, "chars");
-
-		sql.once
-			<< "DELETE FROM " << db.make_table(vana::table::items) << " "
-			<< "WHERE location = :location AND account_id = :account AND world_id = :world",
-			use(item::storage, "location"),
-			use(account_id, "account"),
-			use(world_id, "world");
-
-		game_storage_slot max = get_num_items();
-
-		if (max > 0) {
-			vector<item_db_record> v;
-			for (game_storage_slot i = 0; i < max; ++i) {
-				item_db_record rec{i, player_id, account_id, world_id, item::storage, get_item(i)};
-				v.push_back(rec);
-			}
-			item::database_insert(db, v);
+		header_row header = get_header_row();
+		if (!m_saved_header.diff(header_tracker::rows{{0, header}}, batch).empty()) {
+			game_storage_slot slots = std::get<0>(header);
+			game_mesos mesos = std::get<1>(header);
+			int32_t char_slots = std::get<2>(header);
+
+			batch.add([=](vana::io::database &db) {
+				auto &sql = db.get_session();
+				sql.once
+					<< "UPDATE " << db.make_table(vana::table::storage) << " "
+					<< "SET slots = :slots, mesos = :mesos, char_slots = :chars "
+					<< "WHERE account_id = :account AND world_id = :world",
+					soci::use(account_id, "account"),
+					soci::use(world_id, "world"),
+					soci::use(slots, "slots"),
+					soci::use(mesos, "mesos"),
+					soci::use(char_slots, "chars");
+			});
+		}
+
+		auto item_changes = m_saved_items.diff(get_item_rows(), batch);
+		if (!item_changes.empty()) {
+			batch.add([player_id, account_id, world_id, item_changes](vana::io::database &db) mutable {
+				using namespace soci;
+				auto &sql = db.get_session();
+				game_storage_slot slot = 0;
+
+				// Storage rows belong to the account but are keyed by whichever character wrote them last, so changed slots are replaced by hand
+				statement st = (sql.prepare
+					<< "DELETE FROM " << db.make_table(vana::table::items) << " "
+					<< "WHERE location = :location AND account_id = :account AND world_id = :world AND slot = :slot",
+					use(item::storage, "location"),
+					use(account_id, "account"),
+					use(world_id, "world"),
+					use(slot, "slot"));
+
+				for (const auto &key : item_changes.deletes) {
+					slot = key;
+					st.execute(true);
+				}
+
+				vector<item_db_record> v;
+				for (auto &kvp : item_changes.upserts) {
+					slot = kvp.first;
+					st.execute(true);
+					v.emplace_back(kvp.first, player_id, account_id, world_id, item::storage, &kvp.second);
+				}
+
+				if (v.size() > 0) {
+					item::database_insert(db, v);
+				}
+			});
 		}
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
+auto player_storage::get_item_rows() const -> item_tracker::rows {
+	item_tracker::rows rows;
+	for (game_storage_slot i = 0; i < get_num_items(); ++i) {
+		rows.emplace(i, item{m_items[i]});
+	}
+	return rows;
+}
+
+auto player_storage::get_header_row() const -> header_row {
+	return header_row{m_slots, m_mesos.get_mesos(), m_char_slots};
+}
+
 }
 }
\ No newline at end of file
@@ -17,8 +17,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
+#include "common/item.hpp"
 #include "common/types.hpp"
 #include "common/util/meso_inventory.hpp"
+#include <tuple>
 #include <vector>
 
 namespace vana {
@@ -26,12 +30,13 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		class player_storage {
 			NONCOPYABLE(player_storage);
 			NO_DEFAULT_CONSTRUCTOR(player_storage);
 		public:
-			player_storage(ref_ptr<player> player);
+			player_storage(ref_ptr<player> player, const player_snapshot &snapshot);
 			~player_storage();
 
 			auto set_slots(game_storage_slot slots) -> void;
@@ -53,14 +58,24 @@ namespace vana {
 				return nullptr;
 			}
 
-			auto load() -> void;
-			auto save() -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto save(vana::io::write_behind::batch &batch) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 		private:
+			using item_tracker = vana::io::row_tracker<game_storage_slot, item>;
+			using header_row = tuple<game_storage_slot, game_mesos, int32_t>;
+			using header_tracker = vana::io::row_tracker<int8_t, header_row>;
+
+			auto get_item_rows() const -> item_tracker::rows;
+			auto get_header_row() const -> header_row;
+
 			game_storage_slot m_slots = 0;
 			int32_t m_char_slots = 0;
 			vana::util::meso_inventory m_mesos;
 			vector<item *> m_items;
 			view_ptr<player> m_player;
+			item_tracker m_saved_items;
+			header_tracker m_saved_header;
 		};
 	}
 }
\ No newline at end of file
@@ -18,58 +18,74 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "player_variables.hpp"
 #include "common/io/database.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
 
-player_variables::player_variables(ref_ptr<player> player) :
+player_variables::player_variables(ref_ptr<player> player, const player_snapshot &snapshot) :
 	m_player{player}
 {
-	load();
+	load(snapshot);
 }
 
-auto player_variables::save() -> void {
+auto player_variables::save(vana::io::write_behind::batch &batch) -> void {
 	if (auto player = m_player.lock()) {
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
 		game_player_id char_id = player->get_id();
 
-		sql.once << "DELETE FROM " << db.make_table(vana::table::character_variables) << " WHERE character_id = :char",
-			soci::use(char_id, "char");
+		auto changes = m_saved_variables.diff(variable_tracker::rows{std::begin(m_variables), std::end(m_variables)}, batch);
+		if (changes.empty()) {
+			return;
+		}
 
-		if (m_variables.size() > 0) {
+		batch.add([char_id, changes](vana::io::database &db) {
+			auto &sql = db.get_session();
 			string key = "";
 			string value = "";
 
-			soci::statement st = (sql.prepare
-				<< "INSERT INTO " << db.make_table(vana::table::character_variables) << " "
-				<< "VALUES (:char, :key, :value)",
-				soci::use(char_id, "char"),
-				soci::use(key, "key"),
-				soci::use(value, "value"));
-
-			for (const auto &kvp : m_variables) {
-				key = kvp.first;
-				value = kvp.second;
-				st.execute(true);
+			if (changes.deletes.size() > 0) {
+				soci::statement st = (sql.prepare
+					<< "DELETE FROM " << db.make_table(vana::table::character_variables) << " WHERE character_id = :char AND `key` = :key",
+					soci::use(char_id, "char"),
+					soci::use(key, "key"));
+
+				for (const auto &variable : changes.deletes) {
+					key = variable;
+					st.execute(true);
+				}
 			}
-		}
+
+			if (changes.upserts.size() > 0) {
+				soci::statement st = (sql.prepare
+					<< "REPLACE INTO " << db.make_table(vana::table::character_variables) << " "
+					<< "VALUES (:char, :key, :value)",
+					soci::use(char_id, "char"),
+					soci::use(key, "key"),
+					soci::use(value, "value"));
+
+				for (const auto &kvp : changes.upserts) {
+					key = kvp.first;
+					value = kvp.second;
+					st.execute(true);
+				}
+			}
+		});
 	}
 	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
-auto player_variables::load() -> void {
-	if (auto player = m_player.lock()) {
-		auto &db = vana::io::database::get_char_db();
-		auto &sql = db.get_session();
-		soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::table::character_variables) << " WHERE character_id = :char",
-			soci::use(player->get_id(), "char"));
+auto player_variables::load(const player_snapshot &snapshot) -> void {
+	for (const auto &row : snapshot.variables) {
+		m_variables[row.first] = row.second;
+	}
 
-		for (const auto &row : rs) {
-			m_variables[row.get<string>("key")] = row.get<string>("value");
-		}
+	m_saved_variables.reset(variable_tracker::rows{std::begin(m_variables), std::end(m_variables)});
+}
+
+auto player_variables::fill_snapshot(player_snapshot &snapshot) const -> void {
+	for (const auto &kvp : m_variables) {
+		snapshot.variables.emplace_back(kvp.first, kvp.second);
 	}
-	else THROW_CODE_EXCEPTION(invalid_operation_exception, "This should never be thrown");
 }
 
 }
@@ -17,21 +17,28 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/io/row_tracker.hpp"
+#include "common/io/write_behind.hpp"
 #include "common/variables.hpp"
 
 namespace vana {
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		class player_variables : public variables {
 			NONCOPYABLE(player_variables);
 			NO_DEFAULT_CONSTRUCTOR(player_variables);
 		public:
-			player_variables(ref_ptr<player> player);
-			auto save() -> void;
-			auto load() -> void;
+			player_variables(ref_ptr<player> player, const player_snapshot &snapshot);
+			auto save(vana::io::write_behind::batch &batch) -> void;
+			auto load(const player_snapshot &snapshot) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 		private:
+			using variable_tracker = vana::io::row_tracker<string, string>;
+
 			view_ptr<player> m_player;
+			variable_tracker m_saved_variables;
 		};
 	}
 }
\ No newline at end of file
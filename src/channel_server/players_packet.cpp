@@ -188,13 +188,13 @@ SPLIT_PACKET_IMPL(use_melee_attack, game_player_id player_id, game_skill_id mast
 
 	for (const auto &target : attack.damages) {
 		builder.map
-			.add<game_map_object>(target.first)
+			.add<game_map_object>(target.get_map_mob_id())
 			.unk<int8_t>(0x06);
 
 		if (is_meso_explosion) {
-			builder.map.add<uint8_t>(static_cast<uint8_t>(target.second.size()));
+			builder.map.add<uint8_t>(target.size());
 		}
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			builder.map.add<game_damage>(hit);
 		}
 	}
@@ -226,10 +226,10 @@ SPLIT_PACKET_IMPL(use_ranged_attack, game_player_id player_id, game_skill_id mas
 
 	for (const auto &target : attack.damages) {
 		builder.map
-			.add<game_map_object>(target.first)
+			.add<game_map_object>(target.get_map_mob_id())
 			.unk<int8_t>(0x06);
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			game_damage damage = hit;
 			switch (skill_id) {
 				case constant::skill::marksman::snipe: // Snipe is always crit
@@ -261,10 +261,10 @@ SPLIT_PACKET_IMPL(use_spell_attack, game_player_id player_id, const attack_data
 
 	for (const auto &target : attack.damages) {
 		builder.map
-			.add<game_map_object>(target.first)
+			.add<game_map_object>(target.get_map_mob_id())
 			.unk<int8_t>(0x06);
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			builder.map.add<game_damage>(hit);
 		}
 	}
@@ -286,10 +286,10 @@ SPLIT_PACKET_IMPL(use_summon_attack, game_player_id player_id, const attack_data
 
 	for (const auto &target : attack.damages) {
 		builder.map
-			.add<game_map_object>(target.first)
+			.add<game_map_object>(target.get_map_mob_id())
 			.unk<int8_t>(0x06);
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			builder.map.add<game_damage>(hit);
 		}
 	}
@@ -323,10 +323,10 @@ SPLIT_PACKET_IMPL(use_energy_charge_attack, game_player_id player_id, int32_t ma
 
 	for (const auto &target : attack.damages) {
 		builder.map
-			.add<game_map_object>(target.first)
+			.add<game_map_object>(target.get_map_mob_id())
 			.unk<int8_t>(0x06);
 
-		for (const auto &hit : target.second) {
+		for (const auto &hit : target) {
 			builder.map.add<game_damage>(hit);
 		}
 	}
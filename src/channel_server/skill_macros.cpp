@@ -18,18 +18,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "skill_macros.hpp"
 #include "common/io/database.hpp"
 #include "common/util/misc.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
 
-auto skill_macros::load(game_player_id char_id) -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT s.* FROM " << db.make_table(vana::table::skill_macros) << " s WHERE s.character_id = :char",
-		soci::use(char_id, "char"));
-
-	for (const auto &row : rs) {
-		add(row.get<int8_t>("pos"), new skill_macro(row.get<string>("name"), row.get<bool>("shout"), row.get<game_skill_id>("skill_1"), row.get<game_skill_id>("skill_2"), row.get<game_skill_id>("skill_3")));
+auto skill_macros::load(const player_snapshot &snapshot) -> void {
+	for (const auto &row : snapshot.skill_macros) {
+		add(row.pos, new skill_macro(row.name, row.shout, row.skill_1, row.skill_2, row.skill_3));
 	}
 }
 
@@ -70,5 +66,18 @@ auto skill_macros::save(game_player_id char_id) -> void {
 	}
 }
 
+auto skill_macros::fill_snapshot(player_snapshot &snapshot) const -> void {
+	for (const auto &kvp : m_skill_macros) {
+		player_snapshot::skill_macro_row row;
+		row.pos = kvp.first;
+		row.name = kvp.second->name;
+		row.shout = kvp.second->shout;
+		row.skill_1 = kvp.second->skill1;
+		row.skill_2 = kvp.second->skill2;
+		row.skill_3 = kvp.second->skill3;
+		snapshot.skill_macros.push_back(std::move(row));
+	}
+}
+
 }
 }
\ No newline at end of file
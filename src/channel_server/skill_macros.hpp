@@ -24,6 +24,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace vana {
 	namespace channel_server {
+		struct player_snapshot;
+
 		class skill_macros {
 		public:
 			struct skill_macro;
@@ -32,8 +34,9 @@ namespace vana {
 			auto get_skill_macro(int8_t pos) -> skill_macro *;
 			auto get_max() -> int8_t;
 
-			auto load(game_player_id char_id) -> void;
+			auto load(const player_snapshot &snapshot) -> void;
 			auto save(game_player_id char_id) -> void;
+			auto fill_snapshot(player_snapshot &snapshot) const -> void;
 		private:
 			int8_t m_max_point = -1;
 			hash_map<int8_t, ref_ptr<skill_macro>> m_skill_macros;
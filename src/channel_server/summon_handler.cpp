@@ -155,7 +155,7 @@ auto summon_handler::move_summon(ref_ptr<player> player, packet_reader &reader)
 
 	move_path path(reader);
 	summon->reset_from_move_path(path);
-	player->send_map(packets::move_summon(player->get_id(), summon, path), true);
+	player->send_nearby(packets::move_summon(player->get_id(), summon, path), true);
 }
 
 auto summon_handler::damage_summon(ref_ptr<player> player, packet_reader &reader) -> void {
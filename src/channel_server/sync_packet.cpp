@@ -23,6 +23,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "channel_server/channel_server.hpp"
 #include "channel_server/party.hpp"
 #include "channel_server/player.hpp"
+#include "channel_server/player_snapshot.hpp"
 
 namespace vana {
 namespace channel_server {
@@ -153,6 +154,22 @@ PACKET_IMPL(player::connectable_established, game_player_id player_id) {
 	return builder;
 }
 
+PACKET_IMPL(player::handoff, game_player_id player_id, game_channel_id channel, ref_ptr<player_snapshot> snapshot) {
+	packet_builder builder;
+	builder
+		.add<packet_header>(IMSG_SYNC)
+		.add<protocol_sync>(sync::sync_types::player)
+		.add<protocol_sync>(sync::player::handoff)
+		.add<game_player_id>(player_id)
+		.add<game_channel_id>(channel)
+		.add<bool>(snapshot != nullptr);
+
+	if (snapshot != nullptr) {
+		snapshot->write_to_packet(builder);
+	}
+	return builder;
+}
+
 PACKET_IMPL(party::sync, int8_t type, game_player_id player_id, int32_t target) {
 	packet_builder builder;
 	builder
@@ -31,6 +31,7 @@ namespace vana {
 
 	namespace channel_server {
 		class player;
+		struct player_snapshot;
 
 		namespace packets {
 			namespace interserver {
@@ -45,6 +46,7 @@ namespace vana {
 					PACKET(connect, const player_data &player, bool first_connect);
 					PACKET(disconnect, game_player_id player_id);
 					PACKET(update_player, const player_data &player, protocol_update_bits flags);
+					PACKET(handoff, game_player_id player_id, game_channel_id channel, ref_ptr<player_snapshot> snapshot);
 				}
 				namespace party {
 					PACKET(sync, int8_t type, game_player_id player_id, int32_t target = 0);
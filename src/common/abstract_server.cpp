@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/connection_manager.hpp"
 #include "common/exit_code.hpp"
 #include "common/hash_utilities.hpp"
+#include "common/log/async_logger.hpp"
 #include "common/log/combo_loggers.hpp"
 #include "common/log/console_logger.hpp"
 #include "common/log/file_logger.hpp"
@@ -30,13 +31,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/lua/config_file.hpp"
 #include "common/session.hpp"
 #include "common/timer/thread.hpp"
+#include "common/timer/timer.hpp"
 #include "common/util/misc.hpp"
 #include "common/util/thread_pool.hpp"
 #include "common/util/time.hpp"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 namespace vana {
 
@@ -84,6 +88,7 @@ auto abstract_server::initialize() -> result {
 	}
 
 	m_inter_server_config = config->get<config::inter_server>("");
+	m_database_executor = make_owned_ptr<vana::io::database_executor>(m_connection_manager, m_inter_server_config.database_thread_count);
 
 	auto salting = lua::config_file::get_salting_config();
 	salting->run();
@@ -99,8 +104,9 @@ auto abstract_server::initialize() -> result {
 		return result::failure;
 	}
 	init_complete();
+	start_stats_reporting();
 
-	m_connection_manager.run();
+	m_connection_manager.run(m_inter_server_config.io_thread_count);
 
 	return result::success;
 }
@@ -118,6 +124,9 @@ auto abstract_server::load_log_config() -> void {
 }
 
 auto abstract_server::shutdown() -> void {
+	if (m_stats_endpoint != nullptr) {
+		m_stats_endpoint->stop();
+	}
 	m_connection_manager.stop();
 	vana::util::thread_pool::wait();
 }
@@ -134,6 +143,90 @@ auto abstract_server::get_interserver_salting_policy() const -> const config::sa
 	return m_salting_policy;
 }
 
+auto abstract_server::get_database_executor() -> vana::io::database_executor & {
+	return *m_database_executor;
+}
+
+auto abstract_server::get_handler_stats() -> vana::util::opcode_stats & {
+	return m_connection_manager.get_handler_stats();
+}
+
+auto abstract_server::start_stats_reporting() -> void {
+	if (m_inter_server_config.stats_log_interval.count() > 0) {
+		timer::timer::create(
+			[this](const time_point &now) {
+				// Handlers only ever run on the dispatch strand, so reading game state from there needs no extra locking
+				m_connection_manager.dispatch([this] {
+					log(vana::log::type::info, [&](out_stream &stream) {
+						stream << "Stats" << std::endl;
+						write_stats(stream);
+					});
+				});
+			},
+			timer::id{timer::type::stats_timer},
+			nullptr,
+			m_inter_server_config.stats_log_interval,
+			m_inter_server_config.stats_log_interval);
+	}
+
+	connection_port first_port = m_inter_server_config.stats_port;
+	if (first_port == 0) {
+		return;
+	}
+
+	// Every server on a host shares the same configuration, so each one takes the next free port
+	connection_port last_port = static_cast<connection_port>(std::min<uint32_t>(first_port + 31, std::numeric_limits<connection_port>::max()));
+	m_stats_endpoint = make_owned_ptr<stats_endpoint>(m_connection_manager, [this](out_stream &stream) { write_stats(stream); });
+	auto port = m_stats_endpoint->listen(first_port, last_port);
+	if (port.is_initialized()) {
+		log(vana::log::type::info, [&](out_stream &stream) {
+			stream << "Stats endpoint listening on 127.0.0.1:" << port.get();
+		});
+	}
+	else {
+		m_stats_endpoint.reset();
+		log(vana::log::type::warning, [&](out_stream &stream) {
+			stream << "No free port for the stats endpoint between " << first_port << " and " << last_port;
+		});
+	}
+}
+
+auto abstract_server::write_stats(out_stream &stream) -> void {
+	auto timer_lag = timer::thread::get_instance().get_lag_metrics();
+
+	stream << "vana_uptime_seconds " << vana::util::time::get_distance<seconds>(vana::util::time::get_now(), m_start_time) << std::endl;
+	stream << "vana_sessions " << m_connection_manager.get_session_count() << std::endl;
+	stream << "vana_timer_runs " << timer_lag.timers_run << std::endl;
+	stream << "vana_timer_pending " << timer_lag.timers_pending << std::endl;
+	stream << "vana_timer_lag_average_us " << duration_cast<microseconds>(timer_lag.get_average_lag()).count() << std::endl;
+	stream << "vana_timer_lag_max_us " << duration_cast<microseconds>(timer_lag.max_lag).count() << std::endl;
+	if (m_database_executor != nullptr) {
+		stream << "vana_database_threads " << m_database_executor->get_connection_count() << std::endl;
+		stream << "vana_database_queue_depth " << m_database_executor->get_pending_count() << std::endl;
+	}
+
+	write_server_stats(stream);
+
+	m_connection_manager.get_handler_stats().for_each([&](packet_header opcode, const vana::util::opcode_stats::entry &entry) {
+		out_stream label;
+		label << "opcode=\"0x" << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << opcode << "\"";
+		string opcode_label = label.str();
+		const auto &time = entry.handler_time;
+
+		stream << "vana_handler_requests{" << opcode_label << "} " << time.get_count() << std::endl;
+		stream << "vana_handler_bytes{" << opcode_label << "} " << entry.bytes.load() << std::endl;
+		for (const auto &quantile : {std::make_pair("0.5", 50.), std::make_pair("0.9", 90.), std::make_pair("0.99", 99.)}) {
+			stream << "vana_handler_time_us{" << opcode_label << ",quantile=\"" << quantile.first << "\"} " << time.get_percentile(quantile.second).count() << std::endl;
+		}
+		stream << "vana_handler_time_us_mean{" << opcode_label << "} " << time.get_mean().count() << std::endl;
+		stream << "vana_handler_time_us_max{" << opcode_label << "} " << time.get_max().count() << std::endl;
+	});
+}
+
+auto abstract_server::write_server_stats(out_stream &stream) -> void {
+	// Intentionally left blank
+}
+
 auto abstract_server::get_inter_server_config() const -> const config::inter_server & {
 	return m_inter_server_config;
 }
@@ -162,20 +255,25 @@ auto abstract_server::create_logger(const config::log &conf) -> void {
 	server_type server_type = get_server_type();
 	size_t buffer_size = conf.buffer_size;
 
+	owned_ptr<vana::log::base_logger> sink;
 	switch (static_cast<vana::log::destination>(conf.destination)) {
-		case vana::log::destination::console: m_logger = make_owned_ptr<vana::log::console_logger>(file, format, time_format, server_type, buffer_size); break;
-		case vana::log::destination::file: m_logger = make_owned_ptr<vana::log::file_logger>(file, format, time_format, server_type, buffer_size); break;
-		case vana::log::destination::sql: m_logger = make_owned_ptr<vana::log::sql_logger>(file, format, time_format, server_type, buffer_size); break;
-		case vana::log::destination::file_sql: m_logger = make_owned_ptr<vana::log::dual_logger<vana::log::file_logger, vana::log::sql_logger>>(file, format, time_format, server_type, buffer_size); break;
-		case vana::log::destination::file_console: m_logger = make_owned_ptr<vana::log::dual_logger<vana::log::file_logger, vana::log::console_logger>>(file, format, time_format, server_type, buffer_size); break;
-		case vana::log::destination::sql_console: m_logger = make_owned_ptr<vana::log::dual_logger<vana::log::sql_logger, vana::log::console_logger>>(file, format, time_format, server_type, buffer_size); break;
-		case vana::log::destination::file_sql_console: m_logger = make_owned_ptr<vana::log::tri_logger<vana::log::file_logger, vana::log::sql_logger, vana::log::console_logger>>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::console: sink = make_owned_ptr<vana::log::console_logger>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::file: sink = make_owned_ptr<vana::log::file_logger>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::sql: sink = make_owned_ptr<vana::log::sql_logger>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::file_sql: sink = make_owned_ptr<vana::log::dual_logger<vana::log::file_logger, vana::log::sql_logger>>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::file_console: sink = make_owned_ptr<vana::log::dual_logger<vana::log::file_logger, vana::log::console_logger>>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::sql_console: sink = make_owned_ptr<vana::log::dual_logger<vana::log::sql_logger, vana::log::console_logger>>(file, format, time_format, server_type, buffer_size); break;
+		case vana::log::destination::file_sql_console: sink = make_owned_ptr<vana::log::tri_logger<vana::log::file_logger, vana::log::sql_logger, vana::log::console_logger>>(file, format, time_format, server_type, buffer_size); break;
+	}
+
+	if (sink != nullptr) {
+		m_logger = make_owned_ptr<vana::log::async_logger>(std::move(sink));
 	}
 }
 
 auto abstract_server::log(vana::log::type type, const string &message) -> void {
 	if (auto logger = m_logger.get()) {
-		logger->log(type, make_log_identifier(), message);
+		logger->log(type, time(nullptr), make_log_identifier(), message);
 	}
 }
 
@@ -22,8 +22,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/config/salt.hpp"
 #include "common/connection_manager.hpp"
 #include "common/external_ip.hpp"
+#include "common/io/database_executor.hpp"
 #include "common/ip.hpp"
 #include "common/log/base_logger.hpp"
+#include "common/stats_endpoint.hpp"
 #include "common/types.hpp"
 #include <memory>
 #include <string>
@@ -44,6 +46,10 @@ namespace vana {
 		auto get_server_type() const -> server_type;
 		auto get_inter_password() const -> string;
 		auto get_interserver_salting_policy() const -> const config::salt &;
+		auto get_database_executor() -> vana::io::database_executor &;
+		auto get_handler_stats() -> vana::util::opcode_stats &;
+		// Text exposition format, one "name{labels} value" per line
+		auto write_stats(out_stream &stream) -> void;
 	protected:
 		abstract_server(server_type type);
 		virtual auto load_config() -> result;
@@ -51,6 +57,7 @@ namespace vana {
 		virtual auto load_data() -> result = 0;
 		virtual auto make_log_identifier() const -> opt_string = 0;
 		virtual auto get_log_prefix() const -> string = 0;
+		virtual auto write_server_stats(out_stream &stream) -> void;
 
 		auto get_inter_server_config() const -> const config::inter_server &;
 		auto send_auth(ref_ptr<session> session) const -> void;
@@ -60,6 +67,7 @@ namespace vana {
 	private:
 		auto load_log_config() -> void;
 		auto create_logger(const config::log &conf) -> void;
+		auto start_stats_reporting() -> void;
 
 		server_type m_server_type = server_type::none;
 		time_point m_start_time;
@@ -70,5 +78,7 @@ namespace vana {
 		config::salt m_salting_policy;
 		ip_matrix m_external_ips;
 		connection_manager m_connection_manager;
+		owned_ptr<vana::io::database_executor> m_database_executor;
+		owned_ptr<stats_endpoint> m_stats_endpoint;
 	};
 }
\ No newline at end of file
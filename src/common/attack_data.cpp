@@ -0,0 +1,64 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "attack_data.hpp"
+#include "common/packet_reader.hpp"
+
+namespace vana {
+
+auto attack_data::read_targets(packet_reader &reader, bool summon) -> void {
+	int8_t target_hits = hits;
+	for (int8_t i = 0; i < targets; ++i) {
+		game_map_object map_mob_id = reader.get<game_map_object>();
+		// hitAction is calculated using: rand() % hitAnimation + 7
+		// However, it doesn't match with the standard 6 outcome (when there's only 1 animation)
+		// This should be -1 when there's no hit animation
+		auto hitAction = reader.get<int8_t>();
+		
+		auto tmp = reader.get<uint8_t>();
+		// The imgActionNodeIndex is the wz property node index of the action/animation of the mob
+		// This would be used for mob position checking (in combination with frameIdx)
+		auto imgActionNodeIndex = (tmp & 0x7F);
+		auto facingLeft = (int)((tmp >> 7) & 1);
+
+		auto frameIdx = reader.get<int8_t>(); // Mob animation frame index
+
+		reader.skip<uint8_t>(); // Damage stats calculator index. Bit 8 == mob doomed
+		
+		reader.skip<point>(); // Mob pos
+		reader.skip<point>(); // Damage pos
+		if (!is_meso_explosion) {
+			reader.skip<uint16_t>(); // Delay per hit
+		}
+		else {
+			target_hits = reader.get<int8_t>(); // Hits for Meso Explosion
+		}
+		attack_target *target = damages.get_or_add(map_mob_id);
+		for (int8_t k = 0; k < target_hits; ++k) {
+			game_damage damage = reader.get<game_damage>();
+			// Anything past the protocol limits is hacking, so it's read off and dropped
+			if (target != nullptr && target->add_hit(damage)) {
+				total_damage += damage;
+			}
+		}
+		if (!summon) {
+			reader.skip<game_checksum>();
+		}
+	}
+}
+
+}
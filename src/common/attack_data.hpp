@@ -19,10 +19,61 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "common/point.hpp"
 #include "common/types.hpp"
-#include <unordered_map>
-#include <vector>
+#include <array>
 
 namespace vana {
+	class packet_reader;
+
+	// Damage lines for one mob, stored inline since the client packs hit counts into a nibble
+	class attack_target {
+	public:
+		static const uint8_t max_hits = 15;
+
+		attack_target() = default;
+		explicit attack_target(game_map_object map_mob_id) : m_map_mob_id{map_mob_id} { }
+
+		auto get_map_mob_id() const -> game_map_object { return m_map_mob_id; }
+		auto size() const -> uint8_t { return m_hit_count; }
+		auto begin() const -> const game_damage * { return m_hits.data(); }
+		auto end() const -> const game_damage * { return m_hits.data() + m_hit_count; }
+		auto add_hit(game_damage damage) -> bool {
+			if (m_hit_count >= max_hits) return false;
+			m_hits[m_hit_count++] = damage;
+			return true;
+		}
+	private:
+		game_map_object m_map_mob_id = 0;
+		uint8_t m_hit_count = 0;
+		array<game_damage, max_hits> m_hits;
+	};
+
+	// Fixed capacity target list in packet order so compiling an attack doesn't allocate
+	class attack_targets {
+	public:
+		static const uint8_t max_targets = 15;
+
+		auto size() const -> uint8_t { return m_target_count; }
+		auto begin() const -> const attack_target * { return m_targets.data(); }
+		auto end() const -> const attack_target * { return m_targets.data() + m_target_count; }
+
+		// The same mob listed twice gets its hits appended, nullptr means the list is full
+		auto get_or_add(game_map_object map_mob_id) -> attack_target * {
+			for (uint8_t i = 0; i < m_target_count; ++i) {
+				if (m_targets[i].get_map_mob_id() == map_mob_id) {
+					return &m_targets[i];
+				}
+			}
+			if (m_target_count >= max_targets) {
+				return nullptr;
+			}
+			m_targets[m_target_count] = attack_target{map_mob_id};
+			return &m_targets[m_target_count++];
+		}
+	private:
+		uint8_t m_target_count = 0;
+		array<attack_target, max_targets> m_targets;
+	};
+
 	struct attack_data {
 		bool is_meso_explosion = false;
 		bool is_shadow_meso = false;
@@ -47,6 +98,9 @@ namespace vana {
 		int64_t total_damage = 0;
 		point projectile_pos;
 		point player_pos;
-		hash_map<game_map_object, vector<game_damage>> damages;
+		attack_targets damages;
+
+		// Reads the damage lines for every target, targets, hits and is_meso_explosion have to be filled in first
+		auto read_targets(packet_reader &reader, bool summon) -> void;
 	};
 }
\ No newline at end of file
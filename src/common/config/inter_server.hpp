@@ -32,6 +32,12 @@ namespace vana {
 			}
 
 			bool client_encryption = true;
+			uint32_t client_send_queue_limit = 1048576;
+			uint16_t io_thread_count = 1;
+			uint16_t database_thread_count = 2;
+			uint16_t map_worker_count = 0;
+			seconds stats_log_interval{0};
+			connection_port stats_port = 0;
 			ping client_ping;
 			ping server_ping;
 			connection_port login_port = 0;
@@ -44,6 +50,12 @@ namespace vana {
 		auto read(lua_environment &config, const string &prefix) -> config::inter_server {
 			config::inter_server ret;
 			ret.client_encryption = config.get<bool>("use_client_encryption");
+			ret.client_send_queue_limit = config.get<uint32_t>("client_send_queue_limit", ret.client_send_queue_limit);
+			ret.io_thread_count = config.get<uint16_t>("io_threads", ret.io_thread_count);
+			ret.database_thread_count = config.get<uint16_t>("database_threads", ret.database_thread_count);
+			ret.map_worker_count = config.get<uint16_t>("map_worker_threads", ret.map_worker_count);
+			ret.stats_log_interval = seconds{config.get<int32_t>("stats_log_interval", 0)};
+			ret.stats_port = config.get<connection_port>("stats_port", ret.stats_port);
 			ret.client_ping = config.get<config::ping>("client_ping");
 			ret.server_ping = config.get<config::ping>("inter_ping");
 			ret.login_ip = ip{ip::string_to_ipv4(config.get<string>("login_ip"))};
@@ -44,6 +44,9 @@ namespace vana {
 			seconds fame_time = seconds{24 * 60 * 60};
 			seconds fame_reset_time = seconds{24 * 60 * 60 * 30};
 			seconds map_unload_time = seconds{30 * 60};
+			int32_t interest_player_threshold = 0;
+			game_coord interest_view_range = 1000;
+			milliseconds movement_coalesce_interval = milliseconds{0};
 			game_channel_id max_channels = 19;
 			string event_message;
 			string scrolling_header;
@@ -158,6 +161,18 @@ namespace vana {
 					if (config.validate_value(lua_type::number, value.second, key, prefix, true) == lua_type::nil) continue;
 					ret.map_unload_time = value.second.as<seconds>();
 				}
+				else if (key == "interest_player_threshold") {
+					if (config.validate_value(lua_type::number, value.second, key, prefix, true) == lua_type::nil) continue;
+					ret.interest_player_threshold = value.second.as<int32_t>();
+				}
+				else if (key == "interest_view_range") {
+					if (config.validate_value(lua_type::number, value.second, key, prefix, true) == lua_type::nil) continue;
+					ret.interest_view_range = value.second.as<game_coord>();
+				}
+				else if (key == "movement_coalesce_interval") {
+					if (config.validate_value(lua_type::number, value.second, key, prefix, true) == lua_type::nil) continue;
+					ret.movement_coalesce_interval = value.second.as<milliseconds>();
+				}
 				else if (key == "rates") {
 					if (config.validate_value(lua_type::table, value.second, key, prefix, true) == lua_type::nil) continue;
 					ret.rates = value.second.into<config::rates>(config, prefix + "." + key);
@@ -234,6 +249,9 @@ namespace vana {
 			ret.fame_time = reader.get<seconds>();
 			ret.fame_reset_time = reader.get<seconds>();
 			ret.map_unload_time = reader.get<seconds>();
+			ret.interest_player_threshold = reader.get<int32_t>();
+			ret.interest_view_range = reader.get<game_coord>();
+			ret.movement_coalesce_interval = reader.get<milliseconds>();
 			ret.max_channels = reader.get<game_channel_id>();
 			ret.event_message = reader.get<string>();
 			ret.scrolling_header = reader.get<string>();
@@ -267,6 +285,9 @@ namespace vana {
 			builder.add<seconds>(obj.fame_time);
 			builder.add<seconds>(obj.fame_reset_time);
 			builder.add<seconds>(obj.map_unload_time);
+			builder.add<int32_t>(obj.interest_player_threshold);
+			builder.add<game_coord>(obj.interest_view_range);
+			builder.add<milliseconds>(obj.movement_coalesce_interval);
 			builder.add<game_channel_id>(obj.max_channels);
 			builder.add<string>(obj.event_message);
 			builder.add<string>(obj.scrolling_header);
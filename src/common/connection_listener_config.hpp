@@ -26,6 +26,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 	struct connection_listener_config {
 		config::ping ping;
+		// 0 means the send queue is unbounded
+		uint32_t max_send_queue_bytes;
 		bool encrypt;
 		connection_type type;
 		string subversion;
@@ -34,12 +36,14 @@ namespace vana {
 
 		connection_listener_config(
 			const config::ping &ping,
+			uint32_t max_send_queue_bytes,
 			bool encrypt,
 			connection_type type,
 			string subversion,
 			connection_port port,
 			ip::type ip_type) :
 			ping{ping},
+			max_send_queue_bytes{max_send_queue_bytes},
 			encrypt{encrypt},
 			type{type},
 			subversion{subversion},
@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 
 connection_manager::connection_manager(abstract_server *server) :
+	m_dispatch_strand{m_io_service},
 	m_server{server}
 {
 	m_work = make_owned_ptr<asio::io_service::work>(m_io_service);
@@ -37,7 +38,7 @@ connection_manager::~connection_manager() {
 	// m_work.reset() needs to be a pre-wait hook and in the destructor for the cases where the thread is never leased (e.g. DB unavailable)
 	// Doing this a second time doesn't harm an already-reset m_work pointer, so we're in the clear
 	m_work.reset();
-	m_thread.reset();
+	m_threads.clear();
 }
 
 auto connection_manager::listen(const connection_listener_config &config, handler_creator handler_creator) -> void {
@@ -100,9 +101,10 @@ auto connection_manager::connect(const ip &destination, connection_port port, co
 				}
 				else {
 					new_session->set_type(vana::util::misc::get_connection_type(source_type));
-					new_session->start(ping, make_ref_ptr<encrypted_packet_transformer>(recv_iv, send_iv));
+					// Outbound connections are always to other servers, so their send queue is unbounded
+					new_session->start(ping, 0, make_ref_ptr<encrypted_packet_transformer>(recv_iv, send_iv));
 
-					m_sessions.insert(new_session);
+					start(new_session);
 
 					return std::make_pair(result::success, new_session);
 				}
@@ -129,19 +131,26 @@ auto connection_manager::stop() -> void {
 	}
 	m_servers.clear();
 
-	for (auto &session : m_sessions) {
+	hash_set<ref_ptr<session>> sessions;
+	{
+		owned_lock<mutex> l{m_sessions_mutex};
+		sessions.swap(m_sessions);
+	}
+
+	for (auto &session : sessions) {
 		session->disconnect();
 	}
-	m_sessions.clear();
 }
 
 auto connection_manager::stop(ref_ptr<session> session) -> void {
 	if (m_stopping) return;
+	owned_lock<mutex> l{m_sessions_mutex};
 	m_sessions.erase(session);
 }
 
 auto connection_manager::start(ref_ptr<session> session) -> void {
 	if (m_stopping) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+	owned_lock<mutex> l{m_sessions_mutex};
 	m_sessions.insert(session);
 }
 
@@ -149,10 +158,40 @@ auto connection_manager::get_server() -> abstract_server * {
 	return m_server;
 }
 
-auto connection_manager::run() -> void {
-	m_thread = vana::util::thread_pool::lease(
-		[this] { m_io_service.run(); },
-		[this] { m_work.reset(); });
+auto connection_manager::get_io_service() -> asio::io_service & {
+	return m_io_service;
+}
+
+auto connection_manager::dispatch(function<void()> work) -> void {
+	m_dispatch_strand.post([this, work] {
+		owned_lock<vana::util::shared_gate> l{m_dispatch_gate};
+		work();
+	});
+}
+
+auto connection_manager::get_dispatch_gate() -> vana::util::shared_gate & {
+	return m_dispatch_gate;
+}
+
+auto connection_manager::get_session_count() const -> size_t {
+	owned_lock<mutex> l{m_sessions_mutex};
+	return m_sessions.size();
+}
+
+auto connection_manager::get_handler_stats() -> vana::util::opcode_stats & {
+	return m_handler_stats;
+}
+
+auto connection_manager::run(uint16_t thread_count) -> void {
+	if (thread_count == 0) {
+		thread_count = 1;
+	}
+
+	for (uint16_t i = 0; i < thread_count; ++i) {
+		m_threads.push_back(vana::util::thread_pool::lease(
+			[this] { m_io_service.run(); },
+			[this] { m_work.reset(); }));
+	}
 }
 
 }
\ No newline at end of file
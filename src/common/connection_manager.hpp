@@ -21,6 +21,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/server_type.hpp"
 #include "common/session.hpp"
 #include "common/types.hpp"
+#include "common/util/opcode_stats.hpp"
+#include "common/util/shared_gate.hpp"
 #include <asio.hpp>
 #include <atomic>
 #include <memory>
@@ -44,18 +46,33 @@ namespace vana {
 		~connection_manager();
 		auto listen(const connection_listener_config &listener, handler_creator handler_creator) -> void;
 		auto connect(const ip &destination, connection_port port, const config::ping &ping, server_type source_type, handler_creator handler_creator) -> pair<result, ref_ptr<session>>;
-		auto run() -> void;
+		auto run(uint16_t thread_count) -> void;
 		auto stop() -> void;
 		auto stop(ref_ptr<session> session) -> void;
 		auto start(ref_ptr<session> session) -> void;
 		auto get_server() -> abstract_server *;
+		auto get_io_service() -> asio::io_service &;
+		// Runs work on the dispatch strand while holding the dispatch gate exclusively
+		auto dispatch(function<void()> work) -> void;
+		// Anything running game logic off the dispatch strand must hold this shared
+		auto get_dispatch_gate() -> vana::util::shared_gate &;
+		auto get_session_count() const -> size_t;
+		auto get_handler_stats() -> vana::util::opcode_stats &;
 	private:
 		vector<ref_ptr<connection_listener>> m_servers;
 		hash_set<ref_ptr<session>> m_sessions;
-		ref_ptr<std::thread> m_thread;
+		vector<ref_ptr<std::thread>> m_threads;
 		owned_ptr<asio::io_service::work> m_work;
 		asio::io_service m_io_service;
+		// Socket I/O and decryption run on each session's own strand, but packet handlers touch shared game state
+		// All handlers are funneled through this strand so they never run concurrently with each other
+		// Work a server hands to its own threads instead holds the gate shared, dispatched work holds it exclusively
+		asio::io_service::strand m_dispatch_strand;
+		vana::util::shared_gate m_dispatch_gate;
+		vana::util::opcode_stats m_handler_stats;
+		mutable mutex m_sessions_mutex;
 		abstract_server *m_server;
-		bool m_stopping = false;
+		// Set by stop() and read from the I/O threads
+		std::atomic<bool> m_stopping{false};
 	};
 }
\ No newline at end of file
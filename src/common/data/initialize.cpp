@@ -17,6 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #include "initialize.hpp"
 #include "common/abstract_server.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/data/version.hpp"
 #include "common/io/database.hpp"
 #include "common/io/database_updater.hpp"
@@ -105,6 +106,8 @@ auto check_mcdb_version(abstract_server *server) -> result {
 		});
 	}
 
+	vana::data::snapshot::get_instance().open(major_version, minor_version, maple_version, test_server, maple_locale);
+
 	return result::success;
 }
 
@@ -19,7 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/algorithm.hpp"
 #include "common/constant/gender.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/game_logic/player.hpp"
 #include "common/util/randomizer.hpp"
 #include <algorithm>
@@ -44,11 +45,9 @@ auto beauty::load_skins() -> void {
 	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing Skins... ";
 	m_skins.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::character_skin_data) << " ORDER BY skinid ASC");
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::character_skin_data, "skinid ASC");
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		m_skins.push_back(row.get<game_skin_id>("skinid"));
 	}
 
@@ -58,11 +57,9 @@ auto beauty::load_skins() -> void {
 auto beauty::load_hair() -> void {
 	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing Hair... ";
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::character_hair_data) << " ORDER BY hairid ASC");
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::character_hair_data, "hairid ASC");
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_gender_id gender_id = vana::util::game_logic::player::get_gender_id(row.get<string>("gender"));
 		game_hair_id hair = row.get<game_hair_id>("hairid");
 		auto &gender = gender_id == constant::gender::female ? m_female : m_male;
@@ -75,11 +72,9 @@ auto beauty::load_hair() -> void {
 auto beauty::load_faces() -> void {
 	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing Faces... ";
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::character_face_data) << " ORDER BY faceid ASC");
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::character_face_data, "faceid ASC");
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_gender_id gender_id = vana::util::game_logic::player::get_gender_id(row.get<string>("gender"));
 		game_face_id face = row.get<game_face_id>("faceid");
 		auto &gender = gender_id == constant::gender::female ? m_female : m_male;
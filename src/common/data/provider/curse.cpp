@@ -16,11 +16,10 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #include "curse.hpp"
-#include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/string.hpp"
-#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
@@ -31,23 +30,24 @@ namespace provider {
 auto curse::load_data() -> void {
 	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing Curse Info...";
 
-	m_curse_words.clear();
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::curse_data));
+	vector<string> words;
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::curse_data);
 
-	for (const auto &row : rs) {
-		m_curse_words.push_back(row.get<string>("word"));
+	for (const auto &row : *rs) {
+		words.push_back(row.get<string>("word"));
 	}
 
+	m_curse_words.build(words);
+
 	std::cout << "DONE" << std::endl;
 }
 
 auto curse::is_curse_word(const string &cmp) const -> bool {
-	string c = vana::util::str::remove_spaces(vana::util::str::to_lower(cmp));
-	return ext::any_of(m_curse_words, [&c](const string &s) -> bool {
-		return c.find(s, 0) != string::npos;
-	});
+	return m_curse_words.contains_any(vana::util::str::remove_spaces(vana::util::str::to_lower(cmp)));
+}
+
+auto curse::get_curse_matcher() const -> const vana::util::string_matcher & {
+	return m_curse_words;
 }
 
 }
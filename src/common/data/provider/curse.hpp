@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/types.hpp"
+#include "common/util/string_matcher.hpp"
 #include <string>
 #include <vector>
 
@@ -29,8 +30,9 @@ namespace vana {
 				auto load_data() -> void;
 
 				auto is_curse_word(const string &cmp) const -> bool;
+				auto get_curse_matcher() const -> const vana::util::string_matcher &;
 			private:
-				vector<string> m_curse_words;
+				vana::util::string_matcher m_curse_words;
 			};
 		}
 	}
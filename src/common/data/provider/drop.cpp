@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "drop.hpp"
 #include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/io/database.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
@@ -47,11 +48,9 @@ auto drop::load_drops() -> void {
 		});
 	};
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::drop_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::drop_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		info = data::type::drop_info{};
 
 		int32_t dropper = row.get<int32_t>("dropperid");
@@ -62,26 +61,16 @@ auto drop::load_drops() -> void {
 		info.chance = row.get<uint32_t>("chance");
 		drop_flags(row.get<opt_string>("flags"));
 
-		bool found = false;
-		for (auto &drop : m_drop_info) {
-			if (drop.first == dropper) {
-				found = true;
-				drop.second.push_back(info);
-				break;
-			}
-		}
-
-		if (!found) {
-			vector<data::type::drop_info> current;
-			current.push_back(info);
-			m_drop_info.emplace_back(dropper, current);
-		}
+		m_drop_info[dropper].push_back(info);
 	}
 
-	rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::user_drop_data) << " ORDER BY dropperid");
+	// User data is meant to be edited in place, so it never comes from the snapshot
+	auto &db = vana::io::database::get_data_db();
+	auto &sql = db.get_session();
+	soci::rowset<> user_rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::user_drop_data) << " ORDER BY dropperid");
 	int32_t last_dropper_id = -1;
 
-	for (const auto &row : rs) {
+	for (const auto &row : user_rs) {
 		info = data::type::drop_info{};
 
 		int32_t dropper = row.get<int32_t>("dropperid");
@@ -93,25 +82,11 @@ auto drop::load_drops() -> void {
 		drop_flags(row.get<opt_string>("flags"));
 
 		if (dropper != last_dropper_id) {
-			// Check to see if a drop is required
-			bool removed = ext::remove_element_if(
-				m_drop_info,
-				[&dropper](auto value) {
-					return value.first == dropper;
-				});
-
-			if (removed) {
-				vector<data::type::drop_info> current;
-				m_drop_info.emplace_back(dropper, current);
-			}
+			// User drop data replaces whatever the dropper had by default
+			m_drop_info[dropper].clear();
 		}
 
-		for (auto &drop : m_drop_info) {
-			if (drop.first == dropper) {
-				drop.second.push_back(info);
-				break;
-			}
-		}
+		m_drop_info[dropper].push_back(info);
 
 		last_dropper_id = dropper;
 	}
@@ -120,11 +95,9 @@ auto drop::load_drops() -> void {
 auto drop::load_global_drops() -> void {
 	m_global_drops.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::drop_global_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::drop_global_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::global_drop_info drop;
 
 		drop.continent = row.get<int8_t>("continent");
@@ -144,10 +117,8 @@ auto drop::load_global_drops() -> void {
 }
 
 auto drop::get_drops(int32_t object_id) const -> const vector<data::type::drop_info> & {
-	for (const auto &drop : m_drop_info) {
-		if (drop.first == object_id) {
-			return drop.second;
-		}
+	if (auto drops = ext::find_value_ptr(m_drop_info, object_id)) {
+		return *drops;
 	}
 
 	static vector<data::type::drop_info> empty;
@@ -36,7 +36,7 @@ namespace vana {
 				auto load_drops() -> void;
 				auto load_global_drops() -> void;
 
-				vector<pair<int32_t, vector<data::type::drop_info>>> m_drop_info;
+				hash_map<int32_t, vector<data::type::drop_info>> m_drop_info;
 				vector<data::type::global_drop_info> m_global_drops;
 			};
 		}
@@ -16,8 +16,10 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #include "equip.hpp"
+#include "common/algorithm.hpp"
 #include "common/constant/job/track.hpp"
 #include "common/data/initialize.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/io/database.hpp"
 #include "common/util/randomizer.hpp"
 #include "common/util/string.hpp"
@@ -41,17 +43,17 @@ auto equip::load_data() -> void {
 auto equip::load_equips() -> void {
 	m_equip_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
 	// Ugly hack to get the integers instead of scientific notation
 	// Note: This is MySQL's crappy behavior
 	// It displays scientific notation for only very large values, meaning it's wildly inconsistent and hard to parse
 	// We just use the string and send it to a translation function
-	soci::rowset<> rs = (sql.prepare
-		<< "SELECT *, REPLACE(FORMAT(equip_slots + 0, 0), \",\", \"\") AS equip_slot_flags "
-		<< "FROM " << db.make_table(vana::data::table::item_equip_data));
+	auto rs = vana::data::snapshot::get_instance().get_query(vana::data::table::item_equip_data + " with equip_slot_flags", [](vana::io::database &db) -> soci::rowset<> {
+		return (db.get_session().prepare
+			<< "SELECT *, REPLACE(FORMAT(equip_slots + 0, 0), \",\", \"\") AS equip_slot_flags "
+			<< "FROM " << db.make_table(vana::data::table::item_equip_data));
+	});
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::equip_info equip;
 
 		equip.id = row.get<game_item_id>("itemid");
@@ -100,7 +102,7 @@ auto equip::load_equips() -> void {
 			else if (cmp == "pirate") equip.valid_jobs.push_back(constant::job::track::pirate);
 		});
 
-		m_equip_info.push_back(equip);
+		m_equip_info.emplace(equip.id, equip);
 	}
 }
 
@@ -199,10 +201,9 @@ auto equip::get_slots(game_item_id equip_id) const -> int8_t {
 }
 
 auto equip::get_equip_info(game_item_id equip_id) const -> const data::type::equip_info & {
-	for (const auto &equip : m_equip_info) {
-		if (equip.id == equip_id) {
-			return equip;
-		}
+	auto equip = ext::find_value_ptr(m_equip_info, equip_id);
+	if (equip != nullptr) {
+		return *equip;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
@@ -37,7 +37,7 @@ namespace vana {
 			private:
 				auto load_equips() -> void;
 
-				vector<data::type::equip_info> m_equip_info;
+				hash_map<game_item_id, data::type::equip_info> m_equip_info;
 			};
 		}
 	}
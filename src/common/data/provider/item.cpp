@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/data/provider/equip.hpp"
 #include "common/data/provider/shop.hpp"
 #include "common/data/initialize.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/io/database.hpp"
 #include "common/item.hpp"
 #include "common/util/game_logic/item.hpp"
@@ -55,15 +56,15 @@ auto item::load_data(buff &provider) -> void {
 auto item::load_items() -> void {
 	m_item_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare
-		<< "SELECT id.*, s.label "
-		<< "FROM " << db.make_table(vana::data::table::item_data) << " id "
-		<< "LEFT JOIN " << db.make_table(vana::data::table::strings) << " s ON id.itemid = s.objectid AND s.object_type = :item",
-		soci::use(string{"item"}, "item"));
+	auto rs = vana::data::snapshot::get_instance().get_query(vana::data::table::item_data + " with labels", [](vana::io::database &db) -> soci::rowset<> {
+		return (db.get_session().prepare
+			<< "SELECT id.*, s.label "
+			<< "FROM " << db.make_table(vana::data::table::item_data) << " id "
+			<< "LEFT JOIN " << db.make_table(vana::data::table::strings) << " s ON id.itemid = s.objectid AND s.object_type = :item",
+			soci::use(string{"item"}, "item"));
+	});
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::item_info info;
 		vana::util::str::run_flags(row.get<opt_string>("flags"), [&info](const string &cmp) {
 			if (cmp == "time_limited") info.time_limited = true;
@@ -88,18 +89,16 @@ auto item::load_items() -> void {
 		info.npc = row.get<game_npc_id>("npc");
 		info.name = row.get<string>("label");
 
-		m_item_info.push_back(info);
+		m_item_info.emplace(info.id, info);
 	}
 }
 
 auto item::load_scrolls() -> void {
 	m_scroll_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_scroll_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_scroll_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::scroll_info info;
 		info.item_id = row.get<game_item_id>("itemid");
 		info.success = row.get<uint16_t>("success");
@@ -126,19 +125,17 @@ auto item::load_scrolls() -> void {
 			else if (cmp == "prevent_slip") info.prevent_slip = true;
 		});
 
-		m_scroll_info.push_back(info);
+		m_scroll_info.emplace(info.item_id, info);
 	}
 }
 
 auto item::load_consumes(buff &provider) -> void {
 	m_consume_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_random_morphs));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_random_morphs);
 
 	hash_map<game_item_id, vector<data::type::morph_chance_info>> morph_data;
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::morph_chance_info info;
 		game_item_id item_id = row.get<game_item_id>("itemid");
 		info.morph = row.get<game_morph_id>("morphid");
@@ -147,9 +144,9 @@ auto item::load_consumes(buff &provider) -> void {
 		morph_data[item_id].push_back(info);
 	}
 
-	rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_consume_data));
+	rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_consume_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::consume_info info;
 		info.item_id = row.get<game_item_id>("itemid");
 		info.effect = row.get<uint8_t>("effect");
@@ -231,57 +228,47 @@ auto item::load_consumes(buff &provider) -> void {
 		});
 
 		provider.add_item_info(info.item_id, info);
-		m_consume_info.push_back(info);
+		m_consume_info.emplace(info.item_id, info);
 	}
 }
 
 auto item::load_map_ranges() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_monster_card_map_ranges));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_monster_card_map_ranges);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::card_map_range_info info;
 		game_item_id item_id = row.get<game_item_id>("itemid");
 		info.start_map = row.get<game_map_id>("start_map");
 		info.end_map = row.get<game_map_id>("end_map");
 
-		bool found = false;
-		for (auto &item : m_consume_info) {
-			if (item.item_id == item_id) {
-				found = true;
-				item.map_ranges.push_back(info);
-				break;
-			}
-		}
+		auto kvp = m_consume_info.find(item_id);
+		if (kvp == std::end(m_consume_info)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		kvp->second.map_ranges.push_back(info);
 	}
 }
 
 auto item::load_monster_card_data() -> void {
-	m_mob_to_card_mapping.clear();
+	m_mob_to_card.clear();
+	m_card_to_mob.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::monster_card_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::monster_card_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_item_id card_id = row.get<game_item_id>("cardid");
 		game_mob_id mob_id = row.get<game_mob_id>("mobid");
 
-		m_mob_to_card_mapping.emplace_back(card_id, mob_id);
+		m_mob_to_card.emplace(mob_id, card_id);
+		m_card_to_mob.emplace(card_id, mob_id);
 	}
 }
 
 auto item::load_item_skills() -> void {
 	m_skillbooks.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_skills));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_skills);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::skillbook_info info;
 		game_item_id item_id = row.get<game_item_id>("itemid");
 		info.skill_id = row.get<game_skill_id>("skillid");
@@ -289,61 +276,31 @@ auto item::load_item_skills() -> void {
 		info.max_level = row.get<game_skill_level>("master_level");
 		info.chance = row.get<int8_t>("chance");
 
-		bool found = false;
-		for (auto &book : m_skillbooks) {
-			if (book.first == item_id) {
-				found = true;
-				book.second.push_back(info);
-				break;
-			}
-		}
-
-		if (!found) {
-			vector<data::type::skillbook_info> current;
-			current.push_back(info);
-			m_skillbooks.emplace_back(item_id, current);
-		}
+		m_skillbooks[item_id].push_back(info);
 	}
 }
 
 auto item::load_summon_bags() -> void {
 	m_summon_bags.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_summons));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_summons);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::summon_bag_info info;
 		game_item_id item_id = row.get<game_item_id>("itemid");
 		info.mob_id = row.get<game_mob_id>("mobid");
 		info.chance = row.get<uint16_t>("chance");
 
-		bool found = false;
-		for (auto &summon : m_summon_bags) {
-			if (summon.first == item_id) {
-				found = true;
-				summon.second.push_back(info);
-				break;
-			}
-		}
-
-		if (!found) {
-			vector<data::type::summon_bag_info> current;
-			current.push_back(info);
-			m_summon_bags.emplace_back(item_id, current);
-		}
+		m_summon_bags[item_id].push_back(info);
 	}
 }
 
 auto item::load_item_rewards() -> void {
 	m_item_rewards.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_reward_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_reward_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::item_reward_info info;
 		game_item_id item_id = row.get<game_item_id>("itemid");
 		info.reward_id = row.get<game_item_id>("rewardid");
@@ -351,31 +308,16 @@ auto item::load_item_rewards() -> void {
 		info.quantity = row.get<int16_t>("quantity");
 		info.effect = row.get<string>("effect");
 
-		bool found = false;
-		for (auto &reward : m_item_rewards) {
-			if (reward.first == item_id) {
-				found = true;
-				reward.second.push_back(info);
-				break;
-			}
-		}
-
-		if (!found) {
-			vector<data::type::item_reward_info> current;
-			current.push_back(info);
-			m_item_rewards.emplace_back(item_id, current);
-		}
+		m_item_rewards[item_id].push_back(info);
 	}
 }
 
 auto item::load_pets() -> void {
 	m_pet_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_pet_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_pet_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::pet_info info;
 		info.item_id = row.get<game_item_id>("itemid");
 		info.name = row.get<string>("default_name");
@@ -390,52 +332,44 @@ auto item::load_pets() -> void {
 			else if (cmp == "auto_react") info.auto_react = true;
 		});
 
-		m_pet_info.push_back(info);
+		m_pet_info.emplace(info.item_id, info);
 	}
 }
 
 auto item::load_pet_interactions() -> void {
 	m_pet_interact_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::item_pet_interactions));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::item_pet_interactions);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::pet_interact_info info;
 		info.item_id = row.get<game_item_id>("itemid");
 		info.command_id = row.get<int32_t>("command");
 		info.increase = row.get<int16_t>("closeness");
 		info.prob = row.get<uint32_t>("success");
 
-		m_pet_interact_info.push_back(info);
+		m_pet_interact_info[info.item_id].emplace(info.command_id, info);
 	}
 }
 
 auto item::get_card_id(game_mob_id mob_id) const -> optional<game_item_id> {
-	auto kvp =
-		ext::find_value_ptr_if(m_mob_to_card_mapping, [&mob_id](auto value) { return value.second == mob_id; });
-
-	if (kvp == nullptr) {
+	auto card_id = ext::find_value_ptr(m_mob_to_card, mob_id);
+	if (card_id == nullptr) {
 		return {};
 	}
-	return kvp->first;
+	return *card_id;
 }
 
 auto item::get_mob_id(game_item_id card_id) const -> optional<game_mob_id> {
-	auto kvp =
-		ext::find_value_ptr_if(m_mob_to_card_mapping, [&card_id](auto value) { return value.first == card_id; });
-
-	if (kvp == nullptr) {
+	auto mob_id = ext::find_value_ptr(m_card_to_mob, card_id);
+	if (mob_id == nullptr) {
 		return {};
 	}
-	return kvp->second;
+	return *mob_id;
 }
 
 auto item::scroll_item(const equip &provider, game_item_id scroll_id, vana::item *equip, bool white_scroll, bool gm_scroller, int8_t &succeed, bool &cursed) const -> hacking_result {
-	auto kvp = ext::find_value_ptr_if(
-		m_scroll_info,
-		[&scroll_id](auto value) { return value.item_id == scroll_id; });
+	auto kvp = ext::find_value_ptr(m_scroll_info, scroll_id);
 
 	if (kvp == nullptr) {
 		return hacking_result::definitely_hacking;
@@ -529,45 +463,31 @@ auto item::scroll_item(const equip &provider, game_item_id scroll_id, vana::item
 }
 
 auto item::get_item_info(game_item_id item_id) const -> const data::type::item_info * const {
-	return ext::find_value_ptr_if(
-		m_item_info,
-		[&item_id](auto value) { return value.id == item_id; });
+	return ext::find_value_ptr(m_item_info, item_id);
 }
 
 auto item::get_consume_info(game_item_id item_id) const -> const data::type::consume_info * const {
-	return ext::find_value_ptr_if(
-		m_consume_info,
-		[&item_id](auto value) { return value.item_id == item_id; });
+	return ext::find_value_ptr(m_consume_info, item_id);
 }
 
 auto item::get_pet_info(game_item_id item_id) const -> const data::type::pet_info * const {
-	return ext::find_value_ptr_if(
-		m_pet_info,
-		[&item_id](auto value) { return value.item_id == item_id; });
+	return ext::find_value_ptr(m_pet_info, item_id);
 }
 
 auto item::get_interaction(game_item_id item_id, int32_t action) const -> const data::type::pet_interact_info * const {
-	return ext::find_value_ptr_if(
-		m_pet_interact_info,
-		[&item_id, &action](auto value) { return value.item_id == item_id && value.command_id == action; });
+	return ext::find_value_ptr(ext::find_value_ptr(m_pet_interact_info, item_id), action);
 }
 
 auto item::get_item_skills(game_item_id item_id) const -> const vector<data::type::skillbook_info> * const {
-	return &ext::find_value_ptr_if(
-		m_skillbooks,
-		[&item_id](auto value) { return value.first == item_id; })->second;
+	return ext::find_value_ptr(m_skillbooks, item_id);
 }
 
 auto item::get_item_rewards(game_item_id item_id) const -> const vector<data::type::item_reward_info> * const {
-	return &ext::find_value_ptr_if(
-		m_item_rewards,
-		[&item_id](auto value) { return value.first == item_id; })->second;
+	return ext::find_value_ptr(m_item_rewards, item_id);
 }
 
 auto item::get_item_summons(game_item_id item_id) const -> const vector<data::type::summon_bag_info> * const {
-	return &ext::find_value_ptr_if(
-		m_summon_bags,
-		[&item_id](auto value) { return value.first == item_id; })->second;
+	return ext::find_value_ptr(m_summon_bags, item_id);
 }
 
 }
@@ -18,7 +18,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "map.hpp"
 #include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/game_logic/map.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
@@ -32,6 +33,7 @@ namespace provider {
 auto map::load_data() -> void {
 	load_continents();
 	load_maps();
+	load_link_tables();
 }
 
 auto map::load_continents() -> void {
@@ -41,15 +43,13 @@ auto map::load_continents() -> void {
 	int8_t map_cluster;
 	int8_t continent;
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_continent_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::map_continent_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		map_cluster = row.get<int8_t>("map_cluster");
 		continent = row.get<int8_t>("continent");
 
-		copy.push_back(std::make_pair(map_cluster, continent));
+		copy.emplace(map_cluster, continent);
 	}
 
 	{
@@ -65,11 +65,9 @@ auto map::load_maps() -> void {
 
 	decltype(m_maps) copy;
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::map_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		auto info = make_ref_ptr<data::type::map_info>();
 		game_map_id id = row.get<game_map_id>("mapid");
 		game_map_id link = row.get<game_map_id>("link");
@@ -131,14 +129,14 @@ auto map::load_maps() -> void {
 		info->damage_per_second = row.get<game_damage>("damage_per_second");
 		info->ship_kind = row.get<int8_t>("ship_kind");
 
-		copy.push_back(info);
+		copy.emplace(id, info);
 	}
 
 	/*
 	// This adds about 40 seconds to the debug startup process (the process is roughly 20 seconds currently)
 	// This isn't desirable for now
 	for (auto &map : m_maps) {
-		load_map(map);
+		load_map(*map.second);
 	}
 	*/
 
@@ -151,23 +149,23 @@ auto map::load_maps() -> void {
 	std::cout << "DONE" << std::endl;
 }
 
+auto map::load_link_tables() -> void {
+	// Link info is still built per map on demand, this only pulls the tables it reads from into the snapshot
+	auto &snapshot = vana::data::snapshot::get_instance();
+	snapshot.get_indexed_table(vana::data::table::map_time_mob, "mapid");
+	snapshot.get_indexed_table(vana::data::table::map_footholds, "mapid");
+	snapshot.get_indexed_table(vana::data::table::map_life, "mapid");
+	snapshot.get_indexed_table(vana::data::table::map_portals, "mapid");
+	snapshot.get_indexed_table(vana::data::table::map_seats, "mapid");
+}
+
 auto map::load_map(data::type::map_info &map) -> void {
-	size_t index = 0;
-	bool found = false;
-	for (/* intentionally blank */; index < m_link_info.size(); ++index) {
-		auto &value = m_link_info[index];
-		found =
-			(map.link != 0 && value->id == map.link) ||
-			(map.link == 0 && value->id == map.id);
-
-		if (found) {
-			break;
-		}
-	}
+	game_map_id link_id = map.link != 0 ? map.link : map.id;
+	auto &link_info = m_link_info[link_id];
 
-	if (!found) {
+	if (link_info == nullptr) {
 		auto info = make_ref_ptr<data::type::map_link_info>();
-		info->id = map.link != 0 ? map.link : map.id;
+		info->id = link_id;
 
 		load_map_time_mob(*info);
 		load_footholds(*info);
@@ -175,22 +173,16 @@ auto map::load_map(data::type::map_info &map) -> void {
 		load_portals(*info);
 		load_seats(*info);
 
-		m_link_info.push_back(info);
-
-		map.link_info = m_link_info[m_link_info.size() - 1];
-	}
-	else {
-		map.link_info = m_link_info[index];
+		link_info = info;
 	}
+
+	map.link_info = link_info;
 }
 
 auto map::load_seats(data::type::map_link_info &map) -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_seats) << " WHERE mapid = :map",
-		soci::use(map.id, "map"));
+	auto rs = vana::data::snapshot::get_instance().get_indexed_table(vana::data::table::map_seats, "mapid");
 
-	for (const auto &row : rs) {
+	for (const auto &row : rs->find_rows(map.id)) {
 		data::type::seat_info chair;
 		game_seat_id id = row.get<game_seat_id>("seatid");
 		chair.pos = point{row.get<game_coord>("x_pos"), row.get<game_coord>("y_pos")};
@@ -201,12 +193,9 @@ auto map::load_seats(data::type::map_link_info &map) -> void {
 }
 
 auto map::load_portals(data::type::map_link_info &map) -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_portals) << " WHERE mapid = :map",
-		soci::use(map.id, "map"));
+	auto rs = vana::data::snapshot::get_instance().get_indexed_table(vana::data::table::map_portals, "mapid");
 
-	for (const auto &row : rs) {
+	for (const auto &row : rs->find_rows(map.id)) {
 		data::type::portal_info portal;
 		vana::util::str::run_flags(row.get<opt_string>("flags"), [&portal](const string &cmp) {
 			if (cmp == "only_once") portal.only_once = true;
@@ -230,12 +219,9 @@ auto map::load_map_life(data::type::map_link_info &map) -> void {
 	data::type::spawn_info life;
 	string type;
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_life) << " WHERE mapid = :map",
-		soci::use(map.id, "map"));
+	auto rs = vana::data::snapshot::get_instance().get_indexed_table(vana::data::table::map_life, "mapid");
 
-	for (const auto &row : rs) {
+	for (const auto &row : rs->find_rows(map.id)) {
 		life = data::type::spawn_info{};
 		vana::util::str::run_flags(row.get<opt_string>("flags"), [&life](const string &cmp) {
 			if (cmp == "faces_left") life.faces_left = true;
@@ -270,12 +256,10 @@ auto map::load_map_life(data::type::map_link_info &map) -> void {
 }
 
 auto map::load_footholds(data::type::map_link_info &map) -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_footholds) << " WHERE mapid = :map",
-		soci::use(map.id, "map"));
+	auto rs = vana::data::snapshot::get_instance().get_indexed_table(vana::data::table::map_footholds, "mapid");
 
-	for (const auto &row : rs) {
+	vector<data::type::foothold_info> footholds;
+	for (const auto &row : rs->find_rows(map.id)) {
 		data::type::foothold_info foot;
 		vana::util::str::run_flags(row.get<opt_string>("flags"), [&foot](const string &cmp) {
 			if (cmp == "forbid_downward_jump") foot.forbid_jump_down = true;
@@ -290,17 +274,16 @@ auto map::load_footholds(data::type::map_link_info &map) -> void {
 		foot.left_edge = row.get<game_foothold_id>("previousid") == 0;
 		foot.right_edge = row.get<game_foothold_id>("nextid") == 0;
 
-		map.footholds.push_back(foot);
+		footholds.push_back(foot);
 	}
+
+	map.footholds = data::type::foothold_index{std::move(footholds)};
 }
 
 auto map::load_map_time_mob(data::type::map_link_info &map) -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::map_time_mob) << " WHERE mapid = :map",
-		soci::use(map.id, "map"));
+	auto rs = vana::data::snapshot::get_instance().get_indexed_table(vana::data::table::map_time_mob, "mapid");
 
-	for (const auto &row : rs) {
+	for (const auto &row : rs->find_rows(map.id)) {
 		data::type::time_mob_info info{};
 
 		info.id = row.get<game_mob_id>("mobid");
@@ -316,26 +299,20 @@ auto map::get_continent(game_map_id map_id) -> opt_int8_t {
 	int8_t cluster = vana::util::game_logic::map::get_map_cluster(map_id);
 
 	owned_lock<mutex> l{m_load_mutex};
-	for (const auto &continent : m_continents) {
-		if (continent.first == cluster) {
-			return continent.second;
-		}
+	auto kvp = m_continents.find(cluster);
+	if (kvp != std::end(m_continents)) {
+		return kvp->second;
 	}
 
 	return {};
 }
 
 auto map::get_map(game_map_id map_id) -> ref_ptr<const data::type::map_info> {
-	ref_ptr<data::type::map_info> ptr;
 	owned_lock<mutex> l{m_load_mutex};
-	for (auto &map : m_maps) {
-		if (map->id == map_id) {
-			ptr = map;
-			break;
-		}
-	}
+	auto kvp = m_maps.find(map_id);
+	if (kvp == std::end(m_maps)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
-	if (ptr == nullptr) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+	ref_ptr<data::type::map_info> ptr = kvp->second;
 
 	if (ptr->link_info == nullptr) {
 		load_map(*ptr);
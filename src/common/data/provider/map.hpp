@@ -37,6 +37,7 @@ namespace vana {
 			private:
 				auto load_continents() -> void;
 				auto load_maps() -> void;
+				auto load_link_tables() -> void;
 
 				auto load_map_time_mob(data::type::map_link_info &map) -> void;
 				auto load_footholds(data::type::map_link_info &map) -> void;
@@ -46,9 +47,9 @@ namespace vana {
 				auto load_map(data::type::map_info &map) -> void;
 
 				mutex m_load_mutex;
-				vector<ref_ptr<data::type::map_info>> m_maps;
-				vector<ref_ptr<data::type::map_link_info>> m_link_info;
-				vector<pair<int8_t, int8_t>> m_continents;
+				hash_map<game_map_id, ref_ptr<data::type::map_info>> m_maps;
+				hash_map<game_map_id, ref_ptr<data::type::map_link_info>> m_link_info;
+				hash_map<int8_t, int8_t> m_continents;
 			};
 		}
 	}
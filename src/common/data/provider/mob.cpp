@@ -18,7 +18,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "mob.hpp"
 #include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
 #include <iostream>
@@ -43,11 +44,9 @@ auto mob::load_data() -> void {
 auto mob::load_attacks() -> void {
 	m_attacks.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::mob_attacks));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::mob_attacks);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::mob_attack_info mob_attack;
 
 		game_mob_id mob_id = row.get<game_mob_id>("mobid");
@@ -68,58 +67,32 @@ auto mob::load_attacks() -> void {
 			else if (cmp == "area_effect_plus") mob_attack.attack_type = data::type::mob_attack_type::area_effect_plus;
 		});
 
-		bool found = false;
-		for (auto &mob : m_attacks) {
-			if (mob.first == mob_id) {
-				mob.second.push_back(mob_attack);
-				found = true;
-				break;
-			}
-		}
-		if (!found) {
-			vector<data::type::mob_attack_info> new_value{mob_attack};
-			m_attacks.push_back(std::make_pair(mob_id, new_value));
-		}
+		m_attacks[mob_id].push_back(mob_attack);
 	}
 }
 
 auto mob::load_skills() -> void {
 	m_skills.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::mob_skills));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::mob_skills);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::mob_skill_info mob_skill;
 		game_mob_id mob_id = row.get<game_mob_id>("mobid");
 		mob_skill.skill_id = row.get<game_mob_skill_id>("skillid");
 		mob_skill.level = row.get<game_mob_skill_level>("skill_level");
 		mob_skill.effect_after = milliseconds{row.get<int16_t>("effect_delay")};
 
-		bool found = false;
-		for (auto &mob : m_skills) {
-			if (mob.first == mob_id) {
-				mob.second.push_back(mob_skill);
-				found = true;
-				break;
-			}
-		}
-		if (!found) {
-			vector<data::type::mob_skill_info> new_value{mob_skill};
-			m_skills.push_back(std::make_pair(mob_id, new_value));
-		}
+		m_skills[mob_id].push_back(mob_skill);
 	}
 }
 
 auto mob::load_mobs() -> void {
 	m_mob_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::mob_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::mob_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		auto mob = make_ref_ptr<data::type::mob_info>();
 
 		mob->id = row.get<game_mob_id>("mobid");
@@ -188,80 +161,60 @@ auto mob::load_mobs() -> void {
 		mob->can_poison = (!mob->boss && mob->poison_attr != mob_elemental_attribute::immune && mob->poison_attr != mob_elemental_attribute::strong);
 
 		// Skill count relies on skills being loaded first
-		for (const auto &skill : m_skills) {
-			if (skill.first == mob->id) {
-				mob->skill_count = static_cast<uint8_t>(skill.second.size());
-				break;
-			}
+		if (auto skills = ext::find_value_ptr(m_skills, mob->id)) {
+			mob->skill_count = static_cast<uint8_t>(skills->size());
 		}
 
-		m_mob_info.push_back(mob);
+		m_mob_info.emplace(mob->id, mob);
 	}
 }
 
 auto mob::load_summons() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::mob_summons));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::mob_summons);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_mob_id mob_id = row.get<game_mob_id>("mobid");
 		game_mob_id summon_id = row.get<game_mob_id>("summonid");
 
-		for (const auto &mob : m_mob_info) {
-			if (mob->id == mob_id) {
-				mob->summon.push_back(summon_id);
-				break;
-			}
+		auto kvp = m_mob_info.find(mob_id);
+		if (kvp != std::end(m_mob_info)) {
+			kvp->second->summon.push_back(summon_id);
 		}
 	}
 }
 
 auto mob::mob_exists(game_mob_id mob_id) const -> bool {
-	for (const auto &mob : m_mob_info) {
-		if (mob->id == mob_id) {
-			return true;
-		}
-	}
-
-	return false;
+	return ext::is_element(m_mob_info, mob_id);
 }
 
 auto mob::get_mob_info(game_mob_id mob_id) const -> ref_ptr<const data::type::mob_info> {
-	for (const auto &info : m_mob_info) {
-		if (info->id == mob_id) {
-			return info;
-		}
+	auto kvp = m_mob_info.find(mob_id);
+	if (kvp != std::end(m_mob_info)) {
+		return kvp->second;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
 }
 
 auto mob::get_mob_attack(game_mob_id mob_id, uint8_t index) const -> const data::type::mob_attack_info * const {
-	for (const auto &mob : m_attacks) {
-		if (mob.first == mob_id) {
-			return &mob.second[index];
-		}
+	if (auto attacks = ext::find_value_ptr(m_attacks, mob_id)) {
+		return &(*attacks)[index];
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
 }
 
 auto mob::get_mob_skill(game_mob_id mob_id, uint8_t index) const -> const data::type::mob_skill_info * const {
-	for (const auto &mob : m_skills) {
-		if (mob.first == mob_id) {
-			return &mob.second[index];
-		}
+	if (auto skills = ext::find_value_ptr(m_skills, mob_id)) {
+		return &(*skills)[index];
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
 }
 
 auto mob::get_skills(game_mob_id mob_id) const -> const vector<data::type::mob_skill_info> & {
-	for (const auto &mob : m_skills) {
-		if (mob.first == mob_id) {
-			return mob.second;
-		}
+	if (auto skills = ext::find_value_ptr(m_skills, mob_id)) {
+		return *skills;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
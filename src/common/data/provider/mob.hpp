@@ -44,9 +44,9 @@ namespace vana {
 				auto load_skills() -> void;
 				auto load_summons() -> void;
 
-				vector<ref_ptr<data::type::mob_info>> m_mob_info;
-				vector<pair<game_mob_id, vector<data::type::mob_attack_info>>> m_attacks;
-				vector<pair<game_mob_id, vector<data::type::mob_skill_info>>> m_skills;
+				hash_map<game_mob_id, ref_ptr<data::type::mob_info>> m_mob_info;
+				hash_map<game_mob_id, vector<data::type::mob_attack_info>> m_attacks;
+				hash_map<game_mob_id, vector<data::type::mob_skill_info>> m_skills;
 			};
 		}
 	}
@@ -18,7 +18,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "npc.hpp"
 #include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
 #include <iostream>
@@ -30,11 +31,9 @@ namespace provider {
 auto npc::load_data() -> void {
 	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing NPCs... ";
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::npc_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::npc_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::npc_info info;
 		info.id = row.get<game_npc_id>("npcid");
 		info.storage_cost = row.get<game_mesos>("storage_cost");
@@ -44,49 +43,33 @@ auto npc::load_data() -> void {
 			else if (cmp == "is_guild_rank") info.is_guild_rank = true;
 		});
 
-		m_data.push_back(info);
+		m_data.emplace(info.id, info);
 	}
 
 	std::cout << "DONE" << std::endl;
 }
 
 auto npc::get_storage_cost(game_npc_id npc) const -> game_mesos {
-	for (const auto &value : m_data) {
-		if (value.id == npc) {
-			return value.storage_cost;
-		}
+	auto info = ext::find_value_ptr(m_data, npc);
+	if (info != nullptr) {
+		return info->storage_cost;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
 }
 
 auto npc::is_maple_tv(game_npc_id npc) const -> bool {
-	for (const auto &value : m_data) {
-		if (value.id == npc) {
-			return value.is_maple_tv;
-		}
-	}
-
-	return false;
+	auto info = ext::find_value_ptr(m_data, npc);
+	return info != nullptr && info->is_maple_tv;
 }
 
 auto npc::is_guild_rank(game_npc_id npc) const -> bool {
-	for (const auto &value : m_data) {
-		if (value.id == npc) {
-			return value.is_guild_rank;
-		}
-	}
-
-	return false;
+	auto info = ext::find_value_ptr(m_data, npc);
+	return info != nullptr && info->is_guild_rank;
 }
 
 auto npc::is_valid_npc_id(game_npc_id npc) const -> bool {
-	for (const auto &value : m_data) {
-		if (value.id == npc) {
-			return true;
-		}
-	}
-	return false;
+	return ext::is_element(m_data, npc);
 }
 
 }
@@ -19,7 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/algorithm.hpp"
 #include "common/constant/job/id.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/quest.hpp"
 #include "common/util/game_logic/player.hpp"
 #include "common/util/string.hpp"
@@ -45,18 +46,16 @@ auto quest::load_data() -> void {
 auto quest::load_quest_data() -> void {
 	m_quests.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::quest_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::quest_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		vana::quest quest;
 		game_quest_id quest_id = row.get<game_quest_id>("questid");
 
 		quest.set_next_quest(row.get<game_quest_id>("next_quest"));
 		quest.set_quest_id(quest_id);
 
-		m_quests.push_back(quest);
+		m_quests.emplace(quest_id, quest);
 	}
 }
 
@@ -64,11 +63,9 @@ auto quest::load_requests() -> void {
 	// TODO FIXME quest
 	// Process the state when you add quest requests
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::quest_requests));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::quest_requests);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_quest_id quest_id = row.get<game_quest_id>("questid");
 		data::type::quest_request_info quest_request;
 
@@ -96,55 +93,37 @@ auto quest::load_requests() -> void {
 			}
 		});
 
-		bool found = false;
-		for (auto &quest : m_quests) {
-			if (quest.get_quest_id() == quest_id) {
-				found = true;
-				quest.add_request(false, quest_request);
-				break;
-			}
-		}
-
-		if (!found) {
+		auto kvp = m_quests.find(quest_id);
+		if (kvp == std::end(m_quests)) {
 			// Stupidly, this could be the case in the official data files
 			vana::quest current;
 			current.set_quest_id(quest_id);
-			current.add_request(false, quest_request);
-			m_quests.push_back(current);
+			kvp = m_quests.emplace(quest_id, current).first;
 		}
+
+		kvp->second.add_request(false, quest_request);
 	}
 }
 
 auto quest::load_required_jobs() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::quest_required_jobs));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::quest_required_jobs);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_quest_id quest_id = row.get<game_quest_id>("questid");
 		data::type::quest_request_info request;
 		request.is_job = true;
 		request.id = row.get<game_job_id>("valid_jobid");
 
-		bool found = false;
-		for (auto &quest : m_quests) {
-			if (quest.get_quest_id() == quest_id) {
-				found = true;
-				quest.add_request(true, request);
-				break;
-			}
-		}
-
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		auto kvp = m_quests.find(quest_id);
+		if (kvp == std::end(m_quests)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		kvp->second.add_request(true, request);
 	}
 }
 
 auto quest::load_rewards() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::quest_rewards));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::quest_rewards);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_quest_id quest_id = row.get<game_quest_id>("questid");
 		data::type::quest_reward_info reward;
 		game_job_id job = row.get<game_job_id>("job");
@@ -169,138 +148,124 @@ auto quest::load_rewards() -> void {
 		reward.gender = vana::util::game_logic::player::get_gender_id(row.get<string>("gender"));
 		reward.prop = row.get<int32_t>("prop");
 
-		bool found = false;
-		for (auto &quest : m_quests) {
-			if (quest.get_quest_id() == quest_id) {
-				found = true;
+		auto kvp = m_quests.find(quest_id);
+		if (kvp == std::end(m_quests)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+
+		auto &quest = kvp->second;
+		if (job != -1 || job_tracks.empty()) {
+			quest.add_reward(start, reward, job);
+			continue;
+		}
 
-				if (job != -1 || job_tracks.empty()) {
+		vana::util::str::run_flags(job_tracks, [&quest, &reward, &start](const string &cmp) {
+			auto add_reward_for_jobs = [&quest, &reward, &start](init_list<game_job_id> jobs) {
+				for (const auto &job : jobs) {
 					quest.add_reward(start, reward, job);
-					break;
 				}
-
-				vana::util::str::run_flags(job_tracks, [&quest, &reward, &start](const string &cmp) {
-					auto add_reward_for_jobs = [&quest, &reward, &start](init_list<game_job_id> jobs) {
-						for (const auto &job : jobs) {
-							quest.add_reward(start, reward, job);
-						}
-					};
-					if (cmp == "beginner") {
-						add_reward_for_jobs({
-							constant::job::id::beginner
-						});
-					}
-					else if (cmp == "warrior") {
-						add_reward_for_jobs({
-							constant::job::id::swordsman,
-							constant::job::id::fighter, constant::job::id::crusader, constant::job::id::hero,
-							constant::job::id::page, constant::job::id::white_knight, constant::job::id::paladin,
-							constant::job::id::spearman, constant::job::id::dragon_knight, constant::job::id::dark_knight,
-						});
-					}
-					else if (cmp == "magician") {
-						add_reward_for_jobs({
-							constant::job::id::magician,
-							constant::job::id::fp_wizard, constant::job::id::fp_mage, constant::job::id::fp_arch_mage,
-							constant::job::id::il_wizard, constant::job::id::il_mage, constant::job::id::il_arch_mage,
-							constant::job::id::cleric, constant::job::id::priest, constant::job::id::bishop,
-						});
-					}
-					else if (cmp == "bowman") {
-						add_reward_for_jobs({
-							constant::job::id::archer,
-							constant::job::id::hunter, constant::job::id::ranger, constant::job::id::bowmaster,
-							constant::job::id::crossbowman, constant::job::id::sniper, constant::job::id::marksman,
-						});
-					}
-					else if (cmp == "thief") {
-						add_reward_for_jobs({
-							constant::job::id::rogue,
-							constant::job::id::assassin, constant::job::id::hermit, constant::job::id::night_lord,
-							constant::job::id::bandit, constant::job::id::chief_bandit, constant::job::id::shadower,
-						});
-					}
-					else if (cmp == "pirate") {
-						add_reward_for_jobs({
-							constant::job::id::pirate,
-							constant::job::id::brawler, constant::job::id::marauder, constant::job::id::buccaneer,
-							constant::job::id::gunslinger, constant::job::id::outlaw, constant::job::id::corsair,
-						});
-					}
-					else if (cmp == "cygnus_beginner") {
-						add_reward_for_jobs({
-							constant::job::id::noblesse
-						});
-					}
-					else if (cmp == "cygnus_warrior") {
-						add_reward_for_jobs({
-							constant::job::id::dawn_warrior1, constant::job::id::dawn_warrior2, constant::job::id::dawn_warrior3
-						});
-					}
-					else if (cmp == "cygnus_magician") {
-						add_reward_for_jobs({
-							constant::job::id::blaze_wizard1, constant::job::id::blaze_wizard2, constant::job::id::blaze_wizard3
-						});
-					}
-					else if (cmp == "cygnus_bowman") {
-						add_reward_for_jobs({
-							constant::job::id::wind_archer1, constant::job::id::wind_archer2, constant::job::id::wind_archer3
-						});
-					}
-					else if (cmp == "cygnus_thief") {
-						add_reward_for_jobs({
-							constant::job::id::night_walker1, constant::job::id::night_walker2, constant::job::id::night_walker3
-						});
-					}
-					else if (cmp == "cygnus_pirate") {
-						add_reward_for_jobs({
-							constant::job::id::thunder_breaker1, constant::job::id::thunder_breaker2, constant::job::id::thunder_breaker3
-						});
-					}
-					else if (cmp == "episode2_beginner") {
-						add_reward_for_jobs({
-							constant::job::id::legend
-						});
-					}
-					else if (cmp == "episode2_warrior") {
-						add_reward_for_jobs({constant::job::id::aran1, constant::job::id::aran2, constant::job::id::aran3, constant::job::id::aran4});
-					}
-					else if (cmp == "episode2_magician") {
-						add_reward_for_jobs({
-							constant::job::id::evan1,
-							constant::job::id::evan2, constant::job::id::evan3, constant::job::id::evan4,
-							constant::job::id::evan5, constant::job::id::evan6, constant::job::id::evan7,
-							constant::job::id::evan8, constant::job::id::evan9, constant::job::id::evan10,
-						});
-					}
-					else {
-						THROW_CODE_EXCEPTION(not_implemented_exception, "job_tracks");
-					}
+			};
+			if (cmp == "beginner") {
+				add_reward_for_jobs({
+					constant::job::id::beginner
 				});
-
-				break;
 			}
-		}
-
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+			else if (cmp == "warrior") {
+				add_reward_for_jobs({
+					constant::job::id::swordsman,
+					constant::job::id::fighter, constant::job::id::crusader, constant::job::id::hero,
+					constant::job::id::page, constant::job::id::white_knight, constant::job::id::paladin,
+					constant::job::id::spearman, constant::job::id::dragon_knight, constant::job::id::dark_knight,
+				});
+			}
+			else if (cmp == "magician") {
+				add_reward_for_jobs({
+					constant::job::id::magician,
+					constant::job::id::fp_wizard, constant::job::id::fp_mage, constant::job::id::fp_arch_mage,
+					constant::job::id::il_wizard, constant::job::id::il_mage, constant::job::id::il_arch_mage,
+					constant::job::id::cleric, constant::job::id::priest, constant::job::id::bishop,
+				});
+			}
+			else if (cmp == "bowman") {
+				add_reward_for_jobs({
+					constant::job::id::archer,
+					constant::job::id::hunter, constant::job::id::ranger, constant::job::id::bowmaster,
+					constant::job::id::crossbowman, constant::job::id::sniper, constant::job::id::marksman,
+				});
+			}
+			else if (cmp == "thief") {
+				add_reward_for_jobs({
+					constant::job::id::rogue,
+					constant::job::id::assassin, constant::job::id::hermit, constant::job::id::night_lord,
+					constant::job::id::bandit, constant::job::id::chief_bandit, constant::job::id::shadower,
+				});
+			}
+			else if (cmp == "pirate") {
+				add_reward_for_jobs({
+					constant::job::id::pirate,
+					constant::job::id::brawler, constant::job::id::marauder, constant::job::id::buccaneer,
+					constant::job::id::gunslinger, constant::job::id::outlaw, constant::job::id::corsair,
+				});
+			}
+			else if (cmp == "cygnus_beginner") {
+				add_reward_for_jobs({
+					constant::job::id::noblesse
+				});
+			}
+			else if (cmp == "cygnus_warrior") {
+				add_reward_for_jobs({
+					constant::job::id::dawn_warrior1, constant::job::id::dawn_warrior2, constant::job::id::dawn_warrior3
+				});
+			}
+			else if (cmp == "cygnus_magician") {
+				add_reward_for_jobs({
+					constant::job::id::blaze_wizard1, constant::job::id::blaze_wizard2, constant::job::id::blaze_wizard3
+				});
+			}
+			else if (cmp == "cygnus_bowman") {
+				add_reward_for_jobs({
+					constant::job::id::wind_archer1, constant::job::id::wind_archer2, constant::job::id::wind_archer3
+				});
+			}
+			else if (cmp == "cygnus_thief") {
+				add_reward_for_jobs({
+					constant::job::id::night_walker1, constant::job::id::night_walker2, constant::job::id::night_walker3
+				});
+			}
+			else if (cmp == "cygnus_pirate") {
+				add_reward_for_jobs({
+					constant::job::id::thunder_breaker1, constant::job::id::thunder_breaker2, constant::job::id::thunder_breaker3
+				});
+			}
+			else if (cmp == "episode2_beginner") {
+				add_reward_for_jobs({
+					constant::job::id::legend
+				});
+			}
+			else if (cmp == "episode2_warrior") {
+				add_reward_for_jobs({constant::job::id::aran1, constant::job::id::aran2, constant::job::id::aran3, constant::job::id::aran4});
+			}
+			else if (cmp == "episode2_magician") {
+				add_reward_for_jobs({
+					constant::job::id::evan1,
+					constant::job::id::evan2, constant::job::id::evan3, constant::job::id::evan4,
+					constant::job::id::evan5, constant::job::id::evan6, constant::job::id::evan7,
+					constant::job::id::evan8, constant::job::id::evan9, constant::job::id::evan10,
+				});
+			}
+			else {
+				THROW_CODE_EXCEPTION(not_implemented_exception, "job_tracks");
+			}
+		});
 	}
 }
 
 auto quest::is_quest(game_quest_id quest_id) const -> bool {
-	for (const auto &quest : m_quests) {
-		if (quest.get_quest_id() == quest_id) {
-			return true;
-		}
-	}
-
-	return false;
+	return ext::is_element(m_quests, quest_id);
 }
 
 auto quest::get_info(game_quest_id quest_id) const -> const vana::quest & {
-	for (const auto &quest : m_quests) {
-		if (quest.get_quest_id() == quest_id) {
-			return quest;
-		}
+	auto quest = ext::find_value_ptr(m_quests, quest_id);
+	if (quest != nullptr) {
+		return *quest;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
@@ -16,8 +16,10 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #include "reactor.hpp"
+#include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
 #include <iostream>
@@ -40,11 +42,9 @@ auto reactor::load_data() -> void {
 auto reactor::load_reactors() -> void {
 	m_reactor_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::reactor_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::reactor_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::reactor_info reactor;
 		reactor.id = row.get<game_reactor_id>("reactorid");
 		reactor.max_states = row.get<int8_t>("max_states");
@@ -55,16 +55,14 @@ auto reactor::load_reactors() -> void {
 			else if (cmp == "activate_by_touch") reactor.activate_by_touch = true;
 		});
 
-		m_reactor_info.push_back(reactor);
+		m_reactor_info.emplace(reactor.id, reactor);
 	}
 }
 
 auto reactor::load_states() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::reactor_events) << " ORDER BY reactorId, state ASC");
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::reactor_events, "reactorId, state ASC");
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::reactor_state_info state;
 		game_reactor_id id = row.get<game_reactor_id>("reactorid");
 		int8_t state_id = row.get<int8_t>("state");
@@ -87,57 +85,37 @@ auto reactor::load_states() -> void {
 			else if (cmp == "hit_by_item") state.type = 100;
 		});
 
-		bool found = false;
-		for (auto &reactor : m_reactor_info) {
-			if (reactor.id == id) {
-				found = true;
-				reactor.states[state_id].push_back(state);
-				break;
-			}
-		}
-
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		auto kvp = m_reactor_info.find(id);
+		if (kvp == std::end(m_reactor_info)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		kvp->second.states[state_id].push_back(state);
 	}
 }
 
 auto reactor::load_trigger_skills() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::reactor_event_trigger_skills));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::reactor_event_trigger_skills);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_reactor_id id = row.get<game_reactor_id>("reactorid");
 		int8_t state = row.get<int8_t>("state");
 		game_skill_id skill_id = row.get<game_skill_id>("skillid");
 
-		bool found = false;
-		for (auto &reactor : m_reactor_info) {
-			if (reactor.id == id) {
-				found = true;
-				for (size_t j = 0; j < reactor.states[state].size(); ++j) {
-					reactor.states[state][j].trigger_skills.push_back(skill_id);
-				}
-				break;
-			}
-		}
+		auto kvp = m_reactor_info.find(id);
+		if (kvp == std::end(m_reactor_info)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		for (auto &state_info : kvp->second.states[state]) {
+			state_info.trigger_skills.push_back(skill_id);
+		}
 	}
 }
 
 auto reactor::get_reactor_data(game_reactor_id reactor_id, bool respect_link) const -> const data::type::reactor_info & {
-	for (const auto &reactor : m_reactor_info) {
-		if (reactor.id == reactor_id) {
-			if (!respect_link || reactor.link == 0) {
-				return reactor;
-			}
-
-			for (const auto &link : m_reactor_info) {
-				if (link.id == reactor.link) {
-					return link;
-				}
-			}
-		}
+	auto reactor = ext::find_value_ptr(m_reactor_info, reactor_id);
+	if (reactor != nullptr && respect_link && reactor->link != 0) {
+		reactor = ext::find_value_ptr(m_reactor_info, reactor->link);
+	}
+
+	if (reactor != nullptr) {
+		return *reactor;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
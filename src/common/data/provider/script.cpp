@@ -19,7 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/abstract_server.hpp"
 #include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/file.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
@@ -41,26 +42,20 @@ auto script::load_data() -> void {
 	m_first_map_entry_scripts.clear();
 	m_item_scripts.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::scripts));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::scripts);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		int32_t object_id = row.get<int32_t>("objectid");
 		string script = row.get<string>("script");
 		int8_t modifier = row.get<int8_t>("helper");
 
 		vana::util::str::run_enum(row.get<string>("script_type"), [&](const string &cmp) {
-			if (cmp == "npc") m_npc_scripts.push_back(std::make_pair(object_id, script));
-			else if (cmp == "reactor") m_reactor_scripts.push_back(std::make_pair(object_id, script));
-			else if (cmp == "map_enter") m_map_entry_scripts.push_back(std::make_pair(object_id, script));
-			else if (cmp == "map_first_enter") m_first_map_entry_scripts.push_back(std::make_pair(object_id, script));
-			else if (cmp == "item") m_item_scripts.push_back(std::make_pair(object_id, script));
-			else if (cmp == "quest") {
-				vector<pair<int8_t, string>> value;
-				value.push_back(std::make_pair(modifier, script));
-				m_quest_scripts.push_back(std::make_pair(static_cast<game_quest_id>(object_id), value));
-			}
+			if (cmp == "npc") m_npc_scripts.emplace(object_id, script);
+			else if (cmp == "reactor") m_reactor_scripts.emplace(object_id, script);
+			else if (cmp == "map_enter") m_map_entry_scripts.emplace(object_id, script);
+			else if (cmp == "map_first_enter") m_first_map_entry_scripts.emplace(object_id, script);
+			else if (cmp == "item") m_item_scripts.emplace(object_id, script);
+			else if (cmp == "quest") m_quest_scripts[static_cast<game_quest_id>(object_id)].emplace(modifier, script);
 		});
 	}
 
@@ -68,48 +63,30 @@ auto script::load_data() -> void {
 }
 
 auto script::get_script(abstract_server *server, int32_t object_id, data::type::script_type type) const -> string {
-	if (has_script(object_id, type)) {
-		auto &scripts = resolve(type);
-		for (const auto &script : scripts) {
-			if (script.first == object_id) {
-				string s = build_script_path(type, script.second);
-				if (vana::util::file::exists(s)) {
-					return s;
-				}
+	auto script = ext::find_value_ptr(resolve(type), object_id);
+	if (script != nullptr) {
+		string s = build_script_path(type, *script);
+		if (vana::util::file::exists(s)) {
+			return s;
+		}
 #ifdef DEBUG
-				server->log(vana::log::type::debug_error, "Missing script '" + s + "'");
+		server->log(vana::log::type::debug_error, "Missing script '" + s + "'");
 #endif
-				break;
-			}
-		}
 	}
 	return build_script_path(type, std::to_string(object_id));
 }
 
 auto script::get_quest_script(abstract_server *server, game_quest_id quest_id, int8_t state) const -> string {
-	if (has_quest_script(quest_id, state)) {
-		for (const auto &script : m_quest_scripts) {
-			if (script.first != quest_id) {
-				continue;
-			}
-
-			for (const auto &script_state : script.second) {
-				if (script_state.first != state) {
-					continue;
-				}
-
-				string s = build_script_path(data::type::script_type::quest, script_state.second);
-				if (vana::util::file::exists(s)) {
-					return s;
-				}
+	auto states = ext::find_value_ptr(m_quest_scripts, quest_id);
+	auto script = states == nullptr ? nullptr : ext::find_value_ptr(*states, state);
+	if (script != nullptr) {
+		string s = build_script_path(data::type::script_type::quest, *script);
+		if (vana::util::file::exists(s)) {
+			return s;
+		}
 #ifdef DEBUG
-				server->log(vana::log::type::debug_error, "Missing quest script '" + s + "'");
+		server->log(vana::log::type::debug_error, "Missing quest script '" + s + "'");
 #endif
-				break;
-			}
-
-			break;
-		}
 	}
 
 	return build_script_path(data::type::script_type::quest, std::to_string(quest_id) + (state == 0 ? "s" : "e"));
@@ -121,32 +98,18 @@ auto script::build_script_path(data::type::script_type type, const string &locat
 }
 
 auto script::has_script(int32_t object_id, data::type::script_type type) const -> bool {
-	return ext::any_of(resolve(type), [object_id](pair<int32_t, string> value) -> bool {
-		return value.first == object_id;
-	});
-
+	return ext::is_element(resolve(type), object_id);
 }
 
 auto script::has_quest_script(game_quest_id quest_id, int8_t state) const -> bool {
-	return ext::any_of(m_quest_scripts, [quest_id](pair<game_quest_id, vector<pair<int8_t, string>>> value) -> bool {
-		return value.first == quest_id;
-	});
+	return ext::is_element(m_quest_scripts, quest_id);
 }
 
 auto script::register_npc_script(game_npc_id npc_id, const string &script) -> void {
-	int32_t index = 0;
-	for (auto &script : m_npc_scripts) {
-		if (script.first == npc_id) {
-			m_npc_scripts.erase(m_npc_scripts.begin() + index);
-			break;
-		}
-		index++;
-	}
-
-	m_npc_scripts.push_back({npc_id, script});
+	m_npc_scripts[npc_id] = script;
 }
 
-auto script::resolve(data::type::script_type type) const -> const vector<pair<int32_t, string>> & {
+auto script::resolve(data::type::script_type type) const -> const hash_map<int32_t, string> & {
 	switch (type) {
 		case data::type::script_type::item: return m_item_scripts;
 		case data::type::script_type::map_entry: return m_map_entry_scripts;
@@ -39,15 +39,15 @@ namespace vana {
 
 				auto register_npc_script(game_npc_id npc_id, const string &script) -> void;
 			private:
-				auto resolve(data::type::script_type type) const -> const vector<pair<int32_t, string>> &;
+				auto resolve(data::type::script_type type) const -> const hash_map<int32_t, string> &;
 				auto resolve_path(data::type::script_type type) const -> string;
 
-				vector<pair<game_npc_id, string>> m_npc_scripts;
-				vector<pair<game_reactor_id, string>> m_reactor_scripts;
-				vector<pair<game_map_id, string>> m_map_entry_scripts;
-				vector<pair<game_map_id, string>> m_first_map_entry_scripts;
-				vector<pair<game_item_id, string>> m_item_scripts;
-				vector<pair<game_quest_id, vector<pair<int8_t, string>>>> m_quest_scripts;
+				hash_map<game_npc_id, string> m_npc_scripts;
+				hash_map<game_reactor_id, string> m_reactor_scripts;
+				hash_map<game_map_id, string> m_map_entry_scripts;
+				hash_map<game_map_id, string> m_first_map_entry_scripts;
+				hash_map<game_item_id, string> m_item_scripts;
+				hash_map<game_quest_id, hash_map<int8_t, string>> m_quest_scripts;
 			};
 		}
 	}
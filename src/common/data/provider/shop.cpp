@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/common_header.hpp"
 #include "common/data/initialize.hpp"
 #include "common/data/provider/item.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/io/database.hpp"
 #include "common/packet_builder.hpp"
 #include "common/session.hpp"
@@ -43,37 +44,28 @@ auto shop::load_data() -> void {
 auto shop::load_shops() -> void {
 	m_shops.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::shop_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::shop_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::shop_info info;
 		info.id = row.get<game_shop_id>("shopid");
 		info.npc = row.get<game_npc_id>("npcid");
 		info.recharge_tier = row.get<int8_t>("recharge_tier");
-		m_shops.push_back(info);
+		m_shops.emplace(info.id, info);
 	}
 
-	rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::shop_items) << " ORDER BY shopid, sort DESC");
+	rs = vana::data::snapshot::get_instance().get_table(vana::data::table::shop_items, "shopid, sort DESC");
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::shop_item_info info;
 		game_shop_id shop_id = row.get<game_shop_id>("shopid");
 		info.item_id = row.get<game_item_id>("itemid");
 		info.quantity = row.get<game_slot_qty>("quantity");
 		info.price = row.get<game_mesos>("price");
 
-		bool found = false;
-		for (auto &shop : m_shops) {
-			if (shop.id == shop_id) {
-				found = true;
-				shop.items.push_back(info);
-				break;
-			}
-		}
-
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		auto kvp = m_shops.find(shop_id);
+		if (kvp == std::end(m_shops)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		kvp->second.items.push_back(info);
 	}
 }
 
@@ -87,15 +79,8 @@ auto shop::load_user_shops() -> void {
 		info.id = row.get<game_shop_id>("shopid");
 		info.npc = row.get<game_npc_id>("npcid");
 		info.recharge_tier = row.get<int8_t>("recharge_tier");
-		
-		for (size_t i = 0; i < m_shops.size(); ++i) {
-			if (m_shops[i].id == info.id) {
-				m_shops.erase(std::begin(m_shops) + i);
-				break;
-			}
-		}
 
-		m_shops.push_back(info);
+		m_shops[info.id] = info;
 	}
 
 	rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::user_shop_items) << " ORDER BY shopid, sort DESC");
@@ -107,64 +92,32 @@ auto shop::load_user_shops() -> void {
 		info.quantity = row.get<game_slot_qty>("quantity");
 		info.price = row.get<game_mesos>("price");
 
-		bool found = false;
-		for (auto &shop : m_shops) {
-			if (shop.id == shop_id) {
-				found = true;
-				shop.items.push_back(info);
-				break;
-			}
-		}
-
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		auto kvp = m_shops.find(shop_id);
+		if (kvp == std::end(m_shops)) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		kvp->second.items.push_back(info);
 	}
 }
 
 auto shop::load_recharge_tiers() -> void {
 	m_recharge_costs.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::shop_recharge_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::shop_recharge_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		int8_t recharge_tier = row.get<int8_t>("tierid");
 		game_item_id item_id = row.get<game_item_id>("itemid");
 		double price = row.get<double>("price");
 
-		bool found = false;
-		for (auto &tier : m_recharge_costs) {
-			if (tier.first == recharge_tier) {
-				tier.second.push_back(std::make_pair(item_id, price));
-				found = true;
-				break;
-			}
-		}
-		if (!found) {
-			vector<pair<game_item_id, double>> new_value{std::make_pair(item_id, price)};
-			m_recharge_costs.push_back(std::make_pair(recharge_tier, new_value));
-		}
+		m_recharge_costs[recharge_tier].emplace(item_id, price);
 	}
 }
 
 auto shop::is_shop(game_shop_id id) const -> bool {
-	for (const auto &shop : m_shops) {
-		if (shop.id == id) {
-			return true;
-		}
-	}
-
-	return false;
+	return ext::is_element(m_shops, id);
 }
 
 auto shop::get_shop(game_shop_id id) const -> shop_data {
-	const data::type::shop_info * info = nullptr;
-	for (const auto &shop : m_shops) {
-		if (shop.id == id) {
-			info = &shop;
-		}
-	}
-
+	auto info = ext::find_value_ptr(m_shops, id);
 	if (info == nullptr) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
 	shop_data ret;
@@ -174,66 +127,33 @@ auto shop::get_shop(game_shop_id id) const -> shop_data {
 	}
 
 	if (info->recharge_tier > 0) {
-		bool found = false;
-		for (const auto &tier : m_recharge_costs) {
-			if (tier.first == info->recharge_tier) {
-				for (const auto &item : tier.second) {
-					ret.rechargeables[item.first] = item.second;
-				}
-				found = true;
-				break;
-			}
-		}
+		auto tier = ext::find_value_ptr(m_recharge_costs, info->recharge_tier);
+		if (tier == nullptr) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
-		if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+		for (const auto &item : *tier) {
+			ret.rechargeables[item.first] = item.second;
+		}
 	}
 
 	return ret;
 }
 
 auto shop::get_shop_item(game_shop_id shop_id, uint16_t shop_index) const -> const data::type::shop_item_info * const {
-	const data::type::shop_item_info *item = nullptr;
-	for (const auto &shop : m_shops) {
-		if (shop.id == shop_id) {
-			item = &shop.items[shop_index];
-			break;
-		}
-	}
-
+	auto shop = ext::find_value_ptr(m_shops, shop_id);
+	auto item = shop == nullptr ? nullptr : ext::find_value_ptr(shop->items, shop_index);
 	if (item == nullptr) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 	return item;
 }
 
 auto shop::get_recharge_cost(game_shop_id shop_id, game_item_id item_id, game_slot_qty amount) const -> game_mesos {
-	int8_t recharge_tier = -1;
-	bool found = false;
-	for (const auto &shop : m_shops) {
-		if (shop.id == shop_id) {
-			recharge_tier = shop.recharge_tier;
-			found = true;
-			break;
-		}
-	}
-	if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
-
-	found = false;
-	double recharge_cost = 1.;
-	for (const auto &shop_cost : m_recharge_costs) {
-		if (shop_cost.first == recharge_tier) {
-			for (const auto &item_recharge_cost : shop_cost.second) {
-				if (item_recharge_cost.first == item_id) {
-					recharge_cost = item_recharge_cost.second;
-					found = true;
-					break;
-				}
-			}
-			break;
-		}
-	}
+	auto shop = ext::find_value_ptr(m_shops, shop_id);
+	if (shop == nullptr) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
-	if (!found) THROW_CODE_EXCEPTION(codepath_invalid_exception);
+	auto tier = ext::find_value_ptr(m_recharge_costs, shop->recharge_tier);
+	auto recharge_cost = tier == nullptr ? nullptr : ext::find_value_ptr(*tier, item_id);
+	if (recharge_cost == nullptr) THROW_CODE_EXCEPTION(codepath_invalid_exception);
 
-	return static_cast<game_mesos>(recharge_cost * amount);
+	return static_cast<game_mesos>(*recharge_cost * amount);
 }
 
 }
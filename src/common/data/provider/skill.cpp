@@ -18,7 +18,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "skill.hpp"
 #include "common/algorithm.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/constant/mob_skill.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
@@ -45,24 +46,20 @@ auto skill::load_player_skills() -> void {
 	m_skill_levels.clear();
 	m_skill_max_levels.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::skill_player_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::skill_player_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_skill_id skill_id = row.get<game_skill_id>("skillid");
 
-		m_skill_levels.emplace_back(skill_id, vector<data::type::skill_level_info>{});
-		m_skill_max_levels.emplace_back(skill_id, 1);
+		m_skill_levels.emplace(skill_id, vector<data::type::skill_level_info>{});
+		m_skill_max_levels.emplace(skill_id, 1);
 	}
 }
 
 auto skill::load_player_skill_levels() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::skill_player_level_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::skill_player_level_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::skill_level_info info;
 		game_skill_id skill_id = row.get<game_skill_id>("skillid");
 		game_skill_level skill_level = row.get<game_skill_level>("skill_level");
@@ -104,34 +101,11 @@ auto skill::load_player_skill_levels() -> void {
 		};
 		info.cool_time = seconds{row.get<int32_t>("cooldown_time")};
 
-		bool found = false;
-		for (auto &skill_level_value : m_skill_levels) {
-			if (skill_level_value.first == skill_id) {
-				found = true;
-				skill_level_value.second.push_back(info);
-				break;
-			}
-		}
+		m_skill_levels[skill_id].push_back(info);
 
-		if (!found) {
-			vector<data::type::skill_level_info> current;
-			current.push_back(info);
-			m_skill_levels.emplace_back(skill_id, current);
-		}
-
-		found = false;
-		for (auto &max_skill_level : m_skill_max_levels) {
-			if (max_skill_level.first == skill_id) {
-				found = true;
-				if (skill_level > max_skill_level.second) {
-					max_skill_level.second = skill_level;
-				}
-				break;
-			}
-		}
-
-		if (!found) {
-			m_skill_max_levels.emplace_back(skill_id, skill_level);
+		auto max_level = m_skill_max_levels.emplace(skill_id, skill_level);
+		if (!max_level.second && skill_level > max_level.first->second) {
+			max_level.first->second = skill_level;
 		}
 	}
 }
@@ -139,11 +113,9 @@ auto skill::load_player_skill_levels() -> void {
 auto skill::load_mob_skills() -> void {
 	m_mob_skills.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::skill_mob_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::skill_mob_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::mob_skill_level_info mob_level;
 		game_mob_skill_id skill_id = row.get<game_mob_skill_id>("skillid");
 		game_mob_skill_level level = row.get<game_mob_skill_level>("skill_level");
@@ -164,39 +136,21 @@ auto skill::load_mob_skills() -> void {
 		mob_level.limit = row.get<int16_t>("summon_limit");
 		mob_level.summon_effect = row.get<int8_t>("summon_effect");
 
-		bool found = false;
-		for (auto &skill : m_mob_skills) {
-			if (skill.first == skill_id) {
-				found = true;
-				skill.second.push_back(mob_level);
-				break;
-			}
-		}
-
-		if (!found) {
-			vector<data::type::mob_skill_level_info> current;
-			current.push_back(mob_level);
-			m_mob_skills.emplace_back(skill_id, current);
-		}
+		m_mob_skills[skill_id].push_back(mob_level);
 	}
 }
 
 auto skill::load_mob_summons() -> void {
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::skill_mob_summons));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::skill_mob_summons);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_mob_skill_level level = row.get<game_mob_skill_level>("level");
 		game_mob_id mob_id = row.get<game_mob_id>("mobid");
 
 		bool any = false;
-		for (auto &skill : m_mob_skills) {
-			if (skill.first != constant::mob_skill::summon) {
-				continue;
-			}
-
-			for (auto &skill_level : skill.second) {
+		auto kvp = m_mob_skills.find(constant::mob_skill::summon);
+		if (kvp != std::end(m_mob_skills)) {
+			for (auto &skill_level : kvp->second) {
 				if (skill_level.level != level) {
 					continue;
 				}
@@ -213,29 +167,25 @@ auto skill::load_mob_summons() -> void {
 auto skill::load_banish_data() -> void {
 	m_banish_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::skill_mob_banish_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::skill_mob_banish_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::banish_field_info banish;
 		banish.mob_id = row.get<game_mob_id>("mobid");
 		banish.message = row.get<string>("message");
 		banish.field = row.get<game_map_id>("destination");
 		banish.portal = row.get<string>("portal");
 
-		m_banish_info.push_back(banish);
+		m_banish_info.emplace(banish.mob_id, banish);
 	}
 }
 
 auto skill::load_morphs() -> void {
 	m_morph_info.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::morph_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::morph_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		data::type::morph_info morph;
 		morph.id = row.get<game_morph_id>("morphid");
 
@@ -248,50 +198,45 @@ auto skill::load_morphs() -> void {
 		morph.traction = row.get<double>("traction");
 		morph.swim = row.get<double>("swim");
 
-		m_morph_info.push_back(morph);
+		m_morph_info.emplace(morph.id, morph);
 	}
 }
 
 auto skill::is_valid_skill(game_skill_id skill_id) const -> bool {
-	return ext::any_of(m_skill_levels, [&skill_id](auto value) { return value.first == skill_id; });
+	return ext::is_element(m_skill_levels, skill_id);
 }
 
 auto skill::get_max_level(game_skill_id skill_id) const -> game_skill_level {
-	for (const auto &skill : m_skill_max_levels) {
-		if (skill.first == skill_id) {
-			return skill.second;
-		}
+	auto kvp = m_skill_max_levels.find(skill_id);
+	if (kvp != std::end(m_skill_max_levels)) {
+		return kvp->second;
 	}
 
 	THROW_CODE_EXCEPTION(codepath_invalid_exception);
 }
 
 auto skill::get_skill(game_skill_id skill, game_skill_level level) const -> const data::type::skill_level_info * const {
-	auto skill_ptr = ext::find_value_ptr_if(m_skill_levels, [&skill](auto value) { return value.first == skill; });
+	auto skill_ptr = ext::find_value_ptr(m_skill_levels, skill);
 	if (skill_ptr == nullptr) return nullptr;
 	return ext::find_value_ptr_if(
-		skill_ptr->second,
+		*skill_ptr,
 		[&level](auto value) { return value.level == level; });
 }
 
 auto skill::get_mob_skill(game_mob_skill_id skill, game_mob_skill_level level) const -> const data::type::mob_skill_level_info * const {
-	auto skill_ptr = ext::find_value_ptr_if(m_mob_skills, [&skill](auto value) { return value.first == skill; });
+	auto skill_ptr = ext::find_value_ptr(m_mob_skills, skill);
 	if (skill_ptr == nullptr) return nullptr;
 	return ext::find_value_ptr_if(
-		skill_ptr->second,
+		*skill_ptr,
 		[&level](auto value) { return value.level == level; });
 }
 
 auto skill::get_banish_data(game_mob_id mob_id) const -> const data::type::banish_field_info * const {
-	return ext::find_value_ptr_if(
-		m_banish_info,
-		[&mob_id](auto value) { return value.mob_id == mob_id; });
+	return ext::find_value_ptr(m_banish_info, mob_id);
 }
 
 auto skill::get_morph_data(game_morph_id morph) const -> const data::type::morph_info * const {
-	return ext::find_value_ptr_if(
-		m_morph_info,
-		[&morph](auto value) { return value.id == morph; });
+	return ext::find_value_ptr(m_morph_info, morph);
 }
 
 }
@@ -19,7 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/algorithm.hpp"
 #include "common/constant/gender.hpp"
 #include "common/data/initialize.hpp"
-#include "common/io/database.hpp"
+#include "common/data/snapshot.hpp"
+#include "common/data/table.hpp"
 #include "common/util/game_logic/player.hpp"
 #include "common/util/string.hpp"
 #include <iomanip>
@@ -40,26 +41,24 @@ auto valid_char::load_data() -> void {
 }
 
 auto valid_char::load_forbidden_names() -> void {
-	m_forbidden_names.clear();
+	vector<string> names;
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::character_forbidden_names));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::character_forbidden_names);
 
-	for (const auto &row : rs) {
-		m_forbidden_names.push_back(row.get<string>("forbidden_name"));
+	for (const auto &row : *rs) {
+		names.push_back(row.get<string>("forbidden_name"));
 	}
+
+	m_forbidden_names.build(names);
 }
 
 auto valid_char::load_creation_items() -> void {
 	m_adventurer.clear();
 	m_cygnus.clear();
 
-	auto &db = vana::io::database::get_data_db();
-	auto &sql = db.get_session();
-	soci::rowset<> rs = (sql.prepare << "SELECT * FROM " << db.make_table(vana::data::table::character_creation_data));
+	auto rs = vana::data::snapshot::get_instance().get_table(vana::data::table::character_creation_data);
 
-	for (const auto &row : rs) {
+	for (const auto &row : *rs) {
 		game_gender_id gender_id = vana::util::game_logic::player::get_gender_id(row.get<string>("gender"));
 		int32_t object_id = row.get<int32_t>("objectid");
 		int8_t class_id = -1;
@@ -87,10 +86,7 @@ auto valid_char::load_creation_items() -> void {
 }
 
 auto valid_char::is_forbidden_name(const string &cmp) const -> bool {
-	string c = vana::util::str::remove_spaces(vana::util::str::to_lower(cmp));
-	return ext::any_of(m_forbidden_names, [&c](const string &s) -> bool {
-		return c.find(s, 0) != string::npos;
-	});
+	return m_forbidden_names.contains_any(vana::util::str::remove_spaces(vana::util::str::to_lower(cmp)));
 }
 
 auto valid_char::is_valid_character(game_gender_id gender_id, game_hair_id hair, game_hair_id hair_color, game_face_id face, game_skin_id skin, game_item_id top, game_item_id bottom, game_item_id shoes, game_item_id weapon, int8_t class_id) const -> bool {
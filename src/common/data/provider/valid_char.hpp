@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "common/types.hpp"
 #include "common/data/type/valid_item_type.hpp"
+#include "common/util/string_matcher.hpp"
 #include "common/valid_class_data.hpp"
 #include "common/valid_class_gender_data.hpp"
 #include <string>
@@ -43,7 +44,7 @@ namespace vana {
 				auto is_valid_item(int32_t id, const valid_class_data &items, data::type::valid_item_type type) const -> bool;
 				auto get_items(game_gender_id gender_id, int8_t class_id) const -> const valid_class_data &;
 
-				vector<string> m_forbidden_names;
+				vana::util::string_matcher m_forbidden_names;
 				valid_class_gender_data m_adventurer;
 				valid_class_gender_data m_cygnus;
 			};
@@ -0,0 +1,219 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "snapshot.hpp"
+#include "common/data/initialize.hpp"
+#include "common/io/database.hpp"
+#include "common/packet_builder.hpp"
+#include "common/packet_reader.hpp"
+#include "common/util/file.hpp"
+#include "common/util/randomizer.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace vana {
+namespace data {
+
+namespace {
+	const string snapshot_file = "mcdb.snapshot";
+	const string snapshot_magic = "VANA_MCDB_SNAPSHOT";
+}
+
+snapshot::snapshot()
+{
+}
+
+auto snapshot::open(int32_t major_version, int32_t minor_version, game_version maple_version, bool test_server, const string &locale) -> void {
+	owned_lock<mutex> l{m_tables_mutex};
+
+	out_stream version;
+	version << major_version << "." << minor_version << "/" << maple_version << "/" << locale << (test_server ? "/test" : "");
+	m_version = version.str();
+	m_tables.clear();
+	m_open = true;
+
+	std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Initializing MCDB Snapshot... ";
+	m_dirty = !load();
+	std::cout << (m_dirty ? "REBUILDING" : "DONE") << std::endl;
+}
+
+auto snapshot::close() -> void {
+	owned_lock<mutex> l{m_tables_mutex};
+	if (!m_open) {
+		return;
+	}
+
+	if (m_dirty) {
+		std::cout << std::setw(vana::data::initialize::output_width) << std::left << "Saving MCDB Snapshot... ";
+		save();
+		std::cout << "DONE" << std::endl;
+	}
+
+	for (auto iter = std::begin(m_tables); iter != std::end(m_tables); ) {
+		if (iter->second.index_column.empty()) {
+			iter = m_tables.erase(iter);
+		}
+		else {
+			++iter;
+		}
+	}
+
+	m_open = false;
+	m_dirty = false;
+}
+
+auto snapshot::invalidate() -> void {
+	owned_lock<mutex> l{m_tables_mutex};
+	m_tables.clear();
+	m_open = false;
+	m_dirty = false;
+	std::remove(snapshot_file.c_str());
+}
+
+auto snapshot::get_table(const string &table, const string &order_by) -> ref_ptr<const snapshot_table> {
+	string key = table;
+	if (!order_by.empty()) {
+		key += " ORDER BY " + order_by;
+	}
+
+	return get(key, "", [&](vana::io::database &db) -> soci::rowset<> {
+		return (db.get_session().prepare << "SELECT * FROM " << db.make_table(table) << (order_by.empty() ? "" : " ORDER BY " + order_by));
+	});
+}
+
+auto snapshot::get_indexed_table(const string &table, const string &column) -> ref_ptr<const snapshot_table> {
+	return get(table + " ORDER BY " + column, column, [&](vana::io::database &db) -> soci::rowset<> {
+		return (db.get_session().prepare << "SELECT * FROM " << db.make_table(table) << " ORDER BY " << column);
+	});
+}
+
+auto snapshot::get_query(const string &key, function<soci::rowset<> (vana::io::database &)> query) -> ref_ptr<const snapshot_table> {
+	return get(key, "", query);
+}
+
+auto snapshot::get(const string &key, const string &index_column, function<soci::rowset<> (vana::io::database &)> query) -> ref_ptr<const snapshot_table> {
+	owned_lock<mutex> l{m_tables_mutex};
+
+	auto kvp = m_tables.find(key);
+	if (kvp != std::end(m_tables)) {
+		return kvp->second.table;
+	}
+
+	auto table = snapshot_table::from_rowset(query(vana::io::database::get_data_db()));
+	if (!index_column.empty()) {
+		table->build_index(index_column);
+	}
+
+	if (m_open || !index_column.empty()) {
+		entry value;
+		value.table = table;
+		value.index_column = index_column;
+		m_tables[key] = value;
+		m_dirty = m_dirty || m_open;
+	}
+
+	return table;
+}
+
+auto snapshot::load() -> bool {
+	if (!vana::util::file::exists(snapshot_file)) {
+		return false;
+	}
+
+	std::ifstream stream{snapshot_file, std::ios::in | std::ios::binary};
+	stream.seekg(0, std::ios::end);
+	auto length = static_cast<size_t>(stream.tellg());
+	stream.seekg(0, std::ios::beg);
+
+	vector<unsigned char> buffer(length);
+	if (length == 0 || !stream.read(reinterpret_cast<char *>(buffer.data()), length)) {
+		return false;
+	}
+
+	try {
+		packet_reader reader{buffer.data(), buffer.size()};
+		if (reader.get<string>() != snapshot_magic || reader.get<uint32_t>() != format_version || reader.get<string>() != m_version) {
+			return false;
+		}
+
+		hash_map<string, entry> tables;
+		uint32_t table_count = reader.get<uint32_t>();
+		for (uint32_t i = 0; i < table_count; ++i) {
+			string key = reader.get<string>();
+			entry value;
+			value.index_column = reader.get<string>();
+			value.table = snapshot_table::read(reader);
+			if (value.table == nullptr) {
+				return false;
+			}
+
+			if (!value.index_column.empty()) {
+				value.table->build_index(value.index_column);
+			}
+			tables[key] = value;
+		}
+
+		m_tables = std::move(tables);
+	}
+	catch (std::exception &) {
+		// Truncated or otherwise damaged, the tables will be queried and the file rewritten
+		return false;
+	}
+
+	return true;
+}
+
+auto snapshot::save() -> void {
+	packet_builder builder;
+	builder
+		.add<string>(snapshot_magic)
+		.add<uint32_t>(format_version)
+		.add<string>(m_version)
+		.add<uint32_t>(static_cast<uint32_t>(m_tables.size()));
+
+	for (const auto &kvp : m_tables) {
+		builder
+			.add<string>(kvp.first)
+			.add<string>(kvp.second.index_column);
+
+		kvp.second.table->write(builder);
+	}
+
+	// Every server sharing the directory may be rebuilding at the same time, so write privately and swap the file in
+	string temporary = snapshot_file + "." + std::to_string(vana::util::randomizer::rand<uint32_t>());
+	{
+		std::ofstream stream{temporary, std::ios::out | std::ios::binary | std::ios::trunc};
+		stream.write(reinterpret_cast<const char *>(builder.get_buffer()), builder.get_size());
+		if (!stream) {
+			stream.close();
+			std::remove(temporary.c_str());
+			return;
+		}
+	}
+
+	if (std::rename(temporary.c_str(), snapshot_file.c_str()) != 0) {
+		std::remove(snapshot_file.c_str());
+		if (std::rename(temporary.c_str(), snapshot_file.c_str()) != 0) {
+			std::remove(temporary.c_str());
+		}
+	}
+}
+
+}
+}
@@ -0,0 +1,67 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/data/snapshot_table.hpp"
+#include "common/soci_extensions.hpp"
+#include "common/types.hpp"
+#include <mutex>
+#include <string>
+
+namespace vana {
+	namespace io {
+		class database;
+	}
+
+	namespace data {
+		// Caches MCDB result sets in a binary file keyed on the MCDB version so servers don't have to query every table on startup
+		// Tables missing from the file (or the whole file when the version changes) are read from the database and written back on close
+		class snapshot {
+			SINGLETON(snapshot);
+		public:
+			auto open(int32_t major_version, int32_t minor_version, game_version maple_version, bool test_server, const string &locale) -> void;
+			// Writes back any tables that had to be queried and releases everything that isn't indexed
+			auto close() -> void;
+			// Drops every cached table along with the file, for when the MCDB is edited in place
+			auto invalidate() -> void;
+
+			auto get_table(const string &table, const string &order_by = "") -> ref_ptr<const snapshot_table>;
+			// Indexed tables stay resident after close because they serve lazy per-key loads
+			auto get_indexed_table(const string &table, const string &column) -> ref_ptr<const snapshot_table>;
+			// For queries that aren't a plain table read; the key must change whenever the query does
+			auto get_query(const string &key, function<soci::rowset<> (vana::io::database &)> query) -> ref_ptr<const snapshot_table>;
+		private:
+			static const uint32_t format_version = 1;
+
+			struct entry {
+				ref_ptr<snapshot_table> table;
+				string index_column;
+			};
+
+			auto get(const string &key, const string &index_column, function<soci::rowset<> (vana::io::database &)> query) -> ref_ptr<const snapshot_table>;
+			auto load() -> bool;
+			auto save() -> void;
+
+			bool m_open = false;
+			bool m_dirty = false;
+			string m_version;
+			hash_map<string, entry> m_tables;
+			mutex m_tables_mutex;
+		};
+	}
+}
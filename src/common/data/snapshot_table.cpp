@@ -0,0 +1,214 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "snapshot_table.hpp"
+#include "common/packet_builder.hpp"
+#include "common/packet_reader.hpp"
+#include <cstring>
+#include <ctime>
+
+namespace vana {
+namespace data {
+
+auto snapshot_table::from_rowset(const soci::rowset<> &rs) -> ref_ptr<snapshot_table> {
+	auto table = make_ref_ptr<snapshot_table>();
+
+	for (const auto &row : rs) {
+		if (table->m_row_count == 0) {
+			for (size_t i = 0; i < row.size(); ++i) {
+				table->add_column(row.get_properties(i).get_name());
+			}
+		}
+
+		for (size_t i = 0; i < row.size(); ++i) {
+			cell value{};
+			value.type = cell_type::integer;
+
+			if (row.get_indicator(i) == soci::i_null) {
+				value.type = cell_type::null;
+			}
+			else {
+				switch (row.get_properties(i).get_data_type()) {
+					case soci::dt_string: {
+						string text = row.get<string>(i);
+						value.type = cell_type::text;
+						value.value = static_cast<int64_t>(table->m_text.size());
+						value.length = static_cast<uint32_t>(text.size());
+						table->m_text += text;
+						break;
+					}
+					case soci::dt_double: {
+						double real = row.get<double>(i);
+						value.type = cell_type::real;
+						memcpy(&value.value, &real, sizeof(real));
+						break;
+					}
+					case soci::dt_integer: value.value = row.get<int>(i); break;
+					case soci::dt_long_long: value.value = row.get<long long>(i); break;
+					case soci::dt_unsigned_long_long: value.value = static_cast<int64_t>(row.get<unsigned long long>(i)); break;
+					case soci::dt_date: {
+						std::tm date = row.get<std::tm>(i);
+						value.value = static_cast<int64_t>(mktime(&date));
+						break;
+					}
+					default: THROW_CODE_EXCEPTION(not_implemented_exception, "data_type");
+				}
+			}
+
+			table->m_cells.push_back(value);
+		}
+
+		table->m_row_count++;
+	}
+
+	return table;
+}
+
+auto snapshot_table::read(packet_reader &reader) -> ref_ptr<snapshot_table> {
+	if (reader.get<uint32_t>() != sizeof(cell)) {
+		return nullptr;
+	}
+
+	auto table = make_ref_ptr<snapshot_table>();
+	uint32_t column_count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < column_count; ++i) {
+		table->add_column(reader.get<string>());
+	}
+
+	table->m_row_count = static_cast<size_t>(reader.get<uint64_t>());
+	uint64_t text_size = reader.get<uint64_t>();
+	uint64_t cell_bytes = static_cast<uint64_t>(table->m_row_count) * column_count * sizeof(cell);
+	if (text_size + cell_bytes > reader.get_buffer_length()) {
+		return nullptr;
+	}
+
+	table->m_text.assign(reinterpret_cast<const char *>(reader.get_buffer()), static_cast<size_t>(text_size));
+	reader.skip(static_cast<int32_t>(text_size));
+
+	table->m_cells.resize(table->m_row_count * column_count);
+	if (cell_bytes > 0) {
+		memcpy(table->m_cells.data(), reader.get_buffer(), static_cast<size_t>(cell_bytes));
+		reader.skip(static_cast<int32_t>(cell_bytes));
+	}
+
+	for (const auto &value : table->m_cells) {
+		if (value.type == cell_type::text && static_cast<uint64_t>(value.value) + value.length > text_size) {
+			return nullptr;
+		}
+	}
+
+	return table;
+}
+
+auto snapshot_table::write(packet_builder &builder) const -> void {
+	builder.add<uint32_t>(static_cast<uint32_t>(sizeof(cell)));
+	builder.add<uint32_t>(static_cast<uint32_t>(m_columns.size()));
+	for (const auto &column : m_columns) {
+		builder.add<string>(column);
+	}
+
+	builder.add<uint64_t>(m_row_count);
+	builder.add<uint64_t>(m_text.size());
+	builder.add_buffer(reinterpret_cast<const unsigned char *>(m_text.data()), m_text.size());
+	builder.add_buffer(reinterpret_cast<const unsigned char *>(m_cells.data()), m_cells.size() * sizeof(cell));
+}
+
+auto snapshot_table::build_index(const string &column) -> void {
+	m_index.clear();
+	if (m_row_count == 0) {
+		return;
+	}
+
+	size_t index = get_column(column);
+	int64_t current_key = 0;
+	for (size_t row = 0; row < m_row_count; ++row) {
+		int64_t key = get_integer(get_cell(row, index));
+		if (row > 0 && key == current_key) {
+			m_index[key].second = row + 1;
+			continue;
+		}
+
+		if (!m_index.emplace(key, std::make_pair(row, row + 1)).second) {
+			THROW_CODE_EXCEPTION(codepath_invalid_exception, "snapshot rows must be grouped by the index column");
+		}
+		current_key = key;
+	}
+}
+
+auto snapshot_table::find_rows(int64_t key) const -> range {
+	auto kvp = m_index.find(key);
+	if (kvp == std::end(m_index)) {
+		return range{end(), end()};
+	}
+
+	return range{
+		iterator{this, kvp->second.first},
+		iterator{this, kvp->second.second}
+	};
+}
+
+auto snapshot_table::add_column(const string &name) -> void {
+	m_column_lookup[name] = m_columns.size();
+	m_columns.push_back(name);
+}
+
+auto snapshot_table::get_column(const string &name) const -> size_t {
+	auto kvp = m_column_lookup.find(name);
+	if (kvp == std::end(m_column_lookup)) {
+		THROW_CODE_EXCEPTION(codepath_invalid_exception, "column " + name);
+	}
+	return kvp->second;
+}
+
+auto snapshot_table::get_cell(size_t row, size_t column) const -> const cell & {
+	return m_cells[row * m_columns.size() + column];
+}
+
+auto snapshot_table::get_integer(const cell &value) const -> int64_t {
+	switch (value.type) {
+		case cell_type::null: return 0;
+		case cell_type::integer: return value.value;
+		case cell_type::real: return static_cast<int64_t>(get_real(value));
+	}
+	THROW_CODE_EXCEPTION(codepath_invalid_exception, "text read as a number");
+}
+
+auto snapshot_table::get_real(const cell &value) const -> double {
+	if (value.type != cell_type::real) {
+		return static_cast<double>(get_integer(value));
+	}
+
+	double real;
+	memcpy(&real, &value.value, sizeof(real));
+	return real;
+}
+
+auto snapshot_table::get_value(size_t row, size_t column, bool &value) const -> void {
+	value = get_integer(get_cell(row, column)) == 1;
+}
+
+auto snapshot_table::get_value(size_t row, size_t column, string &value) const -> void {
+	const cell &c = get_cell(row, column);
+	switch (c.type) {
+		case cell_type::null: value.clear(); return;
+		case cell_type::text: value.assign(m_text, static_cast<size_t>(c.value), c.length); return;
+	}
+	THROW_CODE_EXCEPTION(codepath_invalid_exception, "number read as text");
+}
+
+}
+}
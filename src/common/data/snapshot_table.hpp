@@ -0,0 +1,156 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/soci_extensions.hpp"
+#include "common/types.hpp"
+#include "common/util/optional.hpp"
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace vana {
+	class packet_builder;
+	class packet_reader;
+
+	namespace data {
+		class snapshot_table;
+
+		class snapshot_row {
+		public:
+			snapshot_row(const snapshot_table *table, size_t row) : m_table{table}, m_row{row} { }
+
+			// Follows the conversions in soci_extensions: NULL reads as zero or an empty string unless the target is optional
+			template <typename TValue>
+			auto get(const string &column) const -> TValue;
+		private:
+			const snapshot_table *m_table;
+			size_t m_row;
+		};
+
+		// An in-memory copy of one MCDB result set
+		// Cells are fixed-size and text is pooled so a table is written and read back with a handful of bulk copies
+		class snapshot_table {
+			NONCOPYABLE(snapshot_table);
+		public:
+			class iterator {
+			public:
+				iterator(const snapshot_table *table, size_t row) : m_table{table}, m_row{row} { }
+				auto operator*() const -> snapshot_row { return snapshot_row{m_table, m_row}; }
+				auto operator++() -> iterator & { ++m_row; return *this; }
+				auto operator==(const iterator &other) const -> bool { return m_row == other.m_row; }
+				auto operator!=(const iterator &other) const -> bool { return m_row != other.m_row; }
+			private:
+				const snapshot_table *m_table;
+				size_t m_row;
+			};
+
+			class range {
+			public:
+				range(iterator begin, iterator end) : m_begin{begin}, m_end{end} { }
+				auto begin() const -> iterator { return m_begin; }
+				auto end() const -> iterator { return m_end; }
+			private:
+				iterator m_begin;
+				iterator m_end;
+			};
+
+			snapshot_table() = default;
+
+			static auto from_rowset(const soci::rowset<> &rs) -> ref_ptr<snapshot_table>;
+			// Returns nullptr when the serialized table doesn't match this build's layout
+			static auto read(packet_reader &reader) -> ref_ptr<snapshot_table>;
+			auto write(packet_builder &builder) const -> void;
+
+			auto begin() const -> iterator { return iterator{this, 0}; }
+			auto end() const -> iterator { return iterator{this, m_row_count}; }
+			auto size() const -> size_t { return m_row_count; }
+
+			// Requires rows with the same key to be adjacent, which an ORDER BY on the column guarantees
+			auto build_index(const string &column) -> void;
+			auto find_rows(int64_t key) const -> range;
+		private:
+			friend class snapshot_row;
+
+			enum class cell_type : uint8_t {
+				null,
+				integer,
+				real,
+				text,
+			};
+
+			struct cell {
+				// Integer value, bit pattern of a real, or offset into the text pool
+				int64_t value;
+				uint32_t length;
+				cell_type type;
+				uint8_t padding[3];
+			};
+
+			auto add_column(const string &name) -> void;
+			auto get_column(const string &name) const -> size_t;
+			auto get_cell(size_t row, size_t column) const -> const cell &;
+			auto get_integer(const cell &value) const -> int64_t;
+			auto get_real(const cell &value) const -> double;
+
+			template <typename TValue>
+			auto get_value(size_t row, size_t column, TValue &value) const -> std::enable_if_t<std::is_arithmetic<TValue>::value>;
+			template <typename TElement>
+			auto get_value(size_t row, size_t column, optional<TElement> &value) const -> void;
+			auto get_value(size_t row, size_t column, bool &value) const -> void;
+			auto get_value(size_t row, size_t column, string &value) const -> void;
+
+			size_t m_row_count = 0;
+			vector<string> m_columns;
+			hash_map<string, size_t> m_column_lookup;
+			vector<cell> m_cells;
+			string m_text;
+			hash_map<int64_t, pair<size_t, size_t>> m_index;
+		};
+
+		template <typename TValue>
+		auto snapshot_row::get(const string &column) const -> TValue {
+			TValue value;
+			m_table->get_value(m_row, m_table->get_column(column), value);
+			return value;
+		}
+
+		template <typename TValue>
+		auto snapshot_table::get_value(size_t row, size_t column, TValue &value) const -> std::enable_if_t<std::is_arithmetic<TValue>::value> {
+			const cell &c = get_cell(row, column);
+			if (c.type == cell_type::real) {
+				value = static_cast<TValue>(get_real(c));
+			}
+			else {
+				value = static_cast<TValue>(get_integer(c));
+			}
+		}
+
+		template <typename TElement>
+		auto snapshot_table::get_value(size_t row, size_t column, optional<TElement> &value) const -> void {
+			if (get_cell(row, column).type == cell_type::null) {
+				value.reset();
+				return;
+			}
+
+			TElement element;
+			get_value(row, column, element);
+			value = element;
+		}
+	}
+}
@@ -0,0 +1,102 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "foothold_index.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace vana {
+namespace data {
+namespace type {
+
+foothold_index::foothold_index(vector<foothold_info> footholds) :
+	m_footholds{std::move(footholds)}
+{
+	if (m_footholds.empty()) {
+		return;
+	}
+
+	m_min_x = std::numeric_limits<int32_t>::max();
+	m_max_x = std::numeric_limits<int32_t>::min();
+	for (size_t i = 0; i < m_footholds.size(); ++i) {
+		const line &line = m_footholds[i].line;
+		m_min_x = std::min<int32_t>(m_min_x, std::min(line.pt1.x, line.pt2.x));
+		m_max_x = std::max<int32_t>(m_max_x, std::max(line.pt1.x, line.pt2.x));
+		// The first foothold with a given ID is the one the linear searches used to find
+		m_ids.emplace(m_footholds[i].id, i);
+	}
+
+	m_buckets.resize((m_max_x - m_min_x) / bucket_width + 1);
+	for (const auto &foothold : m_footholds) {
+		size_t first = get_bucket(std::min(foothold.line.pt1.x, foothold.line.pt2.x));
+		size_t last = get_bucket(std::max(foothold.line.pt1.x, foothold.line.pt2.x));
+		for (size_t bucket = first; bucket <= last; ++bucket) {
+			m_buckets[bucket].push_back(&foothold);
+		}
+	}
+}
+
+auto foothold_index::get_bucket(int32_t x) const -> size_t {
+	return static_cast<size_t>((x - m_min_x) / bucket_width);
+}
+
+auto foothold_index::find(game_foothold_id id) const -> const foothold_info * {
+	auto kvp = m_ids.find(id);
+	if (kvp == std::end(m_ids)) {
+		return nullptr;
+	}
+	return &m_footholds[kvp->second];
+}
+
+auto foothold_index::get_footholds_at(game_coord x) const -> const foothold_list & {
+	static const foothold_list none;
+	if (x < m_min_x || x > m_max_x) {
+		return none;
+	}
+	return m_buckets[get_bucket(x)];
+}
+
+auto foothold_index::get_footholds_in(game_coord left, game_coord right) const -> foothold_list {
+	foothold_list ret;
+	int32_t first_x = std::max<int32_t>(left, m_min_x);
+	int32_t last_x = std::min<int32_t>(right, m_max_x);
+	if (first_x > last_x) {
+		return ret;
+	}
+
+	size_t first = get_bucket(first_x);
+	size_t last = get_bucket(last_x);
+	for (size_t bucket = first; bucket <= last; ++bucket) {
+		for (const auto &foothold : m_buckets[bucket]) {
+			const line &line = foothold->line;
+			if (std::max(line.pt1.x, line.pt2.x) >= left && std::min(line.pt1.x, line.pt2.x) <= right) {
+				ret.push_back(foothold);
+			}
+		}
+	}
+
+	if (first != last) {
+		// Long footholds span several buckets, the storage is contiguous so pointer order is load order
+		std::sort(std::begin(ret), std::end(ret));
+		ret.erase(std::unique(std::begin(ret), std::end(ret)), std::end(ret));
+	}
+	return ret;
+}
+
+}
+}
+}
@@ -0,0 +1,61 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/data/type/foothold_info.hpp"
+#include "common/types.hpp"
+#include <vector>
+
+namespace vana {
+	namespace data {
+		namespace type {
+			// Owns a map link's footholds and buckets them by horizontal extent so that geometric and ID queries don't scan all of them
+			// Built once when the footholds are loaded and shared by every map instance using the link
+			class foothold_index {
+				NONCOPYABLE(foothold_index);
+			public:
+				using foothold_list = vector<const foothold_info *>;
+				using const_iterator = vector<foothold_info>::const_iterator;
+
+				foothold_index() = default;
+				explicit foothold_index(vector<foothold_info> footholds);
+				foothold_index(foothold_index &&other) = default;
+				auto operator=(foothold_index &&other) -> foothold_index & = default;
+
+				auto begin() const -> const_iterator { return std::cbegin(m_footholds); }
+				auto end() const -> const_iterator { return std::cend(m_footholds); }
+				auto size() const -> size_t { return m_footholds.size(); }
+				auto find(game_foothold_id id) const -> const foothold_info *;
+				// Every foothold whose horizontal extent includes x (inclusive of both ends), in load order
+				auto get_footholds_at(game_coord x) const -> const foothold_list &;
+				// Every foothold whose horizontal extent overlaps [left, right], in load order
+				auto get_footholds_in(game_coord left, game_coord right) const -> foothold_list;
+			private:
+				static const int32_t bucket_width = 128;
+
+				auto get_bucket(int32_t x) const -> size_t;
+
+				int32_t m_min_x = 0;
+				int32_t m_max_x = -1;
+				vector<foothold_info> m_footholds;
+				vector<foothold_list> m_buckets;
+				hash_map<game_foothold_id, size_t> m_ids;
+			};
+		}
+	}
+}
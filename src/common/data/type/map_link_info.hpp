@@ -17,7 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
-#include "common/data/type/foothold_info.hpp"
+#include "common/data/type/foothold_index.hpp"
 #include "common/data/type/portal_info.hpp"
 #include "common/data/type/seat_info.hpp"
 #include "common/data/type/spawn_info.hpp"
@@ -38,7 +38,7 @@ namespace vana {
 				vector<reactor_spawn_info> reactors;
 				vector<mob_spawn_info> mobs;
 				vector<portal_info> portals;
-				vector<foothold_info> footholds;
+				foothold_index footholds;
 				vector<seat_info> seats;
 			};
 		}
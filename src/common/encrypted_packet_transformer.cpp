@@ -19,11 +19,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/common_header.hpp"
 #include "common/maple_version.hpp"
 #include "common/packet_builder.hpp"
-#include "common/util/bit.hpp"
+#include "common/shuffle_cipher.hpp"
 #include "common/util/randomizer.hpp"
-#include <botan/filters.h>
 #include <botan/lookup.h>
-#include <botan/pipe.h>
 
 namespace vana {
 
@@ -39,12 +37,17 @@ const uint8_t aes_key[aes_key_size] = {
 	0x52, 0x00, 0x00, 0x00,
 };
 const int32_t block_size = 1460;
+const int32_t aes_block_size = 16;
+// Keystream is generated in whole AES blocks, so round the largest chunk up
+const int32_t keystream_size = ((block_size + aes_block_size - 1) / aes_block_size) * aes_block_size;
 
 encrypted_packet_transformer::encrypted_packet_transformer(crypto_iv recv_iv, crypto_iv send_iv) :
 	m_recv{recv_iv},
 	m_send{send_iv}
 {
-	m_botan_key = Botan::SymmetricKey{aes_key, aes_key_size};
+	// Botan picks the fastest provider available, which is AES-NI when the CPU supports it
+	m_aes.reset(Botan::get_block_cipher("AES-256"));
+	m_aes->set_key(aes_key, aes_key_size);
 }
 
 auto encrypted_packet_transformer::test_packet(unsigned char *header) -> validity_result {
@@ -77,125 +80,48 @@ auto encrypted_packet_transformer::set_packet_header(unsigned char *header, uint
 
 auto encrypted_packet_transformer::encrypt_packet(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size) -> void {
 	// Custom encryption layer
-	int32_t j;
-	uint8_t a, c;
-	for (uint8_t i = 0; i < 3; ++i) {
-		a = 0;
-		for (j = real_packet_size; j > 0; --j) {
-			c = packet_data[real_packet_size - j];
-			c = vana::util::bit::rotate_left(c, 3);
-			c = static_cast<uint8_t>(c + j); // Guess this is supposed to be right?
-			c = c ^ a;
-			a = c;
-			c = vana::util::bit::rotate_right(a, j);
-			c = c ^ 0xFF;
-			c = c + 0x48;
-			packet_data[real_packet_size - j] = c;
-		}
-		a = 0;
-		for (j = real_packet_size; j > 0; --j) {
-			c = packet_data[j - 1];
-			c = vana::util::bit::rotate_left(c, 4);
-			c = static_cast<uint8_t>(c + j); // Guess this is supposed to be right?
-			c = c ^ a;
-			a = c;
-			c = c ^ 0x13;
-			c = vana::util::bit::rotate_right(c, 3);
-			packet_data[j - 1] = c;
-		}
-	}
+	shuffle_cipher::encrypt(packet_data, real_packet_size);
 
 	// Standard AES
-	int32_t pos = 0;
-	uint8_t first = 1;
-	int32_t t_pos = 0;
-	int32_t write_amount = 0;
-	Botan::InitializationVector iv{m_send.get_bytes(), 16};
-
-	while (real_packet_size > pos) {
-		t_pos = block_size - first * header_size;
-		write_amount = real_packet_size > (pos + t_pos) ?
-			t_pos :
-			(real_packet_size - pos);
-
-		Botan::Pipe pipe{Botan::get_cipher("AES-256/OFB/NoPadding", m_botan_key, iv, Botan::ENCRYPTION)};
-		pipe.start_msg();
-		pipe.write(packet_data + pos, write_amount);
-		pipe.end_msg();
-
-		// Process the message and write it into the buffer
-		pipe.read(packet_data + pos, write_amount);
-
-		pos += t_pos;
-		if (first) {
-			first = 0;
-		}
-	}
+	apply_aes_keystream(packet_data, real_packet_size, header_size, m_send.get_bytes());
 
 	m_send.shuffle();
 }
 
 auto encrypted_packet_transformer::decrypt_packet(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size) -> void {
 	// Standard AES
-	int32_t pos = 0;
-	uint8_t first = 1;
-	int32_t t_pos = 0;
-	int32_t read_amount = 0;
-	Botan::InitializationVector iv{m_recv.get_bytes(), 16};
-
-	while (real_packet_size > pos) {
-		t_pos = block_size - first * header_size;
-		read_amount = real_packet_size > (pos + t_pos) ?
-			t_pos :
-			(real_packet_size - pos);
-
-		Botan::Pipe pipe{Botan::get_cipher("AES-256/OFB/NoPadding", m_botan_key, iv, Botan::DECRYPTION)};
-		pipe.start_msg();
-		pipe.write(packet_data + pos, read_amount);
-		pipe.end_msg();
-
-		// Process the message and write it into the buffer
-		pipe.read(packet_data + pos, read_amount);
-
-		pos += t_pos;
-		if (first) {
-			first = 0;
-		}
-	}
+	apply_aes_keystream(packet_data, real_packet_size, header_size, m_recv.get_bytes());
 
 	m_recv.shuffle();
 
 	// Custom decryption layer
-	int32_t j;
-	uint8_t a, b, c;
-	for (uint8_t i = 0; i < 3; i++) {
-		a = 0;
-		b = 0;
-		for (j = real_packet_size; j > 0; j--) {
-			c = packet_data[j - 1];
-			c = vana::util::bit::rotate_left(c, 3);
-			c = c ^ 0x13;
-			a = c;
-			c = c ^ b;
-			c = static_cast<uint8_t>(c - j); // Guess this is supposed to be right?
-			c = vana::util::bit::rotate_right(c, 4);
-			b = a;
-			packet_data[j - 1] = c;
-		}
-		a = 0;
-		b = 0;
-		for (j = real_packet_size; j > 0; j--) {
-			c = packet_data[real_packet_size - j];
-			c = c - 0x48;
-			c = c ^ 0xFF;
-			c = vana::util::bit::rotate_left(c, j);
-			a = c;
-			c = c ^ b;
-			c = static_cast<uint8_t>(c - j); // Guess this is supposed to be right?
-			c = vana::util::bit::rotate_right(c, 3);
-			b = a;
-			packet_data[real_packet_size - j] = c;
+	shuffle_cipher::decrypt(packet_data, real_packet_size);
+}
+
+auto encrypted_packet_transformer::apply_aes_keystream(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size, const unsigned char *iv) -> void {
+	// AES-OFB, encryption and decryption are the same operation
+	// Each block_size chunk of the packet (the first one is shortened by the header) restarts from the same IV
+	// That means one keystream as long as the largest chunk covers the entire packet
+	unsigned char keystream[keystream_size];
+	int32_t keystream_length = std::min(real_packet_size, block_size);
+
+	const unsigned char *feedback = iv;
+	for (int32_t pos = 0; pos < keystream_length; pos += aes_block_size) {
+		m_aes->encrypt(feedback, keystream + pos);
+		feedback = keystream + pos;
+	}
+
+	int32_t pos = 0;
+	int32_t chunk_size = block_size - header_size;
+	while (real_packet_size > pos) {
+		int32_t amount = std::min(chunk_size, real_packet_size - pos);
+		unsigned char *chunk = packet_data + pos;
+		for (int32_t i = 0; i < amount; ++i) {
+			chunk[i] ^= keystream[i];
 		}
+
+		pos += chunk_size;
+		chunk_size = block_size;
 	}
 }
 
@@ -21,7 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/block_cipher_iv.hpp"
 #include "common/packet_transformer.hpp"
 #include "common/types.hpp"
-#include <botan/lookup.h>
+#include <botan/block_cipher.h>
 
 namespace vana {
 	class encrypted_packet_transformer final : public packet_transformer {
@@ -34,9 +34,11 @@ namespace vana {
 		auto decrypt_packet(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size) -> void override;
 	private:
 		auto get_version_and_size(unsigned char *header, uint16_t &version, uint16_t &size) -> void;
+		auto apply_aes_keystream(unsigned char *packet_data, int32_t real_packet_size, uint16_t header_size, const unsigned char *iv) -> void;
 
 		block_cipher_iv m_recv;
 		block_cipher_iv m_send;
-		Botan::OctetString m_botan_key;
+		// The key never changes, so the key schedule is expanded once and reused for every packet
+		owned_ptr<Botan::BlockCipher> m_aes;
 	};
 }
\ No newline at end of file
@@ -68,6 +68,7 @@ namespace vana {
 				update_player,
 				character_created,
 				character_deleted,
+				handoff,
 			};
 			namespace update_bits {
 				enum : protocol_update_bits {
@@ -0,0 +1,130 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "database_executor.hpp"
+#include "common/abstract_server.hpp"
+#include "common/connection_manager.hpp"
+#include "common/io/database.hpp"
+#include "common/util/thread_pool.hpp"
+#include <functional>
+#include <utility>
+
+namespace vana {
+namespace io {
+
+database_executor::database_executor(connection_manager &manager, uint16_t connection_count) :
+	m_connection_count{connection_count == 0 ? static_cast<uint16_t>(1) : connection_count},
+	m_manager(manager)
+{
+	for (uint16_t i = 0; i < m_connection_count; ++i) {
+		m_threads.push_back(vana::util::thread_pool::lease(
+			[this](owned_lock<recursive_mutex> &lock) {
+				run(lock);
+			},
+			[this] {
+				owned_lock<recursive_mutex> l{m_tasks_mutex};
+				m_work_condition.notify_all();
+			},
+			m_tasks_mutex));
+	}
+}
+
+database_executor::~database_executor() {
+	m_threads.clear();
+}
+
+auto database_executor::execute(const string &query_name, function<void(database &)> query) -> void {
+	enqueue(query_name, std::move(query));
+}
+
+auto database_executor::execute(const string &query_name, function<void(database &)> query, function<void(bool)> callback) -> void {
+	enqueue(query_name, [this, query, callback](database &db) {
+		try {
+			query(db);
+		}
+		catch (...) {
+			dispatch([callback] { callback(false); });
+			throw;
+		}
+		dispatch([callback] { callback(true); });
+	});
+}
+
+auto database_executor::get_connection_count() const -> uint16_t {
+	return m_connection_count;
+}
+
+auto database_executor::get_pending_count() -> size_t {
+	owned_lock<recursive_mutex> l{m_tasks_mutex};
+	return m_tasks.size();
+}
+
+auto database_executor::for_each_latency(function<void(const string &, const vana::util::latency_histogram &)> func) -> void {
+	owned_lock<mutex> l{m_latency_mutex};
+	for (const auto &kvp : m_latency) {
+		func(kvp.first, *kvp.second);
+	}
+}
+
+auto database_executor::enqueue(const string &query_name, function<void(database &)> work) -> void {
+	owned_lock<recursive_mutex> l{m_tasks_mutex};
+	m_tasks.push_back(task{query_name, std::move(work)});
+	m_work_condition.notify_one();
+}
+
+auto database_executor::dispatch(function<void()> func) -> void {
+	m_manager.dispatch(func);
+}
+
+auto database_executor::run(owned_lock<recursive_mutex> &lock) -> void {
+	if (m_tasks.empty()) {
+		m_work_condition.wait(lock);
+		return;
+	}
+
+	// Keep going until the queue is empty so nothing is left behind when the pool shuts down
+	while (!m_tasks.empty()) {
+		task current = std::move(m_tasks.front());
+		m_tasks.pop_front();
+		lock.unlock();
+
+		time_point start = effective_clock::now();
+		try {
+			current.work(database::get_char_db());
+		}
+		catch (std::exception &e) {
+			m_manager.get_server()->log(vana::log::type::error, [&](out_stream &str) {
+				str << "Query " << current.name << " failed: " << e.what();
+			});
+		}
+		get_latency(current.name).record(effective_clock::now() - start);
+
+		lock.lock();
+	}
+}
+
+auto database_executor::get_latency(const string &query_name) -> vana::util::latency_histogram & {
+	owned_lock<mutex> l{m_latency_mutex};
+	auto &histogram = m_latency[query_name];
+	if (histogram == nullptr) {
+		histogram = make_owned_ptr<vana::util::latency_histogram>();
+	}
+	return *histogram;
+}
+
+}
+}
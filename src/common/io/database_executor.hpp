@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include "common/util/latency_histogram.hpp"
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vana {
+	class connection_manager;
+
+	namespace io {
+		class database;
+
+		// Runs character database queries on a fixed set of worker threads, each holding its own connection
+		// Handlers post a query and pick the result up either from a future or from a callback that runs on the dispatch strand
+		class database_executor {
+			NONCOPYABLE(database_executor);
+			NO_DEFAULT_CONSTRUCTOR(database_executor);
+		public:
+			database_executor(connection_manager &manager, uint16_t connection_count);
+			~database_executor();
+
+			// The future rethrows whatever the query threw
+			template <typename TResult>
+			auto post(const string &query_name, function<TResult(database &)> query) -> std::future<TResult>;
+			// The callback is skipped (and the error logged) if the query throws
+			template <typename TResult>
+			auto post(const string &query_name, function<TResult(database &)> query, function<void(TResult)> callback) -> void;
+			// Same as above, but failed runs on the dispatch strand instead when the query throws
+			template <typename TResult>
+			auto post(const string &query_name, function<TResult(database &)> query, function<void(TResult)> callback, function<void()> failed) -> void;
+			auto execute(const string &query_name, function<void(database &)> query) -> void;
+			// The callback runs on the dispatch strand with whether the query succeeded
+			auto execute(const string &query_name, function<void(database &)> query, function<void(bool)> callback) -> void;
+
+			auto get_connection_count() const -> uint16_t;
+			auto get_pending_count() -> size_t;
+			auto for_each_latency(function<void(const string &, const vana::util::latency_histogram &)> func) -> void;
+		private:
+			struct task {
+				string name;
+				function<void(database &)> work;
+			};
+
+			auto enqueue(const string &query_name, function<void(database &)> work) -> void;
+			auto dispatch(function<void()> func) -> void;
+			auto run(owned_lock<recursive_mutex> &lock) -> void;
+			auto get_latency(const string &query_name) -> vana::util::latency_histogram &;
+
+			uint16_t m_connection_count = 0;
+			connection_manager &m_manager;
+			queue<task> m_tasks;
+			std::condition_variable_any m_work_condition;
+			recursive_mutex m_tasks_mutex;
+			mutex m_latency_mutex;
+			hash_map<string, owned_ptr<vana::util::latency_histogram>> m_latency;
+			vector<ref_ptr<std::thread>> m_threads;
+		};
+
+		template <typename TResult>
+		auto database_executor::post(const string &query_name, function<TResult(database &)> query) -> std::future<TResult> {
+			auto promise = make_ref_ptr<std::promise<TResult>>();
+			std::future<TResult> future = promise->get_future();
+			enqueue(query_name, [promise, query](database &db) {
+				try {
+					promise->set_value(query(db));
+				}
+				catch (...) {
+					promise->set_exception(std::current_exception());
+				}
+			});
+			return future;
+		}
+
+		template <typename TResult>
+		auto database_executor::post(const string &query_name, function<TResult(database &)> query, function<void(TResult)> callback) -> void {
+			post<TResult>(query_name, std::move(query), std::move(callback), nullptr);
+		}
+
+		template <typename TResult>
+		auto database_executor::post(const string &query_name, function<TResult(database &)> query, function<void(TResult)> callback, function<void()> failed) -> void {
+			enqueue(query_name, [this, query, callback, failed](database &db) {
+				try {
+					TResult result = query(db);
+					dispatch([callback, result] {
+						callback(result);
+					});
+				}
+				catch (...) {
+					if (failed) {
+						dispatch(failed);
+					}
+					// Logged by the worker
+					throw;
+				}
+			});
+		}
+	}
+}
@@ -0,0 +1,131 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/io/write_behind.hpp"
+#include "common/types.hpp"
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace vana {
+	namespace io {
+		// Remembers the rows last handed to the database so a save only writes what changed since
+		// If a batch fails to commit, the next save is compared against what actually committed instead
+		// TRow must be equality comparable
+		template <typename TKey, typename TRow>
+		class row_tracker {
+		public:
+			using rows = ord_map<TKey, TRow>;
+
+			struct changes {
+				auto empty() const -> bool { return upserts.empty() && deletes.empty(); }
+
+				vector<pair<TKey, TRow>> upserts;
+				vector<TKey> deletes;
+			};
+
+			row_tracker();
+			auto reset(rows current) -> void;
+			// The changes must be written as part of the batch
+			auto diff(rows current, write_behind::batch &batch) -> changes;
+		private:
+			// Batches report back on the write-behind thread, possibly after the owner is gone
+			struct state {
+				mutex lock;
+				rows queued;
+				rows committed;
+			};
+
+			static auto apply(rows &target, const changes &changes) -> void;
+
+			ref_ptr<state> m_state;
+		};
+
+		template <typename TKey, typename TRow>
+		row_tracker<TKey, TRow>::row_tracker() :
+			m_state{make_ref_ptr<state>()}
+		{
+		}
+
+		template <typename TKey, typename TRow>
+		auto row_tracker<TKey, TRow>::reset(rows current) -> void {
+			owned_lock<mutex> l{m_state->lock};
+			m_state->queued = current;
+			m_state->committed = std::move(current);
+		}
+
+		template <typename TKey, typename TRow>
+		auto row_tracker<TKey, TRow>::diff(rows current, write_behind::batch &batch) -> changes {
+			changes result;
+			owned_lock<mutex> l{m_state->lock};
+			rows &persisted = m_state->queued;
+
+			// Both sides are ordered, a single merge pass finds every change
+			auto old_iter = std::begin(persisted);
+			auto new_iter = std::begin(current);
+			while (old_iter != std::end(persisted) || new_iter != std::end(current)) {
+				if (new_iter == std::end(current) || (old_iter != std::end(persisted) && old_iter->first < new_iter->first)) {
+					result.deletes.push_back(old_iter->first);
+					++old_iter;
+				}
+				else if (old_iter == std::end(persisted) || new_iter->first < old_iter->first) {
+					result.upserts.push_back(*new_iter);
+					++new_iter;
+				}
+				else {
+					if (!(old_iter->second == new_iter->second)) {
+						result.upserts.push_back(*new_iter);
+					}
+					++old_iter;
+					++new_iter;
+				}
+			}
+
+			persisted = std::move(current);
+			l.unlock();
+
+			if (!result.empty()) {
+				ref_ptr<state> tracked = m_state;
+				batch.on_complete([tracked, result](bool committed) {
+					owned_lock<mutex> l{tracked->lock};
+					if (committed) {
+						apply(tracked->committed, result);
+					}
+					else {
+						// Rows are written whole, so whatever the failed batch and anything queued after it held is simply sent again
+						tracked->queued = tracked->committed;
+					}
+				});
+			}
+			return result;
+		}
+
+		template <typename TKey, typename TRow>
+		auto row_tracker<TKey, TRow>::apply(rows &target, const changes &changes) -> void {
+			for (const auto &key : changes.deletes) {
+				target.erase(key);
+			}
+			for (const auto &kvp : changes.upserts) {
+				target.erase(kvp.first);
+				target.emplace(kvp.first, kvp.second);
+			}
+		}
+	}
+}
@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "write_behind.hpp"
+#include "common/abstract_server.hpp"
+#include "common/io/database.hpp"
+#include "common/util/thread_pool.hpp"
+#include <functional>
+#include <utility>
+
+namespace vana {
+namespace io {
+
+auto write_behind::batch::add(work work) -> void {
+	m_work.push_back(std::move(work));
+}
+
+auto write_behind::batch::on_complete(function<void(bool)> callback) -> void {
+	m_callbacks.push_back(std::move(callback));
+}
+
+auto write_behind::batch::empty() const -> bool {
+	return m_work.empty();
+}
+
+write_behind::write_behind(abstract_server *server) :
+	m_server{server}
+{
+	m_thread = vana::util::thread_pool::lease(
+		[this](owned_lock<recursive_mutex> &lock) {
+			run(lock);
+		},
+		[this] {
+			owned_lock<recursive_mutex> l{m_mutex};
+			m_work_condition.notify_one();
+		},
+		m_mutex);
+}
+
+write_behind::~write_behind() {
+	m_thread.reset();
+	// Anything submitted after the thread stopped is still written
+	owned_lock<recursive_mutex> l{m_mutex};
+	if (!m_pending.empty()) {
+		drain(l);
+	}
+}
+
+auto write_behind::submit(batch &&batch) -> ticket {
+	owned_lock<recursive_mutex> l{m_mutex};
+	if (batch.empty()) {
+		return m_submitted;
+	}
+
+	m_submitted++;
+	m_pending.emplace_back(m_submitted, std::move(batch));
+	m_work_condition.notify_one();
+	return m_submitted;
+}
+
+auto write_behind::wait(ticket ticket) -> void {
+	owned_lock<recursive_mutex> l{m_mutex};
+	m_completed_condition.wait(l, [&] { return m_completed >= ticket; });
+}
+
+auto write_behind::on_completed(ticket ticket, function<void()> callback) -> void {
+	{
+		owned_lock<recursive_mutex> l{m_mutex};
+		if (m_completed < ticket) {
+			m_completion_callbacks.emplace_back(ticket, std::move(callback));
+			return;
+		}
+	}
+	callback();
+}
+
+auto write_behind::flush() -> void {
+	ticket last;
+	{
+		owned_lock<recursive_mutex> l{m_mutex};
+		last = m_submitted;
+	}
+	wait(last);
+}
+
+auto write_behind::get_pending_count() -> size_t {
+	owned_lock<recursive_mutex> l{m_mutex};
+	return static_cast<size_t>(m_submitted - m_completed);
+}
+
+auto write_behind::run(owned_lock<recursive_mutex> &lock) -> void {
+	if (m_pending.empty()) {
+		m_work_condition.wait(lock);
+		return;
+	}
+
+	drain(lock);
+}
+
+auto write_behind::drain(owned_lock<recursive_mutex> &lock) -> void {
+	// Everything queued so far is taken at once so shutdown drains the queue before the thread exits
+	queue<pair<ticket, batch>> work;
+	work.swap(m_pending);
+	lock.unlock();
+
+	for (auto &entry : work) {
+		execute(entry.first, entry.second);
+	}
+
+	lock.lock();
+	m_completed = work.back().first;
+	m_completed_condition.notify_all();
+
+	vector<function<void()>> ready;
+	for (auto iter = std::begin(m_completion_callbacks); iter != std::end(m_completion_callbacks); ) {
+		if (iter->first <= m_completed) {
+			ready.push_back(std::move(iter->second));
+			iter = m_completion_callbacks.erase(iter);
+		}
+		else {
+			++iter;
+		}
+	}
+	if (ready.empty()) {
+		return;
+	}
+
+	// Callbacks may submit more work, so they run unlocked
+	lock.unlock();
+	for (const auto &callback : ready) {
+		callback();
+	}
+	lock.lock();
+}
+
+auto write_behind::execute(ticket ticket, batch &batch) -> void {
+	bool committed = false;
+	try {
+		auto &db = database::get_char_db();
+		soci::transaction transaction{db.get_session()};
+		for (const auto &work : batch.m_work) {
+			work(db);
+		}
+		transaction.commit();
+		committed = true;
+	}
+	catch (std::exception &e) {
+		m_server->log(vana::log::type::error, [&](out_stream &str) {
+			str << "Write-behind batch " << ticket << " failed: " << e.what();
+		});
+	}
+
+	for (const auto &callback : batch.m_callbacks) {
+		callback(committed);
+	}
+}
+
+}
+}
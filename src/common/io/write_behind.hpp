@@ -0,0 +1,80 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vana {
+	class abstract_server;
+
+	namespace io {
+		class database;
+
+		// Runs queued database writes in submission order on a dedicated thread with its own connection
+		// Each batch is committed in a single transaction
+		class write_behind {
+			NONCOPYABLE(write_behind);
+			NO_DEFAULT_CONSTRUCTOR(write_behind);
+		public:
+			using work = function<void(database &)>;
+			using ticket = uint64_t;
+
+			class batch {
+			public:
+				auto add(work work) -> void;
+				// Called on the write-behind thread once the batch has committed (true) or rolled back (false)
+				auto on_complete(function<void(bool)> callback) -> void;
+				auto empty() const -> bool;
+			private:
+				friend class write_behind;
+
+				vector<work> m_work;
+				vector<function<void(bool)>> m_callbacks;
+			};
+
+			write_behind(abstract_server *server);
+			~write_behind();
+
+			auto submit(batch &&batch) -> ticket;
+			auto wait(ticket ticket) -> void;
+			// Runs the callback on the write-behind thread once the ticket is written, or right away if it already was
+			auto on_completed(ticket ticket, function<void()> callback) -> void;
+			auto flush() -> void;
+			auto get_pending_count() -> size_t;
+		private:
+			auto run(owned_lock<recursive_mutex> &lock) -> void;
+			auto drain(owned_lock<recursive_mutex> &lock) -> void;
+			auto execute(ticket ticket, batch &batch) -> void;
+
+			ticket m_submitted = 0;
+			ticket m_completed = 0;
+			queue<pair<ticket, batch>> m_pending;
+			vector<pair<ticket, function<void()>>> m_completion_callbacks;
+			std::condition_variable_any m_work_condition;
+			std::condition_variable_any m_completed_condition;
+			recursive_mutex m_mutex;
+			abstract_server *m_server = nullptr;
+			ref_ptr<std::thread> m_thread;
+		};
+	}
+}
@@ -75,6 +75,34 @@ item::item(item *item)
 	m_expiration = item->get_expiration_time();
 }
 
+auto item::operator ==(const item &other) const -> bool {
+	return
+		m_id == other.m_id &&
+		m_amount == other.m_amount &&
+		m_hammers == other.m_hammers &&
+		m_slots == other.m_slots &&
+		m_scrolls == other.m_scrolls &&
+		m_str == other.m_str &&
+		m_dex == other.m_dex &&
+		m_int == other.m_int &&
+		m_luk == other.m_luk &&
+		m_hp == other.m_hp &&
+		m_mp == other.m_mp &&
+		m_watk == other.m_watk &&
+		m_matk == other.m_matk &&
+		m_wdef == other.m_wdef &&
+		m_mdef == other.m_mdef &&
+		m_accuracy == other.m_accuracy &&
+		m_avoid == other.m_avoid &&
+		m_hands == other.m_hands &&
+		m_jump == other.m_jump &&
+		m_speed == other.m_speed &&
+		m_pet_id == other.m_pet_id &&
+		m_name == other.m_name &&
+		m_flags == other.m_flags &&
+		m_expiration == other.m_expiration;
+}
+
 auto item::has_slip_prevention() const -> bool {
 	return test_flags(constant::item::flag::spikes);
 }
@@ -331,7 +359,7 @@ auto item::database_insert(vana::io::database &db, const item_db_info &info) ->
 	item::database_insert(db, v);
 }
 
-auto item::database_insert(vana::io::database &db, const vector<item_db_record> &items) -> void {
+auto item::database_insert(vana::io::database &db, const vector<item_db_record> &items, bool replace) -> void {
 	using namespace soci;
 	auto &sql = db.get_session();
 	using vana::util::misc::get_optional;
@@ -380,7 +408,7 @@ auto item::database_insert(vana::io::database &db, const vector<item_db_record>
 	opt_string name;
 
 	statement st = (sql.prepare
-		<< "INSERT INTO " << db.make_table(vana::table::items) << " (character_id, inv, slot, location, account_id, world_id, item_id, amount, slots, scrolls, istr, idex, iint, iluk, ihp, imp, iwatk, imatk, iwdef, imdef, iacc, iavo, ihand, ispeed, ijump, flags, hammers, pet_id, name, expiration) "
+		<< (replace ? "REPLACE" : "INSERT") << " INTO " << db.make_table(vana::table::items) << " (character_id, inv, slot, location, account_id, world_id, item_id, amount, slots, scrolls, istr, idex, iint, iluk, ihp, imp, iwatk, imatk, iwdef, imdef, iacc, iavo, ihand, ispeed, ijump, flags, hammers, pet_id, name, expiration) "
 		<< "VALUES (:char, :inv, :slot, :location, :account, :world, :item_id, :amount, :slots, :scrolls, :str, :dex, :int, :luk, :hp, :mp, :watk, :matk, :wdef, :mdef, :acc, :avo, :hands, :speed, :jump, :flags, :hammers, :pet, :name, :expiration)",
 		use(player_id, "char"),
 		use(inventory, "inv"),
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/file_time.hpp"
+#include "common/i_packet.hpp"
 #include "common/constant/item.hpp"
 #include "common/item_db_information.hpp"
 #include "common/item_db_record.hpp"
@@ -45,6 +46,8 @@ namespace vana {
 		item(const data::provider::equip &provider, game_item_id equip_id, stat_variance policy, bool is_gm);
 		item(item *item);
 
+		auto operator ==(const item &other) const -> bool;
+
 		auto has_warm_support() const -> bool;
 		auto has_slip_prevention() const -> bool;
 		auto has_lock() const -> bool;
@@ -124,11 +127,13 @@ namespace vana {
 		auto dec_slots(int8_t dec = 1) -> void { m_slots -= dec; }
 		auto inc_scrolls() -> void { m_scrolls++; }
 
-		static auto database_insert(vana::io::database &db, const vector<item_db_record> &items) -> void;
+		static auto database_insert(vana::io::database &db, const vector<item_db_record> &items, bool replace = false) -> void;
 
 		const static string inventory;
 		const static string storage;
 	private:
+		friend struct packet_serialize<item>;
+
 		auto test_stat(int16_t stat, int16_t max) -> int16_t;
 		auto modify_flags(bool add, int16_t flags) -> void;
 		auto test_flags(int16_t flags) const -> bool;
@@ -159,4 +164,62 @@ namespace vana {
 		file_time m_expiration = constant::item::no_expiration;
 		string m_name;
 	};
+
+	template <>
+	struct packet_serialize<item> {
+		auto read(packet_reader &reader) -> item {
+			item ret;
+			ret.m_id = reader.get<game_item_id>();
+			ret.m_amount = reader.get<game_slot_qty>();
+			ret.m_slots = reader.get<int8_t>();
+			ret.m_scrolls = reader.get<int8_t>();
+			ret.m_str = reader.get<game_stat>();
+			ret.m_dex = reader.get<game_stat>();
+			ret.m_int = reader.get<game_stat>();
+			ret.m_luk = reader.get<game_stat>();
+			ret.m_hp = reader.get<game_health>();
+			ret.m_mp = reader.get<game_health>();
+			ret.m_watk = reader.get<game_stat>();
+			ret.m_matk = reader.get<game_stat>();
+			ret.m_wdef = reader.get<game_stat>();
+			ret.m_mdef = reader.get<game_stat>();
+			ret.m_accuracy = reader.get<game_stat>();
+			ret.m_avoid = reader.get<game_stat>();
+			ret.m_hands = reader.get<game_stat>();
+			ret.m_jump = reader.get<game_stat>();
+			ret.m_speed = reader.get<game_stat>();
+			ret.m_flags = reader.get<int16_t>();
+			ret.m_hammers = reader.get<int32_t>();
+			ret.m_pet_id = reader.get<game_pet_id>();
+			ret.m_expiration = reader.get<file_time>();
+			ret.m_name = reader.get<string>();
+			return ret;
+		}
+		auto write(packet_builder &builder, const item &obj) -> void {
+			builder.add<game_item_id>(obj.m_id);
+			builder.add<game_slot_qty>(obj.m_amount);
+			builder.add<int8_t>(obj.m_slots);
+			builder.add<int8_t>(obj.m_scrolls);
+			builder.add<game_stat>(obj.m_str);
+			builder.add<game_stat>(obj.m_dex);
+			builder.add<game_stat>(obj.m_int);
+			builder.add<game_stat>(obj.m_luk);
+			builder.add<game_health>(obj.m_hp);
+			builder.add<game_health>(obj.m_mp);
+			builder.add<game_stat>(obj.m_watk);
+			builder.add<game_stat>(obj.m_matk);
+			builder.add<game_stat>(obj.m_wdef);
+			builder.add<game_stat>(obj.m_mdef);
+			builder.add<game_stat>(obj.m_accuracy);
+			builder.add<game_stat>(obj.m_avoid);
+			builder.add<game_stat>(obj.m_hands);
+			builder.add<game_stat>(obj.m_jump);
+			builder.add<game_stat>(obj.m_speed);
+			builder.add<int16_t>(obj.m_flags);
+			builder.add<int32_t>(obj.m_hammers);
+			builder.add<game_pet_id>(obj.m_pet_id);
+			builder.add<file_time>(obj.m_expiration);
+			builder.add<string>(obj.m_name);
+		}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "async_logger.hpp"
+#include "common/util/thread_pool.hpp"
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+namespace vana {
+namespace log {
+
+async_logger::async_logger(owned_ptr<base_logger> sink) :
+	m_sink{std::move(sink)}
+{
+	m_thread = vana::util::thread_pool::lease(
+		[this] {
+			run();
+		},
+		[this] {
+			std::unique_lock<std::mutex> l{m_mutex};
+			m_condition.notify_one();
+		});
+}
+
+async_logger::~async_logger() {
+	m_thread.reset();
+	// Anything logged after the writer stopped is still written
+	drain();
+	m_sink->flush();
+}
+
+auto async_logger::log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void {
+	entry item;
+	item.type = type;
+	item.time = time;
+	item.identifier = identifier;
+	item.message = message;
+	m_queue.push(std::move(item));
+	m_condition.notify_one();
+}
+
+auto async_logger::run() -> void {
+	try {
+		if (drain()) {
+			m_sink->flush();
+			return;
+		}
+	}
+	catch (std::exception &e) {
+		// The sink can't be trusted to report its own failure
+		std::cerr << "Log writer failed: " << e.what() << std::endl;
+	}
+
+	// The notify in log() is sent without the mutex, so the timeout covers a wakeup that lands before the wait
+	std::unique_lock<std::mutex> l{m_mutex};
+	m_condition.wait_for(l, std::chrono::milliseconds{100});
+}
+
+auto async_logger::drain() -> bool {
+	bool wrote = false;
+	entry item;
+	while (m_queue.try_pop(item)) {
+		m_sink->log(item.type, item.time, item.identifier, item.message);
+		wrote = true;
+	}
+	return wrote;
+}
+
+}
+}
@@ -0,0 +1,58 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/log/base_logger.hpp"
+#include "common/types.hpp"
+#include "common/util/mpsc_queue.hpp"
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace vana {
+	namespace log {
+		// Hands messages to a background writer so callers never format, touch files, or wait on the database
+		class async_logger : public base_logger {
+			NONCOPYABLE(async_logger);
+			NO_DEFAULT_CONSTRUCTOR(async_logger);
+		public:
+			async_logger(owned_ptr<base_logger> sink);
+			~async_logger();
+
+			auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void override;
+		private:
+			struct entry {
+				vana::log::type type = vana::log::type::info;
+				time_t time = 0;
+				opt_string identifier;
+				string message;
+			};
+
+			auto run() -> void;
+			auto drain() -> bool;
+
+			owned_ptr<base_logger> m_sink;
+			vana::util::mpsc_queue<entry> m_queue;
+			std::condition_variable m_condition;
+			std::mutex m_mutex;
+			ref_ptr<std::thread> m_thread;
+		};
+	}
+}
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "base_logger.hpp"
 #include "common/server_type.hpp"
 #include "common/util/time.hpp"
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -29,29 +30,72 @@ namespace log {
 base_logger::base_logger(const string &filename, const string &format, const string &time_format, server_type type, size_t buffer_size) :
 	m_format{format},
 	m_time_format{time_format},
+	m_format_program{compile_format(format)},
+	m_time_format_program{compile_format(time_format)},
 	m_server_type{type}
 {
 }
 
-auto base_logger::format_log(const string &format, vana::log::type type, base_logger *logger, const opt_string &id, const string &message) -> string {
-	return format_log(format, type, logger, time(nullptr), id, message);
+auto base_logger::get_replacements() -> const log_replacements & {
+	static log_replacements replacements;
+	return replacements;
+}
+
+auto base_logger::compile_format(const string &format) -> format_program {
+	const auto &replacements = get_replacements().m_replacements;
+	format_program program;
+	string literal;
+
+	size_t i = 0;
+	while (i < format.size()) {
+		const replacement *match = nullptr;
+		size_t match_size = 0;
+		if (format[i] == '%') {
+			for (const auto &kvp : replacements) {
+				if (format.compare(i, kvp.first.size(), kvp.first) == 0) {
+					match = &kvp.second;
+					match_size = kvp.first.size();
+					break;
+				}
+			}
+		}
+
+		if (match == nullptr) {
+			literal += format[i];
+			i++;
+			continue;
+		}
+
+		format_segment segment;
+		segment.literal = std::move(literal);
+		segment.replace = match;
+		program.push_back(std::move(segment));
+		literal.clear();
+		i += match_size;
+	}
+
+	if (!literal.empty()) {
+		format_segment segment;
+		segment.literal = std::move(literal);
+		program.push_back(std::move(segment));
+	}
+	return program;
 }
 
-auto base_logger::format_log(const string &format, vana::log::type type, base_logger *logger, time_t time, const opt_string &id, const string &message) -> string {
-	string ret = format;
+auto base_logger::format_log(const format_program &program, vana::log::type type, base_logger *logger, time_t time, const opt_string &id, const string &message) -> string {
+	out_stream stream;
 	replacement_args args{type, logger, time, id, message};
-	static log_replacements replacements;
+	format_log(stream, program, args);
+	return stream.str();
+}
 
-	for (const auto &kvp : replacements.m_replacements) {
-		size_t x = ret.find(kvp.first);
-		if (x != string::npos) {
-			out_stream strm;
-			kvp.second(strm, args);
-			const string &y = strm.str();
-			ret.replace(x, kvp.first.size(), y.c_str(), y.size());
+auto base_logger::format_log(out_stream &stream, const format_program &program, const replacement_args &args) -> void {
+	for (const auto &segment : program) {
+		stream << segment.literal;
+		if (segment.replace != nullptr) {
+			(*segment.replace)(stream, args);
 		}
 	}
-	return ret;
 }
 
 base_logger::replacement_args::replacement_args(vana::log::type type, base_logger *logger, time_t time, const opt_string &id, const string &msg) :
@@ -139,7 +183,7 @@ base_logger::log_replacements::log_replacements() {
 		}
 	});
 	add("%t", [](out_stream &stream, const replacement_args &args) {
-		stream << base_logger::format_log(args.logger->get_time_format(), args.type, args.logger, args.time, args.id, args.msg);
+		base_logger::format_log(stream, args.logger->m_time_format_program, args);
 	});
 	add("%e", [](out_stream &stream, const replacement_args &args) {
 		stream << get_level_string(args.type);
@@ -152,8 +196,11 @@ base_logger::log_replacements::log_replacements() {
 	});
 }
 
-auto base_logger::log_replacements::add(const string &key, func func) -> void {
-	m_replacements.emplace(key, func);
+auto base_logger::log_replacements::add(const string &key, replacement func) -> void {
+	auto position = std::find_if(std::begin(m_replacements), std::end(m_replacements), [&key](const pair<string, replacement> &existing) {
+		return existing.first.size() < key.size();
+	});
+	m_replacements.emplace(position, key, func);
 }
 
 auto base_logger::log_replacements::get_level_string(vana::log::type type) -> string {
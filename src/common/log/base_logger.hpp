@@ -22,27 +22,43 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/log/type.hpp"
 #include "common/server_type.hpp"
 #include "common/types.hpp"
+#include <ctime>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace vana {
 	namespace log {
 		class base_logger {
+		private:
+			struct replacement_args;
+			using replacement = function<void(out_stream &, const replacement_args &args)>;
 		public:
 			base_logger(const string &filename, const string &format, const string &time_format, server_type type, size_t buffer_size = 10);
 			virtual ~base_logger() = default;
-			virtual auto log(vana::log::type type, const opt_string &identifier, const string &message) -> void { }
+			virtual auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void { }
+			virtual auto flush() -> void { }
 
 			auto get_server_type() const -> server_type { return m_server_type; }
 			auto get_format() const -> const string & { return m_format; }
 			auto get_time_format() const -> const string & { return m_time_format; }
 		protected:
+			// Formats are split into literals and replacements once, so logging doesn't have to search the string for every key
+			struct format_segment {
+				string literal;
+				const replacement *replace = nullptr;
+			};
+			using format_program = vector<format_segment>;
+
 			base_logger() = default;
-			static auto format_log(const string &format, vana::log::type type, base_logger *logger, const opt_string &id, const string &message) -> string;
-			static auto format_log(const string &format, vana::log::type type, base_logger *logger, time_t time, const opt_string &id, const string &message) -> string;
+			static auto compile_format(const string &format) -> format_program;
+			static auto format_log(const format_program &program, vana::log::type type, base_logger *logger, time_t time, const opt_string &id, const string &message) -> string;
+			auto get_format_program() const -> const format_program & { return m_format_program; }
 		private:
 			friend struct log_replacements;
 
+			static auto format_log(out_stream &stream, const format_program &program, const replacement_args &args) -> void;
+
 			struct replacement_args {
 				vana::log::type type;
 				base_logger *logger;
@@ -54,16 +70,20 @@ namespace vana {
 
 			struct log_replacements {
 				log_replacements();
-				using func = function<void(out_stream &, const replacement_args &args)>;
-				auto add(const string &key, func func) -> void;
+				auto add(const string &key, replacement func) -> void;
 				static auto get_level_string(vana::log::type type) -> string;
 				static auto get_server_type_string(server_type type) -> string;
 
-				hash_map<string, func> m_replacements;
+				// Longest key first so a key is never shadowed by a shorter one sharing its prefix
+				vector<pair<string, replacement>> m_replacements;
 			};
 
+			static auto get_replacements() -> const log_replacements &;
+
 			string m_format;
 			string m_time_format;
+			format_program m_format_program;
+			format_program m_time_format_program;
 			server_type m_server_type;
 		};
 	}
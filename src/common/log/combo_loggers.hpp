@@ -32,9 +32,14 @@ namespace vana {
 				m_logger2 = make_owned_ptr<TLogger2>(filename, format, time_format, type, buffer_size);
 			}
 
-			auto log(vana::log::type type, const opt_string &identifier, const string &message) -> void override {
-				get_logger1()->log(type, identifier, message);
-				get_logger2()->log(type, identifier, message);
+			auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void override {
+				get_logger1()->log(type, time, identifier, message);
+				get_logger2()->log(type, time, identifier, message);
+			}
+
+			auto flush() -> void override {
+				get_logger1()->flush();
+				get_logger2()->flush();
 			}
 		private:
 			auto get_logger1() const -> TLogger1 * { return m_logger1.get(); }
@@ -52,10 +57,16 @@ namespace vana {
 				m_logger3 = make_owned_ptr<TLogger3>(filename, format, time_format, type, buffer_size);
 			}
 
-			auto log(vana::log::type type, const opt_string &identifier, const string &message) -> void override {
-				get_logger1()->log(type, identifier, message);
-				get_logger2()->log(type, identifier, message);
-				get_logger3()->log(type, identifier, message);
+			auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void override {
+				get_logger1()->log(type, time, identifier, message);
+				get_logger2()->log(type, time, identifier, message);
+				get_logger3()->log(type, time, identifier, message);
+			}
+
+			auto flush() -> void override {
+				get_logger1()->flush();
+				get_logger2()->flush();
+				get_logger3()->flush();
 			}
 		private:
 			auto get_logger1() const -> TLogger1 * { return m_logger1.get(); }
@@ -28,7 +28,7 @@ console_logger::console_logger(const string &filename, const string &format, con
 {
 }
 
-auto console_logger::log(vana::log::type type, const opt_string &identifier, const string &message) -> void {
+auto console_logger::log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void {
 	switch (type) {
 		case vana::log::type::critical_error:
 		case vana::log::type::debug_error:
@@ -36,10 +36,10 @@ auto console_logger::log(vana::log::type type, const opt_string &identifier, con
 		case vana::log::type::server_auth_failure:
 		case vana::log::type::warning:
 		case vana::log::type::malformed_packet:
-			std::cerr << base_logger::format_log(get_format(), type, this, identifier, message) << std::endl;
+			std::cerr << base_logger::format_log(get_format_program(), type, this, time, identifier, message) << std::endl;
 			break;
 		default:
-			std::cout << base_logger::format_log(get_format(), type, this, identifier, message) << std::endl;
+			std::cout << base_logger::format_log(get_format_program(), type, this, time, identifier, message) << std::endl;
 			break;
 	}
 }
@@ -27,7 +27,7 @@ namespace vana {
 		public:
 			console_logger(const string &filename, const string &format, const string &time_format, server_type type, size_t buffer_size = 10);
 
-			auto log(vana::log::type type, const opt_string &identifier, const string &message) -> void override;
+			auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void override;
 		};
 	}
 }
\ No newline at end of file
@@ -22,7 +22,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #else
 #include <boost/filesystem.hpp>
 #endif
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -38,38 +37,45 @@ namespace fs = boost::filesystem;
 
 file_logger::file_logger(const string &filename, const string &format, const string &time_format, server_type type, size_t buffer_size) :
 	base_logger{filename, format, time_format, type, buffer_size},
-	m_buffer_size{buffer_size},
-	m_filename_format{filename}
+	m_filename_format{filename},
+	m_filename_program{compile_format(filename)}
 {
-	m_buffer.reserve(buffer_size);
 }
 
 file_logger::~file_logger() {
 	flush();
 }
 
-auto file_logger::log(vana::log::type type, const opt_string &identifier, const string &message) -> void {
-	file_log file;
-	file.message = base_logger::format_log(get_format(), type, this, identifier, message);
-	file.file = base_logger::format_log(get_filename_format(), type, this, identifier, message);
-	m_buffer.push_back(file);
-	if (m_buffer.size() >= m_buffer_size) {
-		flush();
+auto file_logger::log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void {
+	string file = base_logger::format_log(m_filename_program, type, this, time, identifier, message);
+	if (file != m_current_file || !m_stream.is_open()) {
+		open(file);
 	}
+	m_stream << base_logger::format_log(get_format_program(), type, this, time, identifier, message) << '\n';
 }
 
 auto file_logger::flush() -> void {
-	for (const auto &buffered_message : m_buffer) {
-		const string &file = buffered_message.file;
-		fs::path fullPath = fs::system_complete(fs::path{file.substr(0, file.find_last_of("/"))});
-		if (!fs::exists(fullPath)) {
-			fs::create_directories(fullPath);
+	if (m_stream.is_open()) {
+		m_stream.flush();
+	}
+}
+
+auto file_logger::open(const string &file) -> void {
+	if (m_stream.is_open()) {
+		m_stream.close();
+	}
+	m_stream.clear();
+
+	size_t separator = file.find_last_of("/");
+	if (separator != string::npos) {
+		fs::path full_path = fs::system_complete(fs::path{file.substr(0, separator)});
+		if (!fs::exists(full_path)) {
+			fs::create_directories(full_path);
 		}
-		std::fstream f{file, std::ios_base::out};
-		f << buffered_message.message;
-		f.close();
 	}
-	m_buffer.clear();
+
+	m_stream.open(file, std::ios_base::out | std::ios_base::app);
+	m_current_file = file;
 }
 
 }
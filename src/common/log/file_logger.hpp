@@ -18,28 +18,26 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/log/base_logger.hpp"
+#include <fstream>
 #include <string>
-#include <vector>
 
 namespace vana {
 	namespace log {
-		struct file_log {
-			string message;
-			string file;
-		};
-
 		class file_logger : public base_logger {
 		public:
 			file_logger(const string &filename, const string &format, const string &time_format, server_type type, size_t buffer_size = 10);
 			~file_logger();
 
-			auto log(vana::log::type type, const opt_string &identifier, const string &message) -> void override;
-			auto flush() -> void;
+			auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void override;
+			auto flush() -> void override;
 			auto get_filename_format() const -> const string & { return m_filename_format; }
 		private:
+			auto open(const string &file) -> void;
+
 			string m_filename_format;
-			size_t m_buffer_size;
-			vector<file_log> m_buffer;
+			format_program m_filename_program;
+			string m_current_file;
+			std::ofstream m_stream;
 		};
 	}
 }
\ No newline at end of file
@@ -17,6 +17,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #include "sql_logger.hpp"
 #include "common/io/database.hpp"
+#include "common/unix_time.hpp"
+#include <algorithm>
 
 namespace vana {
 namespace log {
@@ -32,11 +34,11 @@ sql_logger::~sql_logger() {
 	flush();
 }
 
-auto sql_logger::log(vana::log::type type, const opt_string &identifier, const string &message) -> void {
+auto sql_logger::log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void {
 	sql_log m;
 	m.type = type;
 	m.message = message;
-	m.time = time(nullptr);
+	m.time = time;
 	m.identifier = identifier;
 	m_buffer.push_back(m);
 	if (m_buffer.size() >= m_buffer_size) {
@@ -49,27 +51,38 @@ auto sql_logger::flush() -> void {
 		auto &db = vana::io::database::get_char_db();
 		auto &sql = db.get_session();
 		server_type_underlying type = static_cast<server_type_underlying>(get_server_type());
-		int32_t log_type = 0;
-		opt_string identifier;
-		// For GCC, GCC doesn't interpret operators very well
-		identifier = "";
-		string message = "";
-		unix_time log_time;
-
-		soci::statement st = (sql.prepare
-			<< "INSERT INTO " << db.make_table(vana::table::logs) << " (log_time, origin, info_type, identifier, message) "
-			<< "VALUES (:time, :origin, :info_type, :identifier, :message)",
-			soci::use(log_time, "time"),
-			soci::use(type, "origin"),
-			soci::use(log_type, "info_type"),
-			soci::use(identifier, "identifier"),
-			soci::use(message, "message"));
-
-		for (const auto &buffered_message : m_buffer) {
-			log_type = static_cast<int32_t>(buffered_message.type);
-			log_time = buffered_message.time;
-			identifier = buffered_message.identifier;
-			message = buffered_message.message;
+		size_t batch_size = std::max<size_t>(m_buffer_size, 1);
+
+		// One multi-row INSERT per batch instead of a round trip per message
+		for (size_t start = 0; start < m_buffer.size(); start += batch_size) {
+			size_t count = std::min(batch_size, m_buffer.size() - start);
+			vector<unix_time> log_times(count);
+			vector<int32_t> log_types(count);
+
+			out_stream query;
+			query << "INSERT INTO " << db.make_table(vana::table::logs) << " (log_time, origin, info_type, identifier, message) VALUES ";
+
+			soci::statement st{sql};
+			for (size_t i = 0; i < count; ++i) {
+				auto &buffered_message = m_buffer[start + i];
+				log_times[i] = buffered_message.time;
+				log_types[i] = static_cast<int32_t>(buffered_message.type);
+
+				if (i > 0) {
+					query << ", ";
+				}
+				query << "(:time" << i << ", :origin" << i << ", :info_type" << i << ", :identifier" << i << ", :message" << i << ")";
+
+				st.exchange(soci::use(log_times[i], "time" + std::to_string(i)));
+				st.exchange(soci::use(type, "origin" + std::to_string(i)));
+				st.exchange(soci::use(log_types[i], "info_type" + std::to_string(i)));
+				st.exchange(soci::use(buffered_message.identifier, "identifier" + std::to_string(i)));
+				st.exchange(soci::use(buffered_message.message, "message" + std::to_string(i)));
+			}
+
+			st.alloc();
+			st.prepare(query.str());
+			st.define_and_bind();
 			st.execute(true);
 		}
 
@@ -35,8 +35,8 @@ namespace vana {
 			sql_logger(const string &filename, const string &format, const string &time_format, server_type type, size_t buffer_size = 10);
 			~sql_logger();
 
-			auto log(vana::log::type type, const opt_string &identifier, const string &message) -> void override;
-			auto flush() -> void;
+			auto log(vana::log::type type, time_t time, const opt_string &identifier, const string &message) -> void override;
+			auto flush() -> void override;
 		private:
 			size_t m_buffer_size;
 			vector<sql_log> m_buffer;
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "lua_environment.hpp"
 #include "common/util/file.hpp"
 #include "common/util/string.hpp"
+#include <exception>
 #include <iostream>
 #include <stdexcept>
 
@@ -26,6 +27,18 @@ namespace lua {
 
 vana::util::object_pool<int32_t, lua_environment *> lua_environment::s_environments =
 	vana::util::object_pool<int32_t, lua_environment *>{1, 1000000};
+hash_map<string, vector<lua_State *>> lua_environment::s_idle_vms;
+hash_map<string, lua_environment::compiled_chunk> lua_environment::s_compiled_chunks;
+mutex lua_environment::s_cache_mutex;
+
+namespace {
+	const char *global_baseline_key = "vana_global_baseline";
+
+	auto append_bytecode(lua_State *lua_vm, const void *data, size_t size, void *bytecode) -> int {
+		static_cast<string *>(bytecode)->append(static_cast<const char *>(data), size);
+		return 0;
+	}
+}
 
 auto lua_environment::get_environment(lua_State *lua_vm) -> lua_environment & {
 	lua_getglobal(lua_vm, "system_environment_id");
@@ -37,15 +50,20 @@ auto lua_environment::get_environment(lua_State *lua_vm) -> lua_environment & {
 
 lua_environment::lua_environment(const string &filename)
 {
-	load_file(filename);
+	load_file(filename, "");
 
 	m_environment_id = s_environments.store(this);
 	set<int32_t>("system_environment_id", m_environment_id);
 }
 
-lua_environment::lua_environment(const string &filename, bool use_thread)
+lua_environment::lua_environment(const string &filename, bool use_thread) :
+	lua_environment{filename, use_thread, ""}
+{
+}
+
+lua_environment::lua_environment(const string &filename, bool use_thread, const string &pool_name)
 {
-	load_file(filename);
+	load_file(filename, pool_name);
 
 	m_environment_id = s_environments.store(this);
 	if (use_thread) {
@@ -56,11 +74,27 @@ lua_environment::lua_environment(const string &filename, bool use_thread)
 
 lua_environment::~lua_environment() {
 	s_environments.release(m_environment_id);
-	lua_close(m_lua_vm);
-	m_lua_vm = nullptr;
+
+	// A VM that never ran has no baseline, and one that is unwinding from an exception may be mid-call
+	if (!m_pool_name.empty() && !m_fresh_vm && !std::uncaught_exception()) {
+		restore_global_baseline();
+		lua_settop(m_lua_vm, 0);
+
+		owned_lock<mutex> l{s_cache_mutex};
+		auto &idle = s_idle_vms[m_pool_name];
+		if (idle.size() < max_idle_vms_per_pool) {
+			idle.push_back(m_lua_vm);
+			m_lua_vm = nullptr;
+		}
+	}
+
+	if (m_lua_vm != nullptr) {
+		lua_close(m_lua_vm);
+		m_lua_vm = nullptr;
+	}
 }
 
-auto lua_environment::load_file(const string &filename) -> void {
+auto lua_environment::load_file(const string &filename, const string &pool_name) -> void {
 	if (m_lua_vm != nullptr) {
 		throw std::runtime_error{"lua_vm was still specified"};
 	}
@@ -69,6 +103,18 @@ auto lua_environment::load_file(const string &filename) -> void {
 	}
 
 	m_file = filename;
+	m_pool_name = pool_name;
+	if (!pool_name.empty()) {
+		owned_lock<mutex> l{s_cache_mutex};
+		auto kvp = s_idle_vms.find(pool_name);
+		if (kvp != std::end(s_idle_vms) && !kvp->second.empty()) {
+			m_lua_vm = kvp->second.back();
+			kvp->second.pop_back();
+			m_fresh_vm = false;
+			return;
+		}
+	}
+
 	m_lua_vm = luaL_newstate();
 
 	require_standard_lib("base", luaopen_base);
@@ -81,15 +127,21 @@ auto lua_environment::load_file(const string &filename) -> void {
 }
 
 auto lua_environment::run() -> result {
+	if (!m_pool_name.empty() && m_fresh_vm) {
+		// Everything the constructors set up is what the VM gets reset to when it goes back to the pool
+		save_global_baseline();
+		m_fresh_vm = false;
+	}
+
 	if (m_lua_thread == nullptr) {
-		if (luaL_dofile(m_lua_vm, m_file.c_str())) {
+		if (load_chunk(m_lua_vm) || lua_pcall(m_lua_vm, 0, LUA_MULTRET, 0)) {
 			handle_error(m_file, get<string>(m_lua_vm, -1));
 			pop();
 			return result::failure;
 		}
 	}
 	else {
-		if (luaL_loadfile(m_lua_thread, m_file.c_str())) {
+		if (load_chunk(m_lua_thread)) {
 			handle_error(m_file, get<string>(m_lua_thread, -1));
 			pop();
 			return result::failure;
@@ -141,6 +193,83 @@ auto lua_environment::require_standard_lib(const string &local_name, lua::lua_fu
 	luaL_requiref(m_lua_vm, local_name.c_str(), func, 1);
 }
 
+auto lua_environment::needs_bindings() const -> bool {
+	return m_fresh_vm;
+}
+
+auto lua_environment::load_chunk(lua_State *lua_vm) -> int {
+	auto modified = vana::util::file::get_modified_time(m_file);
+	if (!modified.is_initialized()) {
+		return luaL_loadfile(lua_vm, m_file.c_str());
+	}
+
+	string chunk_name = "@" + m_file;
+	{
+		owned_lock<mutex> l{s_cache_mutex};
+		auto kvp = s_compiled_chunks.find(m_file);
+		if (kvp != std::end(s_compiled_chunks) && kvp->second.modified == modified.get()) {
+			const string &bytecode = kvp->second.bytecode;
+			return luaL_loadbuffer(lua_vm, bytecode.data(), bytecode.size(), chunk_name.c_str());
+		}
+	}
+
+	int status = luaL_loadfile(lua_vm, m_file.c_str());
+	if (status != LUA_OK) {
+		return status;
+	}
+
+	compiled_chunk chunk;
+	chunk.modified = modified.get();
+	lua_dump(lua_vm, &append_bytecode, &chunk.bytecode);
+
+	owned_lock<mutex> l{s_cache_mutex};
+	s_compiled_chunks[m_file] = std::move(chunk);
+	return status;
+}
+
+auto lua_environment::save_global_baseline() -> void {
+	// Shallow copy of the global table, stored in the registry
+	lua_newtable(m_lua_vm);
+	lua_pushglobaltable(m_lua_vm);
+	lua_pushnil(m_lua_vm);
+	while (lua_next(m_lua_vm, -2) != 0) {
+		lua_pushvalue(m_lua_vm, -2);
+		lua_insert(m_lua_vm, -2);
+		lua_rawset(m_lua_vm, -5);
+	}
+	lua_pop(m_lua_vm, 1);
+	lua_setfield(m_lua_vm, LUA_REGISTRYINDEX, global_baseline_key);
+}
+
+auto lua_environment::restore_global_baseline() -> void {
+	lua_getfield(m_lua_vm, LUA_REGISTRYINDEX, global_baseline_key);
+	lua_pushglobaltable(m_lua_vm);
+
+	// Clearing existing fields is the one modification lua_next tolerates mid-traversal
+	lua_pushnil(m_lua_vm);
+	while (lua_next(m_lua_vm, -2) != 0) {
+		lua_pop(m_lua_vm, 1);
+		lua_pushvalue(m_lua_vm, -1);
+		lua_rawget(m_lua_vm, -4);
+		bool added = lua_isnil(m_lua_vm, -1);
+		lua_pop(m_lua_vm, 1);
+		if (added) {
+			lua_pushvalue(m_lua_vm, -1);
+			lua_pushnil(m_lua_vm);
+			lua_rawset(m_lua_vm, -4);
+		}
+	}
+
+	lua_pushnil(m_lua_vm);
+	while (lua_next(m_lua_vm, -3) != 0) {
+		lua_pushvalue(m_lua_vm, -2);
+		lua_insert(m_lua_vm, -2);
+		lua_rawset(m_lua_vm, -4);
+	}
+
+	lua_pop(m_lua_vm, 2);
+}
+
 auto lua_environment::yield(lua::lua_return quantity_return_results_passed_to_resume) -> lua::lua_return {
 	return lua_yield(m_lua_thread, quantity_return_results_passed_to_resume);
 }
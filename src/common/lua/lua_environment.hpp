@@ -27,6 +27,8 @@ extern "C" {
 #include "common/lua/lua_variant.hpp"
 #include "common/types.hpp"
 #include "common/util/object_pool.hpp"
+#include <ctime>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -127,6 +129,9 @@ namespace vana {
 			auto call(lua_State *lua_vm, int quantity_return_results, const string &func, TArgs ... args) -> result;
 		protected:
 			lua_environment(const string &filename, bool use_thread);
+			// Environments constructed with a pool name borrow an idle VM of the same name when one is available
+			// Such a VM already has its bindings, so derived classes only need to expose/set constants when needs_bindings() is true
+			lua_environment(const string &filename, bool use_thread, const string &pool_name);
 
 			virtual auto handle_error(const string &filename, const string &error) -> void;
 			virtual auto handle_file_not_found(const string &filename) -> void;
@@ -136,11 +141,20 @@ namespace vana {
 			auto expose(const string &name, lua::lua_function func) -> void;
 			auto resume(lua::lua_return pushed_arg_count) -> result;
 			auto require_standard_lib(const string &local_name, lua::lua_function func) -> void;
+			auto needs_bindings() const -> bool;
 
 			template <typename T>
 			auto push_thread(const T &value) -> void;
 		private:
-			auto load_file(const string &filename) -> void;
+			struct compiled_chunk {
+				time_t modified;
+				string bytecode;
+			};
+
+			auto load_file(const string &filename, const string &pool_name) -> void;
+			auto load_chunk(lua_State *lua_vm) -> int;
+			auto save_global_baseline() -> void;
+			auto restore_global_baseline() -> void;
 			auto key_must_exist(const string &key) -> void;
 			template <typename THead, typename ... TTail>
 			auto call_impl(lua_State *lua_vm, const THead &arg, const TTail & ... rest) -> void;
@@ -271,11 +285,17 @@ namespace vana {
 			auto get_impl(lua_State *lua_vm, int index, ord_map<TKey, TElement, TOperation> *) -> ord_map<TKey, TElement, TOperation>;
 			// End get_impl index
 
+			static const size_t max_idle_vms_per_pool = 32;
 			static vana::util::object_pool<int32_t, lua_environment *> s_environments;
+			static hash_map<string, vector<lua_State *>> s_idle_vms;
+			static hash_map<string, compiled_chunk> s_compiled_chunks;
+			static mutex s_cache_mutex;
 
+			bool m_fresh_vm = true;
 			lua_State *m_lua_vm = nullptr;
 			lua_State *m_lua_thread = nullptr;
 			string m_file;
+			string m_pool_name;
 			int32_t m_environment_id;
 		};
 
@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/packet_reader.hpp"
 #include "common/split_packet_builder.hpp"
 #include "common/util/string.hpp"
+#include <algorithm>
 #include <cctype>
 #include <iomanip>
 #include <iostream>
@@ -27,11 +28,43 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 
 packet_builder::packet_builder() :
-	m_packet{new unsigned char[default_buffer_len]},
-	m_packet_capacity{default_buffer_len}
+	m_packet{default_buffer_len}
 {
 }
 
+packet_builder::packet_builder(const packet_builder &other) :
+	m_pos{other.m_pos},
+	m_packet{other.m_pos > default_buffer_len ? other.m_pos : default_buffer_len}
+{
+	memcpy(m_packet.get(), other.m_packet.get(), m_pos);
+}
+
+packet_builder::packet_builder(packet_builder &&other) :
+	m_pos{other.m_pos},
+	m_packet{std::move(other.m_packet)}
+{
+	// The buffer went with the move, so the source is left empty
+	other.m_pos = 0;
+}
+
+auto packet_builder::operator=(const packet_builder &other) -> packet_builder & {
+	if (this != &other) {
+		m_packet.grow(other.m_pos, 0);
+		memcpy(m_packet.get(), other.m_packet.get(), other.m_pos);
+		m_pos = other.m_pos;
+	}
+	return *this;
+}
+
+auto packet_builder::operator=(packet_builder &&other) -> packet_builder & {
+	if (this != &other) {
+		m_packet = std::move(other.m_packet);
+		m_pos = other.m_pos;
+		other.m_pos = 0;
+	}
+	return *this;
+}
+
 auto packet_builder::unk(int32_t bytes) -> packet_builder & {
 	if (bytes <= 0) throw std::invalid_argument{"bytes must be > 0"};
 
@@ -89,15 +122,8 @@ auto packet_builder::add_buffer(const packet_reader &reader) -> packet_builder &
 }
 
 auto packet_builder::get_buffer(size_t pos, size_t len) -> unsigned char * {
-	if (m_packet_capacity < pos + len) {
-		// Buffer is not large enough
-		while (m_packet_capacity < pos + len) {
-			m_packet_capacity *= 2; // Double the capacity each time the buffer is full
-		}
-		unsigned char *new_buffer = new unsigned char[m_packet_capacity];
-		memcpy(new_buffer, m_packet.get(), pos);
-		m_packet.reset(new_buffer);
-	}
+	// Growth is geometric, so appending stays amortized constant time
+	m_packet.grow(pos + len, m_pos);
 
 	return m_packet.get() + pos;
 }
@@ -19,7 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "common/i_packet.hpp"
 #include "common/types.hpp"
-#include "common/util/shared_array.hpp"
+#include "common/util/buffer_pool.hpp"
 #include <cstring>
 #include <iostream>
 #include <limits>
@@ -39,6 +39,10 @@ namespace vana {
 	class packet_builder {
 	public:
 		packet_builder();
+		packet_builder(const packet_builder &other);
+		packet_builder(packet_builder &&other);
+		auto operator=(const packet_builder &other) -> packet_builder &;
+		auto operator=(packet_builder &&other) -> packet_builder &;
 
 		template <typename TValue>
 		auto add(const TValue &value) -> packet_builder &;
@@ -120,8 +124,7 @@ namespace vana {
 		auto add_sized_impl(const vector<TElement> &val, size_t size) -> void;
 
 		size_t m_pos = 0;
-		size_t m_packet_capacity = 0;
-		vana::util::shared_array<unsigned char> m_packet;
+		vana::util::pooled_buffer m_packet;
 	};
 
 	template <typename TValue>
@@ -279,7 +282,7 @@ namespace vana {
 		}
 		strncpy(reinterpret_cast<char *>(get_buffer(m_pos, size)), value.c_str(), slen);
 		for (size_t i = slen; i < size; i++) {
-			m_packet[m_pos + i] = 0;
+			m_packet.get()[m_pos + i] = 0;
 		}
 		m_pos += size;
 	}
@@ -40,6 +40,13 @@ auto packet_handler::send(const packet_builder &builder) -> void {
 	m_session->send(builder);
 }
 
+auto packet_handler::send(ref_ptr<const shared_packet> packet) -> void {
+	if (m_disconnected) {
+		return;
+	}
+	m_session->send(packet);
+}
+
 auto packet_handler::get_latency() const -> milliseconds {
 	if (m_disconnected) {
 		return milliseconds{0};
@@ -51,6 +58,10 @@ auto packet_handler::handle(packet_reader &reader) -> result {
 	return result::success;
 }
 
+auto packet_handler::route(packet_header opcode, function<void()> handle) -> bool {
+	return false;
+}
+
 auto packet_handler::on_connect_base(ref_ptr<session> session) -> void {
 	m_session = session;
 	on_connect();
@@ -27,10 +27,13 @@ namespace vana {
 		auto get_ip() const -> optional<ip>;
 		auto disconnect() -> void;
 		auto send(const packet_builder &builder) -> void;
+		auto send(ref_ptr<const shared_packet> packet) -> void;
 		auto get_latency() const -> milliseconds;
 	protected:
 		friend class session;
 		virtual auto handle(packet_reader &reader) -> result;
+		// Called from the session's strand as each packet arrives, returning false leaves it to the dispatch strand
+		virtual auto route(packet_header opcode, function<void()> handle) -> bool;
 		virtual auto on_connect() -> void;
 		virtual auto on_disconnect() -> void;
 		auto on_connect_base(ref_ptr<session> session) -> void;
@@ -25,6 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/packet_builder.hpp"
 #include "common/packet_handler.hpp"
 #include "common/packet_reader.hpp"
+#include "common/shared_packet.hpp"
 #include "common/util/randomizer.hpp"
 #include "common/util/time.hpp"
 #include <functional>
@@ -37,6 +38,7 @@ session::session(
 	handler handler) :
 	m_manager{manager},
 	m_socket{service},
+	m_strand{service},
 	m_handler{handler},
 	m_ip{0}
 {
@@ -50,10 +52,6 @@ auto session::get_codec() -> packet_transformer & {
 	return *m_codec;
 }
 
-auto session::get_buffer() -> vana::util::shared_array<unsigned char> & {
-	return m_buffer;
-}
-
 auto session::get_latency() const -> milliseconds {
 	return m_latency;
 }
@@ -67,10 +65,25 @@ auto session::set_type(connection_type type) -> void {
 	m_type = type;
 }
 
+auto session::get_send_queue_depth() const -> size_t {
+	owned_lock<mutex> l{m_send_mutex};
+	return m_send_queue.size();
+}
+
+auto session::get_send_queue_bytes() const -> size_t {
+	owned_lock<mutex> l{m_send_mutex};
+	return m_send_queue_bytes;
+}
+
+auto session::get_bytes_in_flight() const -> size_t {
+	owned_lock<mutex> l{m_send_mutex};
+	return m_bytes_in_flight;
+}
+
 auto session::ping() -> void {
 	if (m_ping_count == m_max_ping_count) {
 		// We have a timeout now
-		disconnect();
+		post_disconnect();
 		return;
 	}
 
@@ -79,7 +92,7 @@ auto session::ping() -> void {
 	send(packets::ping());
 }
 
-auto session::start(const config::ping &ping, ref_ptr<packet_transformer> transformer) -> void {
+auto session::start(const config::ping &ping, uint32_t max_send_queue_bytes, ref_ptr<packet_transformer> transformer) -> void {
 	// TODO FIXME support IPv6
 	auto &addr = m_socket.remote_endpoint().address();
 	if (addr.is_v4()) {
@@ -99,9 +112,12 @@ auto session::start(const config::ping &ping, ref_ptr<packet_transformer> transf
 			ping.interval);
 	}
 
+	m_max_send_queue_bytes = max_send_queue_bytes;
 	m_codec = transformer;
 
-	m_handler->on_connect_base(shared_from_this());
+	// Handlers only run on the dispatch strand, packets read below are queued behind this
+	auto self = shared_from_this();
+	m_manager.dispatch([self] { self->m_handler->on_connect_base(self); });
 
 	m_is_connected = true;
 	start_read_header();
@@ -110,7 +126,7 @@ auto session::start(const config::ping &ping, ref_ptr<packet_transformer> transf
 auto session::sync_read(size_t minimum_bytes) -> pair<asio::error_code, packet_reader> {
 	asio::error_code error;
 
-	m_buffer.reset(new unsigned char[max_buffer_len]);
+	m_buffer.grow(max_buffer_len, 0);
 
 	size_t packet_size = asio::read(m_socket,
 		asio::buffer(m_buffer.get(), max_buffer_len),
@@ -126,104 +142,193 @@ auto session::disconnect() -> void {
 	m_manager.stop(shared_from_this());
 	m_is_connected = false;
 
-	asio::error_code ec;
-	m_socket.close(ec);
-	if (ec) {
-		m_manager.get_server()->log(vana::log::type::error, [&](out_stream &str) {
-			str << "FAILURE TO CLOSE SESSION (" << ec.value() << "): " << ec.message();
-		});
-	}
+	// Socket operations must happen on the session's strand
+	auto self = shared_from_this();
+	m_strand.post([self] {
+		asio::error_code ec;
+		self->m_socket.close(ec);
+		if (ec) {
+			self->m_manager.get_server()->log(vana::log::type::error, [&](out_stream &str) {
+				str << "FAILURE TO CLOSE SESSION (" << ec.value() << "): " << ec.message();
+			});
+		}
+	});
+}
+
+auto session::post_disconnect() -> void {
+	// Disconnecting notifies the handler, which must only run on the dispatch strand
+	auto self = shared_from_this();
+	m_manager.dispatch([self] { self->disconnect(); });
 }
 
 auto session::send(const packet_builder &builder, bool encrypt) -> void {
 	send(builder.get_buffer(), builder.get_size(), encrypt);
 }
 
-auto session::send(const unsigned char *buf, int32_t len, bool encrypt) -> void {
-	owned_lock<mutex> l{m_send_mutex};
+auto session::send(ref_ptr<const shared_packet> packet) -> void {
+	send_frame frame;
+	frame.length = packet->get_size() + header_len;
+	frame.shared = packet;
+	queue_frame(std::move(frame));
+}
 
-	unsigned char *send_buffer;
+auto session::send(const unsigned char *buf, int32_t len, bool encrypt) -> void {
 	size_t real_length = len;
-
 	if (encrypt) {
 		real_length += header_len;
-		send_buffer = new unsigned char[real_length];
-		m_send_packet.reset(send_buffer);
+	}
+
+	send_frame frame{real_length};
+	frame.encrypt = encrypt;
+	memcpy(frame.buffer.get() + (encrypt ? header_len : 0), buf, len);
+	queue_frame(std::move(frame));
+}
+
+auto session::queue_frame(send_frame frame) -> void {
+	owned_lock<mutex> l{m_send_mutex};
+	if (m_disconnect_pending) return;
 
-		memcpy(send_buffer + header_len, buf, len);
-		m_codec->set_packet_header(send_buffer, static_cast<uint16_t>(len));
-		m_codec->encrypt_packet(send_buffer + header_len, len, header_len);
+	if (m_max_send_queue_bytes != 0 && m_send_queue_bytes + m_bytes_in_flight + frame.length > m_max_send_queue_bytes) {
+		// The client isn't reading what we send it, there's no sense in buffering without bound
+		// disconnect() may send, so it can't run while we hold the send lock
+		m_disconnect_pending = true;
+		post_disconnect();
+		return;
 	}
-	else {
-		send_buffer = new unsigned char[real_length];
-		m_send_packet.reset(send_buffer);
 
-		memcpy(send_buffer, buf, len);
+	m_send_queue_bytes += frame.length;
+	m_send_queue.push_back(std::move(frame));
+
+	if (!m_write_in_progress) {
+		// Anything else sent before the strand gets to this goes out in the same write
+		m_write_in_progress = true;
+		auto self = shared_from_this();
+		m_strand.post([self] { self->start_write(); });
+	}
+}
+
+auto session::encrypt_frame(send_frame &frame) -> void {
+	size_t len = frame.length - header_len;
+	if (frame.shared != nullptr) {
+		frame.buffer = vana::util::pooled_buffer{frame.length};
+		memcpy(frame.buffer.get() + header_len, frame.shared->get_buffer(), len);
+		frame.shared.reset();
+	}
+
+	unsigned char *send_buffer = frame.buffer.get();
+	m_codec->set_packet_header(send_buffer, static_cast<uint16_t>(len));
+	m_codec->encrypt_packet(send_buffer + header_len, static_cast<int32_t>(len), header_len);
+}
+
+auto session::start_write() -> void {
+	// Must run on m_strand
+	{
+		owned_lock<mutex> l{m_send_mutex};
+		std::swap(m_send_in_flight, m_send_queue);
+		m_bytes_in_flight = m_send_queue_bytes;
+		m_send_queue_bytes = 0;
+	}
+
+	// Frames must be encrypted in queue order because the IV shuffles with every packet
+	// Doing it here keeps that order and spreads the work of a broadcast over the I/O threads
+	m_send_buffers.clear();
+	for (auto &frame : m_send_in_flight) {
+		if (frame.encrypt) {
+			encrypt_frame(frame);
+		}
+		m_send_buffers.push_back(asio::buffer(frame.buffer.get(), frame.length));
 	}
 
-	asio::async_write(m_socket, asio::buffer(send_buffer, real_length),
-		std::bind(&session::handle_write, shared_from_this(),
+	asio::async_write(m_socket, m_send_buffers,
+		m_strand.wrap(std::bind(&session::handle_write, shared_from_this(),
 			std::placeholders::_1,
-			std::placeholders::_2));
+			std::placeholders::_2)));
 }
 
 auto session::start_read_header() -> void {
-	m_buffer.reset(new unsigned char[header_len]);
-
 	asio::async_read(m_socket,
-		asio::buffer(m_buffer.get(), header_len),
-		std::bind(&session::handle_read_header, shared_from_this(),
+		asio::buffer(m_header, header_len),
+		m_strand.wrap(std::bind(&session::handle_read_header, shared_from_this(),
 			std::placeholders::_1,
-			std::placeholders::_2));
+			std::placeholders::_2)));
 }
 
 auto session::handle_write(const asio::error_code &error, size_t bytes_transferred) -> void {
-	owned_lock<mutex> l{m_send_mutex};
+	bool write_more = false;
+	{
+		owned_lock<mutex> l{m_send_mutex};
+		// Frame buffers go back to the buffer pool
+		m_send_in_flight.clear();
+		m_bytes_in_flight = 0;
+
+		write_more = !error && !m_send_queue.empty();
+		m_write_in_progress = write_more;
+	}
+
 	if (error) {
-		disconnect();
+		post_disconnect();
+		return;
+	}
+
+	if (write_more) {
+		start_write();
 	}
 }
 
 auto session::handle_read_header(const asio::error_code &error, size_t bytes_transferred) -> void {
 	if (error) {
-		disconnect();
+		post_disconnect();
 		return;
 	}
 
 	// TODO FIXME
 	// Figure out how to distinguish between client versions and server versions, can use this after
-	//if (m_codec.testPacket(m_buffer.get()) == ValidityResult::Invalid) {
+	//if (m_codec.testPacket(m_header) == ValidityResult::Invalid) {
 	//	// Hacking or trying to crash server
 	//	disconnect();
 	//	return;
 	//}
 
-	size_t len = m_codec->get_packet_length(m_buffer.get());
+	size_t len = m_codec->get_packet_length(m_header);
 	if (len < 2) {
 		// Hacking or trying to crash server
-		disconnect();
+		post_disconnect();
 		return;
 	}
 
-	m_buffer.reset(new unsigned char[len]);
+	m_buffer = vana::util::pooled_buffer{len};
 
 	asio::async_read(m_socket,
 		asio::buffer(m_buffer.get(), len),
-		std::bind(&session::handle_read_body, shared_from_this(),
+		m_strand.wrap(std::bind(&session::handle_read_body, shared_from_this(),
 			std::placeholders::_1,
-			std::placeholders::_2));
+			std::placeholders::_2)));
 }
 
 auto session::handle_read_body(const asio::error_code &error, size_t bytes_transferred) -> void {
 	if (error) {
-		disconnect();
+		post_disconnect();
 		return;
 	}
 
 	m_codec->decrypt_packet(m_buffer.get(), bytes_transferred, header_len);
 
-	packet_reader packet{m_buffer.get(), bytes_transferred};
-	base_handle_request(packet);
+	// The handler takes ownership of the body buffer, asio handlers must be copyable so it travels as a raw pointer
+	// It's returned to the pool after the packet is handled
+	auto self = shared_from_this();
+	size_t capacity = m_buffer.capacity();
+	unsigned char *buffer = m_buffer.release();
+	auto handle = [self, buffer, capacity, bytes_transferred] {
+		if (self->m_is_connected) {
+			packet_reader packet{buffer, bytes_transferred};
+			self->base_handle_request(packet);
+		}
+		vana::util::buffer_pool::release(buffer, capacity);
+	};
+
+	if (bytes_transferred < sizeof(packet_header) || !m_handler->route(packet_reader{buffer, bytes_transferred}.peek<packet_header>(), handle)) {
+		m_manager.dispatch(handle);
+	}
 
 	start_read_header();
 }
@@ -234,7 +339,10 @@ auto session::get_ip() const -> const ip & {
 
 auto session::base_handle_request(packet_reader &reader) -> void {
 	try {
-		switch (reader.peek<packet_header>()) {
+		packet_header opcode = reader.peek<packet_header>();
+		time_point start = vana::util::time::get_now();
+
+		switch (opcode) {
 			case SMSG_PING:
 				if (m_type != connection_type::end_user) {
 					send(packets::pong());
@@ -243,7 +351,7 @@ auto session::base_handle_request(packet_reader &reader) -> void {
 			case CMSG_PONG:
 				if (m_ping_count == 0) {
 					// Trying to spoof pongs without pings
-					disconnect();
+					post_disconnect();
 					return;
 				}
 				m_ping_count = 0;
@@ -253,8 +361,11 @@ auto session::base_handle_request(packet_reader &reader) -> void {
 		}
 
 		if (m_handler->handle(reader) == result::failure) {
-			disconnect();
+			// Map-local requests are handled on a map worker, teardown has to happen on the dispatch strand
+			post_disconnect();
 		}
+
+		m_manager.get_handler_stats().record(opcode, reader.get_buffer_length(), vana::util::time::get_now() - start);
 	}
 #if DEBUG
 	catch (not_implemented_exception &e) {
@@ -23,12 +23,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/packet_transformer.hpp"
 #include "common/timer/container_holder.hpp"
 #include "common/types.hpp"
-#include "common/util/shared_array.hpp"
+#include "common/util/buffer_pool.hpp"
 #include <asio.hpp>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <vector>
 
 namespace vana {
 	class connection_manager;
@@ -36,6 +37,7 @@ namespace vana {
 	class packet_handler;
 	class packet_reader;
 	class session;
+	class shared_packet;
 
 	using handler = ref_ptr<packet_handler>;
 	using handler_creator = function<handler()>;
@@ -49,23 +51,44 @@ namespace vana {
 
 		auto disconnect() -> void;
 		auto send(const packet_builder &builder, bool encrypt = true) -> void;
+		auto send(ref_ptr<const shared_packet> packet) -> void;
 		auto get_ip() const -> const ip &;
 		auto get_latency() const -> milliseconds;
 		auto get_type() const -> connection_type;
 		auto set_type(connection_type type) -> void;
+		auto get_send_queue_depth() const -> size_t;
+		auto get_send_queue_bytes() const -> size_t;
+		auto get_bytes_in_flight() const -> size_t;
 	private:
 		static const size_t header_len = 4;
 		static const size_t max_buffer_len = 65535;
 
+		struct send_frame {
+			send_frame() = default;
+			send_frame(send_frame &&other) = default;
+			explicit send_frame(size_t length) : buffer{length}, length{length} { }
+			auto operator=(send_frame &&other) -> send_frame & = default;
+
+			vana::util::pooled_buffer buffer;
+			// Broadcast payloads stay shared until the frame is encrypted
+			ref_ptr<const shared_packet> shared;
+			// Length on the wire, including the header for encrypted frames
+			size_t length = 0;
+			bool encrypt = true;
+		};
+
 		auto sync_read(size_t minimum_bytes) -> pair<asio::error_code, packet_reader>;
 		auto start_read_header() -> void;
 		auto handle_write(const asio::error_code &error, size_t bytes_transferred) -> void;
+		auto queue_frame(send_frame frame) -> void;
+		auto encrypt_frame(send_frame &frame) -> void;
+		auto start_write() -> void;
+		auto post_disconnect() -> void;
 		auto handle_read_header(const asio::error_code &error, size_t bytes_transferred) -> void;
 		auto handle_read_body(const asio::error_code &error, size_t bytes_transferred) -> void;
 		auto get_socket() -> asio::ip::tcp::socket &;
 		auto get_codec() -> packet_transformer &;
-		auto get_buffer() -> vana::util::shared_array<unsigned char> &;
-		auto start(const config::ping &ping, ref_ptr<packet_transformer> transformer) -> void;
+		auto start(const config::ping &ping, uint32_t max_send_queue_bytes, ref_ptr<packet_transformer> transformer) -> void;
 		auto send(const unsigned char *buf, int32_t len, bool encrypt = true) -> void;
 		auto ping() -> void;
 		auto base_handle_request(packet_reader &reader) -> void;
@@ -74,18 +97,31 @@ namespace vana {
 		friend class connection_listener;
 
 		bool m_is_connected = false;
+		bool m_disconnect_pending = false;
+		bool m_write_in_progress = false;
 		connection_type m_type = connection_type::unknown;
 		int8_t m_ping_count = 0;
 		int32_t m_max_ping_count = 0;
+		uint32_t m_max_send_queue_bytes = 0;
+		size_t m_send_queue_bytes = 0;
+		size_t m_bytes_in_flight = 0;
 		milliseconds m_latency = milliseconds{0};
 		time_point m_last_ping;
 		handler m_handler;
 		ip m_ip;
 		connection_manager &m_manager;
 		asio::ip::tcp::socket m_socket;
-		vana::util::shared_array<unsigned char> m_buffer;
-		vana::util::shared_array<unsigned char> m_send_packet;
+		// Serializes socket operations and decryption for this session, different sessions may run in parallel
+		asio::io_service::strand m_strand;
+		unsigned char m_header[header_len];
+		vana::util::pooled_buffer m_buffer;
+		// Frames waiting for the current write to complete, they're encrypted when their write starts
+		vector<send_frame> m_send_queue;
+		// Frames owned by the outstanding async_write, at most one write is in flight at a time
+		// Only touched on m_strand
+		vector<send_frame> m_send_in_flight;
+		vector<asio::const_buffer> m_send_buffers;
 		ref_ptr<packet_transformer> m_codec;
-		mutex m_send_mutex;
+		mutable mutex m_send_mutex;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "shared_packet.hpp"
+#include "common/packet_builder.hpp"
+#include <cstring>
+
+namespace vana {
+
+shared_packet::shared_packet(const packet_builder &builder) :
+	m_size{builder.get_size()},
+	m_buffer{builder.get_size()}
+{
+	memcpy(m_buffer.get(), builder.get_buffer(), m_size);
+}
+
+}
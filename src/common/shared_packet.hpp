@@ -0,0 +1,40 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include "common/util/buffer_pool.hpp"
+
+namespace vana {
+	class packet_builder;
+
+	// An immutable copy of a packet payload that any number of sessions can queue at once
+	// Each session copies it into its own frame only when it's encrypted, so a broadcast is serialized a single time
+	class shared_packet {
+		NONCOPYABLE(shared_packet);
+		NO_DEFAULT_CONSTRUCTOR(shared_packet);
+	public:
+		explicit shared_packet(const packet_builder &builder);
+
+		auto get_buffer() const -> const unsigned char * { return m_buffer.get(); }
+		auto get_size() const -> size_t { return m_size; }
+	private:
+		size_t m_size = 0;
+		vana::util::pooled_buffer m_buffer;
+	};
+}
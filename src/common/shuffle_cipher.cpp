@@ -0,0 +1,265 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "shuffle_cipher.hpp"
+#include "common/util/bit.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VANA_SHUFFLE_CIPHER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace vana {
+
+namespace {
+
+// Scalar forms of the four passes, these operate on [begin, end)
+// The SIMD paths use them for whatever doesn't fill a full vector
+auto encrypt_forward(unsigned char *packet_data, int32_t real_packet_size, int32_t begin, int32_t end, uint8_t a) -> void {
+	for (int32_t k = begin; k < end; ++k) {
+		int32_t j = real_packet_size - k;
+		uint8_t c = vana::util::bit::rotate_left(packet_data[k], 3);
+		c = static_cast<uint8_t>(c + j);
+		a = c ^ a;
+		c = vana::util::bit::rotate_right(a, j);
+		c = c ^ 0xFF;
+		packet_data[k] = static_cast<uint8_t>(c + 0x48);
+	}
+}
+
+auto encrypt_backward(unsigned char *packet_data, int32_t begin, int32_t end, uint8_t a) -> void {
+	for (int32_t k = end - 1; k >= begin; --k) {
+		int32_t j = k + 1;
+		uint8_t c = vana::util::bit::rotate_left(packet_data[k], 4);
+		c = static_cast<uint8_t>(c + j);
+		a = c ^ a;
+		c = a ^ 0x13;
+		packet_data[k] = vana::util::bit::rotate_right(c, 3);
+	}
+}
+
+auto decrypt_backward(unsigned char *packet_data, int32_t begin, int32_t end) -> void {
+	uint8_t b = 0;
+	for (int32_t k = end - 1; k >= begin; --k) {
+		int32_t j = k + 1;
+		uint8_t a = vana::util::bit::rotate_left(packet_data[k], 3) ^ 0x13;
+		uint8_t c = static_cast<uint8_t>((a ^ b) - j);
+		packet_data[k] = vana::util::bit::rotate_right(c, 4);
+		b = a;
+	}
+}
+
+auto decrypt_forward(unsigned char *packet_data, int32_t real_packet_size, int32_t begin, int32_t end) -> void {
+	uint8_t b = 0;
+	for (int32_t k = begin; k < end; ++k) {
+		int32_t j = real_packet_size - k;
+		uint8_t a = vana::util::bit::rotate_left(static_cast<uint8_t>((packet_data[k] - 0x48) ^ 0xFF), j);
+		uint8_t c = static_cast<uint8_t>((a ^ b) - j);
+		packet_data[k] = vana::util::bit::rotate_right(c, 3);
+		b = a;
+	}
+}
+
+auto encrypt_round_scalar(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	encrypt_forward(packet_data, real_packet_size, 0, real_packet_size, 0);
+	encrypt_backward(packet_data, 0, real_packet_size, 0);
+}
+
+auto decrypt_round_scalar(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	decrypt_backward(packet_data, 0, real_packet_size);
+	decrypt_forward(packet_data, real_packet_size, 0, real_packet_size);
+}
+
+#ifdef VANA_SHUFFLE_CIPHER_SSE2
+const int32_t lane_count = 16;
+
+// 16-bit multipliers that rotate each byte lane by a different amount
+// Byte lane i rotates left by (s + i) & 7 for the ascending set and (s - i) & 7 for the descending set
+struct lane_rotations {
+	lane_rotations() {
+		for (int32_t s = 0; s < 8; ++s) {
+			for (int32_t lane = 0; lane < 8; ++lane) {
+				ascending_even[s][lane] = static_cast<uint16_t>(1 << ((s + lane * 2) & 7));
+				ascending_odd[s][lane] = static_cast<uint16_t>(1 << ((s + lane * 2 + 1) & 7));
+				descending_even[s][lane] = static_cast<uint16_t>(1 << ((s - lane * 2) & 7));
+				descending_odd[s][lane] = static_cast<uint16_t>(1 << ((s - lane * 2 - 1) & 7));
+			}
+		}
+	}
+
+	alignas(16) uint16_t ascending_even[8][8];
+	alignas(16) uint16_t ascending_odd[8][8];
+	alignas(16) uint16_t descending_even[8][8];
+	alignas(16) uint16_t descending_odd[8][8];
+};
+
+const lane_rotations rotations{};
+const __m128i lane_offsets = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+template <int32_t Shifts>
+inline
+auto rotate_left_bytes(__m128i x) -> __m128i {
+	// SSE2 has no 8-bit shifts, so shift 16-bit lanes and mask off the bits that crossed into the neighboring byte
+	__m128i high = _mm_and_si128(_mm_slli_epi16(x, Shifts), _mm_set1_epi8(static_cast<char>((0xFF << Shifts) & 0xFF)));
+	__m128i low = _mm_and_si128(_mm_srli_epi16(x, 8 - Shifts), _mm_set1_epi8(static_cast<char>(0xFF >> (8 - Shifts))));
+	return _mm_or_si128(high, low);
+}
+
+inline
+auto rotate_left_lanes(__m128i x, const uint16_t *even_multipliers, const uint16_t *odd_multipliers) -> __m128i {
+	// Widen each byte to 16 bits and multiply by 1 << shift, the bits that overflow the byte are the ones that wrap around
+	const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+	__m128i even = _mm_mullo_epi16(_mm_and_si128(x, low_bytes), _mm_load_si128(reinterpret_cast<const __m128i *>(even_multipliers)));
+	__m128i odd = _mm_mullo_epi16(_mm_srli_epi16(x, 8), _mm_load_si128(reinterpret_cast<const __m128i *>(odd_multipliers)));
+	even = _mm_or_si128(even, _mm_srli_epi16(even, 8));
+	odd = _mm_or_si128(odd, _mm_srli_epi16(odd, 8));
+	return _mm_or_si128(_mm_and_si128(even, low_bytes), _mm_slli_epi16(odd, 8));
+}
+
+inline
+auto prefix_xor(__m128i x) -> __m128i {
+	x = _mm_xor_si128(x, _mm_slli_si128(x, 1));
+	x = _mm_xor_si128(x, _mm_slli_si128(x, 2));
+	x = _mm_xor_si128(x, _mm_slli_si128(x, 4));
+	return _mm_xor_si128(x, _mm_slli_si128(x, 8));
+}
+
+inline
+auto suffix_xor(__m128i x) -> __m128i {
+	x = _mm_xor_si128(x, _mm_srli_si128(x, 1));
+	x = _mm_xor_si128(x, _mm_srli_si128(x, 2));
+	x = _mm_xor_si128(x, _mm_srli_si128(x, 4));
+	return _mm_xor_si128(x, _mm_srli_si128(x, 8));
+}
+
+inline
+auto position_bytes(int32_t first, bool ascending) -> __m128i {
+	__m128i base = _mm_set1_epi8(static_cast<char>(first));
+	return ascending ?
+		_mm_add_epi8(base, lane_offsets) :
+		_mm_sub_epi8(base, lane_offsets);
+}
+
+inline
+auto load(const unsigned char *data) -> __m128i {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+}
+
+inline
+auto store(unsigned char *data, __m128i value) -> void {
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(data), value);
+}
+
+auto encrypt_round(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	const __m128i all_bits = _mm_set1_epi8(static_cast<char>(0xFF));
+	const __m128i forward_addend = _mm_set1_epi8(0x48);
+	const __m128i backward_xor = _mm_set1_epi8(0x13);
+
+	uint8_t a = 0;
+	int32_t k = 0;
+	for (; k + lane_count <= real_packet_size; k += lane_count) {
+		__m128i c = rotate_left_bytes<3>(load(packet_data + k));
+		c = _mm_add_epi8(c, position_bytes(real_packet_size - k, false));
+		c = _mm_xor_si128(prefix_xor(c), _mm_set1_epi8(static_cast<char>(a)));
+		a = static_cast<uint8_t>(_mm_extract_epi16(c, 7) >> 8);
+		// Rotating right by j is rotating left by -j, which ascends across the lanes
+		int32_t s = (k - real_packet_size) & 7;
+		c = rotate_left_lanes(c, rotations.ascending_even[s], rotations.ascending_odd[s]);
+		c = _mm_add_epi8(_mm_xor_si128(c, all_bits), forward_addend);
+		store(packet_data + k, c);
+	}
+	encrypt_forward(packet_data, real_packet_size, k, real_packet_size, a);
+
+	a = 0;
+	k = real_packet_size - lane_count;
+	for (; k >= 0; k -= lane_count) {
+		__m128i c = rotate_left_bytes<4>(load(packet_data + k));
+		c = _mm_add_epi8(c, position_bytes(k + 1, true));
+		c = _mm_xor_si128(suffix_xor(c), _mm_set1_epi8(static_cast<char>(a)));
+		a = static_cast<uint8_t>(_mm_cvtsi128_si32(c));
+		c = rotate_left_bytes<5>(_mm_xor_si128(c, backward_xor));
+		store(packet_data + k, c);
+	}
+	encrypt_backward(packet_data, 0, k + lane_count, a);
+}
+
+auto decrypt_round(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	const __m128i backward_xor = _mm_set1_epi8(0x13);
+	const __m128i forward_addend = _mm_set1_epi8(0x48);
+	const __m128i all_bits = _mm_set1_epi8(static_cast<char>(0xFF));
+
+	// Ascending order keeps the following byte unmodified until it's been read
+	int32_t k = 0;
+	for (; k + lane_count < real_packet_size; k += lane_count) {
+		__m128i a = _mm_xor_si128(rotate_left_bytes<3>(load(packet_data + k)), backward_xor);
+		__m128i b = _mm_xor_si128(rotate_left_bytes<3>(load(packet_data + k + 1)), backward_xor);
+		__m128i c = _mm_sub_epi8(_mm_xor_si128(a, b), position_bytes(k + 1, true));
+		store(packet_data + k, rotate_left_bytes<4>(c));
+	}
+	// The last byte of the packet has nothing following it, so the remainder starts from scratch
+	decrypt_backward(packet_data, k, real_packet_size);
+
+	// Descending order keeps the preceding byte unmodified until it's been read
+	k = real_packet_size - lane_count;
+	for (; k >= 1; k -= lane_count) {
+		int32_t s = (real_packet_size - k) & 7;
+		__m128i a = _mm_xor_si128(_mm_sub_epi8(load(packet_data + k), forward_addend), all_bits);
+		__m128i b = _mm_xor_si128(_mm_sub_epi8(load(packet_data + k - 1), forward_addend), all_bits);
+		a = rotate_left_lanes(a, rotations.descending_even[s], rotations.descending_odd[s]);
+		b = rotate_left_lanes(b, rotations.descending_even[(s + 1) & 7], rotations.descending_odd[(s + 1) & 7]);
+		__m128i c = _mm_sub_epi8(_mm_xor_si128(a, b), position_bytes(real_packet_size - k, false));
+		store(packet_data + k, rotate_left_bytes<5>(c));
+	}
+	decrypt_forward(packet_data, real_packet_size, 0, k + lane_count);
+}
+#else
+auto encrypt_round(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	encrypt_round_scalar(packet_data, real_packet_size);
+}
+
+auto decrypt_round(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	decrypt_round_scalar(packet_data, real_packet_size);
+}
+#endif
+
+}
+
+auto shuffle_cipher::encrypt(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	for (uint8_t i = 0; i < 3; ++i) {
+		encrypt_round(packet_data, real_packet_size);
+	}
+}
+
+auto shuffle_cipher::decrypt(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	for (uint8_t i = 0; i < 3; ++i) {
+		decrypt_round(packet_data, real_packet_size);
+	}
+}
+
+auto shuffle_cipher::encrypt_scalar(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	for (uint8_t i = 0; i < 3; ++i) {
+		encrypt_round_scalar(packet_data, real_packet_size);
+	}
+}
+
+auto shuffle_cipher::decrypt_scalar(unsigned char *packet_data, int32_t real_packet_size) -> void {
+	for (uint8_t i = 0; i < 3; ++i) {
+		decrypt_round_scalar(packet_data, real_packet_size);
+	}
+}
+
+}
@@ -0,0 +1,35 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+
+namespace vana {
+	// Maple's custom byte-shuffling layer that wraps the AES layer
+	// Encryption carries a running XOR from byte to byte, which is a prefix XOR and can still be done 16 bytes at a time
+	// Decryption only depends on the neighboring ciphertext byte, so every byte of a pass can be computed independently
+	// Falls back to the byte-at-a-time loops when SSE2 isn't available
+	class shuffle_cipher {
+	public:
+		static auto encrypt(unsigned char *packet_data, int32_t real_packet_size) -> void;
+		static auto decrypt(unsigned char *packet_data, int32_t real_packet_size) -> void;
+		// Always the byte-at-a-time loops, the vectorized path has to match these exactly
+		static auto encrypt_scalar(unsigned char *packet_data, int32_t real_packet_size) -> void;
+		static auto decrypt_scalar(unsigned char *packet_data, int32_t real_packet_size) -> void;
+	};
+}
@@ -0,0 +1,131 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "stats_endpoint.hpp"
+#include "common/connection_manager.hpp"
+
+namespace vana {
+
+namespace {
+	const size_t max_request_size = 4096;
+
+	using request_iterator = asio::buffers_iterator<asio::streambuf::const_buffers_type>;
+
+	auto end_of_request(request_iterator begin, request_iterator end) -> pair<request_iterator, bool> {
+		// An empty line ends the request, covering both \n\n and \r\n\r\n as well as a lone newline
+		char previous = '\n';
+		for (request_iterator iter = begin; iter != end; ++iter) {
+			char current = *iter;
+			if (current == '\n' && previous == '\n') {
+				return std::make_pair(++iter, true);
+			}
+			if (current != '\r') {
+				previous = current;
+			}
+		}
+		return std::make_pair(end, false);
+	}
+}
+
+stats_endpoint::stats_endpoint(connection_manager &manager, function<void(out_stream &)> produce_report) :
+	m_manager{manager},
+	m_produce_report{produce_report},
+	m_acceptor{manager.get_io_service()}
+{
+}
+
+auto stats_endpoint::listen(connection_port first_port, connection_port last_port) -> optional<connection_port> {
+	for (uint32_t port = first_port; port <= last_port; port++) {
+		asio::ip::tcp::endpoint endpoint{asio::ip::address_v4::loopback(), static_cast<connection_port>(port)};
+		asio::error_code error;
+
+		m_acceptor.open(endpoint.protocol(), error);
+		if (!error) m_acceptor.bind(endpoint, error);
+		if (!error) m_acceptor.listen(asio::socket_base::max_connections, error);
+
+		if (!error) {
+			begin_accept();
+			return static_cast<connection_port>(port);
+		}
+
+		asio::error_code ignored;
+		m_acceptor.close(ignored);
+	}
+	return {};
+}
+
+auto stats_endpoint::stop() -> void {
+	asio::error_code ignored;
+	m_acceptor.close(ignored);
+}
+
+auto stats_endpoint::begin_accept() -> void {
+	auto socket = make_ref_ptr<asio::ip::tcp::socket>(m_manager.get_io_service());
+	m_acceptor.async_accept(*socket, [this, socket](const asio::error_code &error) {
+		if (error == asio::error::operation_aborted) {
+			return;
+		}
+		if (!error) {
+			read_request(socket);
+		}
+		begin_accept();
+	});
+}
+
+auto stats_endpoint::read_request(ref_ptr<asio::ip::tcp::socket> socket) -> void {
+	auto request = make_ref_ptr<asio::streambuf>(max_request_size);
+	asio::async_read_until(*socket, *request, &end_of_request, [this, socket, request](const asio::error_code &error, size_t bytes_transferred) {
+		if (error && error != asio::error::not_found) {
+			return;
+		}
+
+		auto begin = asio::buffers_begin(request->data());
+		auto end = asio::buffers_end(request->data());
+		bool http = std::distance(begin, end) >= 4 && string{begin, begin + 4} == "GET ";
+
+		m_manager.dispatch([this, socket, http] {
+			send_report(socket, http);
+		});
+	});
+}
+
+auto stats_endpoint::send_report(ref_ptr<asio::ip::tcp::socket> socket, bool http) -> void {
+	out_stream report;
+	m_produce_report(report);
+	string body = report.str();
+
+	auto response = make_ref_ptr<string>();
+	if (http) {
+		out_stream header;
+		header
+			<< "HTTP/1.0 200 OK\r\n"
+			<< "Content-Type: text/plain; version=0.0.4\r\n"
+			<< "Content-Length: " << body.size() << "\r\n"
+			<< "Connection: close\r\n"
+			<< "\r\n";
+		*response = header.str();
+	}
+	*response += body;
+
+	asio::async_write(*socket, asio::buffer(*response), [socket, response](const asio::error_code &error, size_t bytes_transferred) {
+		asio::error_code ignored;
+		socket->shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+		socket->close(ignored);
+	});
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <asio.hpp>
+#include <string>
+
+namespace vana {
+	class connection_manager;
+
+	// Serves a plain text report to local connections for monitoring to scrape
+	// Requests are answered once a blank line arrives, so both HTTP clients and netcat work
+	class stats_endpoint {
+		NONCOPYABLE(stats_endpoint);
+		NO_DEFAULT_CONSTRUCTOR(stats_endpoint);
+	public:
+		// The report is produced on the dispatch strand so it can read game state like any packet handler
+		stats_endpoint(connection_manager &manager, function<void(out_stream &)> produce_report);
+
+		// Binds the first free loopback port in [first_port, last_port]
+		auto listen(connection_port first_port, connection_port last_port) -> optional<connection_port>;
+		auto stop() -> void;
+	private:
+		auto begin_accept() -> void;
+		auto read_request(ref_ptr<asio::ip::tcp::socket> socket) -> void;
+		auto send_report(ref_ptr<asio::ip::tcp::socket> socket, bool http) -> void;
+
+		connection_manager &m_manager;
+		function<void(out_stream &)> m_produce_report;
+		asio::ip::tcp::acceptor m_acceptor;
+	};
+}
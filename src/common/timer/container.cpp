@@ -23,18 +23,41 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 namespace timer {
 
+container::~container() {
+	for (const auto &kvp : m_timers) {
+		vana::timer::thread::get_instance().cancel_timer(kvp.second);
+	}
+}
+
 auto container::is_timer_running(const id &id) const -> bool {
 	return m_timers.find(id) != std::end(m_timers);
 }
 
-auto container::register_timer(ref_ptr<timer> timer, const id &id, time_point run_at) -> void {
-	m_timers[id] = timer;
-	vana::timer::thread::get_instance().register_timer(timer, run_at);
+auto container::register_timer(ref_ptr<timer> timer, const id &id) -> void {
+	auto &thread = vana::timer::thread::get_instance();
+	auto iter = m_timers.find(id);
+	if (iter != std::end(m_timers)) {
+		thread.cancel_timer(iter->second);
+		iter->second = timer;
+	}
+	else {
+		m_timers[id] = timer;
+	}
+	thread.register_timer(timer);
+}
+
+auto container::set_executor(executor executor) -> void {
+	m_executor = executor;
+}
+
+auto container::get_executor() const -> const executor & {
+	return m_executor;
 }
 
 auto container::remove_timer(const id &id) -> void {
 	auto iter = m_timers.find(id);
 	if (iter != std::end(m_timers)) {
+		vana::timer::thread::get_instance().cancel_timer(iter->second);
 		m_timers.erase(iter);
 	}
 }
@@ -17,6 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/timer/func.hpp"
 #include "common/timer/timer.hpp"
 #include "common/timer/id.hpp"
 #include "common/timer/type.hpp"
@@ -29,13 +30,20 @@ namespace vana {
 	namespace timer {
 		class container {
 		public:
+			~container();
+
 			template <typename TDuration>
 			auto get_remaining_time(const id &id) const -> TDuration;
 			auto is_timer_running(const id &id) const -> bool;
-			auto register_timer(ref_ptr<timer> timer, const id &id, time_point run_at) -> void;
+			auto register_timer(ref_ptr<timer> timer, const id &id) -> void;
 			auto remove_timer(const id &id) -> void;
+			// Callbacks for this container's timers are handed to the executor instead of running on the timer thread
+			// Must be set before any timers are registered
+			auto set_executor(executor executor) -> void;
+			auto get_executor() const -> const executor &;
 		private:
 			hash_map<id, ref_ptr<timer>> m_timers;
+			executor m_executor;
 		};
 
 		template <typename TDuration>
@@ -22,5 +22,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 	namespace timer {
 		using func = function<void(const time_point &)>;
+		using executor = function<void(function<void()>)>;
 	}
 }
\ No newline at end of file
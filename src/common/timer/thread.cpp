@@ -20,43 +20,31 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/timer/container.hpp"
 #include "common/util/thread_pool.hpp"
 #include "common/util/time.hpp"
+#include <algorithm>
 #include <chrono>
 #include <functional>
 
 namespace vana {
 namespace timer {
 
-thread::thread()
+auto lag_metrics::get_average_lag() const -> duration {
+	if (timers_run == 0) {
+		return duration{0};
+	}
+	return total_lag / timers_run;
+}
+
+thread::thread() :
+	m_wheel{vana::util::time::get_now()}
 {
 	m_container = make_ref_ptr<container>();
 	m_thread = vana::util::thread_pool::lease(
 		[this](owned_lock<recursive_mutex> &lock) {
-			time_point wait_time = get_wait_time();
 			time_point now = vana::util::time::get_now();
+			m_wheel.advance(now, m_expired);
+			run_expired(now);
 
-			while (wait_time <= now && m_timers.size() > 0) {
-				timer_pair top = m_timers.top();
-
-				if (ref_ptr<timer> timer = top.second.lock()) {
-					m_timers.pop();
-
-					if (timer->run(now) == run_result::reset) {
-						m_timers.emplace(timer->reset(now), timer);
-					}
-					else {
-						timer->remove_from_container();
-					}
-
-					wait_time = get_wait_time();
-				}
-				else {
-					// Expired timer
-					m_timers.pop();
-					continue;
-				}
-			}
-
-			m_main_loop_condition.wait_until(lock, wait_time);
+			m_main_loop_condition.wait_until(lock, m_wheel.get_next_expiry());
 		},
 		[this] {
 			m_main_loop_condition.notify_one();
@@ -66,25 +54,75 @@ thread::thread()
 
 thread::~thread() {
 	m_thread.reset();
+	// The central container cancels its timers on destruction, which has to happen while the wheel is still around
+	m_container.reset();
 }
 
 auto thread::get_timer_container() const -> ref_ptr<container> {
 	return m_container;
 }
 
-auto thread::register_timer(ref_ptr<timer> timer, time_point run_at) -> void {
+auto thread::register_timer(ref_ptr<timer> timer) -> void {
 	owned_lock<recursive_mutex> l{m_timers_mutex};
-	m_timers.emplace(run_at, timer);
+	m_wheel.schedule(timer, vana::util::time::get_now());
 	m_main_loop_condition.notify_one();
 }
 
-auto thread::get_wait_time() const -> time_point {
-	if (m_timers.size() > 0) {
-		return m_timers.top().first;
+auto thread::cancel_timer(ref_ptr<timer> timer) -> void {
+	owned_lock<recursive_mutex> l{m_timers_mutex};
+	timer->m_cancelled = true;
+	m_wheel.cancel(timer.get());
+}
+
+auto thread::get_lag_metrics() -> lag_metrics {
+	owned_lock<recursive_mutex> l{m_timers_mutex};
+	lag_metrics metrics = m_lag;
+	metrics.timers_pending = m_wheel.size();
+	return metrics;
+}
+
+auto thread::reset_lag_metrics() -> void {
+	owned_lock<recursive_mutex> l{m_timers_mutex};
+	m_lag = lag_metrics{};
+}
+
+auto thread::run_expired(const time_point &now) -> void {
+	// Callbacks may register or cancel timers (including ones later in this batch), the lock is recursive
+	for (size_t i = 0; i < m_expired.size(); i++) {
+		ref_ptr<timer> timer = m_expired[i];
+		if (timer->m_cancelled) {
+			continue;
+		}
+
+		duration lag = std::max(now - timer->m_run_at, duration{0});
+		m_lag.timers_run++;
+		m_lag.total_lag += lag;
+		m_lag.max_lag = std::max(m_lag.max_lag, lag);
+
+		ref_ptr<container> owner = timer->m_container.lock();
+		if (owner != nullptr && owner->get_executor() != nullptr) {
+			// The owner's executor runs the callback and removes finished timers, so the container is only touched from there
+			if (timer->m_repeat) {
+				timer->reset(now);
+				m_wheel.schedule(timer, now);
+			}
+			owner->get_executor()([timer, now] { timer->run_executed(now); });
+			continue;
+		}
+
+		if (timer->run(now) == run_result::reset) {
+			if (!timer->m_cancelled) {
+				timer->reset(now);
+				m_wheel.schedule(timer, now);
+			}
+		}
+		else if (!timer->m_cancelled) {
+			timer->remove_from_container();
+		}
 	}
 
-	return vana::util::time::get_now_with_time_added(milliseconds{1000000000});
+	m_expired.clear();
 }
 
 }
-}
\ No newline at end of file
+}
@@ -17,15 +17,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 #pragma once
 
+#include "common/timer/wheel.hpp"
 #include "common/types.hpp"
-#include <atomic>
 #include <condition_variable>
-#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
-#include <utility>
 #include <vector>
 
 namespace vana {
@@ -33,24 +30,30 @@ namespace vana {
 		class container;
 		class timer;
 
+		struct lag_metrics {
+			auto get_average_lag() const -> duration;
+
+			uint64_t timers_run = 0;
+			size_t timers_pending = 0;
+			duration max_lag = duration{0};
+			duration total_lag = duration{0};
+		};
+
 		class thread {
 			SINGLETON(thread);
 		public:
 			~thread();
 			auto get_timer_container() const -> ref_ptr<container>;
-			auto register_timer(ref_ptr<timer> timer, time_point run_at) -> void;
+			auto register_timer(ref_ptr<timer> timer) -> void;
+			auto cancel_timer(ref_ptr<timer> timer) -> void;
+			auto get_lag_metrics() -> lag_metrics;
+			auto reset_lag_metrics() -> void;
 		private:
-			auto get_wait_time() const -> time_point;
-
-			using timer_pair = pair<time_point, view_ptr<timer>>;
-
-			struct find_closest_timer {
-				auto operator()(const timer_pair &t1, const timer_pair &t2) const -> bool {
-					return t1.first > t2.first;
-				}
-			};
+			auto run_expired(const time_point &now) -> void;
 
-			std::priority_queue<timer_pair, vector<timer_pair>, find_closest_timer> m_timers;
+			wheel m_wheel;
+			vector<ref_ptr<timer>> m_expired;
+			lag_metrics m_lag;
 			std::condition_variable_any m_main_loop_condition;
 			recursive_mutex m_timers_mutex;
 			ref_ptr<std::thread> m_thread;
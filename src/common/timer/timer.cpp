@@ -30,7 +30,7 @@ auto timer::create(const func f, const id &id, ref_ptr<container> container, con
 	}
 
 	ref_ptr<timer> timer = make_ref_ptr<vana::timer::timer>(f, id, container, difference_from_now, repeat);
-	container->register_timer(timer, id, timer->m_run_at);
+	container->register_timer(timer, id);
 }
 
 timer::timer(const func f, const id &id, ref_ptr<container> container, const duration &difference_from_now, const duration &repeat) :
@@ -54,6 +54,17 @@ auto timer::run(const time_point &now) const -> run_result {
 	return m_repeat ? run_result::reset : run_result::complete;
 }
 
+auto timer::run_executed(const time_point &now) const -> void {
+	// The owner may have cancelled or replaced the timer while the callback was queued
+	if (m_cancelled) {
+		return;
+	}
+	m_function(now);
+	if (!m_repeat && !m_cancelled) {
+		remove_from_container();
+	}
+}
+
 auto timer::reset(const time_point &now) -> time_point {
 	m_run_at = now + m_repeat_time;
 	return m_run_at;
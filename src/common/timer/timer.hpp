@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/timer/id.hpp"
 #include "common/timer/run_result.hpp"
 #include "common/timer/type.hpp"
+#include "common/timer/wheel.hpp"
 #include "common/types.hpp"
 #include <ctime>
 #include <functional>
@@ -33,6 +34,8 @@ namespace vana {
 		class thread;
 
 		class timer {
+			friend class thread;
+			friend class wheel;
 			NONCOPYABLE(timer);
 			NO_DEFAULT_CONSTRUCTOR(timer);
 		public:
@@ -41,6 +44,8 @@ namespace vana {
 
 			auto get_time_left() const -> duration;
 			auto run(const time_point &now) const -> run_result;
+			// Runs the callback of a timer whose container has an executor, from that executor
+			auto run_executed(const time_point &now) const -> void;
 			auto reset(const time_point &now) -> time_point;
 			auto remove_from_container() const -> void;
 		private:
@@ -50,6 +55,9 @@ namespace vana {
 			bool m_repeat;
 			duration m_repeat_time;
 			func m_function;
+			bool m_cancelled = false;
+			wheel::slot *m_slot = nullptr;
+			wheel::slot::iterator m_slot_position;
 		};
 	}
 }
\ No newline at end of file
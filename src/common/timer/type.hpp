@@ -43,6 +43,9 @@ namespace vana {
 			trade_timer,
 			weather_timer,
 			finalize_timer,
+			stats_timer,
+			movement_timer,
+			handoff_timer,
 		};
 	}
 }
\ No newline at end of file
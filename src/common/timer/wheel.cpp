@@ -0,0 +1,167 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "wheel.hpp"
+#include "common/timer/timer.hpp"
+#include <algorithm>
+
+namespace vana {
+namespace timer {
+
+// Timer resolution, anything finer than this is rounded up to the next tick
+static const milliseconds tick_length{1};
+
+wheel::wheel(const time_point &start) :
+	m_start{start}
+{
+}
+
+auto wheel::schedule(ref_ptr<timer> timer, const time_point &now) -> void {
+	if (m_size == 0) {
+		// Nothing was pending so the skipped ticks were all empty, don't walk them on the next advance
+		m_current_tick = std::max(m_current_tick, get_elapsed_ticks(now));
+	}
+
+	// The current tick has already been collected, nothing can land on it anymore
+	insert(timer, std::max(get_tick(timer->m_run_at), m_current_tick + 1));
+}
+
+auto wheel::cancel(timer *timer) -> void {
+	if (timer->m_slot == nullptr) {
+		return;
+	}
+
+	timer->m_slot->erase(timer->m_slot_position);
+	timer->m_slot = nullptr;
+	m_size--;
+}
+
+auto wheel::advance(const time_point &now, vector<ref_ptr<timer>> &expired) -> void {
+	uint64_t target = get_elapsed_ticks(now);
+	size_t first_expired = expired.size();
+	while (m_current_tick < target) {
+		if (m_size == 0) {
+			m_current_tick = target;
+			break;
+		}
+
+		m_current_tick++;
+
+		if ((m_current_tick & slot_mask) == 0) {
+			for (int32_t level = 1; level < level_count; level++) {
+				uint64_t index = (m_current_tick >> (slot_bits * level)) & slot_mask;
+				cascade(level, index);
+				if (index != 0) {
+					break;
+				}
+			}
+		}
+
+		slot &due = m_levels[0][m_current_tick & slot_mask];
+		for (const auto &entry : due) {
+			if (ref_ptr<timer> timer = entry.lock()) {
+				timer->m_slot = nullptr;
+				expired.push_back(timer);
+			}
+		}
+		m_size -= due.size();
+		due.clear();
+	}
+
+	// Everything in a slot expires on the same tick, keep the order they were due in
+	std::stable_sort(std::begin(expired) + first_expired, std::end(expired), [](const ref_ptr<timer> &a, const ref_ptr<timer> &b) {
+		return a->m_run_at < b->m_run_at;
+	});
+}
+
+auto wheel::get_next_expiry() const -> time_point {
+	if (m_size == 0) {
+		return get_time(m_current_tick) + milliseconds{1000000000};
+	}
+
+	// Higher levels only need to be looked at when the lowest level wraps
+	uint64_t wrap = (m_current_tick | slot_mask) + 1;
+	for (uint64_t tick = m_current_tick + 1; tick < wrap; tick++) {
+		if (!m_levels[0][tick & slot_mask].empty()) {
+			return get_time(tick);
+		}
+	}
+	return get_time(wrap);
+}
+
+auto wheel::size() const -> size_t {
+	return m_size;
+}
+
+auto wheel::insert(ref_ptr<timer> timer, uint64_t expiry_tick) -> void {
+	// Compared rather than passed to std::min, which would odr-use max_ticks
+	uint64_t delta = expiry_tick - m_current_tick;
+	if (delta > max_ticks) {
+		delta = max_ticks;
+	}
+	expiry_tick = m_current_tick + delta;
+
+	int32_t level = 0;
+	while (level < level_count - 1 && delta >= (1ULL << (slot_bits * (level + 1)))) {
+		level++;
+	}
+
+	slot &target = m_levels[level][(expiry_tick >> (slot_bits * level)) & slot_mask];
+	timer->m_slot = &target;
+	timer->m_slot_position = target.insert(std::end(target), timer);
+	m_size++;
+}
+
+auto wheel::cascade(int32_t level, uint64_t index) -> void {
+	slot entries;
+	entries.swap(m_levels[level][index]);
+	m_size -= entries.size();
+
+	for (const auto &entry : entries) {
+		if (ref_ptr<timer> timer = entry.lock()) {
+			// Timers clamped to the top level are placed again from their real expiry
+			insert(timer, std::max(get_tick(timer->m_run_at), m_current_tick));
+		}
+	}
+}
+
+auto wheel::get_tick(const time_point &at) const -> uint64_t {
+	if (at <= m_start) {
+		return 0;
+	}
+
+	uint64_t ticks = get_elapsed_ticks(at);
+	if (get_time(ticks) < at) {
+		ticks++;
+	}
+	return ticks;
+}
+
+auto wheel::get_elapsed_ticks(const time_point &at) const -> uint64_t {
+	if (at <= m_start) {
+		return 0;
+	}
+
+	return static_cast<uint64_t>((at - m_start) / tick_length);
+}
+
+auto wheel::get_time(uint64_t tick) const -> time_point {
+	return m_start + duration_cast<duration>(tick_length * tick);
+}
+
+}
+}
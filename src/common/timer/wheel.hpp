@@ -0,0 +1,63 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <array>
+#include <list>
+#include <vector>
+
+namespace vana {
+	namespace timer {
+		class timer;
+
+		// Hierarchical timing wheel; every level has 256 slots, each level's slot spans the whole level below it
+		// Not thread-safe, the timer thread guards it
+		class wheel {
+			NONCOPYABLE(wheel);
+			NO_DEFAULT_CONSTRUCTOR(wheel);
+		public:
+			using slot = std::list<view_ptr<timer>>;
+
+			wheel(const time_point &start);
+
+			auto schedule(ref_ptr<timer> timer, const time_point &now) -> void;
+			auto cancel(timer *timer) -> void;
+			auto advance(const time_point &now, vector<ref_ptr<timer>> &expired) -> void;
+			auto get_next_expiry() const -> time_point;
+			auto size() const -> size_t;
+		private:
+			static const int32_t slot_bits = 8;
+			static const int32_t slot_count = 1 << slot_bits;
+			static const int32_t level_count = 4;
+			static const uint64_t slot_mask = slot_count - 1;
+			static const uint64_t max_ticks = (1ULL << (slot_bits * level_count)) - 1;
+
+			auto insert(ref_ptr<timer> timer, uint64_t expiry_tick) -> void;
+			auto cascade(int32_t level, uint64_t index) -> void;
+			auto get_tick(const time_point &at) const -> uint64_t;
+			auto get_elapsed_ticks(const time_point &at) const -> uint64_t;
+			auto get_time(uint64_t tick) const -> time_point;
+
+			time_point m_start;
+			uint64_t m_current_tick = 0;
+			size_t m_size = 0;
+			std::array<std::array<slot, slot_count>, level_count> m_levels;
+		};
+	}
+}
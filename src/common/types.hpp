@@ -283,7 +283,7 @@ namespace vana {
 	template <typename TSrc, typename ...TArgs>
 	inline
 	auto make_owned_ptr(TArgs && ...args) -> owned_ptr<TSrc> {
-		return std::make_unique<TSrc>(args...);
+		return std::make_unique<TSrc>(std::forward<TArgs>(args)...);
 	}
 
 	// Game protocol/entity types
@@ -0,0 +1,237 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "buffer_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace vana {
+namespace util {
+
+namespace {
+
+const size_t class_count = 12; // 64 through 131072
+const size_t local_class_limit = 32;
+const size_t transfer_batch = local_class_limit / 2;
+const size_t global_class_bytes = 8 * 1024 * 1024;
+const size_t global_class_limit = 4096;
+
+struct local_cache {
+	std::array<vector<unsigned char *>, class_count> free_lists;
+};
+
+struct global_list {
+	mutex list_mutex;
+	vector<unsigned char *> free_list;
+};
+
+std::array<global_list, class_count> s_global;
+
+// Thread local storage only holds trivial types on some of our compilers, pooled threads hand the cache back when they exit
+thread_local local_cache *s_local = nullptr;
+
+auto get_local() -> local_cache & {
+	if (s_local == nullptr) {
+		s_local = new local_cache;
+	}
+	return *s_local;
+}
+
+auto get_global_limit(size_t class_size) -> size_t {
+	return std::min(global_class_limit, std::max(transfer_batch * 2, global_class_bytes / class_size));
+}
+
+}
+
+std::atomic<uint64_t> buffer_pool::s_allocations{0};
+std::atomic<uint64_t> buffer_pool::s_deallocations{0};
+std::atomic<uint64_t> buffer_pool::s_acquires{0};
+
+auto buffer_pool::get_class_index(size_t size) -> size_t {
+	size_t index = 0;
+	size_t class_size = min_class_size;
+	while (class_size < size) {
+		class_size <<= 1;
+		index++;
+	}
+	return index;
+}
+
+auto buffer_pool::get_class_size(size_t index) -> size_t {
+	return min_class_size << index;
+}
+
+auto buffer_pool::acquire(size_t minimum, size_t &capacity) -> unsigned char * {
+	s_acquires.fetch_add(1, std::memory_order_relaxed);
+
+	if (minimum > max_class_size) {
+		// Nothing we see routinely, not worth holding on to
+		s_allocations.fetch_add(1, std::memory_order_relaxed);
+		capacity = minimum;
+		return new unsigned char[minimum];
+	}
+
+	size_t index = get_class_index(minimum);
+	capacity = get_class_size(index);
+
+	auto &local = get_local().free_lists[index];
+	if (local.empty()) {
+		auto &global = s_global[index];
+		owned_lock<mutex> l{global.list_mutex};
+		size_t count = std::min(transfer_batch, global.free_list.size());
+		local.insert(std::end(local), std::end(global.free_list) - count, std::end(global.free_list));
+		global.free_list.resize(global.free_list.size() - count);
+	}
+
+	if (local.empty()) {
+		s_allocations.fetch_add(1, std::memory_order_relaxed);
+		return new unsigned char[capacity];
+	}
+
+	unsigned char *buffer = local.back();
+	local.pop_back();
+	return buffer;
+}
+
+auto buffer_pool::release(unsigned char *buffer, size_t capacity) -> void {
+	if (buffer == nullptr) return;
+
+	if (capacity > max_class_size) {
+		s_deallocations.fetch_add(1, std::memory_order_relaxed);
+		delete[] buffer;
+		return;
+	}
+
+	size_t index = get_class_index(capacity);
+	auto &local = get_local().free_lists[index];
+	local.push_back(buffer);
+	if (local.size() <= local_class_limit) {
+		return;
+	}
+
+	// Buffers tend to be released on a different thread than the one that acquired them, so spill the excess where everyone can see it
+	auto &global = s_global[index];
+	size_t limit = get_global_limit(capacity);
+	owned_lock<mutex> l{global.list_mutex};
+	while (local.size() > local_class_limit - transfer_batch) {
+		unsigned char *spilled = local.back();
+		local.pop_back();
+		if (global.free_list.size() < limit) {
+			global.free_list.push_back(spilled);
+		}
+		else {
+			s_deallocations.fetch_add(1, std::memory_order_relaxed);
+			delete[] spilled;
+		}
+	}
+}
+
+auto buffer_pool::release_thread_cache() -> void {
+	if (s_local == nullptr) return;
+
+	for (size_t index = 0; index < class_count; ++index) {
+		auto &local = s_local->free_lists[index];
+		if (local.empty()) continue;
+
+		auto &global = s_global[index];
+		size_t limit = get_global_limit(get_class_size(index));
+		owned_lock<mutex> l{global.list_mutex};
+		for (unsigned char *buffer : local) {
+			if (global.free_list.size() < limit) {
+				global.free_list.push_back(buffer);
+			}
+			else {
+				s_deallocations.fetch_add(1, std::memory_order_relaxed);
+				delete[] buffer;
+			}
+		}
+	}
+
+	delete s_local;
+	s_local = nullptr;
+}
+
+auto buffer_pool::get_allocation_count() -> uint64_t {
+	return s_allocations.load(std::memory_order_relaxed);
+}
+
+auto buffer_pool::get_deallocation_count() -> uint64_t {
+	return s_deallocations.load(std::memory_order_relaxed);
+}
+
+auto buffer_pool::get_acquire_count() -> uint64_t {
+	return s_acquires.load(std::memory_order_relaxed);
+}
+
+pooled_buffer::pooled_buffer(size_t minimum) {
+	m_buffer = buffer_pool::acquire(minimum, m_capacity);
+}
+
+pooled_buffer::pooled_buffer(pooled_buffer &&other) :
+	m_buffer{other.m_buffer},
+	m_capacity{other.m_capacity}
+{
+	other.m_buffer = nullptr;
+	other.m_capacity = 0;
+}
+
+pooled_buffer::~pooled_buffer() {
+	reset();
+}
+
+auto pooled_buffer::operator=(pooled_buffer &&other) -> pooled_buffer & {
+	if (this != &other) {
+		reset();
+		std::swap(m_buffer, other.m_buffer);
+		std::swap(m_capacity, other.m_capacity);
+	}
+	return *this;
+}
+
+auto pooled_buffer::grow(size_t minimum, size_t preserve) -> void {
+	if (m_capacity >= minimum) return;
+
+	// Past the largest size class the pool hands out exact sizes, so keep growth geometric here
+	size_t capacity = 0;
+	unsigned char *buffer = buffer_pool::acquire(std::max(minimum, m_capacity * 2), capacity);
+	if (m_buffer != nullptr && preserve > 0) {
+		memcpy(buffer, m_buffer, std::min(preserve, m_capacity));
+	}
+	reset();
+	m_buffer = buffer;
+	m_capacity = capacity;
+}
+
+auto pooled_buffer::reset() -> void {
+	buffer_pool::release(m_buffer, m_capacity);
+	m_buffer = nullptr;
+	m_capacity = 0;
+}
+
+auto pooled_buffer::release() -> unsigned char * {
+	unsigned char *buffer = m_buffer;
+	m_buffer = nullptr;
+	m_capacity = 0;
+	return buffer;
+}
+
+}
+}
@@ -0,0 +1,73 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace vana {
+	namespace util {
+		// Hands out byte buffers in power-of-two size classes so that packets don't go to the heap every time
+		// Each thread keeps a small cache per class and trades batches with a shared list, so a buffer may be released on any thread
+		class buffer_pool {
+		public:
+			static const size_t min_class_size = 64;
+			static const size_t max_class_size = 131072;
+
+			// Returns a buffer of at least minimum bytes, capacity receives the real size which must be passed back to release
+			static auto acquire(size_t minimum, size_t &capacity) -> unsigned char *;
+			static auto release(unsigned char *buffer, size_t capacity) -> void;
+			// Hands the calling thread's cache back to the shared lists, for threads that are about to exit
+			static auto release_thread_cache() -> void;
+
+			// Number of buffers that had to come from (or go back to) the heap, a warm server should see these stay flat
+			static auto get_allocation_count() -> uint64_t;
+			static auto get_deallocation_count() -> uint64_t;
+			static auto get_acquire_count() -> uint64_t;
+		private:
+			static auto get_class_index(size_t size) -> size_t;
+			static auto get_class_size(size_t index) -> size_t;
+
+			static std::atomic<uint64_t> s_allocations;
+			static std::atomic<uint64_t> s_deallocations;
+			static std::atomic<uint64_t> s_acquires;
+		};
+
+		class pooled_buffer {
+			NONCOPYABLE(pooled_buffer);
+		public:
+			pooled_buffer() = default;
+			explicit pooled_buffer(size_t minimum);
+			pooled_buffer(pooled_buffer &&other);
+			~pooled_buffer();
+			auto operator=(pooled_buffer &&other) -> pooled_buffer &;
+
+			auto get() const -> unsigned char * { return m_buffer; }
+			auto capacity() const -> size_t { return m_capacity; }
+			// Ensures the buffer holds at least minimum bytes, the first preserve bytes are kept when the buffer moves
+			auto grow(size_t minimum, size_t preserve) -> void;
+			auto reset() -> void;
+			// Gives up ownership, the caller must hand the pointer back with buffer_pool::release
+			auto release() -> unsigned char *;
+		private:
+			unsigned char *m_buffer = nullptr;
+			size_t m_capacity = 0;
+		};
+	}
+}
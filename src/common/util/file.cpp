@@ -27,6 +27,14 @@ auto exists(const string &file) -> bool {
 	return (!stat(file.c_str(), &file_info)) != 0;
 }
 
+auto get_modified_time(const string &file) -> optional<time_t> {
+	struct stat file_info;
+	if (stat(file.c_str(), &file_info) != 0) {
+		return {};
+	}
+	return file_info.st_mtime;
+}
+
 auto remove_extension(const string &file) -> string {
 	string ret = file;
 	ret = ret.erase(ret.find_last_of('.'));
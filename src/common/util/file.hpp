@@ -18,12 +18,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/types.hpp"
+#include <ctime>
 #include <string>
 
 namespace vana {
 	namespace util {
 		namespace file {
 			auto exists(const string &file) -> bool;
+			auto get_modified_time(const string &file) -> optional<time_t>;
 			auto remove_extension(const string &file) -> string;
 		}
 	}
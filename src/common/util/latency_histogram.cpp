@@ -0,0 +1,96 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "latency_histogram.hpp"
+
+namespace vana {
+namespace util {
+
+latency_histogram::latency_histogram() {
+	reset();
+}
+
+auto latency_histogram::record(const duration &elapsed) -> void {
+	int64_t raw = duration_cast<microseconds>(elapsed).count();
+	uint64_t value = raw < 0 ? 0 : static_cast<uint64_t>(raw);
+
+	size_t index = 0;
+	while (index < bucket_count - 1 && value >= (1ULL << index)) {
+		index++;
+	}
+
+	m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_total.fetch_add(value, std::memory_order_relaxed);
+
+	uint64_t max = m_max.load(std::memory_order_relaxed);
+	while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+	}
+}
+
+auto latency_histogram::reset() -> void {
+	for (auto &bucket : m_buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	m_count.store(0, std::memory_order_relaxed);
+	m_total.store(0, std::memory_order_relaxed);
+	m_max.store(0, std::memory_order_relaxed);
+}
+
+auto latency_histogram::get_count() const -> uint64_t {
+	return m_count.load(std::memory_order_relaxed);
+}
+
+auto latency_histogram::get_bucket(size_t index) const -> uint64_t {
+	return m_buckets[index].load(std::memory_order_relaxed);
+}
+
+auto latency_histogram::get_mean() const -> microseconds {
+	uint64_t count = get_count();
+	if (count == 0) {
+		return microseconds{0};
+	}
+	return microseconds{static_cast<int64_t>(m_total.load(std::memory_order_relaxed) / count)};
+}
+
+auto latency_histogram::get_max() const -> microseconds {
+	return microseconds{static_cast<int64_t>(m_max.load(std::memory_order_relaxed))};
+}
+
+auto latency_histogram::get_percentile(double percentile) const -> microseconds {
+	uint64_t count = get_count();
+	if (count == 0) {
+		return microseconds{0};
+	}
+
+	uint64_t target = static_cast<uint64_t>(count * (percentile / 100.));
+	uint64_t seen = 0;
+	for (size_t i = 0; i < bucket_count - 1; i++) {
+		seen += get_bucket(i);
+		if (seen > target) {
+			return get_bucket_limit(i);
+		}
+	}
+	return get_max();
+}
+
+auto latency_histogram::get_bucket_limit(size_t index) -> microseconds {
+	return microseconds{static_cast<int64_t>(1ULL << index)};
+}
+
+}
+}
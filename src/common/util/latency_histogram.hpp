@@ -0,0 +1,53 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace vana {
+	namespace util {
+		// Power-of-two microsecond buckets, safe to record into from any thread
+		class latency_histogram {
+			NONCOPYABLE(latency_histogram);
+		public:
+			// Bucket i holds samples below 2^i microseconds, the last one catches everything slower
+			static const size_t bucket_count = 24;
+
+			latency_histogram();
+
+			auto record(const duration &elapsed) -> void;
+			auto reset() -> void;
+
+			auto get_count() const -> uint64_t;
+			auto get_bucket(size_t index) const -> uint64_t;
+			auto get_mean() const -> microseconds;
+			auto get_max() const -> microseconds;
+			// Upper bound of the bucket the percentile falls into, percentile is in [0, 100]
+			auto get_percentile(double percentile) const -> microseconds;
+
+			static auto get_bucket_limit(size_t index) -> microseconds;
+		private:
+			std::atomic<uint64_t> m_buckets[bucket_count];
+			std::atomic<uint64_t> m_count;
+			std::atomic<uint64_t> m_total;
+			std::atomic<uint64_t> m_max;
+		};
+	}
+}
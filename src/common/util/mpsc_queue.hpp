@@ -0,0 +1,76 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <atomic>
+#include <utility>
+
+namespace vana {
+	namespace util {
+		// Unbounded multi-producer, single-consumer queue
+		// push never blocks or takes a lock; only one thread may call try_pop
+		template <typename T>
+		class mpsc_queue {
+			NONCOPYABLE(mpsc_queue);
+		public:
+			mpsc_queue() :
+				m_tail{new node{}}
+			{
+				m_head.store(m_tail, std::memory_order_relaxed);
+			}
+
+			~mpsc_queue() {
+				T discard;
+				while (try_pop(discard)) {
+				}
+				delete m_tail;
+			}
+
+			auto push(T value) -> void {
+				node *item = new node{std::move(value)};
+				node *previous = m_head.exchange(item, std::memory_order_acq_rel);
+				previous->next.store(item, std::memory_order_release);
+			}
+
+			auto try_pop(T &value) -> bool {
+				node *next = m_tail->next.load(std::memory_order_acquire);
+				if (next == nullptr) {
+					return false;
+				}
+
+				// The popped node becomes the new stub
+				value = std::move(next->value);
+				delete m_tail;
+				m_tail = next;
+				return true;
+			}
+		private:
+			struct node {
+				node() = default;
+				explicit node(T value) : value{std::move(value)} { }
+
+				std::atomic<node *> next{nullptr};
+				T value;
+			};
+
+			std::atomic<node *> m_head;
+			node *m_tail;
+		};
+	}
+}
@@ -0,0 +1,82 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "opcode_stats.hpp"
+
+namespace vana {
+namespace util {
+
+opcode_stats::opcode_stats() {
+	for (auto &page : m_pages) {
+		page.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+opcode_stats::~opcode_stats() {
+	for (auto &page : m_pages) {
+		delete page.load(std::memory_order_relaxed);
+	}
+}
+
+auto opcode_stats::record(packet_header opcode, size_t bytes, const duration &elapsed) -> void {
+	entry &value = get_page(opcode / page_size).entries[opcode % page_size];
+	value.handler_time.record(elapsed);
+	value.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+auto opcode_stats::reset() -> void {
+	for (auto &page_value : m_pages) {
+		page *current = page_value.load(std::memory_order_acquire);
+		if (current == nullptr) continue;
+
+		for (auto &value : current->entries) {
+			value.handler_time.reset();
+			value.bytes.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+auto opcode_stats::for_each(function<void(packet_header, const entry &)> func) const -> void {
+	for (size_t i = 0; i < page_count; i++) {
+		const page *current = m_pages[i].load(std::memory_order_acquire);
+		if (current == nullptr) continue;
+
+		for (size_t k = 0; k < page_size; k++) {
+			const entry &value = current->entries[k];
+			if (value.handler_time.get_count() == 0) continue;
+			func(static_cast<packet_header>(i * page_size + k), value);
+		}
+	}
+}
+
+auto opcode_stats::get_page(size_t index) -> page & {
+	page *current = m_pages[index].load(std::memory_order_acquire);
+	if (current != nullptr) {
+		return *current;
+	}
+
+	owned_lock<mutex> l{m_allocation_mutex};
+	current = m_pages[index].load(std::memory_order_relaxed);
+	if (current == nullptr) {
+		current = new page;
+		m_pages[index].store(current, std::memory_order_release);
+	}
+	return *current;
+}
+
+}
+}
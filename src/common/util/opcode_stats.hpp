@@ -0,0 +1,58 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include "common/util/latency_histogram.hpp"
+#include <atomic>
+
+namespace vana {
+	namespace util {
+		// Handler time, request count and bytes for every opcode a server receives, safe to record into from any thread
+		// Opcodes are split into pages of 256 that are only allocated once something in them is seen
+		class opcode_stats {
+			NONCOPYABLE(opcode_stats);
+		public:
+			struct entry {
+				// The histogram count doubles as the request count
+				latency_histogram handler_time;
+				std::atomic<uint64_t> bytes{0};
+			};
+
+			opcode_stats();
+			~opcode_stats();
+
+			auto record(packet_header opcode, size_t bytes, const duration &elapsed) -> void;
+			auto reset() -> void;
+			// Only visits opcodes that have been recorded since the last reset
+			auto for_each(function<void(packet_header, const entry &)> func) const -> void;
+		private:
+			static const size_t page_size = 256;
+			static const size_t page_count = 256;
+
+			struct page {
+				entry entries[page_size];
+			};
+
+			auto get_page(size_t index) -> page &;
+
+			std::atomic<page *> m_pages[page_count];
+			mutex m_allocation_mutex;
+		};
+	}
+}
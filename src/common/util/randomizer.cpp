@@ -20,7 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace vana {
 namespace util {
 
-vana::util::randomizer::_impl vana::util::randomizer::s_rand = vana::util::randomizer::_impl{};
+thread_local vana::util::randomizer::_impl *vana::util::randomizer::s_rand = nullptr;
 
 }
 }
\ No newline at end of file
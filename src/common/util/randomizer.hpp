@@ -40,21 +40,21 @@ namespace vana {
 
 			template <typename TDistribution>
 			static auto rand(TDistribution &dist) -> typename TDistribution::result_type {
-				return dist(s_rand.engine());
+				return dist(get_impl().engine());
 			}
 
 			template <typename TNumber>
 			static auto range(TNumber base, TNumber modifier) -> std::enable_if_t<std::is_integral<TNumber>::value, TNumber> {
 				TNumber min = base - (modifier / 2);
 				TNumber max = base + (modifier / 2);
-				return s_rand.rand(max, min);
+				return get_impl().rand(max, min);
 			}
 
 			template <typename TNumber>
 			static auto range(TNumber base, TNumber modifier) -> std::enable_if_t<std::is_floating_point<TNumber>::value, TNumber> {
 				TNumber min = base - (modifier / 2);
 				TNumber max = base + (modifier / 2);
-				return s_rand.rand(max, min);
+				return get_impl().rand(max, min);
 			}
 
 			static auto percentage() -> int32_t {
@@ -63,27 +63,27 @@ namespace vana {
 
 			template <typename TNumber>
 			static auto percentage() -> std::enable_if_t<std::is_integral<TNumber>::value, TNumber> {
-				return s_rand.rand(99, 0);
+				return get_impl().rand(99, 0);
 			}
 
 			template <typename TNumber>
 			static auto rand(TNumber max, TNumber min = 0) -> std::enable_if_t<std::is_integral<TNumber>::value, TNumber> {
-				return s_rand.rand(max, min);
+				return get_impl().rand(max, min);
 			}
 
 			template <typename TNumber>
 			static auto rand(TNumber max, TNumber min = 0) -> std::enable_if_t<std::is_floating_point<TNumber>::value, TNumber> {
-				return s_rand.rand(max, min);
+				return get_impl().rand(max, min);
 			}
 
 			template <typename TNumber>
 			static auto twofold(TNumber min) -> std::enable_if_t<std::is_integral<TNumber>::value, TNumber> {
-				return min + s_rand.rand(min, 0);
+				return min + get_impl().rand(min, 0);
 			}
 
 			template <typename TNumber>
 			static auto twofold(TNumber min) -> std::enable_if_t<std::is_floating_point<TNumber>::value, TNumber> {
-				return min + s_rand.rand(min, 0);
+				return min + get_impl().rand(min, 0);
 			}
 
 			template <typename TContainer>
@@ -93,7 +93,7 @@ namespace vana {
 
 			template <typename TIterator>
 			static auto shuffle(TIterator begin, TIterator end) -> void {
-				std::shuffle(begin, end, s_rand.engine());
+				std::shuffle(begin, end, get_impl().engine());
 			}
 
 			template <typename TContainer>
@@ -152,7 +152,16 @@ namespace vana {
 				std::mt19937 m_engine;
 			};
 
-			static _impl s_rand;
+			// Game logic runs on several threads (packet dispatch, timers, map workers) and engines aren't thread-safe
+			// Thread local storage only holds trivial types on some of our compilers, each engine lives for the life of its thread
+			static auto get_impl() -> _impl & {
+				if (s_rand == nullptr) {
+					s_rand = new _impl;
+				}
+				return *s_rand;
+			}
+
+			static thread_local _impl *s_rand;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "shared_gate.hpp"
+
+namespace vana {
+namespace util {
+
+auto shared_gate::lock() -> void {
+	owned_lock<mutex> l{m_mutex};
+	m_exclusive_waiting++;
+	m_condition.wait(l, [this] { return !m_exclusive && !m_shared_turn && m_shared == 0; });
+	m_exclusive_waiting--;
+	m_exclusive = true;
+}
+
+auto shared_gate::unlock() -> void {
+	{
+		owned_lock<mutex> l{m_mutex};
+		m_exclusive = false;
+		m_shared_turn = m_shared_waiting > 0;
+	}
+	m_condition.notify_all();
+}
+
+auto shared_gate::lock_shared() -> void {
+	owned_lock<mutex> l{m_mutex};
+	m_shared_waiting++;
+	m_condition.wait(l, [this] { return !m_exclusive && (m_exclusive_waiting == 0 || m_shared_turn); });
+	m_shared_waiting--;
+	m_shared++;
+	if (m_shared_waiting == 0) {
+		m_shared_turn = false;
+	}
+}
+
+auto shared_gate::unlock_shared() -> void {
+	bool last = false;
+	{
+		owned_lock<mutex> l{m_mutex};
+		last = --m_shared == 0;
+	}
+	if (last) {
+		m_condition.notify_all();
+	}
+}
+
+}
+}
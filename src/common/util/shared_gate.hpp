@@ -0,0 +1,56 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <condition_variable>
+
+namespace vana {
+	namespace util {
+		// Lets any number of shared holders run together while an exclusive holder runs alone
+		// Shared holders that were waiting when an exclusive holder leaves get in before the next one, so neither side starves
+		class shared_gate {
+			NONCOPYABLE(shared_gate);
+		public:
+			class shared_lock {
+				NONCOPYABLE(shared_lock);
+				NO_DEFAULT_CONSTRUCTOR(shared_lock);
+			public:
+				explicit shared_lock(shared_gate &gate) : m_gate{gate} { m_gate.lock_shared(); }
+				~shared_lock() { m_gate.unlock_shared(); }
+			private:
+				shared_gate &m_gate;
+			};
+
+			shared_gate() = default;
+
+			auto lock() -> void;
+			auto unlock() -> void;
+			auto lock_shared() -> void;
+			auto unlock_shared() -> void;
+		private:
+			mutex m_mutex;
+			std::condition_variable m_condition;
+			uint32_t m_shared = 0;
+			uint32_t m_shared_waiting = 0;
+			uint32_t m_exclusive_waiting = 0;
+			bool m_exclusive = false;
+			bool m_shared_turn = false;
+		};
+	}
+}
@@ -0,0 +1,124 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "string_matcher.hpp"
+#include <algorithm>
+
+namespace vana {
+namespace util {
+
+string_matcher::string_matcher()
+{
+	m_classes.fill(0);
+	m_transitions.assign(m_class_count, 0);
+	m_terminal.assign(1, false);
+}
+
+auto string_matcher::build(const vector<string> &words) -> void {
+	m_classes.fill(0);
+	m_class_count = 1;
+	for (const auto &word : words) {
+		for (char value : word) {
+			auto &word_class = m_classes[static_cast<unsigned char>(value)];
+			if (word_class == 0) {
+				word_class = static_cast<uint16_t>(m_class_count++);
+			}
+		}
+	}
+
+	// Build the trie, -1 marks a missing edge until the failure links fill it in
+	m_transitions.assign(m_class_count, -1);
+	m_terminal.assign(1, false);
+	for (const auto &word : words) {
+		state current = 0;
+		for (char value : word) {
+			size_t edge = current * m_class_count + get_class(value);
+			if (m_transitions[edge] == -1) {
+				state added = static_cast<state>(m_terminal.size());
+				m_transitions[edge] = added;
+				m_transitions.resize(m_transitions.size() + m_class_count, -1);
+				m_terminal.push_back(false);
+			}
+			current = m_transitions[current * m_class_count + get_class(value)];
+		}
+		m_terminal[current] = true;
+	}
+
+	// Breadth first so each state's failure target is complete before it's used
+	vector<state> failure(m_terminal.size(), 0);
+	vector<state> pending;
+	size_t next_pending = 0;
+
+	// Class 0 can't continue any word, so it always falls back to the root
+	for (size_t word_class = 0; word_class < m_class_count; ++word_class) {
+		state &target = m_transitions[word_class];
+		if (target == -1 || word_class == 0) {
+			target = 0;
+		}
+		else {
+			failure[target] = 0;
+			pending.push_back(target);
+		}
+	}
+
+	while (next_pending < pending.size()) {
+		state current = pending[next_pending++];
+		state fallback = failure[current];
+		if (m_terminal[fallback]) {
+			m_terminal[current] = true;
+		}
+
+		for (size_t word_class = 0; word_class < m_class_count; ++word_class) {
+			size_t edge = current * m_class_count + word_class;
+			state fallback_target = m_transitions[fallback * m_class_count + word_class];
+			if (word_class == 0) {
+				m_transitions[edge] = 0;
+			}
+			else if (m_transitions[edge] == -1) {
+				m_transitions[edge] = fallback_target;
+			}
+			else {
+				failure[m_transitions[edge]] = fallback_target;
+				pending.push_back(m_transitions[edge]);
+			}
+		}
+	}
+
+	m_transitions.shrink_to_fit();
+}
+
+auto string_matcher::contains_any(const string &text) const -> bool {
+	state current = 0;
+	if (m_terminal[current]) {
+		return true;
+	}
+
+	for (char value : text) {
+		current = m_transitions[current * m_class_count + get_class(value)];
+		if (m_terminal[current]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+auto string_matcher::empty() const -> bool {
+	return m_terminal.size() == 1 && !m_terminal[0];
+}
+
+}
+}
@@ -0,0 +1,47 @@
+/*
+Copyright (C) 2008-2016 Vana Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; version 2
+of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#pragma once
+
+#include "common/types.hpp"
+#include <string>
+#include <vector>
+
+namespace vana {
+	namespace util {
+		// Aho-Corasick automaton over a fixed word list
+		// Checking a string for any of the words is linear in the length of the string, regardless of how many words there are
+		class string_matcher {
+		public:
+			string_matcher();
+
+			auto build(const vector<string> &words) -> void;
+			auto contains_any(const string &text) const -> bool;
+			auto empty() const -> bool;
+		private:
+			using state = int32_t;
+
+			auto get_class(char value) const -> uint16_t { return m_classes[static_cast<unsigned char>(value)]; }
+
+			// Bytes that never appear in a word share class 0, which keeps the transition table narrow
+			array<uint16_t, 256> m_classes;
+			size_t m_class_count = 1;
+			vector<state> m_transitions;
+			vector<bool> m_terminal;
+		};
+	}
+}
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #pragma once
 
 #include "common/types.hpp"
+#include "common/util/buffer_pool.hpp"
 #include <atomic>
 #include <thread>
 
@@ -59,6 +60,7 @@ namespace vana {
 						while (m_runhread.load(std::memory_order_relaxed)) {
 							work();
 						}
+						buffer_pool::release_thread_cache();
 					});
 					auto pair = make_owned_ptr<thread_pair>(thread, pre_wait_hook);
 					mhreads.emplace_back(std::move(pair));
@@ -71,6 +73,8 @@ namespace vana {
 						while (m_runhread.load(std::memory_order_relaxed)) {
 							work(l);
 						}
+						l.unlock();
+						buffer_pool::release_thread_cache();
 					});
 					auto pair = make_owned_ptr<thread_pair>(thread, pre_wait_hook);
 					mhreads.emplace_back(std::move(pair));
@@ -140,43 +140,55 @@ auto characters::show_all_characters(ref_ptr<user> user_value) -> void {
 }
 
 auto characters::show_characters(ref_ptr<user> user_value) -> void {
-	auto &db = vana::io::database::get_char_db();
-	auto &sql = db.get_session();
 	auto world_id = user_value->get_world_id();
 	game_account_id account_id = user_value->get_account_id();
 	if (!world_id.is_initialized()) {
 		THROW_CODE_EXCEPTION(codepath_invalid_exception, "!world_id.is_initialized()");
 	}
 
-	soci::rowset<> rs = (sql.prepare
-		<< "SELECT * "
-		<< "FROM " << db.make_table(vana::table::characters) << " c "
-		<< "WHERE c.account_id = :account AND c.world_id = :world ",
-		soci::use(account_id, "account"),
-		soci::use(world_id.get(), "world"));
-
-	vector<character> chars;
-	for (const auto &row : rs) {
-		character charc;
-		load_character(charc, row);
-		chars.push_back(charc);
-	}
-
-	opt_int32_t max;
-	sql.once
-		<< "SELECT s.char_slots "
-		<< "FROM " << db.make_table(vana::table::storage) << " s "
-		<< "WHERE s.account_id = :account AND s.world_id = :world ",
-		soci::use(account_id, "account"),
-		soci::use(world_id.get(), "world"),
-		soci::into(max);
+	game_world_id world = world_id.get();
+	login_server::get_instance().get_database_executor().post<pair<vector<character>, opt_int32_t>>(
+		"show_characters",
+		[account_id, world](vana::io::database &db) -> pair<vector<character>, opt_int32_t> {
+			auto &sql = db.get_session();
+			soci::rowset<> rs = (sql.prepare
+				<< "SELECT * "
+				<< "FROM " << db.make_table(vana::table::characters) << " c "
+				<< "WHERE c.account_id = :account AND c.world_id = :world ",
+				soci::use(account_id, "account"),
+				soci::use(world, "world"));
+
+			vector<character> chars;
+			for (const auto &row : rs) {
+				character charc;
+				load_character(charc, row);
+				chars.push_back(charc);
+			}
 
-	if (!sql.got_data() || !max.is_initialized()) {
-		const auto &config = login_server::get_instance().get_worlds().get_world(world_id.get())->get_config();
-		max = config.default_chars;
-	}
+			opt_int32_t max;
+			sql.once
+				<< "SELECT s.char_slots "
+				<< "FROM " << db.make_table(vana::table::storage) << " s "
+				<< "WHERE s.account_id = :account AND s.world_id = :world ",
+				soci::use(account_id, "account"),
+				soci::use(world, "world"),
+				soci::into(max);
+
+			if (!sql.got_data()) {
+				max.reset();
+			}
+			return std::make_pair(chars, max);
+		},
+		[user_value, world](pair<vector<character>, opt_int32_t> result) {
+			opt_int32_t max = result.second;
+			if (!max.is_initialized()) {
+				// World configuration belongs to the dispatch thread, so the default is resolved here rather than in the query
+				const auto &config = login_server::get_instance().get_worlds().get_world(world)->get_config();
+				max = config.default_chars;
+			}
 
-	user_value->send(packets::show_characters(chars, max.get()));
+			user_value->send(packets::show_characters(result.first, max.get()));
+		});
 }
 
 auto characters::check_character_name(ref_ptr<user> user_value, packet_reader &reader) -> void {
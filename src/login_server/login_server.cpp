@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "common/connection_listener_config.hpp"
 #include "common/connection_manager.hpp"
 #include "common/data/initialize.hpp"
+#include "common/data/snapshot.hpp"
 #include "common/maple_version.hpp"
 #include "common/server_type.hpp"
 #include "login_server/login_server_accept_packet.hpp"
@@ -49,6 +50,7 @@ auto login_server::listen() -> void {
 	get_connection_manager().listen(
 		connection_listener_config{
 			config.client_ping,
+			config.client_send_queue_limit,
 			config.client_encryption,
 			connection_type::end_user,
 			maple_version::login_subversion,
@@ -61,6 +63,7 @@ auto login_server::listen() -> void {
 	get_connection_manager().listen(
 		connection_listener_config{
 			config.server_ping,
+			0,
 			true,
 			connection_type::unknown,
 			maple_version::login_subversion,
@@ -91,6 +94,7 @@ auto login_server::load_data() -> result {
 	m_valid_char_data_provider.load_data();
 	m_equip_data_provider.load_data();
 	m_curse_data_provider.load_data();
+	vana::data::snapshot::get_instance().close();
 
 	ranking_calculator::set_timer();
 	display_launch_time();
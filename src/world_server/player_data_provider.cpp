@@ -209,6 +209,7 @@ auto player_data_provider::handle_player_sync(ref_ptr<world_server_accepted_sess
 	switch (reader.get<protocol_sync>()) {
 		case sync::player::change_channel_request: handle_change_channel_request(session, reader); break;
 		case sync::player::change_channel_go: handle_change_channel(reader); break;
+		case sync::player::handoff: handle_handoff(reader); break;
 		case sync::player::connect: handle_player_connect(session->get_channel(), reader); break;
 		case sync::player::disconnect: handle_player_disconnect(session->get_channel(), reader); break;
 		case sync::player::update_player: handle_player_update(reader); break;
@@ -395,6 +396,17 @@ auto player_data_provider::handle_change_channel(packet_reader &reader) -> void
 	remove_pending_player(player_id);
 }
 
+auto player_data_provider::handle_handoff(packet_reader &reader) -> void {
+	game_player_id player_id = reader.get<game_player_id>();
+	channel *destination_channel = world_server::get_instance().get_channels().get_channel(reader.get<game_channel_id>());
+	if (destination_channel == nullptr) {
+		// The destination expires the pending connection by itself
+		return;
+	}
+
+	destination_channel->send(packets::interserver::player::handoff(player_id, reader));
+}
+
 // Parties
 auto player_data_provider::handle_create_party(game_player_id player_id) -> void {
 	auto &player = m_players[player_id];
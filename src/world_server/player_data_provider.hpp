@@ -68,6 +68,7 @@ namespace vana {
 			auto handle_player_disconnect(game_channel_id channel, packet_reader &reader) -> void;
 			auto handle_change_channel_request(ref_ptr<world_server_accepted_session> session, packet_reader &reader) -> void;
 			auto handle_change_channel(packet_reader &reader) -> void;
+			auto handle_handoff(packet_reader &reader) -> void;
 			auto handle_player_update(packet_reader &reader) -> void;
 			auto handle_character_created(packet_reader &reader) -> void;
 			auto handle_character_deleted(packet_reader &reader) -> void;
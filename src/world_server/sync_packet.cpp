@@ -85,6 +85,17 @@ PACKET_IMPL(player::delete_connectable, game_player_id player_id) {
 	return builder;
 }
 
+PACKET_IMPL(player::handoff, game_player_id player_id, packet_reader &buffer) {
+	packet_builder builder;
+	builder
+		.add<packet_header>(IMSG_SYNC)
+		.add<protocol_sync>(sync::sync_types::player)
+		.add<protocol_sync>(sync::player::handoff)
+		.add<game_player_id>(player_id)
+		.add_buffer(buffer);
+	return builder;
+}
+
 PACKET_IMPL(player::player_change_channel, game_player_id player_id, game_channel_id channel_id, const ip &ip_value, connection_port port) {
 	packet_builder builder;
 	builder
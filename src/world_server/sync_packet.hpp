@@ -52,6 +52,7 @@ namespace vana {
 					PACKET(player_change_channel, game_player_id player_id, game_channel_id channel_id, const ip &ip_value, connection_port port);
 					PACKET(new_connectable, game_player_id player_id, const ip &ip_value, packet_reader &buffer);
 					PACKET(delete_connectable, game_player_id player_id);
+					PACKET(handoff, game_player_id player_id, packet_reader &buffer);
 					PACKET(update_player, const player_data &data, protocol_update_bits flags);
 					PACKET(character_created, const player_data &data);
 					PACKET(character_deleted, game_player_id id);
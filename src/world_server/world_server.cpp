@@ -47,6 +47,7 @@ auto world_server::listen() -> void {
 	get_connection_manager().listen(
 		connection_listener_config{
 			config.server_ping,
+			0,
 			true,
 			connection_type::unknown,
 			maple_version::login_subversion,